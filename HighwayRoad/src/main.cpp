@@ -34,7 +34,16 @@ SOFTWARE.
 #include <Prime/Input/Touch.h>
 #include <Prime/Font/Font.h>
 #include <Prime/Model/Model.h>
+#include <Prime/Model/ModelInstanceBatch.h>
+#include <Prime/Model/ModelStaticBatch.h>
 #include <Prime/Imagemap/Imagemap.h>
+#include <Prime/Types/BoundsTree.h>
+#include <list>
+#if defined(PrimeTargetOpenGL)
+#include <Prime/Graphics/opengl/OpenGLGraphics.h>
+#elif defined(PrimeTargetNull)
+#include <Prime/Graphics/null/NullGraphics.h>
+#endif
 
 using namespace Prime;
 
@@ -70,6 +79,183 @@ typedef struct {
 #define TreeScale               0.015f
 #define BuildingScale           0.1f
 
+#define BenchmarkModelCount     1000
+#define BenchmarkReportTime     1.0
+#define DriverStatsReportTime   1.0
+#define HeadlessFrameCount      600
+#define ProfilerReportTime      2.0
+#define ProfilerTracePath       "HighwayRoad.trace.json"
+
+#define StressObjectCountStart  5000
+#define StressObjectCountMin    500
+#define StressObjectCountMax    256000
+#define StressRowSpacing        0.25f
+#define StressColumnCount       4
+#define StressColumnSpacing     0.3f
+#define StressRoadOffset        1.2f
+#define StressReportTime        1.0
+
+#define CullObjectCount         100000
+#define CullMoveCount           1000
+#define CullFieldSize           500.0f
+#define CullFieldHeight         10.0f
+#define CullObjectSizeMin       0.25f
+#define CullObjectSizeMax       2.0f
+#define CullReportTime          1.0
+
+#define VariableSetCount        1000000
+
+#define MathPaletteCount        1000
+#define MathBoneCount           64
+#define MathPointCount          100000
+#define MathMatrixCount         100000
+#define MathTolerance           0.0001f
+
+#define JobBenchmarkCount       200000
+#define JobBenchmarkExpressRate 10
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+// Textured model loads bypass GetContent, so they are counted separately for
+// the asset load report.
+static size_t pendingModelLoadCount = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+// Reference copy of the job queue ogalib used before work stealing: jobs are
+// allocated per submission and kept in one list behind one mutex, submissions
+// signal workers round-robin, worker 0 scans the list for express jobs and
+// every worker waits for a signal after each job. Only used to compare
+// against ogalib::Job in the job benchmark.
+class LegacyJobQueue {
+private:
+
+  typedef struct {
+    std::function<void()> callback;
+    u32 index;
+    bool express;
+    f64 queueTime;
+  } LegacyJob;
+
+  ogalib::ThreadMutex mutex;
+  std::list<LegacyJob*> queue;
+  std::vector<LegacyJob*> completedStack;
+  std::vector<ogalib::ThreadCondition*> conditions;
+  std::vector<ogalib::Thread*> threads;
+  bool* waits;
+  size_t nextIndex;
+  std::vector<f64> latencies;
+  std::atomic<size_t> completedCount;
+  std::atomic<bool> active;
+
+public:
+
+  LegacyJobQueue(size_t threadCount, size_t jobCount): waits(new bool[threadCount]), nextIndex(0), latencies(jobCount), completedCount(0), active(true) {
+    for(size_t i = 0; i < threadCount; i++) {
+      waits[i] = false;
+      conditions.push_back(new ogalib::ThreadCondition());
+    }
+
+    for(size_t i = 0; i < threadCount; i++) {
+      ogalib::Thread* thread = new ogalib::Thread([this, i, threadCount](void*) -> void* {
+        Run(i, i == 0 && threadCount > 1);
+        return nullptr;
+      }, nullptr);
+      thread->Start();
+      threads.push_back(thread);
+    }
+  }
+
+  ~LegacyJobQueue() {
+    active = false;
+    for(size_t i = 0; i < threads.size(); i++) {
+      conditions[i]->ShutdownThread(threads[i], waits[i]);
+      delete conditions[i];
+    }
+
+    for(auto job: queue) {
+      delete job;
+    }
+
+    for(auto job: completedStack) {
+      delete job;
+    }
+
+    delete[] waits;
+  }
+
+  void Submit(u32 index, bool express, std::function<void()> callback) {
+    LegacyJob* job = new LegacyJob{std::move(callback), index, express, GetSystemTime()};
+
+    mutex.Lock();
+    queue.push_back(job);
+    mutex.Unlock();
+
+    mutex.Lock();
+    conditions[nextIndex]->Signal(waits[nextIndex]);
+    if(++nextIndex >= conditions.size())
+      nextIndex = 0;
+    mutex.Unlock();
+  }
+
+  // Signals every worker while waiting, as Job::ProcessGlobal did once per
+  // frame to recover wakeups lost between a job finishing and the next wait.
+  void WaitForCompletion(size_t jobCount) {
+    while(completedCount.load(std::memory_order_acquire) < jobCount) {
+      for(size_t i = 0; i < conditions.size(); i++) {
+        conditions[i]->Signal(waits[i]);
+      }
+      ogalib::Thread::Yield();
+    }
+  }
+
+  f64 GetLatencyPercentile(f64 percentile) {
+    std::sort(latencies.begin(), latencies.end());
+    return latencies[std::min(latencies.size() - 1, (size_t) (percentile * latencies.size()))];
+  }
+
+private:
+
+  void Run(size_t number, bool expressLane) {
+    while(active) {
+      LegacyJob* job = nullptr;
+
+      mutex.Lock();
+      if(expressLane) {
+        auto it = std::find_if(queue.begin(), queue.end(), [](const LegacyJob* queuedJob) {return queuedJob->express;});
+        if(it != queue.end()) {
+          job = *it;
+          queue.erase(it);
+        }
+      }
+      else if(!queue.empty()) {
+        job = queue.front();
+        queue.pop_front();
+      }
+      mutex.Unlock();
+
+      if(job) {
+        latencies[job->index] = GetSystemTime() - job->queueTime;
+        job->callback();
+
+        mutex.Lock();
+        completedStack.push_back(job);
+        mutex.Unlock();
+
+        completedCount.fetch_add(1, std::memory_order_release);
+        ogalib::Thread::Yield();
+      }
+
+      conditions[number]->Wait(waits[number]);
+    }
+  }
+
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Entry
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +268,7 @@ int main(int argc, const char* const* argv) {
 
   // Init engine.
   Engine& engine = PxEngine;
+  f64 loadStartTime = GetSystemTime();
 
   // Load font.
   refptr font = new Font();
@@ -95,6 +282,17 @@ int main(int argc, const char* const* argv) {
   refptr scrollTexProgram = DeviceProgram::Create("data/Shader/Tex/ScrollTex.vsh", "data/Shader/Tex/ScrollTex.fsh");
   refptr modelProgram = DeviceProgram::Create("data/Shader/Model/Model.vsh", "data/Shader/Model/Model.fsh");
   refptr modelAnimProgram = DeviceProgram::Create("data/Shader/Model/ModelAnim.vsh", "data/Shader/Model/ModelAnim.fsh");
+  refptr modelInstancedProgram = DeviceProgram::Create("data/Shader/Model/ModelInstanced.vsh", "data/Shader/Model/ModelInstanced.fsh");
+  refptr modelAnimInstancedProgram = DeviceProgram::Create("data/Shader/Model/ModelAnimInstanced.vsh", "data/Shader/Model/ModelAnimInstanced.fsh");
+  refptr modelAnimCompactProgram = DeviceProgram::Create("data/Shader/Model/ModelAnimCompact.vsh", "data/Shader/Model/ModelAnimCompact.fsh");
+  refptr modelAnimInstancedCompactProgram = DeviceProgram::Create("data/Shader/Model/ModelAnimInstancedCompact.vsh", "data/Shader/Model/ModelAnimInstancedCompact.fsh");
+
+  const ProgramVariableHandle scrollHandle("scroll");
+  const ProgramVariableHandle wrapCountHandle("wrapCount");
+
+  // Compact meshes are drawn with these variants in place of the anim programs.
+  modelAnimProgram->SetVariant("compact", modelAnimCompactProgram);
+  modelAnimInstancedProgram->SetVariant("compact", modelAnimInstancedCompactProgram);
 
   // Load assets.
   refptr road = new Imagemap();
@@ -121,57 +319,123 @@ int main(int argc, const char* const* argv) {
     }
   });
 
-  refptr tree = new Model();
-  GetContent("data/Asset/Tree.obj", [=](Content* content) {
-    tree->SetContent(content);
-
-    GetContent("data/Asset/TreeTexture.png", [=](Content* content) {
-      auto tex = content->GetAs<ImagemapContent>()->GetTex();
-      if(tex) {
-        tree->ApplyTextureOverride("", tex);
+  // Load each model and its texture as one job graph: the model parse and the
+  // texture decode run on the workers at the same time, a staging job joins
+  // them there, and only the graph's response runs on the main thread, where
+  // the content is set and the texture is uploaded.
+  auto loadTexturedModel = [](refptr<Model> model, const std::string& modelURI, const std::string& textureURI) {
+    typedef struct {
+      bool modelLoaded;
+      bool texLoaded;
+      TexData texData;
+      size_t vertexCountBefore;
+      size_t vertexCountAfter;
+      size_t triangleCount;
+      f64 missesBefore;
+      f64 missesAfter;
+    } TexturedModelLoad;
+
+    auto load = std::make_shared<TexturedModelLoad>();
+    load->modelLoaded = false;
+    load->texLoaded = false;
+    load->vertexCountBefore = 0;
+    load->vertexCountAfter = 0;
+    load->triangleCount = 0;
+    load->missesBefore = 0.0;
+    load->missesAfter = 0.0;
+
+    refptr<ModelContent> content = new ModelContent();
+
+    JobGraph* graph = new JobGraph();
+
+    Job* parseJob = graph->Add([=](Job& job) {
+      refptr<ByteBuffer> buffer = ReadFileBuffer(modelURI);
+      if(buffer) {
+        load->modelLoaded = content->Load(buffer, json());
       }
     });
-  });
 
-  refptr buildingBasic = new Model();
-  GetContent("data/Asset/Building/Basic/Model.fbx", [=](Content* content) {
-    buildingBasic->SetContent(content);
-
-    GetContent("data/Asset/Building/Basic/Texture.png", [=](Content* content) {
-      auto tex = content->GetAs<ImagemapContent>()->GetTex();
-      if(tex) {
-        buildingBasic->ApplyTextureOverride("", tex);
+    Job* decodeJob = graph->Add([=](Job& job) {
+      refptr<ByteBuffer> buffer = ReadFileBuffer(textureURI);
+      if(buffer) {
+        load->texLoaded = Tex::LoadPixelsFromPNG(buffer->GetData(), buffer->GetSize(), load->texData);
       }
     });
-  });
 
-  refptr buildingFlower = new Model();
-  GetContent("data/Asset/Building/Flower/Model.fbx", [=](Content* content) {
-    buildingFlower->SetContent(content);
+    graph->Add([=](Job& job) {
+      if(!load->modelLoaded || content->GetSceneCount() == 0) {
+        // Nothing will be drawn with the texture, so skip its upload.
+        load->modelLoaded = false;
+        load->texData = 0;
+        load->texLoaded = false;
+        return;
+      }
 
-    GetContent("data/Asset/Building/Flower/Texture.png", [=](Content* content) {
-      auto tex = content->GetAs<ImagemapContent>()->GetTex();
-      if(tex) {
-        buildingFlower->ApplyTextureOverride("", tex);
+      // Gather what the import-time mesh optimization did for this model.
+      const ModelContentScene& scene = content->GetScene(0);
+      for(size_t i = 0; i < scene.GetMeshCount(); i++) {
+        const ModelMeshOptimizerStats& stats = scene.GetMesh(i).GetOptimizeStats();
+        load->vertexCountBefore += stats.vertexCountBefore;
+        load->vertexCountAfter += stats.vertexCountAfter;
+        load->triangleCount += stats.triangleCount;
+        load->missesBefore += stats.acmrBefore * stats.triangleCount;
+        load->missesAfter += stats.acmrAfter * stats.triangleCount;
       }
-    });
-  });
+    }, {parseJob, decodeJob});
 
-  refptr buildingGrafitti = new Model();
-  GetContent("data/Asset/Building/Grafitti/Model.fbx", [=](Content* content) {
-    buildingGrafitti->SetContent(content);
+    pendingModelLoadCount++;
+    graph->Start([=](JobGraph& graph) {
+      pendingModelLoadCount--;
+
+      if(!load->modelLoaded)
+        return;
+
+      model->SetContent(content);
+
+      if(load->triangleCount) {
+        dbgprintf("Mesh optimization %s: %zu -> %zu vertices, %zu triangles, ACMR %.3f -> %.3f\n", modelURI.c_str(),
+          load->vertexCountBefore, load->vertexCountAfter, load->triangleCount, load->missesBefore / load->triangleCount, load->missesAfter / load->triangleCount);
+      }
 
-    GetContent("data/Asset/Building/Grafitti/Texture.png", [=](Content* content) {
-      auto tex = content->GetAs<ImagemapContent>()->GetTex();
-      if(tex) {
-        buildingGrafitti->ApplyTextureOverride("", tex);
+      if(load->texLoaded) {
+        refptr<Tex> tex = Tex::Create();
+        tex->AddTexData("", load->texData);
+        model->ApplyTextureOverride("", tex);
       }
     });
-  });
+  };
+
+  refptr tree = new Model();
+  loadTexturedModel(tree, "data/Asset/Tree.obj", "data/Asset/TreeTexture.png");
+
+  refptr buildingBasic = new Model();
+  loadTexturedModel(buildingBasic, "data/Asset/Building/Basic/Model.fbx", "data/Asset/Building/Basic/Texture.png");
+
+  refptr buildingFlower = new Model();
+  loadTexturedModel(buildingFlower, "data/Asset/Building/Flower/Model.fbx", "data/Asset/Building/Flower/Texture.png");
+
+  refptr buildingGrafitti = new Model();
+  loadTexturedModel(buildingGrafitti, "data/Asset/Building/Grafitti/Model.fbx", "data/Asset/Building/Grafitti/Texture.png");
 
+  // The rhino is skinned, so load it with compact vertices and report how much
+  // vertex memory that takes.
   refptr rhino = new Model();
-  GetContent("data/Asset/Rhino.glb", [=](Content* content) {
+  json rhinoInfo;
+  rhinoInfo["vertexFormat"] = "compact";
+  GetContent("data/Asset/Rhino.glb", rhinoInfo, [=](Content* content) {
     rhino->SetContent(content);
+
+    if(const ModelContentScene* scene = rhino->GetActiveScene()) {
+      size_t vertexCount = 0;
+      size_t vertexBytes = 0;
+      for(size_t i = 0; i < scene->GetMeshCount(); i++) {
+        const ModelContentMesh& mesh = scene->GetMesh(i);
+        vertexCount += mesh.GetVertexCount();
+        vertexBytes += mesh.GetVertexCount() * mesh.GetVertexSize();
+      }
+
+      dbgprintf("Rhino vertices: %zu, %zu bytes, %.1f bytes per vertex\n", vertexCount, vertexBytes, vertexCount ? (f64) vertexBytes / vertexCount : 0.0);
+    }
   });
 
   // Define a list of highway models.
@@ -205,6 +469,84 @@ int main(int argc, const char* const* argv) {
   f32 focusObjectT = -1.0f;
   f32 focusObjectPosStart = 0.0f;
 
+  // Pressing B toggles a benchmark that animates many rhino instances off-screen
+  // and reports serial against parallel Calc times.
+  std::vector<refptr<Model>> benchmarkModels;
+  bool benchmarkEnabled = false;
+  f64 benchmarkSerialTime = 0.0;
+  f64 benchmarkParallelTime = 0.0;
+  f64 benchmarkReportCtr = 0.0;
+  size_t benchmarkFrameCount = 0;
+
+#if defined(PrimeTargetOpenGL)
+  // Pressing V toggles a report of per-frame driver calls and GPU timers, C
+  // toggles the vertex array cache and Q toggles the render queue so the paths
+  // can be compared.
+  bool driverStatsEnabled = false;
+#endif
+  f64 driverStatsReportCtr = 0.0;
+
+  // Pressing T toggles a stress scene of trees lining the road, [ and ] halve
+  // or double the tree count, and I switches between one instanced draw and a
+  // draw per tree. M merges the trees into a static batch instead, drawn with
+  // one draw per texture. The average frame time is reported once a second.
+  // With the render queue on, per-tree draws are recorded from worker threads.
+  refptr<ModelInstanceBatch> stressBatch = new ModelInstanceBatch(tree);
+  refptr<ModelStaticBatch> stressStaticBatch = new ModelStaticBatch();
+  bool stressEnabled = false;
+  bool stressInstanced = true;
+  bool stressMerged = false;
+  size_t stressObjectCount = StressObjectCountStart;
+  f64 stressFrameTime = 0.0;
+  f64 stressReportCtr = 0.0;
+  size_t stressFrameCount = 0;
+
+  // Pressing F toggles a culling benchmark of boxes scattered around the view.
+  // Each frame some boxes move, then the boxes are tested against the view
+  // frustum one at a time, as a SIMD batch and through a BoundsTree, and the
+  // average times and visible counts are reported once a second.
+  std::vector<f32> cullBounds[6];
+  std::vector<size_t> cullIds;
+  std::vector<u8> cullVisible;
+  std::vector<void*> cullResults;
+  BoundsTree cullTree;
+  Random cullRandom;
+  bool cullEnabled = false;
+  size_t cullMoveIndex = 0;
+  f64 cullMoveTime = 0.0;
+  f64 cullSingleTime = 0.0;
+  f64 cullBatchTime = 0.0;
+  f64 cullTreeTime = 0.0;
+  size_t cullSingleVisibleCount = 0;
+  size_t cullBatchVisibleCount = 0;
+  size_t cullTreeVisibleCount = 0;
+  f64 cullReportCtr = 0.0;
+  size_t cullFrameCount = 0;
+
+#if OGALIB_PROFILER
+  // Pressing P toggles a periodic profiler summary and O starts or stops a
+  // capture that is written out as a Chrome trace.
+  bool profilerReportEnabled = false;
+  f64 profilerReportCtr = 0.0;
+#endif
+
+  auto getStressTransform = [](size_t index) {
+    size_t row = index / (StressColumnCount * 2);
+    size_t column = (index / 2) % StressColumnCount;
+    f32 side = (index & 1) ? 1.0f : -1.0f;
+    f32 x = side * (StressRoadOffset + column * StressColumnSpacing);
+    f32 z = row * StressRowSpacing;
+
+    Mat44 transform;
+    transform.LoadIdentity()
+      .Translate(x, 0.0f, -z)
+      .Rotate((f32) ((index * 37) % 360), 0.0f, 1.0f, 0.0f)
+      .Scale(TreeScale);
+    return transform;
+  };
+
+  bool assetsLoaded = false;
+
   ////////////////////////////////////////
   // Main Loop
   ////////////////////////////////////////
@@ -220,6 +562,12 @@ int main(int argc, const char* const* argv) {
   while(engine.IsRunning()) {
     f32 dt = engine.StartFrame();
 
+    // Report how long the initial asset loads took and the memory peak they caused.
+    if(!assetsLoaded && GetPendingContentCount() == 0 && pendingModelLoadCount == 0) {
+      assetsLoaded = true;
+      dbgprintf("Assets loaded in %.3f s, peak memory %.1f MB\n", GetSystemTime() - loadStartTime, GetPeakMemoryUsage() / (1024.0 * 1024.0));
+    }
+
     // Process camera view direction.
     f32 cursorX, cursorY;
     touch.GetMainCursorPos(cursorX, cursorY);
@@ -253,6 +601,411 @@ int main(int argc, const char* const* argv) {
       roadPos = 0.0f;
     }
 
+    if(kb.IsKeyPressed('B')) {
+      benchmarkEnabled = !benchmarkEnabled;
+      benchmarkSerialTime = 0.0;
+      benchmarkParallelTime = 0.0;
+      benchmarkReportCtr = 0.0;
+      benchmarkFrameCount = 0;
+
+      if(!benchmarkEnabled) {
+        benchmarkModels.clear();
+      }
+    }
+
+    if(kb.IsKeyPressed('F')) {
+      cullEnabled = !cullEnabled;
+      cullMoveTime = 0.0;
+      cullSingleTime = 0.0;
+      cullBatchTime = 0.0;
+      cullTreeTime = 0.0;
+      cullReportCtr = 0.0;
+      cullFrameCount = 0;
+    }
+
+    // Pressing H times setting a program variable by handle against setting it
+    // by name. Each set writes a new value so none are skipped as unchanged.
+    if(kb.IsKeyPressed('H') && scrollTexProgram->IsLoadedIntoVRAM()) {
+      const std::string scrollName("scroll");
+
+      f64 handleStartTime = GetSystemTime();
+      for(size_t i = 0; i < VariableSetCount; i++) {
+        scrollTexProgram->SetVariable(scrollHandle, (f32) i);
+      }
+
+      f64 nameStartTime = GetSystemTime();
+      for(size_t i = 0; i < VariableSetCount; i++) {
+        scrollTexProgram->SetVariable(scrollName, (f32) i);
+      }
+
+      f64 nameEndTime = GetSystemTime();
+      dbgprintf("Set %d variables: by handle %.3f ms, by name %.3f ms\n",
+        VariableSetCount,
+        (nameStartTime - handleStartTime) * 1000.0,
+        (nameEndTime - nameStartTime) * 1000.0);
+    }
+
+    // Pressing J submits a burst of empty jobs from the main thread, every
+    // JobBenchmarkExpressRate-th one express, through ogalib::Job and through
+    // the old list-plus-mutex queue, and reports throughput and p99 latency.
+    if(kb.IsKeyPressed('J')) {
+      std::atomic<size_t> jobCompletedCount(0);
+      ogalib::Job::ResetStats();
+
+      f64 jobStartTime = GetSystemTime();
+      for(size_t i = 0; i < JobBenchmarkCount; i++) {
+        ogalib::JobType type = (i % JobBenchmarkExpressRate) == 0 ? ogalib::JobType::Express : ogalib::JobType::Default;
+        ogalib::Job::Create([&jobCompletedCount](ogalib::Job& job) {
+          jobCompletedCount.fetch_add(1, std::memory_order_release);
+        }, nullptr, type);
+      }
+
+      while(jobCompletedCount.load(std::memory_order_acquire) < JobBenchmarkCount) {
+        ogalib::Thread::Yield();
+      }
+
+      f64 jobEndTime = GetSystemTime();
+      ogalib::JobStats jobStats;
+      ogalib::Job::GetStats(jobStats);
+
+      size_t legacyThreadCount = std::max((size_t) 1, std::min(ogalib::Thread::GetDeviceThreadCount(), (size_t) OGALIB_JOB_CALLBACK_WORKER_COUNT));
+      f64 legacyStartTime;
+      f64 legacyEndTime;
+      f64 legacyLatencyP99;
+      {
+        std::atomic<size_t> legacyCompletedCount(0);
+        LegacyJobQueue legacyQueue(legacyThreadCount, JobBenchmarkCount);
+
+        legacyStartTime = GetSystemTime();
+        for(size_t i = 0; i < JobBenchmarkCount; i++) {
+          legacyQueue.Submit((u32) i, (i % JobBenchmarkExpressRate) == 0, [&legacyCompletedCount]() {
+            legacyCompletedCount.fetch_add(1, std::memory_order_relaxed);
+          });
+        }
+
+        legacyQueue.WaitForCompletion(JobBenchmarkCount);
+        legacyEndTime = GetSystemTime();
+        legacyLatencyP99 = legacyQueue.GetLatencyPercentile(0.99);
+      }
+
+      dbgprintf("Run %d jobs: work stealing %.0f jobs/s, p99 %.3f ms; list queue %.0f jobs/s, p99 %.3f ms\n",
+        JobBenchmarkCount,
+        JobBenchmarkCount / (jobEndTime - jobStartTime),
+        jobStats.latencyP99 * 1000.0,
+        JobBenchmarkCount / (legacyEndTime - legacyStartTime),
+        legacyLatencyP99 * 1000.0);
+    }
+
+    // Pressing X times the batch matrix routines against a plain scalar
+    // reference and reports the largest relative difference between them.
+    if(kb.IsKeyPressed('X')) {
+      Random mathRandom;
+      mathRandom.Seed(1);
+
+      auto getRandomTransform = [&]() {
+        Vec3 axis(mathRandom.GetRange(0.1f, 1.0f), mathRandom.GetRange(-1.0f, 1.0f), mathRandom.GetRange(-1.0f, 1.0f));
+        axis.Normalize();
+        Mat44 transform;
+        transform.LoadTranslation(mathRandom.GetRange(-100.0f, 100.0f), mathRandom.GetRange(-100.0f, 100.0f), mathRandom.GetRange(-100.0f, 100.0f))
+          .Rotate(mathRandom.GetRange(0.0f, 360.0f), axis);
+        return transform;
+      };
+
+      auto multiplyReference = [](const Mat44& a, const Mat44& b) {
+        Mat44 result;
+        for(size_t c = 0; c < 4; c++) {
+          for(size_t r = 0; r < 4; r++) {
+            result.e[c * 4 + r] = a.e[r] * b.e[c * 4] + a.e[4 + r] * b.e[c * 4 + 1] + a.e[8 + r] * b.e[c * 4 + 2] + a.e[12 + r] * b.e[c * 4 + 3];
+          }
+        }
+        return result;
+      };
+
+      auto getMaxError = [](const f32* values, const f32* referenceValues, size_t count) {
+        f32 maxError = 0.0f;
+        for(size_t i = 0; i < count; i++) {
+          f32 error = fabsf(values[i] - referenceValues[i]) / std::max(1.0f, fabsf(referenceValues[i]));
+          maxError = std::max(maxError, error);
+        }
+        return maxError;
+      };
+
+      // Skinning palettes: each bone's global transform times its inverse bind pose.
+      const size_t paletteSize = MathPaletteCount * MathBoneCount;
+      std::vector<Mat44> globals(paletteSize), offsets(paletteSize), palette(paletteSize), paletteReference(paletteSize);
+      for(size_t i = 0; i < paletteSize; i++) {
+        globals[i] = getRandomTransform();
+        offsets[i] = getRandomTransform();
+      }
+
+      f64 paletteReferenceStartTime = GetSystemTime();
+      for(size_t i = 0; i < paletteSize; i++) {
+        paletteReference[i] = multiplyReference(globals[i], offsets[i]);
+      }
+
+      f64 paletteStartTime = GetSystemTime();
+      Mat44::MultiplyPairs(globals.data(), offsets.data(), palette.data(), paletteSize);
+      f64 paletteEndTime = GetSystemTime();
+      f32 paletteError = getMaxError(palette[0].e, paletteReference[0].e, paletteSize * 16);
+
+      // Point transform through a full view projection.
+      Mat44 projection;
+      projection.LoadPerspective(60.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+      Mat44 view = getRandomTransform();
+      Mat44 vp = multiplyReference(projection, view);
+
+      std::vector<Vec3> points(MathPointCount), transformedPoints(MathPointCount), transformedPointsReference(MathPointCount);
+      for(Vec3& point: points) {
+        point = Vec3(mathRandom.GetRange(-100.0f, 100.0f), mathRandom.GetRange(-100.0f, 100.0f), mathRandom.GetRange(-100.0f, 100.0f));
+      }
+
+      f64 pointReferenceStartTime = GetSystemTime();
+      for(size_t i = 0; i < MathPointCount; i++) {
+        const Vec3& p = points[i];
+        transformedPointsReference[i] = Vec3(
+          vp.e11 * p.x + vp.e12 * p.y + vp.e13 * p.z + vp.e14,
+          vp.e21 * p.x + vp.e22 * p.y + vp.e23 * p.z + vp.e24,
+          vp.e31 * p.x + vp.e32 * p.y + vp.e33 * p.z + vp.e34);
+      }
+
+      f64 pointStartTime = GetSystemTime();
+      vp.MultiplyPoints(points.data(), transformedPoints.data(), MathPointCount);
+      f64 pointEndTime = GetSystemTime();
+      f32 pointError = getMaxError(&transformedPoints[0].x, &transformedPointsReference[0].x, MathPointCount * 3);
+
+      // MVP chains: model view then model view projection per object.
+      std::vector<Mat44> models(MathMatrixCount), mvps(MathMatrixCount), mvpsReference(MathMatrixCount);
+      for(Mat44& model: models) {
+        model = getRandomTransform();
+      }
+
+      f64 mvpReferenceStartTime = GetSystemTime();
+      for(size_t i = 0; i < MathMatrixCount; i++) {
+        mvpsReference[i] = multiplyReference(projection, multiplyReference(view, models[i]));
+      }
+
+      f64 mvpStartTime = GetSystemTime();
+      Mat44 mv;
+      for(size_t i = 0; i < MathMatrixCount; i++) {
+        mv.LoadProduct(view, models[i]);
+        mvps[i].LoadProduct(projection, mv);
+      }
+      f64 mvpEndTime = GetSystemTime();
+      f32 mvpError = getMaxError(mvps[0].e, mvpsReference[0].e, MathMatrixCount * 16);
+
+      // Inverses of rigid model transforms against the general inverse.
+      std::vector<Mat44> inverses(models), inversesReference(models);
+
+      f64 inverseReferenceStartTime = GetSystemTime();
+      for(Mat44& inverse: inversesReference) {
+        inverse.Invert();
+      }
+
+      f64 inverseStartTime = GetSystemTime();
+      for(Mat44& inverse: inverses) {
+        inverse.InvertAffine();
+      }
+      f64 inverseEndTime = GetSystemTime();
+      f32 inverseError = getMaxError(inverses[0].e, inversesReference[0].e, MathMatrixCount * 16);
+
+      dbgprintf("Palettes %d x %d: batch %.3f ms, reference %.3f ms, error %g\n", MathPaletteCount, MathBoneCount,
+        (paletteEndTime - paletteStartTime) * 1000.0, (paletteStartTime - paletteReferenceStartTime) * 1000.0, paletteError);
+      dbgprintf("Points %d: batch %.3f ms, reference %.3f ms, error %g\n", MathPointCount,
+        (pointEndTime - pointStartTime) * 1000.0, (pointStartTime - pointReferenceStartTime) * 1000.0, pointError);
+      dbgprintf("MVP chains %d: batch %.3f ms, reference %.3f ms, error %g\n", MathMatrixCount,
+        (mvpEndTime - mvpStartTime) * 1000.0, (mvpStartTime - mvpReferenceStartTime) * 1000.0, mvpError);
+      dbgprintf("Affine inverses %d: batch %.3f ms, general %.3f ms, error %g\n", MathMatrixCount,
+        (inverseEndTime - inverseStartTime) * 1000.0, (inverseStartTime - inverseReferenceStartTime) * 1000.0, inverseError);
+      dbgprintf("Math results %s tolerance\n",
+        std::max(std::max(paletteError, pointError), std::max(mvpError, inverseError)) <= MathTolerance ? "within" : "OUT OF");
+    }
+
+    if(kb.IsKeyPressed('T')) {
+      stressEnabled = !stressEnabled;
+      stressFrameTime = 0.0;
+      stressReportCtr = 0.0;
+      stressFrameCount = 0;
+    }
+
+    if(stressEnabled) {
+      if(kb.IsKeyPressed('I')) {
+        stressInstanced = !stressInstanced;
+        stressMerged = false;
+        stressFrameTime = 0.0;
+        stressReportCtr = 0.0;
+        stressFrameCount = 0;
+      }
+
+      if(kb.IsKeyPressed('M')) {
+        stressMerged = !stressMerged;
+        stressFrameTime = 0.0;
+        stressReportCtr = 0.0;
+        stressFrameCount = 0;
+      }
+
+      if(kb.IsKeyPressed('[') && stressObjectCount > StressObjectCountMin) {
+        stressObjectCount /= 2;
+      }
+
+      if(kb.IsKeyPressed(']') && stressObjectCount < StressObjectCountMax) {
+        stressObjectCount *= 2;
+      }
+
+      if(stressBatch->GetInstanceCount() != stressObjectCount) {
+        stressBatch->ClearInstances();
+        stressBatch->ReserveInstances(stressObjectCount);
+        for(size_t i = 0; i < stressObjectCount; i++) {
+          f32 shade = 0.8f + 0.1f * (f32) (i % 3);
+          stressBatch->AddInstance(getStressTransform(i), Color(shade, 1.0f, shade));
+        }
+
+        stressStaticBatch->Clear();
+        for(size_t i = 0; i < stressObjectCount; i++) {
+          stressStaticBatch->Add(tree, getStressTransform(i));
+        }
+
+        stressFrameTime = 0.0;
+        stressReportCtr = 0.0;
+        stressFrameCount = 0;
+      }
+
+      stressFrameTime += dt;
+      stressFrameCount++;
+
+      stressReportCtr += dt;
+      if(stressReportCtr >= StressReportTime) {
+        dbgprintf("Stress %zu trees (%s): %.3f ms per frame\n", stressObjectCount,
+          stressMerged ? "merged" : stressInstanced ? "instanced" : "per object",
+          stressFrameTime * 1000.0 / stressFrameCount);
+        if(stressMerged) {
+          const ModelStaticBatchStats& stats = stressStaticBatch->GetStats();
+          dbgprintf("Static batch: %zu placements (%zu pending), %zu meshes in %zu groups, %zu vertices, %zu indices, %zu draws, %zu rebuilds\n",
+            stats.placementCount,
+            stats.pendingPlacementCount,
+            stats.meshCount,
+            stats.groupCount,
+            stats.vertexCount,
+            stats.indexCount,
+            stats.drawCount,
+            stats.rebuildCount);
+        }
+        stressFrameTime = 0.0;
+        stressReportCtr = 0.0;
+        stressFrameCount = 0;
+      }
+    }
+
+#if defined(PrimeTargetOpenGL)
+    if(kb.IsKeyPressed('V')) {
+      driverStatsEnabled = !driverStatsEnabled;
+      driverStatsReportCtr = 0.0;
+    }
+
+    if(kb.IsKeyPressed('C')) {
+      OpenGLGraphics& gl = PxOpenGLGraphics;
+      gl.SetVertexArrayCacheEnabled(!gl.IsVertexArrayCacheEnabled());
+      driverStatsReportCtr = 0.0;
+    }
+
+    if(kb.IsKeyPressed('Q')) {
+      g.SetRenderQueueEnabled(!g.IsRenderQueueEnabled());
+      driverStatsReportCtr = 0.0;
+    }
+
+    driverStatsReportCtr += dt;
+    if(driverStatsEnabled && driverStatsReportCtr >= DriverStatsReportTime) {
+      OpenGLGraphics& gl = PxOpenGLGraphics;
+      const OpenGLGraphicsStats& stats = gl.GetLastFrameStats();
+      dbgprintf("Vertex arrays %s: %zu draws, %zu VAO binds, %zu VAO builds, %zu attribute calls, %zu index buffer binds, %zu uniform bytes\n",
+        gl.IsVertexArrayCacheEnabled() ? "cached" : "uncached",
+        stats.drawCount,
+        stats.vertexArrayBindCount,
+        stats.vertexArrayBuildCount,
+        stats.vertexAttributeCallCount,
+        stats.indexBufferBindCount,
+        gl.GetFrameUniformBytesUploaded());
+      dbgprintf("Render queue %s: %zu queued draws, %zu program changes, %zu texture binds, %zu array buffer binds, %zu depth changes, %zu viewport changes, %zu clip changes\n",
+        gl.IsRenderQueueEnabled() ? "on" : "off",
+        stats.queuedDrawCount,
+        stats.programChangeCount,
+        stats.textureBindCount,
+        stats.arrayBufferBindCount,
+        stats.depthStateChangeCount,
+        stats.viewportChangeCount,
+        stats.clipStateChangeCount);
+      dbgprintf("Draw matrices: %zu multiplies, %zu inversions\n",
+        stats.matrixMultiplyCount,
+        stats.matrixInvertCount);
+
+      GraphicsFrameStats frameStats;
+      g.GetFrameStats(frameStats);
+      dbgprintf("Frame: %zu draws, %zu triangles, %zu uniform bytes, %zu uniform ring overflows, %zu texture bytes, GPU %.3f ms\n",
+        frameStats.drawCount,
+        frameStats.triangleCount,
+        frameStats.uniformBytesUploaded,
+        frameStats.uniformOverflowCount,
+        frameStats.texBytesUploaded,
+        frameStats.gpuFrameTime * 1000.0);
+      for(const GraphicsGPUTime& gpuTime: g.GetGPUTimes()) {
+        dbgprintf("  GPU %*s%s: %.3f ms\n", (int) gpuTime.depth * 2, "", gpuTime.name, gpuTime.time * 1000.0);
+      }
+      driverStatsReportCtr = 0.0;
+    }
+#elif defined(PrimeTargetNull)
+    // Headless runs have no window to close, so report the counted work and
+    // stop after a fixed number of frames.
+    driverStatsReportCtr += dt;
+    if(driverStatsReportCtr >= DriverStatsReportTime) {
+      NullGraphics& ng = PxNullGraphics;
+      const NullGraphicsStats& stats = ng.GetLastFrameStats();
+      const NullGraphicsStats& totalStats = ng.GetTotalStats();
+      dbgprintf("Headless frame: %zu draws, %zu instanced draws, %zu instances, %zu indices\n",
+        stats.drawCount,
+        stats.instancedDrawCount,
+        stats.instanceCount,
+        stats.indexCount);
+      dbgprintf("Headless uploads: %zu array buffers (%zu bytes), %zu index buffers (%zu bytes), %zu textures (%zu bytes), %zu programs\n",
+        totalStats.arrayBufferUploadCount,
+        totalStats.arrayBufferUploadBytes,
+        totalStats.indexBufferUploadCount,
+        totalStats.indexBufferUploadBytes,
+        totalStats.texUploadCount,
+        totalStats.texUploadBytes,
+        totalStats.programLoadCount);
+      driverStatsReportCtr = 0.0;
+    }
+
+    if(engine.GetCurrentFrame() >= HeadlessFrameCount) {
+      engine.Stop();
+    }
+#endif
+
+#if OGALIB_PROFILER
+    if(kb.IsKeyPressed('P')) {
+      profilerReportEnabled = !profilerReportEnabled;
+      profilerReportCtr = 0.0;
+      ogalib::Profiler::ResetStats();
+    }
+
+    if(kb.IsKeyPressed('O')) {
+      if(ogalib::Profiler::IsCapturing()) {
+        ogalib::Profiler::StopCapture();
+        if(ogalib::Profiler::WriteChromeTrace(ProfilerTracePath)) {
+          dbgprintf("Profiler trace written to %s\n", ProfilerTracePath);
+        }
+      }
+      else {
+        ogalib::Profiler::StartCapture();
+      }
+    }
+
+    profilerReportCtr += dt;
+    if(profilerReportEnabled && profilerReportCtr >= ProfilerReportTime) {
+      dbgprintf("%s", ogalib::Profiler::GetStatsSummary().c_str());
+      profilerReportCtr = 0.0;
+    }
+#endif
+
     if(objectCount > 0) {
       if(kb.IsKeyPressed(',')) {
         if(focusObject == 0) {
@@ -314,7 +1067,9 @@ int main(int argc, const char* const* argv) {
       .Rotate(viewAzimuth, 0.0f, 1.0f, 0.0f)
       .Translate(0.0f, -ViewHeight, 0.0f);
 
-    scrollTexProgram->SetVariable("scroll", roadPos / RoadRepetitionCount);
+    scrollTexProgram->SetVariable(scrollHandle, roadPos / RoadRepetitionCount);
+
+    g.StartGPUTimer("Scene::Ground");
 
     if(grass) {
       auto grassContent = grass->GetImagemapContent();
@@ -322,7 +1077,7 @@ int main(int argc, const char* const* argv) {
         f32 grassW = (f32) grassContent->GetRectW();
         f32 grassH = (f32) grassContent->GetRectH();
 
-        scrollTexProgram->SetVariable("wrapCount", Vec2(RoadRepetitionCount, RoadRepetitionCount));
+        scrollTexProgram->SetVariable(wrapCountHandle, Vec2(RoadRepetitionCount, RoadRepetitionCount));
 
         g.program.Push() = scrollTexProgram;
         g.model.Push().LoadIdentity()
@@ -346,7 +1101,7 @@ int main(int argc, const char* const* argv) {
         f32 roadW = (f32) roadContent->GetRectW();
         f32 roadH = (f32) roadContent->GetRectH();
 
-        scrollTexProgram->SetVariable("wrapCount", Vec2(1.0f, RoadRepetitionCount));
+        scrollTexProgram->SetVariable(wrapCountHandle, Vec2(1.0f, RoadRepetitionCount));
 
         g.program.Push() = scrollTexProgram;
         g.model.Push().LoadIdentity()
@@ -362,10 +1117,154 @@ int main(int argc, const char* const* argv) {
       }
     }
 
-    for(auto model: models) {
-      model->Calc(dt);
+    g.EndGPUTimer();
+
+    ParallelFor(0, sizeof(models) / sizeof(models[0]), 1, [&](size_t start, size_t end) {
+      for(size_t i = start; i < end; i++) {
+        models[i]->Calc(dt);
+      }
+    });
+
+    if(benchmarkEnabled && rhino->HasContent()) {
+      if(benchmarkModels.empty()) {
+        benchmarkModels.resize(BenchmarkModelCount);
+        for(size_t i = 0; i < BenchmarkModelCount; i++) {
+          benchmarkModels[i] = new Model();
+          benchmarkModels[i]->SetContent(rhino->GetModelContent());
+          benchmarkModels[i]->SetActionTime(i * 0.01f);
+        }
+      }
+
+      f64 serialStartTime = GetSystemTime();
+      for(auto& model: benchmarkModels) {
+        model->Calc(dt);
+      }
+
+      f64 parallelStartTime = GetSystemTime();
+      ParallelFor(0, benchmarkModels.size(), 0, [&](size_t start, size_t end) {
+        for(size_t i = start; i < end; i++) {
+          benchmarkModels[i]->Calc(dt);
+        }
+      });
+
+      f64 parallelEndTime = GetSystemTime();
+      benchmarkSerialTime += parallelStartTime - serialStartTime;
+      benchmarkParallelTime += parallelEndTime - parallelStartTime;
+      benchmarkFrameCount++;
+
+      benchmarkReportCtr += dt;
+      if(benchmarkReportCtr >= BenchmarkReportTime) {
+        dbgprintf("Calc %zu models with %zu bone palettes each: serial %.3f ms, parallel %.3f ms\n", benchmarkModels.size(),
+          benchmarkModels[0]->GetBonePaletteCount(),
+          benchmarkSerialTime * 1000.0 / benchmarkFrameCount,
+          benchmarkParallelTime * 1000.0 / benchmarkFrameCount);
+        benchmarkSerialTime = 0.0;
+        benchmarkParallelTime = 0.0;
+        benchmarkReportCtr = 0.0;
+        benchmarkFrameCount = 0;
+      }
     }
 
+    if(cullEnabled) {
+      std::vector<f32>& centerX = cullBounds[0];
+      std::vector<f32>& centerY = cullBounds[1];
+      std::vector<f32>& centerZ = cullBounds[2];
+      std::vector<f32>& extentX = cullBounds[3];
+      std::vector<f32>& extentY = cullBounds[4];
+      std::vector<f32>& extentZ = cullBounds[5];
+
+      if(cullIds.empty()) {
+        cullRandom.Seed(1);
+        for(size_t i = 0; i < 6; i++) {
+          cullBounds[i].resize(CullObjectCount);
+        }
+
+        cullIds.resize(CullObjectCount);
+        cullVisible.resize(CullObjectCount);
+        cullResults.reserve(CullObjectCount);
+
+        for(size_t i = 0; i < CullObjectCount; i++) {
+          centerX[i] = cullRandom.GetRange(-CullFieldSize, CullFieldSize);
+          centerY[i] = cullRandom.GetRange(0.0f, CullFieldHeight);
+          centerZ[i] = cullRandom.GetRange(-CullFieldSize, CullFieldSize);
+          extentX[i] = cullRandom.GetRange(CullObjectSizeMin, CullObjectSizeMax);
+          extentY[i] = cullRandom.GetRange(CullObjectSizeMin, CullObjectSizeMax);
+          extentZ[i] = cullRandom.GetRange(CullObjectSizeMin, CullObjectSizeMax);
+
+          Vec3 boundsMin(centerX[i] - extentX[i], centerY[i] - extentY[i], centerZ[i] - extentZ[i]);
+          Vec3 boundsMax(centerX[i] + extentX[i], centerY[i] + extentY[i], centerZ[i] + extentZ[i]);
+          cullIds[i] = cullTree.Add(boundsMin, boundsMax, &cullVisible[i]);
+        }
+      }
+
+      f64 moveStartTime = GetSystemTime();
+      for(size_t j = 0; j < CullMoveCount; j++) {
+        size_t i = cullMoveIndex;
+        cullMoveIndex = (cullMoveIndex + 1) % CullObjectCount;
+
+        centerX[i] += cullRandom.GetRange(-1.0f, 1.0f);
+        centerZ[i] += cullRandom.GetRange(-1.0f, 1.0f);
+
+        Vec3 boundsMin(centerX[i] - extentX[i], centerY[i] - extentY[i], centerZ[i] - extentZ[i]);
+        Vec3 boundsMax(centerX[i] + extentX[i], centerY[i] + extentY[i], centerZ[i] + extentZ[i]);
+        cullTree.Move(cullIds[i], boundsMin, boundsMax);
+      }
+
+      Frustum frustum;
+      g.GetFrustum(frustum);
+
+      f64 singleStartTime = GetSystemTime();
+      size_t singleVisibleCount = 0;
+      for(size_t i = 0; i < CullObjectCount; i++) {
+        Vec3 boundsMin(centerX[i] - extentX[i], centerY[i] - extentY[i], centerZ[i] - extentZ[i]);
+        Vec3 boundsMax(centerX[i] + extentX[i], centerY[i] + extentY[i], centerZ[i] + extentZ[i]);
+        if(frustum.TestAABB(boundsMin, boundsMax)) {
+          singleVisibleCount++;
+        }
+      }
+
+      f64 batchStartTime = GetSystemTime();
+      FrustumBoundsList boundsList = {centerX.data(), centerY.data(), centerZ.data(), extentX.data(), extentY.data(), extentZ.data(), CullObjectCount};
+      size_t batchVisibleCount = frustum.TestAABBs(boundsList, cullVisible.data());
+
+      f64 treeStartTime = GetSystemTime();
+      cullResults.clear();
+      size_t treeVisibleCount = cullTree.Cull(frustum, cullResults);
+
+      f64 cullEndTime = GetSystemTime();
+      cullMoveTime += singleStartTime - moveStartTime;
+      cullSingleTime += batchStartTime - singleStartTime;
+      cullBatchTime += treeStartTime - batchStartTime;
+      cullTreeTime += cullEndTime - treeStartTime;
+      cullSingleVisibleCount = singleVisibleCount;
+      cullBatchVisibleCount = batchVisibleCount;
+      cullTreeVisibleCount = treeVisibleCount;
+      cullFrameCount++;
+
+      cullReportCtr += dt;
+      if(cullReportCtr >= CullReportTime) {
+        dbgprintf("Cull %d boxes: move %d %.3f ms, single %.3f ms (%zu visible), batch %.3f ms (%zu visible), tree %.3f ms (%zu visible, height %d)\n",
+          CullObjectCount,
+          CullMoveCount,
+          cullMoveTime * 1000.0 / cullFrameCount,
+          cullSingleTime * 1000.0 / cullFrameCount,
+          cullSingleVisibleCount,
+          cullBatchTime * 1000.0 / cullFrameCount,
+          cullBatchVisibleCount,
+          cullTreeTime * 1000.0 / cullFrameCount,
+          cullTreeVisibleCount,
+          cullTree.GetHeight());
+        cullMoveTime = 0.0;
+        cullSingleTime = 0.0;
+        cullBatchTime = 0.0;
+        cullTreeTime = 0.0;
+        cullReportCtr = 0.0;
+        cullFrameCount = 0;
+      }
+    }
+
+    g.StartGPUTimer("Scene::Objects");
+
     for(auto& obj: objects) {
       f32 pos = roadPos - obj.z;
       if(pos >= -RoadRepetitionCount && pos <= RoadRepetitionCount) {
@@ -385,6 +1284,60 @@ int main(int argc, const char* const* argv) {
       }
     }
 
+    // Stress trees are placed in road space, so scroll them with the view.
+    if(stressEnabled && tree->HasContent()) {
+      auto treeContent = tree->GetModelContent();
+      bool anim = treeContent->GetActionCount() > 0;
+
+      g.view.Push().Translate(0.0f, 0.0f, roadPos);
+
+      // Animated trees cannot be merged, so they fall back to instancing.
+      if(stressMerged && !anim) {
+        g.program.Push() = modelProgram;
+        g.model.Push().LoadIdentity();
+
+        stressStaticBatch->Draw();
+
+        g.model.Pop();
+        g.program.Pop();
+      }
+      else if(stressInstanced || stressMerged) {
+        g.program.Push() = anim ? modelAnimInstancedProgram : modelInstancedProgram;
+        g.model.Push().LoadIdentity();
+
+        stressBatch->Draw();
+
+        g.model.Pop();
+        g.program.Pop();
+      }
+      else if(g.IsRenderQueueEnabled()) {
+        DeviceProgram* treeProgram = anim ? modelAnimProgram : modelProgram;
+
+        ParallelFor(0, stressObjectCount, 0, [&](size_t start, size_t end) {
+          for(size_t i = start; i < end; i++) {
+            tree->Submit(getStressTransform(i), treeProgram);
+          }
+        });
+      }
+      else {
+        g.program.Push() = anim ? modelAnimProgram : modelProgram;
+
+        for(size_t i = 0; i < stressObjectCount; i++) {
+          g.model.Push() = getStressTransform(i);
+
+          tree->Draw();
+
+          g.model.Pop();
+        }
+
+        g.program.Pop();
+      }
+
+      g.view.Pop();
+    }
+
+    g.EndGPUTimer();
+
     g.view.Pop();
     g.projection.Pop();
 
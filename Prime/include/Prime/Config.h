@@ -39,6 +39,18 @@ SOFTWARE.
 #define PrimeTargetPS4 1
 #elif defined(__PROSPERO__)
 #define PrimeTargetPS5 1
+#elif defined(__linux__)
+#define PrimeTargetLinux 1
+#define PrimeTargetNull 1
+#endif
+
+// Define PrimeSIMDDisabled to force the scalar fallbacks.
+#if !defined(PrimeSIMDDisabled)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PrimeSIMDSSE 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define PrimeSIMDNEON 1
+#endif
 #endif
 
 #include <ogalib/json.h>
@@ -193,20 +205,30 @@ T clamp(const T& value, const T& low, const T& high) {
 
 namespace Prime {
 class Content;
+class ByteBuffer;
 
 template <class T>
 class Stack;
 
+template <class T>
+class refptr;
+
 extern f64 GetSystemTime();
 extern f64 GetTargetRTCSeconds();
+extern size_t GetPeakMemoryUsage();
 extern void* ReadFile(const std::string& uri, size_t* size);
 extern void ReadFile(const std::string& uri, const std::function<void (void*, size_t)>& callback);
+extern refptr<ByteBuffer> ReadFileBuffer(const std::string& uri);
+extern void ReadFileBuffer(const std::string& uri, const std::function<void (refptr<ByteBuffer>)>& callback);
+extern void PrefetchFile(const std::string& uri, const std::function<void (refptr<ByteBuffer>)>& callback);
 extern void GetContent(const std::string& uri, const std::function<void (Content*)>& callback);
 extern void GetContent(const std::string& uri, const json& info, const std::function<void (Content*)>& callback);
 extern void GetContentRaw(const std::string& uri, const std::function<void (const void*, size_t)>& callback);
 extern void GetContentRaw(const std::string& uri, const json& info, const std::function<void (const void*, size_t)>& callback);
+extern void PrefetchContent(const std::string& uri);
 extern void MapContentURI(const std::string& mappedURI, const std::string& uri);
 extern const std::string& GetMapppedContentURI(const std::string& uri);
+extern size_t GetPendingContentCount();
 extern void GetPackFilenames(const std::string& uri, Stack<std::string>& filenames);
 extern bool LockSetjmpMutex();
 extern bool UnlockSetjmpMutex();
@@ -229,6 +251,9 @@ using ogalib::string_printf;
 using ogalib::string_vprintf;
 using ogalib::Job;
 using ogalib::JobType;
+using ogalib::JobGraph;
+using ogalib::ParallelFor;
+using ogalib::ParallelReduce;
 using ogalib::Thread;
 using ogalib::ThreadMutex;
 using ogalib::ThreadCondition;
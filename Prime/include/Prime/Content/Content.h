@@ -36,6 +36,7 @@ SOFTWARE.
 #include <Prime/Enum/WrapMode.h>
 #include <Prime/Enum/CollisionType.h>
 #include <Prime/Enum/CollisionTypeParam.h>
+#include <Prime/System/ByteBuffer.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -62,6 +63,7 @@ public:
 
   virtual bool Load(const json& data, const json& info);
   virtual bool Load(const void* data, size_t dataSize, const json& info);
+  virtual bool Load(refptr<ByteBuffer> buffer, const json& info);
 
   virtual void GetWalkReferences(Stack<std::string>& paths) const;
 
@@ -205,7 +205,7 @@ public:
 class FontContent: public Content {
 private:
 
-  std::string fontData;
+  refptr<ByteBuffer> fontBuffer;
 
   FontContentValues values;
   refptr<FontContentSheet> sheet;
@@ -230,7 +230,9 @@ public:
 
 public:
 
+  using Content::Load;
   bool Load(const void* data, size_t dataSize, const json& info) override;
+  bool Load(refptr<ByteBuffer> buffer, const json& info) override;
 
   virtual void SetTexFormat(TexFormat texFormat);
 
@@ -242,6 +244,10 @@ public:
 
   static void GetDefaultValues(json& values);
 
+protected:
+
+  bool LoadSheet(refptr<ByteBuffer> buffer, const json& info);
+
 protected:
 
   static void GetCharCode(u32 c, char* charCode, size_t charCodeSize);
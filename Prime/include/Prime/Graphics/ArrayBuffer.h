@@ -35,6 +35,26 @@ SOFTWARE.
 #include <Prime/Types/Dictionary.h>
 #include <Prime/Graphics/BufferPrimitive.h>
 
+////////////////////////////////////////////////////////////////////////////////
+// Enums
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Component types for vertex attributes. The norm types are read by shaders
+// as floats mapped to [0, 1] or [-1, 1], and the int types as unsigned
+// integers.
+enum ArrayBufferAttributeType {
+  ArrayBufferAttributeTypeF32 = 0,
+  ArrayBufferAttributeTypeS16Norm,
+  ArrayBufferAttributeTypeU16Norm,
+  ArrayBufferAttributeTypeU8Norm,
+  ArrayBufferAttributeTypeU16Int,
+  ArrayBufferAttributeTypeU8Int,
+};
+
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,17 +68,21 @@ private:
   std::string name;
   size_t size;
   size_t offset;
+  ArrayBufferAttributeType type;
+  size_t componentCount;
 
 public:
 
   const std::string& GetName() const {return name;}
   const size_t GetSize() const {return size;}
   const size_t GetOffset() const {return offset;}
+  ArrayBufferAttributeType GetType() const {return type;}
+  size_t GetComponentCount() const {return componentCount;}
 
 public:
 
-  ArrayBufferAttribute(const std::string& name = std::string(), size_t size = 0, size_t offset = 0):
-    name(name), size(size), offset(offset) {}
+  ArrayBufferAttribute(const std::string& name = std::string(), size_t size = 0, size_t offset = 0, ArrayBufferAttributeType type = ArrayBufferAttributeTypeF32, size_t componentCount = 0):
+    name(name), size(size), offset(offset), type(type), componentCount(componentCount ? componentCount : size / sizeof(f32)) {}
   ArrayBufferAttribute(const ArrayBufferAttribute& other) {(void) operator=(other);}
   ~ArrayBufferAttribute() {}
 
@@ -68,6 +92,8 @@ public:
     name = other.name;
     size = other.size;
     offset = other.offset;
+    type = other.type;
+    componentCount = other.componentCount;
     return *this;
   }
 
@@ -76,12 +102,14 @@ public:
       name.clear();
       size = 0;
       offset = 0;
+      type = ArrayBufferAttributeTypeF32;
+      componentCount = 0;
     }
     return *this;
   }
 
   bool operator==(const ArrayBufferAttribute& other) const {
-    return name == other.name && size == other.size && offset == other.offset;
+    return name == other.name && size == other.size && offset == other.offset && type == other.type;
   }
 
   bool operator<(const ArrayBufferAttribute& other) const {
@@ -95,7 +123,12 @@ public:
     else if(size > other.size)
       return false;
 
-    return offset < other.offset;
+    if(offset < other.offset)
+      return true;
+    else if(offset > other.offset)
+      return false;
+
+    return type < other.type;
   }
 
 };
@@ -138,6 +171,7 @@ public:
   virtual bool UnloadFromVRAM();
 
   virtual void LoadAttribute(const std::string& name, size_t size);
+  virtual void LoadAttribute(const std::string& name, ArrayBufferAttributeType type, size_t componentCount);
   virtual const std::string& GetAttributeName(size_t index) const;
   virtual const ArrayBufferAttribute* GetAttribute(const std::string& name);
   virtual size_t GetAttributeCount() const;
@@ -150,6 +184,8 @@ public:
   virtual void SetSyncCount(size_t count);
   virtual void Sync();
 
+  static size_t GetAttributeTypeSize(ArrayBufferAttributeType type);
+
 };
 
 };
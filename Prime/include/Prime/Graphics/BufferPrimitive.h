@@ -35,6 +35,17 @@ typedef enum {
   BufferPrimitive_Count = 5
 } BufferPrimitive;
 
+static __inline size_t GetBufferPrimitiveTriangleCount(BufferPrimitive primitive, size_t indexCount) {
+  switch(primitive) {
+  case BufferPrimitiveTriangles:
+    return indexCount / 3;
+  case BufferPrimitiveTriangleFan:
+    return indexCount >= 3 ? indexCount - 2 : 0;
+  default:
+    return 0;
+  }
+}
+
 #if defined(__cplusplus) && !defined(__INTELLISENSE__)
 namespace std {
   template<> struct hash<BufferPrimitive> {
@@ -58,6 +58,37 @@ namespace Prime {
 
 class DeviceShader;
 
+// An interned program variable name. Names are interned once into a global
+// table, so a handle kept in a static can index the variable table of any
+// program without hashing the name on every set.
+class ProgramVariableHandle {
+protected:
+
+  u32 id;
+
+public:
+
+  u32 GetId() const {return id;}
+  bool IsValid() const {return id != 0;}
+  const std::string& GetName() const;
+
+  bool operator==(const ProgramVariableHandle& other) const {return id == other.id;}
+  bool operator!=(const ProgramVariableHandle& other) const {return id != other.id;}
+
+public:
+
+  ProgramVariableHandle(): id(0) {}
+  explicit ProgramVariableHandle(const std::string& name);
+
+public:
+
+  // Returns an invalid handle when the name has never been interned, which
+  // also means no loaded program declares it.
+  static ProgramVariableHandle Find(const std::string& name);
+  static size_t GetCount();
+
+};
+
 class DeviceProgram: public RefObject {
 friend class Graphics;
 protected:
@@ -78,6 +109,8 @@ protected:
 
   GraphicsDictionary variables;
 
+  Dictionary<std::string, refptr<DeviceProgram>> variants;
+
   bool loadedIntoVRAM;
 
 public:
@@ -116,6 +149,7 @@ public:
   virtual void CheckVariableStatus();
   virtual void ApplyVariableValues();
 
+  // The name setters intern the name and forward to the handle setters.
   virtual void SetVariable(const std::string& name, s32 v);
   virtual void SetVariable(const std::string& name, f32 v);
   virtual void SetVariable(const std::string& name, const Vec2& v);
@@ -136,8 +170,33 @@ public:
   virtual void SetArrayVariable4fv(const std::string& name, const f32* v, size_t count, size_t start = 0);
   virtual void SetArrayVariableMat44fv(const std::string& name, const f32* v, size_t count, size_t start = 0);
 
+  virtual void SetVariable(ProgramVariableHandle handle, s32 v);
+  virtual void SetVariable(ProgramVariableHandle handle, f32 v);
+  virtual void SetVariable(ProgramVariableHandle handle, const Vec2& v);
+  virtual void SetVariable(ProgramVariableHandle handle, const Vec3& v);
+  virtual void SetVariable(ProgramVariableHandle handle, const Vec4& v);
+  virtual void SetVariable(ProgramVariableHandle handle, const Mat44& mat);
+
+  virtual void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, s32 v);
+  virtual void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, f32 v);
+  virtual void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec2& v);
+  virtual void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec3& v);
+  virtual void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec4& v);
+  virtual void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Mat44& mat);
+
+  virtual void SetArrayVariable1fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0);
+  virtual void SetArrayVariable2fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0);
+  virtual void SetArrayVariable3fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0);
+  virtual void SetArrayVariable4fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0);
+  virtual void SetArrayVariableMat44fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0);
+
   virtual void LoadVariablesToShaderStage();
 
+  // Variants are alternate programs for the same draw, such as one that reads
+  // compact vertices, selected by name at draw time.
+  void SetVariant(const std::string& name, DeviceProgram* program);
+  DeviceProgram* GetVariant(const std::string& name) const;
+
 };
 
 };
@@ -32,7 +32,9 @@ SOFTWARE.
 
 #include <Prime/Types/PrimitiveStack.h>
 #include <Prime/Types/TypeStack.h>
+#include <Prime/Types/MatrixStack.h>
 #include <Prime/Types/Viewport.h>
+#include <Prime/Types/Frustum.h>
 #include <Prime/Graphics/DeviceProgram.h>
 #include <Prime/Graphics/IndexBuffer.h>
 #include <Prime/Graphics/ArrayBuffer.h>
@@ -58,6 +60,51 @@ typedef struct _GraphicsScreenConfig {
   u32 swapInterval;
 } GraphicsScreenConfig;
 
+typedef struct _GraphicsSubmitVariable {
+  ProgramVariableHandle handle;
+  const f32* data;
+  size_t itemSize;
+  size_t count;
+} GraphicsSubmitVariable;
+
+// A self-contained draw for Submit. The model matrix replaces the model stack,
+// and variables carry per-draw uniform arrays such as a bone palette, with
+// itemSize counted in floats (1, 2, 3, 4 or 16).
+typedef struct _GraphicsSubmit {
+  DeviceProgram* program;
+  ArrayBuffer* ab;
+  IndexBuffer* ib;
+  size_t start;
+  size_t count;
+  ArrayBuffer* instances;
+  size_t instanceCount;
+  TexChannelTuple const* tupleList;
+  size_t tupleCount;
+  Mat44 model;
+  GraphicsSubmitVariable const* variables;
+  size_t variableCount;
+} GraphicsSubmit;
+
+// Times are in seconds. depth is the nesting level of the timer when it was
+// started, with 0 for the outermost timers of a frame.
+typedef struct _GraphicsGPUTime {
+  const char* name;
+  f64 time;
+  u32 depth;
+} GraphicsGPUTime;
+
+// Counts are for the last completed frame. gpuFrameTime is 0 until GPU timing
+// results have been read back, which lags a few frames behind.
+typedef struct _GraphicsFrameStats {
+  size_t drawCount;
+  size_t instanceCount;
+  size_t triangleCount;
+  size_t uniformBytesUploaded;
+  size_t uniformOverflowCount;
+  size_t texBytesUploaded;
+  f64 gpuFrameTime;
+} GraphicsFrameStats;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,11 +129,13 @@ protected:
   size_t maxTexH;
   size_t maxTexUnits;
 
+  bool cullingEnabled;
+
 public:
 
-  TypeStack<Mat44> projection;
-  TypeStack<Mat44> view;
-  TypeStack<Mat44> model;
+  MatrixStack projection;
+  MatrixStack view;
+  MatrixStack model;
   TypeStack<Viewport> viewport;
   PrimitiveStack<bool> depthMask;
   PrimitiveStack<bool> depthEnabled;
@@ -168,10 +217,63 @@ public:
   virtual void Draw(ArrayBuffer* ab, IndexBuffer* ib, TexChannelTuple const* tupleList, size_t tupleCount);
   virtual void Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, TexChannelTuple const* tupleList, size_t tupleCount);
 
+  virtual void DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, ArrayBuffer* instances, size_t instanceCount, Tex* tex = nullptr);
+  virtual void DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount);
+  virtual void DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount);
+
+  // With the render queue enabled, draws are recorded and then sorted and
+  // executed at EndFrame, and clears act as sort barriers. Submit may then be
+  // called from worker threads; it only reads the view, projection, depth,
+  // viewport and clip plane state, so those must not change while workers
+  // record. Programs, buffers and textures must stay alive until EndFrame.
+  virtual void SetRenderQueueEnabled(bool enabled);
+  virtual bool IsRenderQueueEnabled() const;
+  virtual void Submit(const GraphicsSubmit& submit);
+
+  // With culling enabled, which is the default, Model skips static meshes
+  // whose bounds are outside the frustum of the current projection, view and
+  // model matrices.
+  virtual void SetCullingEnabled(bool enabled);
+  virtual bool IsCullingEnabled() const;
+  virtual void GetFrustum(Frustum& frustum) const;
+
 #pragma endregion
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#pragma region Stats
+
+  // Named GPU timers nest like scopes and must be balanced within a frame.
+  // Results are read back without stalling once the GPU has finished with
+  // them, so GetGPUTimes returns the most recent frame that has completed.
+  // Names must outlive the results, which string literals do.
+  virtual bool IsGPUTimingSupported() const;
+  virtual void StartGPUTimer(const char* name);
+  virtual void EndGPUTimer();
+  virtual const std::vector<GraphicsGPUTime>& GetGPUTimes() const;
+
+  virtual void GetFrameStats(GraphicsFrameStats& stats) const;
+
+#pragma endregion
+
+////////////////////////////////////////////////////////////////////////////////
+
+};
+
+class GraphicsGPUTimerScope {
+public:
+
+  GraphicsGPUTimerScope(const char* name) {
+    Graphics::GetInstance().StartGPUTimer(name);
+  }
+
+  ~GraphicsGPUTimerScope() {
+    Graphics::GetInstance().EndGPUTimer();
+  }
+
+  GraphicsGPUTimerScope(const GraphicsGPUTimerScope&) = delete;
+  GraphicsGPUTimerScope& operator=(const GraphicsGPUTimerScope&) = delete;
+
 };
 
 };
@@ -32,6 +32,7 @@ SOFTWARE.
 
 #include <Prime/System/RefObject.h>
 #include <Prime/System/BlockBuffer.h>
+#include <Prime/System/ByteBuffer.h>
 #include <Prime/Types/Color.h>
 #include <Prime/Types/Stack.h>
 #include <Prime/Types/Dictionary.h>
@@ -400,6 +401,7 @@ public:
 
   virtual void AddTexData(const std::string& name, const std::string& data);
   virtual void AddTexData(const std::string& name, const std::string& data, const json& info);
+  virtual void AddTexData(const std::string& name, refptr<ByteBuffer> buffer, const json& info);
   virtual void AddTexData(const std::string& name, const TexData& data);
   virtual void RemoveTexData(const std::string& name);
   virtual void RemoveAllTexData();
@@ -0,0 +1,138 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetNull)
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/Graphics.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define PxNullGraphics NullGraphics::GetInstance()
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef struct _NullGraphicsStats {
+  size_t drawCount;
+  size_t instancedDrawCount;
+  size_t instanceCount;
+  size_t indexCount;
+  size_t triangleCount;
+  size_t clearCount;
+  size_t arrayBufferUploadCount;
+  size_t arrayBufferUploadBytes;
+  size_t indexBufferUploadCount;
+  size_t indexBufferUploadBytes;
+  size_t texUploadCount;
+  size_t texUploadBytes;
+  size_t programLoadCount;
+} NullGraphicsStats;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// A headless backend that accepts every draw and upload without a GPU. Work
+// is counted per frame and in total so CPU-side benchmarks can check that a
+// scene issued what it should.
+class NullGraphics: public Graphics {
+public:
+
+  static NullGraphics& GetInstance();
+
+private:
+
+  f32 screenW;
+  f32 screenH;
+  bool screenShown;
+
+  NullGraphicsStats frameStats;
+  NullGraphicsStats lastFrameStats;
+  NullGraphicsStats totalStats;
+
+public:
+
+  const NullGraphicsStats& GetLastFrameStats() const {return lastFrameStats;}
+  const NullGraphicsStats& GetTotalStats() const {return totalStats;}
+
+public:
+
+  NullGraphics();
+  ~NullGraphics();
+
+protected:
+
+  void Init() override;
+  void Shutdown() override;
+
+public:
+
+  void ShowScreen(const GraphicsScreenConfig* config = nullptr) override;
+  f32 GetScreenW() const override;
+  f32 GetScreenH() const override;
+
+  void StartFrame() override;
+  void EndFrame() override;
+
+  void ClearScreen() override;
+  void ClearColor() override;
+  void ClearDepth() override;
+
+  void Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, TexChannelTuple const* tupleList, size_t tupleCount) override;
+  void DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) override;
+
+  void GetFrameStats(GraphicsFrameStats& stats) const override;
+
+  void AddArrayBufferUpload(size_t bytes);
+  void AddIndexBufferUpload(size_t bytes);
+  void AddTexUpload(size_t bytes);
+  void AddProgramLoad();
+
+protected:
+
+  virtual void AddDraw(ArrayBuffer* ab, IndexBuffer* ib, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount);
+
+};
+
+};
+
+#endif
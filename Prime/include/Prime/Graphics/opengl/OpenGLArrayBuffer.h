@@ -34,7 +34,31 @@ SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <Prime/Graphics/ArrayBuffer.h>
+#include <Prime/Graphics/opengl/OpenGLIndexBuffer.h>
 #include <Prime/Graphics/opengl/OpenGLInc.h>
+#include <Prime/Graphics/opengl/OpenGLProgram.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define OpenGLArrayBufferVertexArrayMaxCount 8
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef struct _OpenGLArrayBufferVertexArray {
+  u64 programLayoutId;
+  u64 instanceSerial;
+  u64 indexSerial;
+  GLuint vaoId;
+  size_t attributeCallCount;
+} OpenGLArrayBufferVertexArray;
+
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -48,10 +72,15 @@ private:
   void* data;
   size_t dataSize;
   GLuint aboId;
+  u64 serial;
+
+  std::vector<OpenGLArrayBufferVertexArray> vertexArrays;
 
 public:
 
   GLuint GetABOId() const {return aboId;}
+  u64 GetSerial() const {return serial;}
+  size_t GetVertexArrayCount() const {return vertexArrays.size();}
 
 public:
 
@@ -69,6 +98,18 @@ public:
 
   void Sync() override;
 
+  // Returns the vertex array holding this buffer's attribute layout for the
+  // program, creating it on first use. Program attributes this buffer lacks
+  // are taken per instance from the optional instance buffer. A newly created
+  // vertex array is left bound with the index buffer as its element array,
+  // and requires this buffer to be the current GL_ARRAY_BUFFER.
+  OpenGLArrayBufferVertexArray* GetVertexArray(const OpenGLProgram& program, const OpenGLIndexBuffer* indices, OpenGLArrayBuffer* instances, bool& created);
+  void ReleaseVertexArrays();
+
+  // Points the program attribute at the buffer attribute in the currently
+  // bound GL_ARRAY_BUFFER and returns the number of GL calls made.
+  static size_t LoadVertexAttribute(const OpenGLProgramAttributeInfo& info, const ArrayBufferAttribute& attribute, GLsizei stride, GLuint divisor);
+
 };
 
 };
@@ -0,0 +1,131 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetOpenGL)
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/opengl/OpenGLInc.h>
+#include <Prime/Graphics/Graphics.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define OpenGLGPUTimerDefaultFrameCount 4
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (APIENTRYP OpenGLQueryCounterProc)(GLuint id, GLenum target);
+typedef void (APIENTRYP OpenGLGetQueryObjectui64vProc)(GLuint id, GLenum pname, GLuint64* params);
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef struct _OpenGLGPUTimerQuery {
+  const char* name;
+  u32 depth;
+  size_t startQuery;
+  size_t endQuery;
+  u64 cpuStart;
+} OpenGLGPUTimerQuery;
+
+typedef struct _OpenGLGPUTimerFrame {
+  std::vector<GLuint> queryIds;
+  size_t queryIdCount;
+  std::vector<OpenGLGPUTimerQuery> timers;
+  bool pending;
+} OpenGLGPUTimerFrame;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Ring of GL_TIMESTAMP query sets, one per frame in flight. Each timer writes a
+// timestamp when it starts and ends. A frame's results are read once its last
+// query is available, and a frame that is still pending when its slot comes
+// around again is dropped rather than waited on.
+class OpenGLGPUTimer {
+private:
+
+  OpenGLQueryCounterProc queryCounter;
+  OpenGLGetQueryObjectui64vProc getQueryObjectui64v;
+
+  std::vector<OpenGLGPUTimerFrame> frames;
+  size_t frameIndex;
+  bool frameStarted;
+  std::vector<size_t> openTimers;
+
+  std::vector<GraphicsGPUTime> results;
+  std::vector<GLuint64> resultTimestamps;
+  size_t droppedFrameCount;
+
+public:
+
+  bool IsSupported() const {return queryCounter != nullptr && getQueryObjectui64v != nullptr;}
+  const std::vector<GraphicsGPUTime>& GetResults() const {return results;}
+  size_t GetDroppedFrameCount() const {return droppedFrameCount;}
+
+public:
+
+  OpenGLGPUTimer();
+  ~OpenGLGPUTimer();
+
+public:
+
+  bool Init(size_t frameCount = OpenGLGPUTimerDefaultFrameCount);
+  void Shutdown();
+
+  void StartFrame();
+  void EndFrame();
+
+  void Start(const char* name);
+  void End();
+
+private:
+
+  size_t AddQuery(OpenGLGPUTimerFrame& frame);
+  void ReadFrame(OpenGLGPUTimerFrame& frame);
+
+};
+
+};
+
+#endif
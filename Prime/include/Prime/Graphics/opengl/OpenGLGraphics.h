@@ -35,6 +35,9 @@ SOFTWARE.
 
 #include <Prime/Graphics/Graphics.h>
 #include <Prime/Graphics/opengl/OpenGLProgram.h>
+#include <Prime/Graphics/opengl/OpenGLUniformRing.h>
+#include <Prime/Graphics/opengl/OpenGLRenderQueue.h>
+#include <Prime/Graphics/opengl/OpenGLGPUTimer.h>
 #include <Prime/Graphics/ArrayBuffer.h>
 #include <Prime/Graphics/IndexBuffer.h>
 #include <Prime/Graphics/Tex.h>
@@ -45,6 +48,22 @@ SOFTWARE.
 
 #define PxOpenGLGraphics OpenGLGraphics::GetInstance()
 
+////////////////////////////////////////////////////////////////////////////////
+// Enums
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+enum OpenGLGraphicsDrawMat {
+  OpenGLGraphicsDrawMatVP = 1 << 0,
+  OpenGLGraphicsDrawMatMV = 1 << 1,
+  OpenGLGraphicsDrawMatMVP = 1 << 2,
+  OpenGLGraphicsDrawMatNormal = 1 << 3,
+  OpenGLGraphicsDrawMatGPos = 1 << 4,
+};
+
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Structs
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +77,28 @@ typedef struct _OpenGLGraphicsCurrentTexture {
   bool hasAlpha;
 } OpenGLGraphicsCurrentTexture;
 
+typedef struct _OpenGLGraphicsStats {
+  size_t drawCount;
+  size_t instancedDrawCount;
+  size_t instanceCount;
+  size_t vertexArrayBindCount;
+  size_t vertexArrayBuildCount;
+  size_t vertexAttributeCallCount;
+  size_t indexBufferBindCount;
+  size_t arrayBufferBindCount;
+  size_t programChangeCount;
+  size_t textureBindCount;
+  size_t viewportChangeCount;
+  size_t depthStateChangeCount;
+  size_t clipStateChangeCount;
+  size_t queuedDrawCount;
+  size_t triangleCount;
+  size_t texUploadCount;
+  size_t texUploadBytes;
+  size_t matrixMultiplyCount;
+  size_t matrixInvertCount;
+} OpenGLGraphicsStats;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,22 +116,57 @@ private:
 
   GLFWwindow* screenWindow;
 
-  TypeStack<Mat44> drawMatMVP;  
-  TypeStack<Mat44> drawMatModel;
-  TypeStack<Mat44> drawMatView;
-  TypeStack<Mat44> drawMatVP;
-  TypeStack<Mat44> drawMatMV;
+  // Matrix products for immediate draws. Each is built on first use after a
+  // stack it depends on changes version, with the built ones flagged in
+  // drawMatValidMask.
+  Mat44 drawMatVP;
+  Mat44 drawMatMV;
+  Mat44 drawMatMVP;
+  Mat44 drawMatNormal;
+  Mat44 drawMatGPos;
+  u64 drawMatProjectionVersion;
+  u64 drawMatViewVersion;
+  u64 drawMatModelVersion;
+  f32 drawMatNearZ;
+  f32 drawMatFarZ;
+  u32 drawMatValidMask;
 
   // Render State
   TypeStack<OpenGLGraphicsCurrentTexture>* currentTextureStacks;
   PrimitiveStack<GLuint> currentIBOId;
   PrimitiveStack<GLuint> currentABOId;
   PrimitiveStack<GLuint> currentProgramId;
+  GLuint currentVAOId;
   Color currentClearScreenColor;
   f64 currentClearScreenDepth;
   Viewport currentViewport;
   bool currentDepthMask;
   bool currentDepthEnabled;
+  u32 currentClipMask;
+
+  OpenGLUniformRing uniformRing;
+
+  OpenGLRenderQueue renderQueue;
+  bool renderQueueEnabled;
+
+  OpenGLGPUTimer gpuTimer;
+
+  bool vertexArrayCacheEnabled;
+
+  OpenGLGraphicsStats frameStats;
+  OpenGLGraphicsStats lastFrameStats;
+
+public:
+
+  bool IsVertexArrayCacheEnabled() const {return vertexArrayCacheEnabled;}
+  void SetVertexArrayCacheEnabled(bool enabled) {vertexArrayCacheEnabled = enabled;}
+
+  const OpenGLGraphicsStats& GetLastFrameStats() const {return lastFrameStats;}
+
+  OpenGLUniformRing& GetUniformRing() {return uniformRing;}
+  size_t GetFrameUniformBytesUploaded() const {return uniformRing.GetLastFrameStats().bytesUploaded;}
+
+  OpenGLGPUTimer& GetGPUTimer() {return gpuTimer;}
 
 public:
 
@@ -124,6 +200,20 @@ public:
   void ClearDepth() override;
 
   void Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, TexChannelTuple const* tupleList, size_t tupleCount) override;
+  void DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) override;
+
+  void SetRenderQueueEnabled(bool enabled) override;
+  bool IsRenderQueueEnabled() const override;
+  void Submit(const GraphicsSubmit& submit) override;
+
+  bool IsGPUTimingSupported() const override;
+  void StartGPUTimer(const char* name) override;
+  void EndGPUTimer() override;
+  const std::vector<GraphicsGPUTime>& GetGPUTimes() const override;
+
+  void GetFrameStats(GraphicsFrameStats& stats) const override;
+
+  void AddTexUpload(size_t bytes);
 
   virtual GLFWwindow* GetOpenGLGLFWScreenWindow() const;
 
@@ -131,22 +221,42 @@ protected:
 
   virtual void ResetRenderState();
 
+  virtual void DrawElements(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount);
+  virtual void ExecuteDrawElements(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, OpenGLProgram& prog);
+
+  virtual void RecordRenderPacket(const GraphicsSubmit& submit);
+  virtual void FlushRenderQueue();
+
   virtual void PushDrawTexChannelTupleList(TexChannelTuple const* tupleList, size_t tupleCount);
   virtual void PushDrawTex(Tex* tex, size_t unit, TexChannel channel = TexChannelMain);
   virtual void PushDrawIndexBuffer(IndexBuffer* ib);
   virtual void PushDrawArrayBuffer(ArrayBuffer* ab);
   virtual void PushDrawProgram(DeviceProgram* deviceProgram);
-  virtual void PushDrawMatrices();
 
   virtual void PopDrawTexChannelTupleList();
   virtual void PopDrawTex(size_t unit);
   virtual void PopDrawIndexBuffer();
   virtual void PopDrawArrayBuffer();
   virtual void PopDrawProgram();
-  virtual void PopDrawMatrices();
 
+  virtual void UpdateDrawMatrices();
+  virtual const Mat44& GetDrawMatVP();
+  virtual const Mat44& GetDrawMatMV();
+  virtual const Mat44& GetDrawMatMVP();
+  virtual const Mat44& GetDrawMatNormal();
+  virtual const Mat44& GetDrawMatGPos();
+
+  virtual void LoadDrawTex(Tex* tex, size_t unit, TexChannel channel = TexChannelMain);
+  virtual void LoadDrawTexId(GLint unit, GLuint textureId);
+  virtual void LoadDrawIndexBuffer(IndexBuffer* ib);
+  virtual void LoadDrawArrayBuffer(ArrayBuffer* ab);
+  virtual void LoadDrawProgram(DeviceProgram* deviceProgram);
+  virtual bool LoadDrawVertexArray(ArrayBuffer* ab, IndexBuffer* ib, OpenGLProgram& prog, ArrayBuffer* instances = nullptr);
   virtual void LoadDrawViewport();
+  virtual void LoadDrawViewport(const Viewport& drawViewport);
   virtual void LoadDrawDepth();
+  virtual void LoadDrawDepth(bool drawDepthMask, bool drawDepthEnabled);
+  virtual void LoadDrawClipPlanes(u32 clipMask);
 
 };
 
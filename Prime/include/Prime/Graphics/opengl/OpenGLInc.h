@@ -59,6 +59,19 @@ SOFTWARE.
 #define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
 #define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
 
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (APIENTRYP OpenGLVertexAttribDivisorProc)(GLuint index, GLuint divisor);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -97,5 +110,6 @@ void AssertOpenGLProgramLinkCore(GLuint programId);
 ////////////////////////////////////////////////////////////////////////////////
 
 extern bool __PrimeOpenGLOutOfMemoryError;
+extern OpenGLVertexAttribDivisorProc __PrimeOpenGLVertexAttribDivisor;
 
 #endif
@@ -48,10 +48,12 @@ private:
   void* data;
   size_t dataSize;
   GLuint iboId;
+  u64 serial;
 
 public:
 
   GLuint GetIBOId() const {return iboId;}
+  u64 GetSerial() const {return serial;}
 
 public:
 
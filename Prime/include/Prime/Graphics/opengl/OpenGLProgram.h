@@ -67,14 +67,23 @@ class OpenGLProgram: public DeviceProgram {
 protected:
 
   GLuint programId;
+  u64 layoutId;
 
   GLuint variableBufferId;
   GLint uniformBlockIndex;
 
   void* variableBuffer;
   size_t variableBufferSize;
-
-  Dictionary<std::string, OpenGLProgramVariableInfo*> variableInfoLookup;
+  size_t variableBufferUsedSize;
+  size_t variableDirtyBegin;
+  size_t variableDirtyEnd;
+  bool variableBufferIdSynced;
+  u64 variableRingSerial;
+  GLintptr variableRingOffset;
+
+  // Indexed by ProgramVariableHandle id. Names interned after the link are
+  // past the end, since the program cannot declare them.
+  std::vector<OpenGLProgramVariableInfo*> variableInfoByHandle;
   OpenGLProgramVariableInfo* variableInfo;
   size_t variableInfoCount;
 
@@ -87,9 +96,13 @@ protected:
 public:
 
   GLuint GetProgramId() const {return programId;}
+  u64 GetLayoutId() const {return layoutId;}
 
   GLuint GetVariableBufferId() const {return variableBufferId;}
   GLint GetUniformBlockIndex() const {return uniformBlockIndex;}
+  size_t GetVariableBufferUsedSize() const {return variableBufferUsedSize;}
+  size_t GetVariableBufferSize() const {return variableBufferSize;}
+  const void* GetVariableBuffer() const {return variableBuffer;}
 
   size_t GetAttributeCount() const {return attributeInfoCount;}
 
@@ -109,30 +122,47 @@ public:
 
   void CheckVariableStatus() override;
 
-  void SetVariable(const std::string& name, s32 v) override;
-  void SetVariable(const std::string& name, f32 v) override;
-  void SetVariable(const std::string& name, const Vec2& v) override;
-  void SetVariable(const std::string& name, const Vec3& v) override;
-  void SetVariable(const std::string& name, const Vec4& v) override;
-  void SetVariable(const std::string& name, const Mat44& mat) override;
-
-  void SetArrayVariable(const std::string& name, size_t arrayIndex, s32 v) override;
-  void SetArrayVariable(const std::string& name, size_t arrayIndex, f32 v) override;
-  void SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec2& v) override;
-  void SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec3& v) override;
-  void SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec4& v) override;
-  void SetArrayVariable(const std::string& name, size_t arrayIndex, const Mat44& mat) override;
-
-  void SetArrayVariable1fv(const std::string& name, const f32* v, size_t count, size_t start = 0) override;
-  void SetArrayVariable2fv(const std::string& name, const f32* v, size_t count, size_t start = 0) override;
-  void SetArrayVariable3fv(const std::string& name, const f32* v, size_t count, size_t start = 0) override;
-  void SetArrayVariable4fv(const std::string& name, const f32* v, size_t count, size_t start = 0) override;
-  void SetArrayVariableMat44fv(const std::string& name, const f32* v, size_t count, size_t start = 0) override;
+  using DeviceProgram::SetVariable;
+  using DeviceProgram::SetArrayVariable;
+  using DeviceProgram::SetArrayVariable1fv;
+  using DeviceProgram::SetArrayVariable2fv;
+  using DeviceProgram::SetArrayVariable3fv;
+  using DeviceProgram::SetArrayVariable4fv;
+  using DeviceProgram::SetArrayVariableMat44fv;
+
+  void SetVariable(ProgramVariableHandle handle, s32 v) override;
+  void SetVariable(ProgramVariableHandle handle, f32 v) override;
+  void SetVariable(ProgramVariableHandle handle, const Vec2& v) override;
+  void SetVariable(ProgramVariableHandle handle, const Vec3& v) override;
+  void SetVariable(ProgramVariableHandle handle, const Vec4& v) override;
+  void SetVariable(ProgramVariableHandle handle, const Mat44& mat) override;
+
+  void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, s32 v) override;
+  void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, f32 v) override;
+  void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec2& v) override;
+  void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec3& v) override;
+  void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec4& v) override;
+  void SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Mat44& mat) override;
+
+  void SetArrayVariable1fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0) override;
+  void SetArrayVariable2fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0) override;
+  void SetArrayVariable3fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0) override;
+  void SetArrayVariable4fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0) override;
+  void SetArrayVariableMat44fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start = 0) override;
 
   void LoadVariablesToShaderStage() override;
 
+  // Uniform block snapshots for deferred draws. The block has the layout of
+  // the program's variable buffer and is uploaded in place of it.
+  virtual size_t GetVariableBlockExtent(ProgramVariableHandle handle, size_t itemSize, size_t count) const;
+  virtual void WriteVariableBlockData(void* block, ProgramVariableHandle handle, const f32* data, size_t itemSize, size_t count) const;
+  size_t GetVariableBlockExtent(const std::string& name, size_t itemSize, size_t count) const;
+  void WriteVariableBlockData(void* block, const std::string& name, const f32* data, size_t itemSize, size_t count) const;
+  virtual void LoadVariableBlockToShaderStage(const void* block, size_t blockSize);
+
   virtual const OpenGLProgramVariableInfo* GetVariableInfo(size_t index) const;
   virtual const OpenGLProgramVariableInfo* GetVariableInfo(const std::string& name) const;
+  const OpenGLProgramVariableInfo* GetVariableInfo(ProgramVariableHandle handle) const {return handle.GetId() < variableInfoByHandle.size() ? variableInfoByHandle[handle.GetId()] : nullptr;}
   virtual const OpenGLProgramAttributeInfo* GetAttributeInfo(size_t index) const;
   virtual GLint GetTextureLoc(size_t unit) const;
 
@@ -140,6 +170,9 @@ private:
 
   void InitOpenGLProgram(DeviceShader* vertexShader, DeviceShader* fragmentShader);
 
+  void WriteVariableData(size_t addr, const void* data, size_t size);
+  void WriteVariableArrayData(const OpenGLProgramVariableInfo* info, const f32* data, size_t itemSize, size_t count, size_t start);
+
 };
 
 };
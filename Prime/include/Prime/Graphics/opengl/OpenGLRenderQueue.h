@@ -0,0 +1,158 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetOpenGL)
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/opengl/OpenGLProgram.h>
+#include <Prime/Graphics/ArrayBuffer.h>
+#include <Prime/Graphics/IndexBuffer.h>
+#include <Prime/Graphics/Tex.h>
+#include <Prime/Types/Viewport.h>
+#include <atomic>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define OpenGLRenderPacketMaxTexCount 4
+
+////////////////////////////////////////////////////////////////////////////////
+// Enums
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+enum OpenGLRenderPacketLayer {
+  OpenGLRenderPacketLayerOpaque = 0,
+  OpenGLRenderPacketLayerTransparent,
+  OpenGLRenderPacketLayerOverlay,
+};
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef struct _OpenGLRenderPacket {
+  u64 key;
+  OpenGLProgram* program;
+  ArrayBuffer* ab;
+  IndexBuffer* ib;
+  ArrayBuffer* instances;
+  TexChannelTuple textures[OpenGLRenderPacketMaxTexCount];
+  size_t texCount;
+  size_t start;
+  size_t count;
+  size_t instanceCount;
+  size_t uniformOffset;
+  size_t uniformSize;
+  Viewport viewport;
+  u32 clipMask;
+  bool depthMask;
+  bool depthEnabled;
+} OpenGLRenderPacket;
+
+// Recording threads cannot share the graphics draw matrix cache, so each
+// bucket keeps the projection and view it last recorded with and their
+// product.
+typedef struct _OpenGLRenderQueueBucket {
+  std::vector<OpenGLRenderPacket> packets;
+  std::vector<u8> uniformData;
+  Mat44 projection;
+  Mat44 view;
+  Mat44 vp;
+  bool vpValid;
+} OpenGLRenderQueueBucket;
+
+typedef struct _OpenGLRenderQueueItem {
+  u64 key;
+  const OpenGLRenderPacket* packet;
+  const u8* uniformData;
+} OpenGLRenderQueueItem;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Deferred draw packets sorted by a 64-bit state key. Each recording thread
+// appends to its own bucket, so recording only takes a lock the first time a
+// thread records into the queue. Sorting and execution happen on the main
+// thread once recording has finished.
+//
+// Key layout, from the most significant bit:
+//   opaque:      layer (2), program (16), texture (16), buffer (14), depth (16)
+//   transparent: layer (2), inverted depth (24), program (16), texture (16), buffer (6)
+//   overlay:     layer (2), submission sequence (62)
+// Opaque packets are grouped by state and drawn front to back within a group,
+// transparent packets are drawn back to front, and packets drawn without a
+// depth test keep their submission order.
+class OpenGLRenderQueue {
+private:
+
+  u64 id;
+  ThreadMutex* bucketMutex;
+  std::vector<OpenGLRenderQueueBucket*> buckets;
+  std::vector<OpenGLRenderQueueItem> items;
+  std::atomic<u64> sequence;
+
+public:
+
+  OpenGLRenderQueue();
+  ~OpenGLRenderQueue();
+
+public:
+
+  OpenGLRenderQueueBucket& GetThreadBucket();
+  u64 GetNextSequence();
+
+  bool IsEmpty() const;
+  size_t GetPacketCount() const;
+
+  const std::vector<OpenGLRenderQueueItem>& Sort();
+  void Clear();
+
+  static u64 MakeKey(OpenGLRenderPacketLayer layer, u64 programId, const void* tex, const void* ab, f32 depth, u64 sequence);
+
+};
+
+};
+
+#endif
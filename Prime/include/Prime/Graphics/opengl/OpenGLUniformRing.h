@@ -0,0 +1,138 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetOpenGL)
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/opengl/OpenGLInc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define OpenGLUniformRingDefaultFrameSize (4 * 1024 * 1024)
+#define OpenGLUniformRingDefaultFrameCount 3
+#define OpenGLUniformRingMaxFrameSize (64 * 1024 * 1024)
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef struct _OpenGLUniformRingStats {
+  size_t bytesUploaded;
+  size_t uploadCount;
+  size_t reuseCount;
+  size_t fallbackCount;
+  size_t overflowCount;
+  size_t stallCount;
+  size_t growCount;
+} OpenGLUniformRingStats;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Frame-segmented uniform buffer. Each frame writes into its own segment of a
+// single persistently mapped buffer, and a fence placed at EndFrame guards the
+// segment until the GPU has consumed it. Without glBufferStorage the ring falls
+// back to glBufferSubData into the same segments. When a frame asks for more
+// than its segment holds, the ring is reallocated at the next StartFrame with
+// segments sized from that frame's demand, up to OpenGLUniformRingMaxFrameSize.
+class OpenGLUniformRing {
+private:
+
+  GLuint bufferId;
+  u8* mapping;
+  bool persistent;
+
+  size_t frameSize;
+  size_t frameCount;
+  size_t frameIndex;
+  size_t frameHead;
+  size_t frameDemand;
+  u64 frameSerial;
+  GLsync* frameFences;
+
+  size_t offsetAlignment;
+
+  GLuint boundIndex;
+  GLintptr boundOffset;
+  GLsizeiptr boundSize;
+
+  OpenGLUniformRingStats stats;
+  OpenGLUniformRingStats lastFrameStats;
+
+public:
+
+  bool IsReady() const {return bufferId != GL_NONE;}
+  bool IsPersistent() const {return persistent;}
+  GLuint GetBufferId() const {return bufferId;}
+  u64 GetFrameSerial() const {return frameSerial;}
+
+  const OpenGLUniformRingStats& GetStats() const {return stats;}
+  const OpenGLUniformRingStats& GetLastFrameStats() const {return lastFrameStats;}
+
+public:
+
+  OpenGLUniformRing();
+  ~OpenGLUniformRing();
+
+public:
+
+  bool Init(size_t frameSize = OpenGLUniformRingDefaultFrameSize, size_t frameCount = OpenGLUniformRingDefaultFrameCount);
+  void Shutdown();
+
+  void StartFrame();
+  void EndFrame();
+
+  bool Upload(const void* data, size_t dataSize, size_t allocSize, GLintptr& offset);
+  void BindRange(GLuint index, GLintptr offset, GLsizeiptr size);
+  void ResetBinding();
+
+  void CountReuse();
+  void CountFallback(size_t dataSize);
+
+private:
+
+  bool Grow(size_t demand);
+
+};
+
+};
+
+#endif
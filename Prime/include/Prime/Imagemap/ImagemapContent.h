@@ -180,9 +180,12 @@ public:
 
 public:
 
+  using Content::Load;
   bool Load(const json& data, const json& info) override;
   bool Load(const void* data, size_t dataSize, const json& info) override;
+  bool Load(refptr<ByteBuffer> buffer, const json& info) override;
   virtual bool LoadFromBC(const void* data, size_t dataSize, const json& info);
+  virtual bool LoadFromBC(refptr<ByteBuffer> buffer, const json& info);
   virtual bool LoadFromPNG(const void* data, size_t dataSize, const json& info);
   virtual bool LoadFromJPEG(const void* data, size_t dataSize, const json& info);
 
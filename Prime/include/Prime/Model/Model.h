@@ -34,6 +34,7 @@ SOFTWARE.
 #include <Prime/Interface/IMeasurable.h>
 #include <Prime/Model/ModelContent.h>
 #include <Prime/Model/ModelPose.h>
+#include <Prime/Graphics/DeviceProgram.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -42,6 +43,7 @@ SOFTWARE.
 namespace Prime {
 
 class Model: public RefObject, public IProcessable, public IMeasurable {
+friend class ModelStaticBatch;
 private:
 
   refptr<ModelContent> content;
@@ -64,6 +66,9 @@ private:
   std::string actionSceneName;
   bool actionSceneNameKnown;
   size_t actionIndex;
+  size_t actionSceneIndex;
+  size_t actionSkeletonActionIndex;
+  size_t actionKeyFrameCursor;
   bool actionChanged;
   f32 actionTimeScale;
   f32 actionCtr;
@@ -74,8 +79,16 @@ private:
   bool actionReverse;
   Dictionary<std::string, std::string> mappedActionName;
 
+  // Global bone transforms are shared by every mesh. Each mesh's palette
+  // multiplies them by its bone offsets, and meshes with the same offsets point
+  // at the same palette so it is built and uploaded once.
+  Mat44* boneTransforms;
   Mat44** activeBoneTransforms;
-  Mat44** boneTransforms;
+  Mat44* bonePalettes;
+  Mat44* bonePaletteOffsets;
+  Mat44* activeBoneGlobalTransforms;
+  size_t* activeBoneIndices;
+  size_t bonePaletteCount;
   size_t activeMeshCount;
   size_t activeBoneCount;
   size_t totalBoneCount;
@@ -112,8 +125,22 @@ public:
   void Calc(f32 dt) override;
   void Draw() override;
 
+  // Draws every mesh once per instance. Instance attributes such as iModel are
+  // read from the instance buffer and applied outside the model matrix.
+  virtual void DrawInstanced(ArrayBuffer* instances, size_t instanceCount);
+
+  // Submits every mesh as a self-contained draw with the given model matrix.
+  // Nothing is taken from the model stack and no references are taken, so
+  // this can record into the render queue from worker threads as long as the
+  // model is not animated or modified at the same time.
+  virtual void Submit(const Mat44& transform, DeviceProgram* program);
+
   f32 GetUniformSize() const override;
 
+  // Bounds of the active scene in model space, including the scene, mesh base
+  // and mesh transforms. Returns false if there is nothing to measure.
+  virtual bool GetBounds(Vec3& boundsMin, Vec3& boundsMax) const;
+
   ////////////////////////////////////////
   // Actions
   ////////////////////////////////////////
@@ -153,9 +180,12 @@ public:
   virtual void SetMeshTransform(const std::string& name, const Mat44& mat);
   virtual void ClearMeshTransform(const std::string& name);
   virtual void DrawMesh(const ModelContentMesh& mesh, size_t meshIndex);
+  virtual void DrawMeshInstanced(const ModelContentMesh& mesh, size_t meshIndex, ArrayBuffer* instances, size_t instanceCount);
+  virtual Tex* GetMeshTex(const ModelContentMesh& mesh) const;
 
   virtual const Mat44* GetActiveBoneTransform(size_t meshIndex, size_t activePoseBoneIndex) const;
   virtual const Mat44* GetBoneTransform(size_t meshIndex, size_t boneIndex) const;
+  size_t GetBonePaletteCount() const {return bonePaletteCount;}
 
   virtual f32 GetUniformBaseScale(bool cached = true);
 
@@ -163,9 +193,10 @@ protected:
 
   void DiscardAction();
   void GetActionKeyFrames(const ModelContentSkeleton& skeleton, const ModelContentSkeletonAction& skeletonAction, const ModelContentSkeletonActionKeyFrame** keyFrame1, const ModelContentSkeletonActionKeyFrame** keyFrame2, f32* weight);
+  size_t FindActionKeyFrame(const ModelContentSkeletonAction& skeletonAction, f32 time);
 
-  void UpdateBoneTransformsForPoses(const ModelContent& content, const ModelContentSkeleton& skeleton, size_t meshIndex, size_t boneIndex, Mat44 transformation, const ModelContentSkeletonPose* pose1, const ModelContentSkeletonPose* pose2 = NULL, f32 t = 0.0f);
-  void UpdateBoneTransformsForModelPose(const ModelContent& content, const ModelContentSkeleton& skeleton, size_t meshIndex, size_t boneIndex, Mat44 transformation, const ModelPose& pose);
+  void CreateBoneTransforms(const ModelContentScene& scene, const ModelContentSkeleton& skeleton);
+  void UpdateBoneTransforms(const ModelContentSkeleton& skeleton, const ModelPose& pose);
 
   void DestroyBoneTransforms();
 
@@ -123,6 +123,7 @@ public:
 
 public:
 
+  using Content::Load;
   bool Load(const void* data, size_t dataSize, const json& info) override;
   virtual bool LoadFromGLTF(const void* data, size_t dataSize, const json& info);
   virtual bool LoadFromFBX(const void* data, size_t dataSize, const json& info);
@@ -33,7 +33,27 @@ SOFTWARE.
 #include <Prime/Graphics/ArrayBuffer.h>
 #include <Prime/Graphics/IndexBuffer.h>
 #include <Prime/Graphics/Tex.h>
+#include <Prime/Model/ModelMeshOptimizer.h>
 #include <Prime/Types/Mat44.h>
+#include <Prime/Types/Vec4.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Enums
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Compact meshes store snorm16 positions and unorm16 UVs relative to the mesh
+// bounds, octahedral normals, and u8 or u16 bone indices with unorm8 weights.
+// They are drawn with the program's "compact" variant, which decodes them
+// using meshPosScale, meshPosOffset and meshUVScaleOffset. meshPosOffset.w
+// holds the number of bone influences per vertex (4 or 8).
+enum ModelContentMeshVertexFormat {
+  ModelContentMeshVertexFormatStandard = 0,
+  ModelContentMeshVertexFormatCompact,
+};
+
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -45,6 +65,7 @@ class ModelContentMesh {
 friend class Model;
 friend class ModelContent;
 friend class ModelContentScene;
+friend class ModelStaticBatch;
 private:
 
   size_t textureIndex;
@@ -59,16 +80,29 @@ private:
   Vec3 vertexMin;
   Vec3 vertexMax;
 
+  Vec3 boundsMin;
+  Vec3 boundsMax;
+  Vec3 boundsCenter;
+  f32 boundsRadius;
+
   ArrayBuffer* ab;
   IndexBuffer* ib;
 
   size_t vertexCount;
+  size_t vertexSize;
   size_t indexCount;
 
+  ModelContentMeshVertexFormat vertexFormat;
+  Vec4 posScale;
+  Vec4 posOffset;
+  Vec4 uvScaleOffset;
+
   Mat44 baseTransform;
 
   bool anim;
 
+  ModelMeshOptimizerStats optimizeStats;
+
 public:
   
   size_t GetTextureIndex() const {return textureIndex;}
@@ -80,10 +114,25 @@ public:
   const Vec3& GetVertexMin() const {return vertexMin;}
   const Vec3& GetVertexMax() const {return vertexMax;}
 
+  // Bounds of the vertex positions in mesh space, before the base transform.
+  const Vec3& GetBoundsMin() const {return boundsMin;}
+  const Vec3& GetBoundsMax() const {return boundsMax;}
+  const Vec3& GetBoundsCenter() const {return boundsCenter;}
+  f32 GetBoundsRadius() const {return boundsRadius;}
+
   const Mat44& GetBaseTransform() const {return baseTransform;}
 
   bool GetAnim() const {return anim;}
 
+  size_t GetVertexCount() const {return vertexCount;}
+  size_t GetVertexSize() const {return vertexSize;}
+  ModelContentMeshVertexFormat GetVertexFormat() const {return vertexFormat;}
+  const Vec4& GetPosScale() const {return posScale;}
+  const Vec4& GetPosOffset() const {return posOffset;}
+  const Vec4& GetUVScaleOffset() const {return uvScaleOffset;}
+
+  const ModelMeshOptimizerStats& GetOptimizeStats() const {return optimizeStats;}
+
 public:
 
   ModelContentMesh();
@@ -96,6 +145,8 @@ public:
 
   void SetDirectTex(Tex* directTex);
 
+  void CalcBounds();
+
   f32 GetVertexElement(size_t index, size_t vertexSize, size_t elementOffset = 0) const;
   void GetVertexElement2(Vec2& v, size_t index, size_t vertexSize, size_t elementOffset = 0) const;
   void GetVertexElement3(Vec3& v, size_t index, size_t vertexSize, size_t elementOffset = 0) const;
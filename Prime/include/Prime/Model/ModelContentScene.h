@@ -43,6 +43,8 @@ SOFTWARE.
 
 namespace Prime {
 
+class ModelContent;
+
 class ModelContentScene {
 friend class Model;
 friend class ModelContent;
@@ -68,10 +70,15 @@ private:
 
   Stack<refptr<Tex>> textures;
   bool loadTextures;
+  bool compactVertices;
+  bool optimizeMeshes;
 
   Vec3 vertexMin;
   Vec3 vertexMax;
 
+  Vec3 boundsMin;
+  Vec3 boundsMax;
+
 public:
 
   const std::string& GetName() const {return name;}
@@ -86,7 +93,7 @@ public:
   const ModelContentAnimation& GetAnimation(size_t index) const {PrimeAssert(index < animationCount, "Invalid animation index."); return animations[index];}
   size_t GetAnimationCount() const {return animationCount;}
 
-  refptr<Tex> GetTexture(size_t index) const {PrimeAssert(index < textures.GetCount(), "Invalid texture index."); return textures[index];}
+  Tex* GetTexture(size_t index) const {PrimeAssert(index < textures.GetCount(), "Invalid texture index."); return textures[index];}
   size_t GetTextureCount() const {return textures.GetCount();}
 
   const Mat44& GetBaseTransform() const {return baseTransform;}
@@ -95,6 +102,10 @@ public:
   const Vec3& GetVertexMin() const {return vertexMin;}
   const Vec3& GetVertexMax() const {return vertexMax;}
 
+  // Bounds of every mesh after its base transform, before the scene's.
+  const Vec3& GetBoundsMin() const {return boundsMin;}
+  const Vec3& GetBoundsMax() const {return boundsMax;}
+
 public:
 
   ModelContentScene();
@@ -103,6 +114,8 @@ public:
 public:
 
   void SetLoadTextures(bool loadTextures);
+  void SetCompactVertices(bool compactVertices);
+  void SetOptimizeMeshes(bool optimizeMeshes);
   size_t GetMeshIndexByName(const std::string& name) const;
 
 protected:
@@ -110,6 +123,9 @@ protected:
   void ReadModelUsingTinyGLTF(const void* data, size_t dataSize);
   void ReadModelUsingAssimp(const void* data, size_t dataSize);
 
+  void LoadMeshBuffers();
+  void LoadMeshAnimVertices(ModelContentMesh& mesh, void* vertices, size_t vertexCount);
+
   void DestroyMeshes();
   void DestroySkeletons();
   void DestroyAnimations();
@@ -61,6 +61,10 @@ private:
   size_t rootBoneIndex;
   size_t actionPoseBoneCount;
 
+  size_t* orderedBoneIndices;
+  size_t* orderedBoneParentIndices;
+  size_t orderedBoneCount;
+
   ModelContentSkeletonPose* poses;
   size_t poseCount;
 
@@ -80,6 +84,12 @@ public:
   size_t GetRootBoneIndex() const {return rootBoneIndex;}
   size_t GetActionPoseBoneCount() const {return actionPoseBoneCount;}
 
+  // Bones reachable from the root, ordered so every parent comes before its
+  // children. The parent index is a bone index, or PrimeNotFound for the root.
+  size_t GetOrderedBoneIndex(size_t index) const {PrimeAssert(index < orderedBoneCount, "Invalid ordered bone index."); return orderedBoneIndices[index];}
+  size_t GetOrderedBoneParentIndex(size_t index) const {PrimeAssert(index < orderedBoneCount, "Invalid ordered bone index."); return orderedBoneParentIndices[index];}
+  size_t GetOrderedBoneCount() const {return orderedBoneCount;}
+
   const ModelContentSkeletonPose& GetPose(size_t index) const {PrimeAssert(index < poseCount, "Invalid pose index."); return poses[index];}
   size_t GetPoseCount() const {return poseCount;}
 
@@ -104,6 +114,7 @@ public:
   size_t GetBoneIndexByName(const std::string& name) const;
   size_t GetActionPoseBoneIndexByName(const std::string& name) const;
   void ApplyBoneAffectingVertices(const std::string& name);
+  size_t GetActionIndexByName(const std::string& name) const;
   const ModelContentSkeletonAction* GetActionByName(const std::string& name) const;
 
 protected:
@@ -122,7 +133,10 @@ protected:
   void EnsureKeyFramePose(ModelContentSkeletonActionKeyFrame& keyFrame, size_t keyFrameIndex, ModelContentSkeletonAction& action, Stack<ModelContentSkeletonPose>& createdPoses);
   void EnsureKeyFrameTransformations(ModelContentSkeletonActionKeyFrame& keyFrame, size_t keyFrameIndex, ModelContentSkeletonAction& action, Stack<ModelContentSkeletonPose>& createdPoses);
 
+  void BuildBoneOrder();
+
   void DestroyBones();
+  void DestroyBoneOrder();
   void DestroyPoses();
   void DestroyActions();
 
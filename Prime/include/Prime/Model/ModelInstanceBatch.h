@@ -0,0 +1,107 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Model/Model.h>
+#include <Prime/Graphics/ArrayBuffer.h>
+#include <Prime/Types/Color.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define ModelInstanceBatchMinCapacity 64
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Per-instance vertex data, read by the instanced model shaders as iModel and
+// iTint.
+typedef struct _ModelInstance {
+  f32 transform[16];
+  f32 tint[4];
+} ModelInstance;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Draws many placements of one model with a single instanced draw per mesh.
+// Textures and the animation pose come from the source model, so animated
+// instances share its current pose.
+class ModelInstanceBatch: public RefObject {
+private:
+
+  refptr<Model> model;
+
+  std::vector<ModelInstance> instances;
+  ArrayBuffer* instanceBuffer;
+  size_t instanceBufferCapacity;
+  bool instancesModified;
+
+public:
+
+  Model* GetModel() const {return model;}
+  size_t GetInstanceCount() const {return instances.size();}
+  const ModelInstance& GetInstance(size_t index) const {return instances[index];}
+
+public:
+
+  ModelInstanceBatch(Model* model = nullptr);
+  ~ModelInstanceBatch();
+
+public:
+
+  virtual void SetModel(Model* model);
+
+  virtual size_t AddInstance(const Mat44& transform, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f));
+  virtual void SetInstance(size_t index, const Mat44& transform);
+  virtual void SetInstance(size_t index, const Mat44& transform, const Color& tint);
+  virtual void RemoveInstance(size_t index);
+  virtual void ClearInstances();
+  virtual void ReserveInstances(size_t count);
+
+  virtual void Draw();
+
+protected:
+
+  void SyncInstanceBuffer();
+
+};
+
+};
@@ -0,0 +1,108 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Config.h>
+#include <Prime/Enum/IndexFormat.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define ModelMeshOptimizerCacheSize 32
+#define ModelMeshOptimizerACMRCacheSize 16
+#define ModelMeshOptimizerOverdrawThreshold 1.05f
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// ACMR is the average number of post-transform cache misses per triangle,
+// measured with a FIFO cache of ModelMeshOptimizerACMRCacheSize entries. It
+// ranges from 3.0 for unshared triangles down to about 0.5 for a good order
+// on a regular grid.
+typedef struct _ModelMeshOptimizerStats {
+  size_t vertexCountBefore;
+  size_t vertexCountAfter;
+  size_t triangleCount;
+  f32 acmrBefore;
+  f32 acmrAfter;
+} ModelMeshOptimizerStats;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Reorders indexed triangle lists for the GPU. Vertices are opaque blocks of
+// vertexSize bytes with an f32 xyz position at positionOffset. Every function
+// works on 32-bit indices in place and is safe to run on job workers, so
+// loaders optimize meshes in parallel before creating their buffers.
+class ModelMeshOptimizer {
+public:
+
+  // Runs weld, vertex cache, overdraw and vertex fetch in that order.
+  // vertices may be reallocated and vertexCount shrinks to the vertices that
+  // are still referenced.
+  static void Optimize(void*& vertices, size_t& vertexCount, size_t vertexSize, size_t positionOffset, u32* indices, size_t indexCount, ModelMeshOptimizerStats* stats = nullptr);
+
+  // Merges vertices that are byte-for-byte identical and returns the new
+  // vertex count. Unique vertices are compacted to the front of the buffer.
+  static size_t WeldVertices(void* vertices, size_t vertexCount, size_t vertexSize, u32* indices, size_t indexCount);
+
+  // Orders triangles for the post-transform vertex cache using Tom Forsyth's
+  // linear-speed algorithm.
+  static void OptimizeVertexCache(u32* indices, size_t indexCount, size_t vertexCount);
+
+  // Splits a cache-optimized list into clusters that keep the cache order and
+  // sorts them so outward-facing clusters draw first, which lets early depth
+  // rejection discard more of what follows. threshold bounds how much ACMR
+  // may be traded for smaller clusters.
+  static void OptimizeOverdraw(u32* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset, f32 threshold = ModelMeshOptimizerOverdrawThreshold);
+
+  // Reorders vertices by first use in the index list, dropping unreferenced
+  // ones, and returns the new vertex count.
+  static size_t OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t vertexSize, u32* indices, size_t indexCount);
+
+  static f32 CalcACMR(const u32* indices, size_t indexCount, size_t vertexCount, size_t cacheSize = ModelMeshOptimizerACMRCacheSize);
+
+  // Returns a newly allocated copy of indices in the smallest format that can
+  // address vertexCount vertices. 16-bit indices are used whenever possible.
+  static void* CreatePackedIndices(const u32* indices, size_t indexCount, size_t vertexCount, IndexFormat& indexFormat);
+
+};
+
+};
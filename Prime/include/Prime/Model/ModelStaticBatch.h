@@ -0,0 +1,176 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Model/Model.h>
+#include <Prime/Graphics/ArrayBuffer.h>
+#include <Prime/Graphics/IndexBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Merged vertices use the same layout as static model meshes, so batches are
+// drawn with the regular model programs.
+typedef struct _ModelStaticBatchVertex {
+  f32 x, y, z;
+  f32 u, v;
+  f32 nx, ny, nz;
+} ModelStaticBatchVertex;
+
+// One mesh of a placement, with the transform from mesh space into batch
+// space. The content reference keeps the mesh data alive while a rebuild reads
+// it.
+typedef struct _ModelStaticBatchPart {
+  refptr<ModelContent> content;
+  const ModelContentMesh* mesh;
+  Mat44 transform;
+} ModelStaticBatchPart;
+
+// Merged buffers for every part drawn with one texture.
+typedef struct _ModelStaticBatchGroup {
+  refptr<Tex> tex;
+  Dictionary<size_t, std::vector<ModelStaticBatchPart>> parts;
+  ArrayBuffer* ab;
+  IndexBuffer* ib;
+  size_t vertexCount;
+  size_t indexCount;
+  Vec3 boundsMin;
+  Vec3 boundsMax;
+  bool modified;
+  bool building;
+} ModelStaticBatchGroup;
+
+// Input and output of a group rebuild job.
+typedef struct _ModelStaticBatchBuild {
+  std::vector<ModelStaticBatchPart> parts;
+  ModelStaticBatchVertex* vertices;
+  void* indices;
+  size_t vertexCount;
+  size_t indexCount;
+  IndexFormat indexFormat;
+  Vec3 boundsMin;
+  Vec3 boundsMax;
+} ModelStaticBatchBuild;
+
+typedef struct _ModelStaticBatchStats {
+  size_t placementCount;
+  size_t pendingPlacementCount;
+  size_t meshCount;
+  size_t skippedMeshCount;
+  size_t groupCount;
+  size_t vertexCount;
+  size_t indexCount;
+  size_t drawCount;
+  size_t rebuildCount;
+} ModelStaticBatchStats;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Merges the meshes of non-animated model placements into one vertex and
+// index buffer per texture, so a static scene is drawn with one draw per
+// texture instead of one per mesh. Placements are transformed into batch space
+// on job threads when their group is rebuilt, and a group keeps drawing its
+// previous buffers until the rebuild completes. Only groups touched by an add
+// or remove are rebuilt. Placements whose model content is not loaded yet are
+// merged once it is.
+class ModelStaticBatch: public RefObject {
+private:
+
+  typedef struct _Placement {
+    refptr<Model> model;
+    Mat44 transform;
+    std::vector<ModelStaticBatchGroup*> groups;
+    bool pending;
+  } Placement;
+
+  Dictionary<size_t, Placement> placements;
+  size_t nextPlacementId;
+  size_t pendingPlacementCount;
+
+  std::vector<ModelStaticBatchGroup*> groups;
+
+  ModelStaticBatchStats stats;
+
+public:
+
+  size_t GetPlacementCount() const {return placements.GetCount();}
+  size_t GetGroupCount() const {return groups.size();}
+
+public:
+
+  ModelStaticBatch();
+  ~ModelStaticBatch();
+
+public:
+
+  // Adds a placement of the model and returns an id for Remove. The model's
+  // textures, mesh transforms and scene are read when the placement is merged,
+  // so later changes to the model do not affect the batch.
+  virtual size_t Add(Model* model, const Mat44& transform);
+  virtual void Remove(size_t id);
+  virtual void Clear();
+
+  // Merges pending placements and starts rebuilds for modified groups. Called
+  // by Draw, but can be called earlier to start the work sooner.
+  virtual void Update();
+
+  // Draws each group with the current program and model matrix.
+  virtual void Draw();
+
+  // Returns false if no group has been built yet or the batch is empty.
+  virtual bool GetBounds(Vec3& boundsMin, Vec3& boundsMax) const;
+
+  const ModelStaticBatchStats& GetStats() const {return stats;}
+
+protected:
+
+  bool ResolvePlacement(size_t id, Placement& placement);
+  void ReleasePlacement(size_t id, Placement& placement);
+  ModelStaticBatchGroup* GetGroup(Tex* tex);
+  void StartRebuild(ModelStaticBatchGroup* group);
+  void FinishRebuild(ModelStaticBatchGroup* group, ModelStaticBatchBuild* build);
+  void UpdateStats();
+
+  static void BuildGroup(ModelStaticBatchBuild& build);
+
+};
+
+};
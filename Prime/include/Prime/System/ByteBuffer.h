@@ -0,0 +1,87 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Config.h>
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Immutable, reference-counted block of bytes. Unlike RefObject, references may
+// be added and released from any thread, so a buffer can be handed from a file
+// read to a decode job without copying.
+class ByteBuffer {
+private:
+
+  std::atomic<u32> _refCount;
+
+protected:
+
+  const void* data;
+  size_t size;
+  void* ownedData;
+  ByteBuffer* parent;
+
+public:
+
+  const void* GetData() const {return data;}
+  size_t GetSize() const {return size;}
+  u32 GetRefCount() const {return _refCount.load(std::memory_order_acquire);}
+
+public:
+
+  ByteBuffer(void* data, size_t size);
+  virtual ~ByteBuffer();
+
+protected:
+
+  ByteBuffer();
+
+public:
+
+  void IncRef();
+  void DecRef();
+
+public:
+
+  ByteBuffer* Slice(size_t offset, size_t size);
+
+public:
+
+  static ByteBuffer* Copy(const void* data, size_t size);
+
+};
+
+};
@@ -0,0 +1,94 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/System/ByteBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Enums
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef enum {
+  MappedFileAdviceNormal = 0,
+  MappedFileAdviceSequential,
+  MappedFileAdviceRandom,
+  MappedFileAdviceWillNeed,
+} MappedFileAdvice;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Read-only view of a file mapped into the address space. The view is handed
+// out as a ByteBuffer so decoders read the file pages directly instead of a
+// malloc'd copy. The mapping is released with the last reference.
+class MappedFile: public ByteBuffer {
+protected:
+
+  std::string path;
+  void* mapping;
+  size_t mappingSize;
+
+public:
+
+  const std::string& GetPath() const {return path;}
+  bool IsMapped() const {return mapping != nullptr;}
+
+public:
+
+  ~MappedFile();
+
+protected:
+
+  MappedFile();
+
+public:
+
+  void Advise(MappedFileAdvice advice, size_t offset = 0, size_t length = 0) const;
+
+public:
+
+  static MappedFile* Open(const std::string& path);
+
+protected:
+
+  bool Map(const std::string& path);
+  void Unmap();
+
+};
+
+};
@@ -32,6 +32,14 @@ SOFTWARE.
 
 #include <Prime/System/DataFile.h>
 #include <Prime/System/PrimePackFormatItem.h>
+#include <Prime/System/PrimePackFormatReader.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define PrimePackFormatHeaderBytes "\xE3PPF\x0D\x0A\x01"
+#define PrimePackFormatLatestVersion 3
 
 ////////////////////////////////////////////////////////////////////////////////
 // Enums
@@ -48,8 +56,28 @@ typedef enum {
   PrimePackFormatErrorInvalidFileSize,
   PrimePackFormatErrorContentNone,
   PrimePackFormatErrorChunkNotFoundInPNG,
+  PrimePackFormatErrorInvalidItem,
 } PrimePackFormatError;
 
+typedef enum {
+  PrimePackFormatCodecNone = 0,
+  PrimePackFormatCodecDeflate,
+  PrimePackFormatCodecMax = 16,
+} PrimePackFormatCodecType;
+
+typedef struct _PrimePackFormatCodec {
+  const char* name;
+  size_t (*bound)(size_t srcSize);
+  size_t (*encode)(const void* src, size_t srcSize, void* dest, size_t destCapacity);
+  bool (*decode)(const void* src, size_t srcSize, void* dest, size_t destSize);
+} PrimePackFormatCodec;
+
+typedef struct _PrimePackFormatStats {
+  uint64_t itemsOpened;
+  uint64_t bytesRead;
+  uint64_t bytesCopied;
+} PrimePackFormatStats;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,13 +90,13 @@ class PrimePackFormat {
 private:
 
   std::string contentPath;
-  BlockBuffer* ppfData;
+  refptr<ByteBuffer> packBuffer;
 
   void* loadChunk;
   size_t loadChunkSize;
 
   uint32_t version;
-  std::unordered_map<std::string, PrimePackFormatItem*> items;
+  std::vector<PrimePackFormatItem> items;
   std::unordered_map<std::string, BlockBuffer*> addedItems;
   std::unordered_map<std::string, std::string> metadata;
   PrimePackFormatError error;
@@ -92,6 +120,7 @@ public:
 public:
 
   void InitFromData(const void* data, size_t dataSize);
+  void InitFromBuffer(refptr<ByteBuffer> buffer);
   void SetLoadChunk(const void* chunk, size_t chunkSize);
   void SetContentPath(const std::string& contentPath);
 
@@ -101,13 +130,43 @@ public:
   void GetItemPaths(std::vector<std::string>& paths) const;
   BlockBuffer* GetItemData(const std::string& path, size_t blockSize = 0) const;
 
+  const PrimePackFormatItem* GetItem(const std::string& path) const;
+  uint64_t GetItemSize(const std::string& path) const;
+  bool GetItemSpan(const std::string& path, const void** data, size_t* dataSize) const;
+  PrimePackFormatReader* OpenItem(const std::string& path) const;
+  bool ReadItem(const std::string& path, void* dest, size_t destSize) const;
+  bool ReadItemRange(const std::string& path, uint64_t offset, void* dest, size_t size) const;
+  refptr<ByteBuffer> GetItemBuffer(const std::string& path) const;
+
   void AddItem(const std::string& path, void* data, size_t dataSize, bool replace = false);
   void AddItem(const std::string& path, const std::string& data, bool replace = false);
 
 private:
 
-  PrimePackFormatError ParseVersion1(DataFile& file);
-  PrimePackFormatError ParseVersion2(DataFile& file);
+  PrimePackFormatError ParseVersion1(DataFile& file, size_t dataSize);
+  PrimePackFormatError ParseVersion2(DataFile& file, size_t dataSize);
+  PrimePackFormatError ParseVersion3(DataFile& file, size_t dataSize);
+  void SortItems();
+  bool FindPackData(const void* data, size_t dataSize, size_t* packOffset, size_t* packSize);
+  bool GetItemInput(const PrimePackFormatItem& item, const void** input, size_t* inputSize) const;
+  bool ReadItemBlocks(const PrimePackFormatItem& item, uint64_t offset, void* dest, size_t size) const;
+
+public:
+
+  static uint64_t HashData(const void* data, size_t dataSize);
+
+  static void RegisterCodec(uint32_t type, const PrimePackFormatCodec& codec);
+  static const PrimePackFormatCodec* GetCodec(uint32_t type);
+  static bool DecodeBlock(uint32_t type, const void* src, size_t srcSize, void* dest, size_t destSize);
+
+  static void GetStats(PrimePackFormatStats& stats);
+  static void ResetStats();
+
+private:
+
+  static void CountBytes(uint64_t bytesRead, uint64_t bytesCopied);
+
+  friend class PrimePackFormatReader;
 
 };
 
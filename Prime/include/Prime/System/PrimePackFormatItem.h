@@ -32,6 +32,20 @@ SOFTWARE.
 
 #include <Prime/System/BlockBuffer.h>
 #include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+typedef struct _PrimePackFormatBlock {
+  uint64_t offset;
+  uint64_t size;
+} PrimePackFormatBlock;
+
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -47,13 +61,19 @@ public:
   uint64_t size;
   uint64_t dataSize;
   uint64_t offset;
+  uint64_t hash;
   uint32_t binaryFormat;
   uint32_t compression;
+  uint32_t blockSize;
+  std::vector<PrimePackFormatBlock> blocks;
+
+public:
+
+  size_t GetBlockDataSize(size_t index) const;
 
 public:
 
   PrimePackFormatItem();
-  ~PrimePackFormatItem();
 
 };
 
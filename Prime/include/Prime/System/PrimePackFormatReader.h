@@ -0,0 +1,92 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/System/ByteBuffer.h>
+#include <Prime/System/RefObject.h>
+#include <Prime/System/PrimePackFormatItem.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Sequential reader for a single pack item. Stored items are copied straight
+// from the pack bytes and compressed items are decoded directly into the
+// destination passed to Read. Block-compressed items only go through a
+// scratch block when a read ends partway into a block.
+class PrimePackFormatReader {
+private:
+
+  refptr<ByteBuffer> source;
+  const uint8_t* input;
+  size_t inputSize;
+  size_t inputOffset;
+  uint64_t size;
+  uint64_t position;
+  uint32_t compression;
+  void* stream;
+  bool finished;
+  bool failed;
+
+  std::vector<PrimePackFormatBlock> blocks;
+  uint32_t blockSize;
+  size_t blockIndex;
+  uint8_t* scratch;
+  size_t scratchOffset;
+  size_t scratchSize;
+
+public:
+
+  uint64_t GetSize() const {return size;}
+  uint64_t GetPosition() const {return position;}
+  bool IsDone() const {return finished || failed;}
+  bool HasFailed() const {return failed;}
+
+public:
+
+  PrimePackFormatReader(refptr<ByteBuffer> source, const void* input, size_t inputSize, uint64_t size, uint32_t compression);
+  PrimePackFormatReader(refptr<ByteBuffer> source, const PrimePackFormatItem& item);
+  ~PrimePackFormatReader();
+
+public:
+
+  size_t Read(void* dest, size_t destSize);
+  bool Skip(uint64_t count);
+
+private:
+
+  size_t ReadBlocks(uint8_t* out, size_t destSize);
+
+};
+
+};
@@ -0,0 +1,89 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/System/PrimePackFormat.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define PrimePackFormatDefaultBlockSize (256 * 1024)
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Builds packs in the latest format. Each item is split into blockSize chunks
+// that are compressed independently on the job workers, so readers can decode
+// one item in parallel or read a sub-range without the preceding bytes.
+class PrimePackFormatWriter {
+private:
+
+  typedef struct _Entry {
+    std::string path;
+    refptr<ByteBuffer> data;
+    uint32_t codec;
+  } Entry;
+
+  std::vector<Entry> entries;
+  std::unordered_map<std::string, size_t> entryIndices;
+  std::unordered_map<std::string, std::string> metadata;
+  uint32_t codec;
+  uint32_t blockSize;
+
+public:
+
+  uint32_t GetCodec() const {return codec;}
+  uint32_t GetBlockSize() const {return blockSize;}
+  size_t GetItemCount() const {return entries.size();}
+
+public:
+
+  PrimePackFormatWriter(uint32_t codec = PrimePackFormatCodecDeflate, uint32_t blockSize = PrimePackFormatDefaultBlockSize);
+  ~PrimePackFormatWriter();
+
+public:
+
+  void SetCodec(uint32_t codec);
+  void SetMetadata(const std::string& name, const std::string& value);
+
+  void AddItem(const std::string& path, const void* data, size_t dataSize);
+  void AddItem(const std::string& path, refptr<ByteBuffer> data);
+
+  ByteBuffer* Write() const;
+  bool Save(const std::string& path) const;
+
+};
+
+};
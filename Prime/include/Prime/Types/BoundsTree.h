@@ -0,0 +1,127 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Types/Frustum.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define BoundsTreeDefaultMargin 0.1f
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Free nodes are chained through parent and have a height of -1. Leaves have
+// a height of 0 and no children.
+typedef struct _BoundsTreeNode {
+  Vec3 boundsMin;
+  Vec3 boundsMax;
+  void* data;
+  size_t parent;
+  size_t child1;
+  size_t child2;
+  s32 height;
+} BoundsTreeNode;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// A dynamic bounding volume hierarchy for culling and overlap queries. Each
+// object is a leaf whose box is enlarged by the margin, so small moves do not
+// change the tree. Leaves are inserted next to the sibling that grows the
+// surface area least and the tree is kept balanced with rotations, so adds,
+// removes and moves are O(log n).
+class BoundsTree {
+private:
+
+  std::vector<BoundsTreeNode> nodes;
+  size_t root;
+  size_t freeList;
+  size_t leafCount;
+  f32 margin;
+
+public:
+
+  size_t GetCount() const {return leafCount;}
+  size_t GetNodeCount() const {return nodes.size();}
+  s32 GetHeight() const {return root != PrimeNotFound ? nodes[root].height : 0;}
+
+  f32 GetMargin() const {return margin;}
+  void SetMargin(f32 margin) {this->margin = margin;}
+
+  void* GetData(size_t id) const {PrimeAssert(id < nodes.size() && nodes[id].height == 0, "Invalid bounds tree id."); return nodes[id].data;}
+  const Vec3& GetBoundsMin(size_t id) const {PrimeAssert(id < nodes.size() && nodes[id].height == 0, "Invalid bounds tree id."); return nodes[id].boundsMin;}
+  const Vec3& GetBoundsMax(size_t id) const {PrimeAssert(id < nodes.size() && nodes[id].height == 0, "Invalid bounds tree id."); return nodes[id].boundsMax;}
+
+public:
+
+  BoundsTree(f32 margin = BoundsTreeDefaultMargin);
+  ~BoundsTree();
+
+public:
+
+  // Returns an id for Move and Remove. Ids are reused after Remove.
+  size_t Add(const Vec3& boundsMin, const Vec3& boundsMax, void* data);
+  void Remove(size_t id);
+  void Clear();
+
+  // Returns true if the object left its enlarged box and was reinserted.
+  bool Move(size_t id, const Vec3& boundsMin, const Vec3& boundsMax);
+
+  // Append the data of each object whose enlarged box is inside or crosses
+  // the frustum or overlaps the box, and return the number appended. Subtrees
+  // fully inside the frustum are appended without further tests.
+  size_t Cull(const Frustum& frustum, std::vector<void*>& results) const;
+  size_t Query(const Vec3& boundsMin, const Vec3& boundsMax, std::vector<void*>& results) const;
+
+protected:
+
+  size_t AllocateNode();
+  void FreeNode(size_t index);
+  void InsertLeaf(size_t leaf);
+  void RemoveLeaf(size_t leaf);
+  size_t Balance(size_t index);
+  void UpdateNode(size_t index);
+
+};
+
+};
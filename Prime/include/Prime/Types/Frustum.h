@@ -0,0 +1,124 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Types/Mat44.h>
+#include <Prime/Types/Vec4.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Enums
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+enum FrustumPlane {
+  FrustumPlaneLeft = 0,
+  FrustumPlaneRight,
+  FrustumPlaneBottom,
+  FrustumPlaneTop,
+  FrustumPlaneNear,
+  FrustumPlaneFar,
+  FrustumPlane_Count,
+};
+
+enum FrustumTest {
+  FrustumTestOutside = 0,
+  FrustumTestIntersect,
+  FrustumTestInside,
+};
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define FrustumPlaneMaskAll ((1 << FrustumPlane_Count) - 1)
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Boxes for TestAABBs, stored as centers and half extents in separate arrays
+// so they can be tested four at a time.
+typedef struct _FrustumBoundsList {
+  const f32* centerX;
+  const f32* centerY;
+  const f32* centerZ;
+  const f32* extentX;
+  const f32* extentY;
+  const f32* extentZ;
+  size_t count;
+} FrustumBoundsList;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// Six normalized planes facing into the frustum, extracted from a combined
+// projection * view matrix. Using projection * view * model instead gives the
+// frustum in model space, so model-space bounds can be tested directly.
+class Frustum {
+public:
+
+  Vec4 planes[FrustumPlane_Count];
+
+public:
+
+  Frustum();
+  explicit Frustum(const Mat44& mat);
+
+public:
+
+  void Load(const Mat44& mat);
+
+  bool TestPoint(const Vec3& point) const;
+  bool TestSphere(const Vec3& center, f32 radius) const;
+  bool TestAABB(const Vec3& boundsMin, const Vec3& boundsMax) const;
+
+  // Tests only the planes set in planeMask and clears the bits of planes the
+  // box is fully inside, so children of a box need not test those again.
+  FrustumTest ClassifyAABB(const Vec3& boundsMin, const Vec3& boundsMax, u32& planeMask) const;
+
+  // Writes 1 for each visible box and 0 otherwise, and returns the number of
+  // visible boxes. Uses SSE or NEON when available.
+  size_t TestAABBs(const FrustumBoundsList& bounds, u8* visible) const;
+
+};
+
+};
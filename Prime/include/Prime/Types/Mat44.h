@@ -260,6 +260,9 @@ public:
   Mat44& Rotate(f32 angle, f32 x = 0.0f, f32 y = 0.0f, f32 z = 1.0f);
   Mat44& Rotate(f32 angle, const Vec3& axis);
 
+  // Loads a * b without the identity checks done by Multiply, for callers
+  // that already know whether either side is the identity.
+  Mat44& LoadProduct(const Mat44& a, const Mat44& b);
   Mat44& Multiply(const Mat44& by);
   Mat44& MultiplyPre(const Mat44& by);
   Mat44& MultiplyOrtho(f32 x, f32 y, f32 w, f32 h, f32 nearZ, f32 farZ);
@@ -269,12 +272,25 @@ public:
   Vec2 Multiply(const Vec2& v, f32 z = 0.0f, f32 w = 1.0f) const;
   Vec3 Multiply(const Vec3& v, f32 w = 1.0f) const;
   Vec4 Multiply(const Vec4& v) const;
+  // Batch forms of the products above, with points taken to have w = 1 for
+  // Vec3. Results may be the same arrays as the inputs.
+  void MultiplyPoints(const Vec3* points, Vec3* results, size_t count) const;
+  void MultiplyPoints(const Vec4* points, Vec4* results, size_t count) const;
+  static void MultiplyPairs(const Mat44* a, const Mat44* b, Mat44* results, size_t count);
   void Multiply(s32 x, s32 y, s32& rx, s32& ry, s32& rz) const;
   void Multiply(s32 x, s32 y, s32& rx, s32& ry) const;
   void Multiply(f32 x, f32 y, f32& rx, f32& ry, f32& rz) const;
   void Multiply(f32 x, f32 y, f32& rx, f32& ry) const;
+  // Transforms an axis-aligned box and returns the axis-aligned box enclosing
+  // the result.
+  void MultiplyBounds(const Vec3& boundsMin, const Vec3& boundsMax, Vec3& resultMin, Vec3& resultMax) const;
 
   bool Invert();
+  // Faster inverses for matrices whose last row is 0 0 0 1. InvertRigid also
+  // requires the 3x3 part to be a pure rotation.
+  bool InvertAffine();
+  Mat44& InvertRigid();
+  bool IsAffine() const {return e41 == 0.0f && e42 == 0.0f && e43 == 0.0f && e44 == 1.0f;}
   Mat44& Transpose();
   Vec3 Reflect(const Vec3& incident, const Vec3& normal) const;
   Quat GetQuat() const;
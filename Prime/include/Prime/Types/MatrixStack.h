@@ -0,0 +1,83 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Types/TypeStack.h>
+#include <Prime/Types/Mat44.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Prime {
+
+// A Mat44 stack with a version that changes whenever its top matrix does, so
+// products of several stacks can be cached. The matrix is edited in place
+// through Mat44, so a change is found by comparing against the matrix seen by
+// the previous GetVersion rather than by hooking every mutator. Mat44 itself
+// stays a plain 16 floats, since arrays of it are uploaded as uniform data.
+class MatrixStack: public TypeStack<Mat44> {
+private:
+
+  Mat44 versionMat;
+  u64 version;
+  bool versionIdentity;
+
+public:
+
+  // Whether the matrix was the identity as of the last GetVersion.
+  bool IsVersionIdentity() const {return versionIdentity;}
+
+public:
+
+  MatrixStack(): TypeStack<Mat44>(),
+  version(0),
+  versionIdentity(false) {
+
+  }
+
+public:
+
+  using TypeStack<Mat44>::operator=;
+
+  u64 GetVersion() {
+    if(version == 0 || memcmp(versionMat.e, e, sizeof(e)) != 0) {
+      versionMat = *this;
+      versionIdentity = IsIdentity();
+      version++;
+    }
+
+    return version;
+  }
+
+};
+
+};
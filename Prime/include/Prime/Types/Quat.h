@@ -69,6 +69,9 @@ public:
   Quat& ConvertFromEulerAnglesDeg(const Vec3& euler);
 
   Quat Interpolate(const Quat& other, f32 t) const;
+  // Single precision interpolation that uses a normalized lerp for close
+  // rotations and only falls back to slerp for large angles.
+  Quat InterpolateFast(const Quat& other, f32 t) const;
 
   Vec3 GetEulerAngles() const;
   Vec3 GetEulerAnglesDeg() const;
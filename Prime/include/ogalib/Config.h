@@ -41,3 +41,43 @@ SOFTWARE.
 #ifndef OGALIB_JOB_CALLBACK_WORKER_THREAD_PRIORITY
 #define OGALIB_JOB_CALLBACK_WORKER_THREAD_PRIORITY (-1.0f)
 #endif
+
+#ifndef OGALIB_JOB_WORKER_SPIN_COUNT
+#define OGALIB_JOB_WORKER_SPIN_COUNT 64
+#endif
+
+#ifndef OGALIB_JOB_DEQUE_INITIAL_CAPACITY
+#define OGALIB_JOB_DEQUE_INITIAL_CAPACITY 1024
+#endif
+
+#ifndef OGALIB_JOB_CALLBACK_INLINE_SIZE
+#define OGALIB_JOB_CALLBACK_INLINE_SIZE 128
+#endif
+
+#ifndef OGALIB_JOB_RESULT_COUNT
+#define OGALIB_JOB_RESULT_COUNT 4
+#endif
+
+#ifndef OGALIB_JOB_POOL_CAPACITY
+#define OGALIB_JOB_POOL_CAPACITY 1024
+#endif
+
+#ifndef OGALIB_PROFILER
+#if defined(_DEBUG)
+#define OGALIB_PROFILER 1
+#else
+#define OGALIB_PROFILER 0
+#endif
+#endif
+
+#ifndef OGALIB_PROFILER_THREAD_EVENT_CAPACITY
+#define OGALIB_PROFILER_THREAD_EVENT_CAPACITY 16384
+#endif
+
+#ifndef OGALIB_PROFILER_FRAME_HISTORY
+#define OGALIB_PROFILER_FRAME_HISTORY 512
+#endif
+
+#ifndef OGALIB_PROFILER_CAPTURE_EVENT_CAPACITY
+#define OGALIB_PROFILER_CAPTURE_EVENT_CAPACITY (1024 * 1024)
+#endif
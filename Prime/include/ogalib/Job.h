@@ -32,6 +32,17 @@ SOFTWARE.
 
 #include <ogalib/Thread.h>
 #include <functional>
+#include <atomic>
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <string.h>
+
+#ifdef new
+#pragma push_macro("new")
+#undef new
+#define OGALIB_JOB_RESTORE_NEW
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -45,6 +56,131 @@ enum class JobType {
   Express = 2,
 };
 
+typedef struct _JobStats {
+  uint64_t submitted;
+  uint64_t started;
+  uint64_t stolen;
+  uint64_t expressStarted;
+  double latencyP50;
+  double latencyP99;
+  double latencyMax;
+  uint64_t allocations;
+  uint64_t recycled;
+} JobStats;
+
+class Job;
+class JobGraph;
+
+// Type-erased job callback with inline storage. Callables that fit within
+// OGALIB_JOB_CALLBACK_INLINE_SIZE bytes are stored without allocating; larger
+// ones fall back to the heap and are counted in JobStats::allocations.
+class JobCallback {
+private:
+
+  typedef struct _Ops {
+    void (*invoke)(void* storage, Job& job);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void* storage);
+  } Ops;
+
+  template<typename F>
+  class InlineOps {
+  public:
+
+    static void Invoke(void* storage, Job& job) {(*static_cast<F*>(storage))(job);}
+    static void Move(void* dst, void* src) {new(dst) F(std::move(*static_cast<F*>(src))); static_cast<F*>(src)->~F();}
+    static void Destroy(void* storage) {static_cast<F*>(storage)->~F();}
+
+    static constexpr Ops ops = {Invoke, Move, Destroy};
+
+  };
+
+  template<typename F>
+  class HeapOps {
+  public:
+
+    static void Invoke(void* storage, Job& job) {(**static_cast<F**>(storage))(job);}
+    static void Move(void* dst, void* src) {*static_cast<F**>(dst) = *static_cast<F**>(src);}
+    static void Destroy(void* storage) {delete *static_cast<F**>(storage);}
+
+    static constexpr Ops ops = {Invoke, Move, Destroy};
+
+  };
+
+  alignas(std::max_align_t) unsigned char storage[OGALIB_JOB_CALLBACK_INLINE_SIZE];
+  const Ops* ops;
+
+public:
+
+  JobCallback(): ops(nullptr) {}
+  JobCallback(std::nullptr_t): ops(nullptr) {}
+  JobCallback(const JobCallback& other) = delete;
+
+  JobCallback(JobCallback&& other): ops(other.ops) {
+    if(ops) {
+      ops->move(storage, other.storage);
+      other.ops = nullptr;
+    }
+  }
+
+  template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, JobCallback>::value>>
+  JobCallback(F&& f): ops(nullptr) {
+    typedef std::decay_t<F> Callable;
+
+    if constexpr(std::is_constructible<bool, const Callable&>::value) {
+      if(!static_cast<bool>(f))
+        return;
+    }
+
+    if constexpr(sizeof(Callable) <= OGALIB_JOB_CALLBACK_INLINE_SIZE && alignof(Callable) <= alignof(std::max_align_t)) {
+      new(storage) Callable(std::forward<F>(f));
+      ops = &InlineOps<Callable>::ops;
+    }
+    else {
+      *reinterpret_cast<Callable**>(storage) = new Callable(std::forward<F>(f));
+      ops = &HeapOps<Callable>::ops;
+      OnHeapAllocation();
+    }
+  }
+
+  ~JobCallback() {
+    Reset();
+  }
+
+public:
+
+  JobCallback& operator=(const JobCallback& other) = delete;
+
+  JobCallback& operator=(JobCallback&& other) {
+    if(this != &other) {
+      Reset();
+      ops = other.ops;
+      if(ops) {
+        ops->move(storage, other.storage);
+        other.ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  explicit operator bool() const {return ops != nullptr;}
+  void operator()(Job& job) {ops->invoke(storage, job);}
+
+  void Reset() {
+    if(ops) {
+      ops->destroy(storage);
+      ops = nullptr;
+    }
+  }
+
+private:
+
+  static void OnHeapAllocation();
+
+};
+
+void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
 class Job {
 friend void Init(const json& params);
 friend void WaitForNoJobs();
@@ -52,14 +188,26 @@ friend void Shutdown();
 friend void Process();
 friend void* JobThread(void*);
 friend void* JobWorkerThread(void*);
+friend class JobQueue;
+friend class JobWorker;
+friend class JobGraph;
+friend void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
 private:
 
-  std::function<void(Job&)> callback;
-  std::function<void(Job&)> response;
+  JobCallback callback;
+  JobCallback response;
   ogalib::Thread* thread;
-  bool completed;
+  std::atomic<bool> completed;
   bool canceled;
   JobType type;
+  Job* queueNext;
+  uint64_t queueTime;
+  JobGraph* graph;
+  std::atomic<int32_t> dependencyCount;
+  std::vector<Job*> successors;
+  bool detached;
+  bool pooled;
+  uint64_t results[OGALIB_JOB_RESULT_COUNT];
 
 public:
 
@@ -69,13 +217,16 @@ public:
 
 public:
 
-  Job(std::function<void(Job&)> callback, std::function<void(Job&)> response, JobType type);
-  Job(std::function<void(Job&)> callback, std::function<void(Job&)> response, const json& data = json(), JobType type = JobType::Default);
+  Job(JobCallback callback, JobCallback response, JobType type);
+  Job(JobCallback callback, JobCallback response, const json& data = json(), JobType type = JobType::Default);
   ~Job();
 
 private:
 
+  Job(JobType type, JobGraph* graph, JobCallback callback);
+
   void InitCommon();
+  void Submit();
 
 public:
 
@@ -83,8 +234,40 @@ public:
   void Cancel();
   void Shutdown();
 
+  // Typed result slots for passing small values (pointers, sizes, flags) from
+  // the callback to the response without boxing them in data.
+  template<typename T>
+  void SetResult(size_t index, T value) {
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(uint64_t), "Job results must be trivially copyable and at most 8 bytes.");
+    ogalibAssert(index < OGALIB_JOB_RESULT_COUNT, "Job result index out of range: %d", (int) index);
+    memcpy(&results[index], &value, sizeof(T));
+  }
+
+  template<typename T>
+  T GetResult(size_t index) const {
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(uint64_t), "Job results must be trivially copyable and at most 8 bytes.");
+    ogalibAssert(index < OGALIB_JOB_RESULT_COUNT, "Job result index out of range: %d", (int) index);
+    T value;
+    memcpy(&value, &results[index], sizeof(T));
+    return value;
+  }
+
+public:
+
+  // Same as new Job(...), but reuses a recycled Job when one is available. Jobs
+  // whose data is left empty are returned to the pool after their response, so
+  // steady-state submission does not allocate.
+  static Job* Create(JobCallback callback, JobCallback response, JobType type = JobType::Default);
+  static Job* Create(JobCallback callback, JobCallback response, const json& data, JobType type = JobType::Default);
+
+  static void GetStats(JobStats& stats);
+  static void ResetStats();
+
 private:
 
+  static Job* Acquire();
+  static void Release(Job* job);
+
   static void InitGlobal();
   static void ShutdownGlobal();
   static void ProcessGlobal();
@@ -95,4 +278,100 @@ private:
 
 };
 
+// A set of jobs with dependencies between them. Jobs run on the workers as soon
+// as all of their predecessors have finished, and only the graph's response is
+// handed back to the main thread. Like Job, a started graph deletes itself
+// (and its jobs) after the response is called.
+class JobGraph {
+friend class Job;
+friend class JobWorker;
+private:
+
+  std::vector<Job*> jobs;
+  std::atomic<size_t> remaining;
+  std::atomic<bool> canceled;
+  std::function<void(JobGraph&)> response;
+  bool started;
+
+public:
+
+  json data;
+  std::string error;
+
+public:
+
+  JobGraph();
+  ~JobGraph();
+
+public:
+
+  Job* Add(JobCallback callback, JobType type = JobType::Default);
+  Job* Add(JobCallback callback, std::initializer_list<Job*> predecessors, JobType type = JobType::Default);
+  Job* Then(Job* predecessor, JobCallback callback, JobType type = JobType::Default);
+  void AddDependency(Job* job, Job* predecessor);
+
+  void Start(std::function<void(JobGraph&)> response = nullptr);
+  void Cancel();
+
+  size_t GetJobCount() const {return jobs.size();}
+  bool IsCanceled() const {return canceled;}
+
+private:
+
+  void OnJobCompleted(Job* job);
+  void Release();
+
 };
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+// Splits [begin, end) into chunks of about grain items and runs fn(chunkBegin,
+// chunkEnd) on the job workers, with the calling thread also taking chunks.
+// Returns once every chunk has run. A grain of 0 picks a chunk size from the
+// worker count.
+void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+// Returns the chunk size ParallelFor uses for a grain of 0.
+size_t GetParallelGrain(size_t count);
+
+// Like ParallelFor, but map(chunkBegin, chunkEnd) returns a partial result per
+// chunk and the partials are folded with combine in range order, so the result
+// does not depend on scheduling.
+template<typename T, typename Map, typename Combine>
+T ParallelReduce(size_t begin, size_t end, size_t grain, const T& identity, Map map, Combine combine) {
+  if(end <= begin)
+    return identity;
+
+  if(grain == 0) {
+    grain = GetParallelGrain(end - begin);
+  }
+
+  // Each partial is its own object so chunks never write to a shared word, as
+  // they would through std::vector<bool>.
+  typedef struct {
+    T value;
+  } Partial;
+
+  size_t chunkCount = (end - begin + grain - 1) / grain;
+  std::vector<Partial> partials(chunkCount, Partial {identity});
+
+  ParallelFor(begin, end, grain, [&](size_t chunkBegin, size_t chunkEnd) {
+    partials[(chunkBegin - begin) / grain].value = map(chunkBegin, chunkEnd);
+  });
+
+  T result = identity;
+  for(const auto& partial: partials) {
+    result = combine(result, partial.value);
+  }
+
+  return result;
+}
+
+};
+
+#ifdef OGALIB_JOB_RESTORE_NEW
+#pragma pop_macro("new")
+#undef OGALIB_JOB_RESTORE_NEW
+#endif
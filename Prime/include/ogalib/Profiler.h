@@ -0,0 +1,165 @@
+/*
+ogalib
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ogalib/Thread.h>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+// Scope and counter names must be string literals (or otherwise outlive the
+// profiler); events store the pointer, not a copy.
+#if OGALIB_PROFILER
+#define ogalibProfileConcat2(a, b) a##b
+#define ogalibProfileConcat(a, b) ogalibProfileConcat2(a, b)
+#define ogalibProfileScope(name) ogalib::ProfileScope ogalibProfileConcat(ogalibProfileScope, __LINE__)(name)
+#define ogalibProfileCounter(name, value) ogalib::Profiler::AddCounter(name, (double) (value))
+#define ogalibProfileThread(name) ogalib::Profiler::SetThreadName(name)
+#define ogalibProfileFrame() ogalib::Profiler::Frame()
+#else
+#define ogalibProfileScope(name) ((void)0)
+#define ogalibProfileCounter(name, value) ((void)0)
+#define ogalibProfileThread(name) ((void)0)
+#define ogalibProfileFrame() ((void)0)
+#endif
+
+#if OGALIB_PROFILER
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace ogalib {
+
+class json;
+
+// Times are in seconds. Per-scope times are summed over every thread, so a
+// scope that runs on several job workers at once can exceed the frame time.
+typedef struct _ProfileScopeStats {
+  const char* name;
+  bool gpu;
+  uint64_t frameCalls;
+  double frameTime;
+  double averageTime;
+  double maxTime;
+  uint64_t totalCalls;
+  double totalTime;
+} ProfileScopeStats;
+
+typedef struct _ProfileCounterStats {
+  const char* name;
+  double value;
+} ProfileCounterStats;
+
+typedef struct _ProfileStats {
+  uint64_t frameCount;
+  double frameTime;
+  double frameP50;
+  double frameP95;
+  double frameP99;
+  double frameMax;
+  uint64_t eventsDropped;
+  std::vector<ProfileScopeStats> scopes;
+  std::vector<ProfileCounterStats> counters;
+} ProfileStats;
+
+// Low-overhead CPU instrumentation. Each thread records completed scopes into
+// its own single-producer ring; the main thread drains every ring once per
+// frame in Frame(), so recording never takes a lock. Only compiled in when
+// OGALIB_PROFILER is non-zero (debug builds by default).
+class Profiler {
+friend void Init(const json& params);
+friend void Shutdown();
+friend class ProfileScope;
+public:
+
+  // Marks the start of a new frame on the main thread and folds every event
+  // recorded since the previous call into the stats.
+  static void Frame();
+
+  static void AddCounter(const char* name, double value);
+
+  // Adds a GPU timing read back by the graphics device. start and end are on
+  // the GetTime() clock, so the GPU track lines up with the CPU scopes.
+  static void AddGPUScope(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+  static void SetThreadName(const char* name);
+
+  static void GetStats(ProfileStats& stats);
+  static std::string GetStatsSummary(size_t maxScopes = 16);
+  static void ResetStats();
+
+  // Keeps every drained event from StartCapture() until StopCapture() (up to
+  // OGALIB_PROFILER_CAPTURE_EVENT_CAPACITY) for export as a Chrome trace that
+  // can be opened in chrome://tracing or Perfetto.
+  static void StartCapture();
+  static void StopCapture();
+  static bool IsCapturing();
+  static bool WriteChromeTrace(const std::string& path);
+
+  static uint64_t GetTime();
+
+private:
+
+  static void Record(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+  static uint32_t EnterScope();
+
+  static void InitGlobal();
+  static void ShutdownGlobal();
+
+};
+
+class ProfileScope {
+private:
+
+  const char* name;
+  uint64_t start;
+  uint32_t depth;
+
+public:
+
+  ProfileScope(const char* name): name(name), depth(Profiler::EnterScope()) {
+    start = Profiler::GetTime();
+  }
+
+  ~ProfileScope() {
+    Profiler::Record(name, start, Profiler::GetTime(), depth);
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+};
+
+};
+
+#endif
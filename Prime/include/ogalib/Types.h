@@ -46,7 +46,7 @@ SOFTWARE.
 #define ogalib_dbgprintf printf
 #define ogalibAssert(b, f, ...) {if(!(b)) {ogalib::AssertCore(__FILE__, __LINE__, f, ##__VA_ARGS__);}} ((void)0)
 #else
-#define ogalib_dbgprintf ((void)0)
+#define ogalib_dbgprintf(f, ...) ((void)0)
 #define ogalibAssert(b, f, ...) ((void)0)
 #endif
 
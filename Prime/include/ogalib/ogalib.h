@@ -31,6 +31,7 @@ SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <ogalib/Job.h>
+#include <ogalib/Profiler.h>
 #include <functional>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -330,8 +330,9 @@ void Asset::Load(size_t id) {
                               IncLoading();
                               SendURL(itURL.GetString(), [=](const json& response) {
                                 if(auto it = response.find("data")) {
-                                  std::string data = it.GetString();
-                                  modelTex->AddTexData(name, data, itemCopy);
+                                  size_t dataSize;
+                                  const void* data = it.GetStringData(&dataSize);
+                                  modelTex->AddTexData(name, ByteBuffer::Copy(data, dataSize), itemCopy);
                                 }
 
                                 DecLoading();
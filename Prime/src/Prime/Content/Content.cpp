@@ -48,6 +48,13 @@ bool Content::Load(const void* data, size_t dataSize, const json& info) {
   return true;
 }
 
+bool Content::Load(refptr<ByteBuffer> buffer, const json& info) {
+  if(!buffer)
+    return false;
+
+  return Load(buffer->GetData(), buffer->GetSize(), info);
+}
+
 void Content::GetWalkReferences(Stack<std::string>& paths) const {
 
 }
@@ -38,6 +38,10 @@ SOFTWARE.
 #include <Prime/Graphics/ps4/PS4Graphics.h>
 #elif defined(PrimeTargetPS5)
 #include <Prime/Graphics/ps5/PS5Graphics.h>
+#elif defined(PrimeTargetNull)
+#include <Prime/Graphics/null/NullGraphics.h>
+#include <Prime/Input/null/NullKeyboard.h>
+#include <Prime/Input/null/NullTouch.h>
 #endif
 
 using namespace Prime;
@@ -83,6 +87,10 @@ running(false) {
   PxPS4Graphics;
 #elif defined(PrimeTargetPS5)
   PxPS5Graphics;
+#elif defined(PrimeTargetNull)
+  PxNullGraphics;
+  PxNullKeyboard;
+  PxNullTouch;
 #endif
 
   InitContent();
@@ -117,13 +125,22 @@ void Engine::Stop() {
 }
 
 f32 Engine::StartFrame() {
+  ogalibProfileFrame();
+
   f64 frameTime = GetSystemTime();
   f32 dt = (f32) (frameTime - lastFrameTime);
   lastFrameTime = frameTime;
 
-  ogalib::Process();
+  {
+    ogalibProfileScope("ogalib::Process");
+    ogalib::Process();
+  }
+
+  {
+    ogalibProfileScope("Graphics::StartFrame");
+    PxGraphics.StartFrame();
+  }
 
-  PxGraphics.StartFrame();
   PxKeyboard.StartFrame();
   PxTouch.StartFrame();
 
@@ -133,9 +150,16 @@ f32 Engine::StartFrame() {
 void Engine::EndFrame() {
   PxTouch.EndFrame();
   PxKeyboard.EndFrame();
-  PxGraphics.EndFrame();
-  
-  ProcessContentRefs();
+
+  {
+    ogalibProfileScope("Graphics::EndFrame");
+    PxGraphics.EndFrame();
+  }
+
+  {
+    ogalibProfileScope("ProcessContentRefs");
+    ProcessContentRefs();
+  }
 
   currentFrame++;
 }
@@ -300,39 +300,38 @@ FontContent::~FontContent() {
 }
 
 bool FontContent::Load(const void* data, size_t dataSize, const json& info) {
-  bool copyFontData = true;
-
   if(data == nullptr || dataSize == 0) {
-    bool available;
+    refptr<ByteBuffer> buffer;
 
     mutex->Lock();
-
-    size_t fontDataSize = fontData.size();
-    if(fontDataSize > 0) {
-      data = fontData.c_str();
-      dataSize = fontDataSize;
-      copyFontData = false;
-      available = true;
-    }
-    else {
-      available = false;
-    }
-
+    buffer = fontBuffer;
     mutex->Unlock();
 
-    if(!available) {
+    if(!buffer)
       return false;
-    }
+
+    return LoadSheet(buffer, info);
   }
 
-  if(copyFontData) {
-    mutex->Lock();
+  return Load(ByteBuffer::Copy(data, dataSize), info);
+}
 
-    fontData.clear();
-    fontData.append((const char*) data, dataSize);
+bool FontContent::Load(refptr<ByteBuffer> buffer, const json& info) {
+  if(!buffer)
+    return false;
 
-    mutex->Unlock();
-  }
+  // Keep a reference to the font file rather than a copy; sheets are rebuilt
+  // from it later when the font is resized.
+  mutex->Lock();
+  fontBuffer = buffer;
+  mutex->Unlock();
+
+  return LoadSheet(buffer, info);
+}
+
+bool FontContent::LoadSheet(refptr<ByteBuffer> buffer, const json& info) {
+  const void* data = buffer->GetData();
+  size_t dataSize = buffer->GetSize();
 
   FontContentSheet* newSheet = new FontContentSheet();
   if(!newSheet)
@@ -631,7 +630,7 @@ bool FontContent::Load(const void* data, size_t dataSize, const json& info) {
   texture_font_delete(font);
   texture_atlas_delete(atlas);
 
-  new Job(nullptr, [=](Job& job) {
+  Job::Create(nullptr, [=](Job& job) {
     newSheet->tex = Tex::Create();
     if(newSheet->tex) {
       newSheet->tex->AddTexData("", "", {
@@ -733,7 +732,7 @@ void FontContent::CheckReload() {
     loadingCount++;
 
     IncRef();
-    new Job([=](Job& job) {
+    Job::Create([=](Job& job) {
       Load(nullptr, 0, json());
     }, [=](Job& job) {
       if(loadingCount > 0) {
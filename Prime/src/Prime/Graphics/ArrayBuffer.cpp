@@ -61,6 +61,14 @@ void ArrayBuffer::LoadAttribute(const std::string& name, size_t size) {
   attributeLookup[name] = index;
 }
 
+void ArrayBuffer::LoadAttribute(const std::string& name, ArrayBufferAttributeType type, size_t componentCount) {
+  ArrayBufferAttribute attribute(name, GetAttributeTypeSize(type) * componentCount, 0, type, componentCount);
+  size_t index = attributes.GetCount();
+  attributes.Push(attribute);
+
+  attributeLookup[name] = index;
+}
+
 const std::string& ArrayBuffer::GetAttributeName(size_t index) const {
   static const std::string noName;
 
@@ -112,3 +120,23 @@ void ArrayBuffer::SetSyncCount(size_t count) {
 void ArrayBuffer::Sync() {
   PrimeAssert(false, "Unimplemented sync function for ArrayBuffer.");
 }
+
+size_t ArrayBuffer::GetAttributeTypeSize(ArrayBufferAttributeType type) {
+  switch(type) {
+  case ArrayBufferAttributeTypeF32:
+    return sizeof(f32);
+  case ArrayBufferAttributeTypeS16Norm:
+    return sizeof(s16);
+  case ArrayBufferAttributeTypeU16Norm:
+    return sizeof(u16);
+  case ArrayBufferAttributeTypeU8Norm:
+    return sizeof(u8);
+  case ArrayBufferAttributeTypeU16Int:
+    return sizeof(u16);
+  case ArrayBufferAttributeTypeU8Int:
+    return sizeof(u8);
+  default:
+    PrimeAssert(false, "Invalid array buffer attribute type.");
+    return 0;
+  }
+}
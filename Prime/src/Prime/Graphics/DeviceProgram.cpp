@@ -32,13 +32,86 @@ SOFTWARE.
 
 #include <Prime/Graphics/DeviceShader.h>
 #include <Prime/Graphics/Graphics.h>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
 
 using namespace Prime;
 
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+// Names are kept in a deque so references returned by GetName stay valid as
+// the table grows. Id 0 is reserved for the invalid handle.
+typedef struct _ProgramVariableNameTable {
+  std::shared_mutex mutex;
+  Dictionary<std::string, u32> ids;
+  std::deque<std::string> names;
+
+  _ProgramVariableNameTable() {
+    names.emplace_back();
+  }
+} ProgramVariableNameTable;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static ProgramVariableNameTable& GetProgramVariableNameTable();
+
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
 
+ProgramVariableHandle::ProgramVariableHandle(const std::string& name):
+id(0) {
+  ProgramVariableNameTable& table = GetProgramVariableNameTable();
+
+  {
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    if(auto it = table.ids.Find(name)) {
+      id = it.value();
+      return;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(table.mutex);
+  if(auto it = table.ids.Find(name)) {
+    id = it.value();
+  }
+  else {
+    id = (u32) table.names.size();
+    table.names.push_back(name);
+    table.ids[name] = id;
+  }
+}
+
+const std::string& ProgramVariableHandle::GetName() const {
+  ProgramVariableNameTable& table = GetProgramVariableNameTable();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+  PrimeAssert(id < table.names.size(), "Invalid program variable handle: %u", id);
+  return table.names[id];
+}
+
+ProgramVariableHandle ProgramVariableHandle::Find(const std::string& name) {
+  ProgramVariableNameTable& table = GetProgramVariableNameTable();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+  ProgramVariableHandle handle;
+  if(auto it = table.ids.Find(name)) {
+    handle.id = it.value();
+  }
+
+  return handle;
+}
+
+size_t ProgramVariableHandle::GetCount() {
+  ProgramVariableNameTable& table = GetProgramVariableNameTable();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+  return table.names.size();
+}
+
 DeviceProgram::DeviceProgram(const void* vertexShaderData, size_t vertexShaderDataSize, const void* fragmentShaderData, size_t fragmentShaderDataSize):
 vertexShader(nullptr),
 fragmentShader(nullptr),
@@ -161,7 +234,7 @@ bool DeviceProgram::UnloadFromVRAM() {
   bool vertexShaderUnloaded = vertexShader->UnloadFromVRAM();
   bool fragmentShaderUnloaded = fragmentShader->UnloadFromVRAM();
 
-  loadedIntoVRAM = vertexShaderUnloaded && fragmentShaderUnloaded;
+  loadedIntoVRAM = !(vertexShaderUnloaded && fragmentShaderUnloaded);
 
   return !loadedIntoVRAM;
 }
@@ -237,78 +310,151 @@ void DeviceProgram::CheckVariableStatus() {
 }
 
 void DeviceProgram::SetVariable(const std::string& name, s32 v) {
-  variables[name] = v;
+  SetVariable(ProgramVariableHandle(name), v);
 }
 
 void DeviceProgram::SetVariable(const std::string& name, f32 v) {
-  variables[name] = v;
+  SetVariable(ProgramVariableHandle(name), v);
 }
 
 void DeviceProgram::SetVariable(const std::string& name, const Vec2& v) {
-  variables[name] = v;
+  SetVariable(ProgramVariableHandle(name), v);
 }
 
 void DeviceProgram::SetVariable(const std::string& name, const Vec3& v) {
-  variables[name] = v;
+  SetVariable(ProgramVariableHandle(name), v);
 }
 
 void DeviceProgram::SetVariable(const std::string& name, const Vec4& v) {
-  variables[name] = v;
+  SetVariable(ProgramVariableHandle(name), v);
 }
 
 void DeviceProgram::SetVariable(const std::string& name, const Mat44& mat) {
-  variables[name] = mat;
+  SetVariable(ProgramVariableHandle(name), mat);
 }
 
 void DeviceProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, s32 v) {
-  variables[GraphicsDictionaryKey(name, arrayIndex)] = v;
+  SetArrayVariable(ProgramVariableHandle(name), arrayIndex, v);
 }
 
 void DeviceProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, f32 v) {
-  variables[GraphicsDictionaryKey(name, arrayIndex)] = v;
+  SetArrayVariable(ProgramVariableHandle(name), arrayIndex, v);
 }
 
 void DeviceProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec2& v) {
-  variables[GraphicsDictionaryKey(name, arrayIndex)] = v;
+  SetArrayVariable(ProgramVariableHandle(name), arrayIndex, v);
 }
 
 void DeviceProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec3& v) {
-  variables[GraphicsDictionaryKey(name, arrayIndex)] = v;
+  SetArrayVariable(ProgramVariableHandle(name), arrayIndex, v);
 }
 
 void DeviceProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec4& v) {
-  variables[GraphicsDictionaryKey(name, arrayIndex)] = v;
+  SetArrayVariable(ProgramVariableHandle(name), arrayIndex, v);
 }
 
 void DeviceProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Mat44& mat) {
-  variables[GraphicsDictionaryKey(name, arrayIndex)] = mat;
+  SetArrayVariable(ProgramVariableHandle(name), arrayIndex, mat);
 }
 
 void DeviceProgram::SetArrayVariable1fv(const std::string& name, const f32* v, size_t count, size_t start) {
+  SetArrayVariable1fv(ProgramVariableHandle(name), v, count, start);
+}
+
+void DeviceProgram::SetArrayVariable2fv(const std::string& name, const f32* v, size_t count, size_t start) {
+  SetArrayVariable2fv(ProgramVariableHandle(name), v, count, start);
+}
+
+void DeviceProgram::SetArrayVariable3fv(const std::string& name, const f32* v, size_t count, size_t start) {
+  SetArrayVariable3fv(ProgramVariableHandle(name), v, count, start);
+}
+
+void DeviceProgram::SetArrayVariable4fv(const std::string& name, const f32* v, size_t count, size_t start) {
+  SetArrayVariable4fv(ProgramVariableHandle(name), v, count, start);
+}
+
+void DeviceProgram::SetArrayVariableMat44fv(const std::string& name, const f32* v, size_t count, size_t start) {
+  SetArrayVariableMat44fv(ProgramVariableHandle(name), v, count, start);
+}
+
+void DeviceProgram::SetVariable(ProgramVariableHandle handle, s32 v) {
+  variables[handle.GetName()] = v;
+}
+
+void DeviceProgram::SetVariable(ProgramVariableHandle handle, f32 v) {
+  variables[handle.GetName()] = v;
+}
+
+void DeviceProgram::SetVariable(ProgramVariableHandle handle, const Vec2& v) {
+  variables[handle.GetName()] = v;
+}
+
+void DeviceProgram::SetVariable(ProgramVariableHandle handle, const Vec3& v) {
+  variables[handle.GetName()] = v;
+}
+
+void DeviceProgram::SetVariable(ProgramVariableHandle handle, const Vec4& v) {
+  variables[handle.GetName()] = v;
+}
+
+void DeviceProgram::SetVariable(ProgramVariableHandle handle, const Mat44& mat) {
+  variables[handle.GetName()] = mat;
+}
+
+void DeviceProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, s32 v) {
+  variables[GraphicsDictionaryKey(handle.GetName(), arrayIndex)] = v;
+}
+
+void DeviceProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, f32 v) {
+  variables[GraphicsDictionaryKey(handle.GetName(), arrayIndex)] = v;
+}
+
+void DeviceProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec2& v) {
+  variables[GraphicsDictionaryKey(handle.GetName(), arrayIndex)] = v;
+}
+
+void DeviceProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec3& v) {
+  variables[GraphicsDictionaryKey(handle.GetName(), arrayIndex)] = v;
+}
+
+void DeviceProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec4& v) {
+  variables[GraphicsDictionaryKey(handle.GetName(), arrayIndex)] = v;
+}
+
+void DeviceProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Mat44& mat) {
+  variables[GraphicsDictionaryKey(handle.GetName(), arrayIndex)] = mat;
+}
+
+void DeviceProgram::SetArrayVariable1fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
+  const std::string& name = handle.GetName();
   for(size_t i = 0; i < count; i++) {
     variables[GraphicsDictionaryKey(name, start + i)] = v[i];
   }
 }
 
-void DeviceProgram::SetArrayVariable2fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void DeviceProgram::SetArrayVariable2fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
+  const std::string& name = handle.GetName();
   for(size_t i = 0; i < count; i++) {
     variables[GraphicsDictionaryKey(name, start + i)] = Vec2(v[i * 2], v[i * 2 + 1]);
   }
 }
 
-void DeviceProgram::SetArrayVariable3fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void DeviceProgram::SetArrayVariable3fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
+  const std::string& name = handle.GetName();
   for(size_t i = 0; i < count; i++) {
     variables[GraphicsDictionaryKey(name, start + i)] = Vec3(v[i * 3], v[i * 3 + 1], v[i * 3 + 2]);
   }
 }
 
-void DeviceProgram::SetArrayVariable4fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void DeviceProgram::SetArrayVariable4fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
+  const std::string& name = handle.GetName();
   for(size_t i = 0; i < count; i++) {
     variables[GraphicsDictionaryKey(name, start + i)] = Vec4(v[i * 4], v[i * 4 + 1], v[i * 4 + 2], v[i * 4 + 3]);
   }
 }
 
-void DeviceProgram::SetArrayVariableMat44fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void DeviceProgram::SetArrayVariableMat44fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
+  const std::string& name = handle.GetName();
   for(size_t i = 0; i < count; i++) {
     const f32* p = &v[16 * i];
     variables[GraphicsDictionaryKey(name, start + i)] = Mat44(p);
@@ -318,3 +464,30 @@ void DeviceProgram::SetArrayVariableMat44fv(const std::string& name, const f32*
 void DeviceProgram::LoadVariablesToShaderStage() {
 
 }
+
+void DeviceProgram::SetVariant(const std::string& name, DeviceProgram* program) {
+  if(program) {
+    variants[name] = program;
+  }
+  else {
+    variants.Remove(name);
+  }
+}
+
+DeviceProgram* DeviceProgram::GetVariant(const std::string& name) const {
+  if(auto it = variants.Find(name))
+    return it.value();
+  else
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static ProgramVariableNameTable& GetProgramVariableNameTable() {
+  // Handles are often built during static initialization, so the table has
+  // to exist before the first of them regardless of translation unit order.
+  static ProgramVariableNameTable table;
+  return table;
+}
@@ -68,7 +68,8 @@ Graphics& Graphics::GetInstance() {
 Graphics::Graphics():
 maxTexW(0),
 maxTexH(0),
-maxTexUnits(0) {
+maxTexUnits(0),
+cullingEnabled(true) {
 
 }
 
@@ -264,3 +265,107 @@ void Graphics::Draw(ArrayBuffer* ab, IndexBuffer* ib, TexChannelTuple const* tup
 void Graphics::Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, TexChannelTuple const* texList, size_t texCount) {
 
 }
+
+void Graphics::DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, ArrayBuffer* instances, size_t instanceCount, Tex* tex) {
+  if(tex) {
+    TexChannelTuple tuple(tex);
+    DrawInstanced(ab, ib, 0, ib->GetSyncCount(), instances, instanceCount, &tuple, 1);
+  }
+  else {
+    DrawInstanced(ab, ib, 0, ib->GetSyncCount(), instances, instanceCount, (TexChannelTuple*) nullptr, 0);
+  }
+}
+
+void Graphics::DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) {
+  DrawInstanced(ab, ib, 0, ib->GetSyncCount(), instances, instanceCount, tupleList, tupleCount);
+}
+
+void Graphics::DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) {
+
+}
+
+void Graphics::SetRenderQueueEnabled(bool enabled) {
+
+}
+
+bool Graphics::IsRenderQueueEnabled() const {
+  return false;
+}
+
+void Graphics::Submit(const GraphicsSubmit& submit) {
+  PxRequireMainThread;
+
+  DeviceProgram* submitProgram = submit.program;
+  if(!submitProgram)
+    return;
+
+  for(size_t i = 0; i < submit.variableCount; i++) {
+    const GraphicsSubmitVariable& variable = submit.variables[i];
+    switch(variable.itemSize) {
+    case 1:
+      submitProgram->SetArrayVariable1fv(variable.handle, variable.data, variable.count);
+      break;
+    case 2:
+      submitProgram->SetArrayVariable2fv(variable.handle, variable.data, variable.count);
+      break;
+    case 3:
+      submitProgram->SetArrayVariable3fv(variable.handle, variable.data, variable.count);
+      break;
+    case 4:
+      submitProgram->SetArrayVariable4fv(variable.handle, variable.data, variable.count);
+      break;
+    case 16:
+      submitProgram->SetArrayVariableMat44fv(variable.handle, variable.data, variable.count);
+      break;
+    default:
+      PrimeAssert(false, "Unsupported submit variable item size: %zu", variable.itemSize);
+      break;
+    }
+  }
+
+  program.Push() = submitProgram;
+  model.Push() = submit.model;
+
+  if(submit.instances) {
+    DrawInstanced(submit.ab, submit.ib, submit.start, submit.count, submit.instances, submit.instanceCount, submit.tupleList, submit.tupleCount);
+  }
+  else {
+    Draw(submit.ab, submit.ib, submit.start, submit.count, submit.tupleList, submit.tupleCount);
+  }
+
+  model.Pop();
+  program.Pop();
+}
+
+void Graphics::SetCullingEnabled(bool enabled) {
+  cullingEnabled = enabled;
+}
+
+bool Graphics::IsCullingEnabled() const {
+  return cullingEnabled;
+}
+
+void Graphics::GetFrustum(Frustum& frustum) const {
+  frustum.Load(projection * view);
+}
+
+bool Graphics::IsGPUTimingSupported() const {
+  return false;
+}
+
+void Graphics::StartGPUTimer(const char* name) {
+
+}
+
+void Graphics::EndGPUTimer() {
+
+}
+
+const std::vector<GraphicsGPUTime>& Graphics::GetGPUTimes() const {
+  static const std::vector<GraphicsGPUTime> empty;
+  return empty;
+}
+
+void Graphics::GetFrameStats(GraphicsFrameStats& stats) const {
+  memset(&stats, 0, sizeof(stats));
+}
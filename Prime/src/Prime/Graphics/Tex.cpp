@@ -316,11 +316,18 @@ void Tex::AddTexData(const std::string& name, const std::string& data) {
 }
 
 void Tex::AddTexData(const std::string& name, const std::string& data, const json& info) {
+  AddTexData(name, ByteBuffer::Copy(data.c_str(), data.size()), info);
+}
+
+void Tex::AddTexData(const std::string& name, refptr<ByteBuffer> buffer, const json& info) {
   PxRequireMainThread;
 
+  if(!buffer)
+    return;
+
   IncRef();
 
-  new Job([=](Job& job) {
+  Job::Create([=](Job& job) {
     std::string format;
     if(auto itFormat = info.find("format")) {
       format = itFormat.GetString();
@@ -375,7 +382,7 @@ void Tex::AddTexData(const std::string& name, const std::string& data, const jso
                 else {
                   texData->pixels = new BlockBuffer(blockSize);
                   if(texData->pixels) {
-                    texData->pixels->Append(data.c_str(), data.size());
+                    texData->pixels->Append(buffer->GetData(), buffer->GetSize());
                   }
                 }
 
@@ -387,7 +394,7 @@ void Tex::AddTexData(const std::string& name, const std::string& data, const jso
                   texData->tw = texData->w;
                   texData->th = texData->h;
 
-                  job.data["texData"] = texData;
+                  job.SetResult(0, texData);
                 }
               }
             }
@@ -486,7 +493,7 @@ void Tex::AddTexData(const std::string& name, const std::string& data, const jso
                 else {
                   texData->pixels = new BlockBuffer(blockSize);
                   if(texData->pixels) {
-                    texData->pixels->Append(data.c_str(), data.size());
+                    texData->pixels->Append(buffer->GetData(), buffer->GetSize());
                   }
                 }
 
@@ -500,7 +507,7 @@ void Tex::AddTexData(const std::string& name, const std::string& data, const jso
                   texData->tw = texData->w;
                   texData->th = texData->h;
 
-                  job.data["texData"] = texData;
+                  job.SetResult(0, texData);
                 }
               }
             }
@@ -509,44 +516,45 @@ void Tex::AddTexData(const std::string& name, const std::string& data, const jso
       }
     }
     else {
-      if(IsFormatPNG(data.c_str(), data.size(), info)) {
+      const void* data = buffer->GetData();
+      size_t dataSize = buffer->GetSize();
+
+      if(IsFormatPNG(data, dataSize, info)) {
         TexData* texData = new TexData();
-        if(texData && LoadPixelsFromPNG(data.c_str(), data.size(), *texData)) {
-          job.data["texData"] = texData;
+        if(texData && LoadPixelsFromPNG(data, dataSize, *texData)) {
+          job.SetResult(0, texData);
         }
       }
-      else if(IsFormatJPEG(data.c_str(), data.size(), info)) {
+      else if(IsFormatJPEG(data, dataSize, info)) {
         TexData* texData = new TexData();
-        if(texData && LoadPixelsFromJPEG(data.c_str(), data.size(), *texData)) {
-          job.data["texData"] = texData;
+        if(texData && LoadPixelsFromJPEG(data, dataSize, *texData)) {
+          job.SetResult(0, texData);
         }
       }
     }
   }, [=](Job& job) {
-    if(auto it = job.data.find("texData")) {
-      TexData* tempTexData = it.GetPtr<TexData>();
-      if(tempTexData) {
-        TexData* texData;
-        
-        if(auto it = texDataLookup.Find(name)) {
-          texData = it.value();
-        }
-        else {
-          texData = new TexData();
-          if(texData) {
-            texDataLookup[name] = texData;
-          }
-        }
+    TexData* tempTexData = job.GetResult<TexData*>(0);
+    if(tempTexData) {
+      TexData* texData;
 
+      if(auto it = texDataLookup.Find(name)) {
+        texData = it.value();
+      }
+      else {
+        texData = new TexData();
         if(texData) {
-          texData->TakePixels(*tempTexData);
-          CacheInfo();
-          UnloadFromVRAM();
-          LoadIntoVRAM();
+          texDataLookup[name] = texData;
         }
+      }
 
-        PrimeSafeDelete(tempTexData);
+      if(texData) {
+        texData->TakePixels(*tempTexData);
+        CacheInfo();
+        UnloadFromVRAM();
+        LoadIntoVRAM();
       }
+
+      PrimeSafeDelete(tempTexData);
     }
 
     DecRef();
@@ -0,0 +1,257 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetNull)
+
+#include <Prime/Graphics/null/NullGraphics.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Engine.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define NullGraphicsMaxTexSize 16384
+#define NullGraphicsMaxTexUnits 32
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+NullGraphics& NullGraphics::GetInstance() {
+  PxRequireInit;
+
+  if(instance) {
+    PrimeAssert(dynamic_cast<NullGraphics*>(instance), "Graphics instance is not a NullGraphics instance.");
+    return *static_cast<NullGraphics*>(instance);
+  }
+
+  NullGraphics* inst = new NullGraphics();
+  PrimeAssert(inst, "Could not create NullGraphics instance.");
+  instance = inst;
+  inst->Init();
+  return *static_cast<NullGraphics*>(instance);
+}
+
+NullGraphics::NullGraphics():
+screenW(0.0f),
+screenH(0.0f),
+screenShown(false) {
+  memset(&frameStats, 0, sizeof(frameStats));
+  memset(&lastFrameStats, 0, sizeof(lastFrameStats));
+  memset(&totalStats, 0, sizeof(totalStats));
+}
+
+NullGraphics::~NullGraphics() {
+
+}
+
+void NullGraphics::Init() {
+  Graphics::Init();
+
+  maxTexW = NullGraphicsMaxTexSize;
+  maxTexH = NullGraphicsMaxTexSize;
+  maxTexUnits = NullGraphicsMaxTexUnits;
+}
+
+void NullGraphics::Shutdown() {
+  Graphics::Shutdown();
+}
+
+void NullGraphics::ShowScreen(const GraphicsScreenConfig* config) {
+  if(screenShown)
+    return;
+
+  static const GraphicsScreenConfig DefaultConfig = {
+    "Prime Engine Game",
+    1600,
+    900,
+    true,
+    1,
+  };
+
+  const GraphicsScreenConfig* useConfig = config;
+  if(!config) {
+    useConfig = &DefaultConfig;
+  }
+
+  screenW = (f32) useConfig->w;
+  screenH = (f32) useConfig->h;
+  screenShown = true;
+}
+
+f32 NullGraphics::GetScreenW() const {
+  return screenW;
+}
+
+f32 NullGraphics::GetScreenH() const {
+  return screenH;
+}
+
+void NullGraphics::StartFrame() {
+  viewport.Push() = Viewport(0.0f, 0.0f, screenW, screenH);
+
+  lastFrameStats = frameStats;
+  memset(&frameStats, 0, sizeof(frameStats));
+
+  ogalibProfileCounter("Graphics draws", lastFrameStats.drawCount);
+  ogalibProfileCounter("Graphics triangles", lastFrameStats.triangleCount);
+  ogalibProfileCounter("Graphics texture bytes", lastFrameStats.texUploadBytes);
+
+  Graphics::StartFrame();
+}
+
+void NullGraphics::EndFrame() {
+  Graphics::EndFrame();
+
+  viewport.Pop();
+}
+
+void NullGraphics::ClearScreen() {
+  frameStats.clearCount++;
+  totalStats.clearCount++;
+}
+
+void NullGraphics::ClearColor() {
+  frameStats.clearCount++;
+  totalStats.clearCount++;
+}
+
+void NullGraphics::ClearDepth() {
+  frameStats.clearCount++;
+  totalStats.clearCount++;
+}
+
+void NullGraphics::Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, TexChannelTuple const* tupleList, size_t tupleCount) {
+  AddDraw(ab, ib, count, nullptr, 0, tupleList, tupleCount);
+}
+
+void NullGraphics::DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) {
+  if(!instances || instanceCount == 0)
+    return;
+
+  AddDraw(ab, ib, count, instances, instanceCount, tupleList, tupleCount);
+}
+
+void NullGraphics::GetFrameStats(GraphicsFrameStats& stats) const {
+  stats.drawCount = lastFrameStats.drawCount;
+  stats.instanceCount = lastFrameStats.instanceCount;
+  stats.triangleCount = lastFrameStats.triangleCount;
+  stats.uniformBytesUploaded = 0;
+  stats.uniformOverflowCount = 0;
+  stats.texBytesUploaded = lastFrameStats.texUploadBytes;
+  stats.gpuFrameTime = 0.0;
+}
+
+void NullGraphics::AddArrayBufferUpload(size_t bytes) {
+  frameStats.arrayBufferUploadCount++;
+  frameStats.arrayBufferUploadBytes += bytes;
+  totalStats.arrayBufferUploadCount++;
+  totalStats.arrayBufferUploadBytes += bytes;
+}
+
+void NullGraphics::AddIndexBufferUpload(size_t bytes) {
+  frameStats.indexBufferUploadCount++;
+  frameStats.indexBufferUploadBytes += bytes;
+  totalStats.indexBufferUploadCount++;
+  totalStats.indexBufferUploadBytes += bytes;
+}
+
+void NullGraphics::AddTexUpload(size_t bytes) {
+  frameStats.texUploadCount++;
+  frameStats.texUploadBytes += bytes;
+  totalStats.texUploadCount++;
+  totalStats.texUploadBytes += bytes;
+}
+
+void NullGraphics::AddProgramLoad() {
+  frameStats.programLoadCount++;
+  totalStats.programLoadCount++;
+}
+
+void NullGraphics::AddDraw(ArrayBuffer* ab, IndexBuffer* ib, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) {
+  ogalibProfileScope("Graphics::Draw");
+
+  if(!program || !ab || !ib || count == 0)
+    return;
+
+  // Resources are loaded and synced at draw time the same way the GPU
+  // backends do it, so upload counts match what a real frame would send.
+  DeviceProgram* drawProgram = program;
+  if(!drawProgram->IsLoadedIntoVRAM())
+    drawProgram->LoadIntoVRAM();
+
+  if(ab->IsDataModified())
+    ab->Sync();
+  if(!ab->IsLoadedIntoVRAM())
+    ab->LoadIntoVRAM();
+
+  if(ib->IsDataModified())
+    ib->Sync();
+  if(!ib->IsLoadedIntoVRAM())
+    ib->LoadIntoVRAM();
+
+  if(instances) {
+    if(instances->IsDataModified())
+      instances->Sync();
+    if(!instances->IsLoadedIntoVRAM())
+      instances->LoadIntoVRAM();
+  }
+
+  for(size_t i = 0; i < tupleCount; i++) {
+    Tex* tex = tupleList[i].tex;
+    if(tex && !tex->IsLoadedIntoVRAM()) {
+      tex->LoadIntoVRAM();
+    }
+  }
+
+  drawProgram->LoadVariablesToShaderStage();
+
+  size_t triangleCount = GetBufferPrimitiveTriangleCount(ab->GetPrimitive(), count) * (instances ? instanceCount : 1);
+
+  frameStats.drawCount++;
+  frameStats.indexCount += count;
+  frameStats.triangleCount += triangleCount;
+  totalStats.drawCount++;
+  totalStats.indexCount += count;
+  totalStats.triangleCount += triangleCount;
+
+  if(instances) {
+    frameStats.instancedDrawCount++;
+    frameStats.instanceCount += instanceCount;
+    totalStats.instancedDrawCount++;
+    totalStats.instanceCount += instanceCount;
+  }
+}
+
+#endif
@@ -0,0 +1,178 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetNull)
+
+#include <Prime/Graphics/null/NullIndexBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/null/NullGraphics.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////
+
+static const size_t IndexBufferDataSizeTable[] = {
+  0,
+  sizeof(u8),
+  sizeof(u16),
+  sizeof(u32),
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+NullIndexBuffer::NullIndexBuffer(IndexFormat format, const void* data, size_t indexCount): IndexBuffer(format, data, indexCount) {
+  dataSize = indexCount * IndexBufferDataSizeTable[format];
+
+  this->data = malloc(dataSize);
+  PrimeAssert(this->data, "Could not create data.");
+  if(data) {
+    memcpy(this->data, data, dataSize);
+  }
+  else {
+    memset(this->data, 0, dataSize);
+  }
+}
+
+NullIndexBuffer::~NullIndexBuffer() {
+  UnloadFromVRAM();
+  PrimeSafeFree(data);
+}
+
+bool NullIndexBuffer::LoadIntoVRAM() {
+  if(loadedIntoVRAM)
+    return true;
+
+  PxNullGraphics.AddIndexBufferUpload(IndexBufferDataSizeTable[format] * syncCount);
+
+  dataModified = false;
+  loadedIntoVRAM = true;
+
+  return true;
+}
+
+bool NullIndexBuffer::UnloadFromVRAM() {
+  loadedIntoVRAM = false;
+  return true;
+}
+
+size_t NullIndexBuffer::GetIndexSize() const {
+  return IndexBufferDataSizeTable[format];
+}
+
+size_t NullIndexBuffer::GetValue(size_t index) const {
+  if(indexCount == 0)
+    return 0;
+
+  size_t useIndex = (index < indexCount) ? index : (index % indexCount);
+  if(format == IndexFormatSize8) {
+    return static_cast<u8*>(data)[useIndex];
+  }
+  else if(format == IndexFormatSize16) {
+    return static_cast<u16*>(data)[useIndex];
+  }
+  else if(format == IndexFormatSize32) {
+    return static_cast<u32*>(data)[useIndex];
+  }
+  else {
+    PrimeAssert(false, "Invalid index format.");
+    return 0;
+  }
+}
+
+void NullIndexBuffer::SetValue(size_t index, size_t value) {
+  if(indexCount == 0)
+    return;
+
+  size_t useIndex = (index < indexCount) ? index : (index % indexCount);
+  if(format == IndexFormatSize8) {
+    static_cast<u8*>(data)[useIndex] = (u8) (value & 0xFF);
+    dataModified = true;
+  }
+  else if(format == IndexFormatSize16) {
+    static_cast<u16*>(data)[useIndex] = (u16) (value & 0xFFFF);
+    dataModified = true;
+  }
+  else if(format == IndexFormatSize32) {
+    static_cast<u32*>(data)[useIndex] = (u32) value;
+    dataModified = true;
+  }
+  else {
+    PrimeAssert(false, "Invalid index format.");
+  }
+}
+
+void NullIndexBuffer::SetValues(size_t start, size_t count, const void* data) {
+  if(indexCount == 0 || count == 0)
+    return;
+
+  size_t useStart = (start < indexCount) ? start : (start % indexCount);
+  size_t useCount = (useStart + count > indexCount) ? (indexCount - useStart) : count;
+  if(useCount > 0) {
+    u8* data8 = static_cast<u8*>(this->data);
+    const size_t itemSize = IndexBufferDataSizeTable[format];
+    memcpy(&data8[useStart * itemSize], data, itemSize * useCount);
+    dataModified = true;
+  }
+}
+
+void NullIndexBuffer::CopyValueBlock(size_t index, size_t fromIndex, size_t count) {
+  if(indexCount == 0 || count == 0)
+    return;
+
+  // Copies run forward one index at a time like the GPU backends, so an
+  // overlapping block repeats its source pattern.
+  const size_t itemSize = IndexBufferDataSizeTable[format];
+  u8* d = static_cast<u8*>(data) + index * itemSize;
+  u8* s = static_cast<u8*>(data) + fromIndex * itemSize;
+  u8* e = d + count * itemSize;
+  while(d != e) {
+    memcpy(d, s, itemSize);
+    d += itemSize;
+    s += itemSize;
+  }
+
+  dataModified = true;
+}
+
+void NullIndexBuffer::Sync() {
+  if(!loadedIntoVRAM)
+    return;
+
+  PxNullGraphics.AddIndexBufferUpload(IndexBufferDataSizeTable[format] * syncCount);
+
+  dataModified = false;
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetNull)
+
+#include <Prime/Graphics/null/NullProgram.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/null/NullGraphics.h>
+#include <Prime/Graphics/DeviceShader.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+NullProgram::NullProgram(const void* vertexShaderData, size_t vertexShaderDataSize, const void* fragmentShaderData, size_t fragmentShaderDataSize): DeviceProgram(vertexShaderData, vertexShaderDataSize, fragmentShaderData, fragmentShaderDataSize) {
+
+}
+
+NullProgram::NullProgram(DeviceShader* vertexShader, DeviceShader* fragmentShader): DeviceProgram(vertexShader, fragmentShader) {
+
+}
+
+NullProgram::NullProgram(const char* vertexShaderPath, const char* fragmentShaderPath): DeviceProgram(vertexShaderPath, fragmentShaderPath) {
+
+}
+
+NullProgram::~NullProgram() {
+  UnloadFromVRAM();
+}
+
+bool NullProgram::LoadIntoVRAM() {
+  PxRequireMainThread;
+
+  if(loadedIntoVRAM)
+    return true;
+
+  // Programs created from paths have no shaders until both files are read.
+  if(!vertexShader || !fragmentShader)
+    return false;
+
+  if(!DeviceProgram::LoadIntoVRAM())
+    return false;
+
+  PxNullGraphics.AddProgramLoad();
+
+  return true;
+}
+
+bool NullProgram::UnloadFromVRAM() {
+  PxRequireMainThread;
+
+  if(!loadedIntoVRAM)
+    return true;
+
+  return DeviceProgram::UnloadFromVRAM();
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetNull)
+
+#include <Prime/Graphics/null/NullTex.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/null/NullGraphics.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+NullTex::NullTex(u32 w, u32 h, TexFormat format, const void* pixels, const json& options): Tex(w, h, format, pixels, options) {
+
+}
+
+NullTex::NullTex(u32 w, u32 h, TexFormat format, const json& options): NullTex(w, h, format, nullptr, options) {
+
+}
+
+NullTex::NullTex(u32 w, u32 h, TexFormat format, const void* pixels): NullTex(w, h, format, pixels, json()) {
+
+}
+
+NullTex::NullTex(): Tex() {
+
+}
+
+NullTex::NullTex(const std::string& name, const std::string& data): Tex(name, data) {
+
+}
+
+NullTex::~NullTex() {
+  UnloadFromVRAM();
+}
+
+bool NullTex::LoadIntoVRAM() {
+  if(loadedIntoVRAM)
+    return true;
+
+  NullGraphics& g = PxNullGraphics;
+
+  if(renderBufferTexFormat) {
+    if(renderBufferTW > g.GetMaxTexW() || renderBufferTH > g.GetMaxTexH()) {
+      PrimeAssert(false, "Texture size is too large.");
+      return false;
+    }
+
+    loadedIntoVRAM = true;
+    return true;
+  }
+
+  // Count the same mip chain the GPU backends upload: levels sorted by size,
+  // stopping at the first level that is not half the previous one.
+  size_t bytes = 0;
+
+  Stack<TexDataLevelSortItem> levels;
+  GetTexDataAsLevels(levels);
+
+  TexData* prevTexData = nullptr;
+  for(const auto& item: levels) {
+    TexData* texData = item.texData;
+
+    if(prevTexData && (prevTexData->tw >> 1) != texData->tw) {
+      break;
+    }
+
+    if(texData->pixels) {
+      bytes += texData->pixels->GetSize();
+      loadedLevelCount++;
+    }
+
+    prevTexData = texData;
+  }
+
+  g.AddTexUpload(bytes);
+
+  loadedIntoVRAM = true;
+
+  return true;
+}
+
+bool NullTex::UnloadFromVRAM() {
+  loadedIntoVRAM = false;
+  return Tex::UnloadFromVRAM();
+}
+
+#endif
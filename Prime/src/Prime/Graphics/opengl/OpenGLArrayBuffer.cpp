@@ -34,15 +34,36 @@ SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <Prime/Graphics/opengl/OpenGLInc.h>
+#include <Prime/Graphics/opengl/OpenGLProgram.h>
 
 using namespace Prime;
 
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static u64 serialCounter = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////
+
+static const GLenum OpenGLArrayBufferAttributeTypeTable[] = {
+  GL_FLOAT,
+  GL_SHORT,
+  GL_UNSIGNED_SHORT,
+  GL_UNSIGNED_BYTE,
+  GL_UNSIGNED_SHORT,
+  GL_UNSIGNED_BYTE,
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
 
 OpenGLArrayBuffer::OpenGLArrayBuffer(size_t itemSize, const void* data, size_t itemCount, BufferPrimitive primitive): ArrayBuffer(itemSize, data, itemCount, primitive),
-aboId(GL_NONE) {
+aboId(GL_NONE),
+serial(0) {
   PrimeAssert(itemSize > 0, "Invalid array buffer item size.");
   PrimeAssert(itemCount > 0, "Invalid array buffer item count.");
 
@@ -84,6 +105,10 @@ bool OpenGLArrayBuffer::LoadIntoVRAM() {
 
   GLCMD(glBindBuffer(GL_ARRAY_BUFFER, id));
 
+  // GL buffer names are reused after deletion, so vertex arrays that refer to
+  // this buffer as their instance source key on the serial instead.
+  serial = ++serialCounter;
+
   dataModified = false;
   loadedIntoVRAM = true;
 
@@ -94,6 +119,8 @@ bool OpenGLArrayBuffer::UnloadFromVRAM() {
   if(!loadedIntoVRAM)
     return true;
 
+  ReleaseVertexArrays();
+
   if(aboId) {
     GLCMD(glDeleteBuffers(1, &aboId));
   }
@@ -145,4 +172,130 @@ void OpenGLArrayBuffer::Sync() {
   dataModified = false;
 }
 
+OpenGLArrayBufferVertexArray* OpenGLArrayBuffer::GetVertexArray(const OpenGLProgram& program, const OpenGLIndexBuffer* indices, OpenGLArrayBuffer* instances, bool& created) {
+  created = false;
+
+  if(!loadedIntoVRAM)
+    return nullptr;
+
+  if(instances && !instances->IsLoadedIntoVRAM())
+    return nullptr;
+
+  u64 programLayoutId = program.GetLayoutId();
+  u64 instanceSerial = instances ? instances->GetSerial() : 0;
+  for(auto& vertexArray: vertexArrays) {
+    if(vertexArray.programLayoutId == programLayoutId && vertexArray.instanceSerial == instanceSerial)
+      return &vertexArray;
+  }
+
+  // Programs that have been relinked or deleted leave stale entries behind, so
+  // drop the oldest once the cache is full.
+  if(vertexArrays.size() >= OpenGLArrayBufferVertexArrayMaxCount) {
+    GLCMD(glDeleteVertexArrays(1, &vertexArrays.front().vaoId));
+    vertexArrays.erase(vertexArrays.begin());
+  }
+
+  OpenGLArrayBufferVertexArray vertexArray;
+  vertexArray.programLayoutId = programLayoutId;
+  vertexArray.instanceSerial = instanceSerial;
+  vertexArray.indexSerial = indices ? indices->GetSerial() : 0;
+  vertexArray.vaoId = GL_NONE;
+  vertexArray.attributeCallCount = 0;
+
+  GLCMD(glGenVertexArrays(1, &vertexArray.vaoId));
+  GLCMD(glBindVertexArray(vertexArray.vaoId));
+  GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices ? indices->GetIBOId() : GL_NONE));
+
+  bool instancesBound = false;
+
+  size_t attributeCount = program.GetAttributeCount();
+  for(size_t i = 0; i < attributeCount; i++) {
+    const OpenGLProgramAttributeInfo* info = program.GetAttributeInfo(i);
+    if(info && info->loc >= 0) {
+      if(const ArrayBufferAttribute* attribute = GetAttribute(info->name)) {
+        vertexArray.attributeCallCount += LoadVertexAttribute(*info, *attribute, (GLsizei) itemSize, 0);
+      }
+    }
+  }
+
+  if(instances && __PrimeOpenGLVertexAttribDivisor) {
+    for(size_t i = 0; i < attributeCount; i++) {
+      const OpenGLProgramAttributeInfo* info = program.GetAttributeInfo(i);
+      if(info && info->loc >= 0 && !GetAttribute(info->name)) {
+        if(const ArrayBufferAttribute* attribute = instances->GetAttribute(info->name)) {
+          if(!instancesBound) {
+            GLCMD(glBindBuffer(GL_ARRAY_BUFFER, instances->GetABOId()));
+            instancesBound = true;
+          }
+
+          vertexArray.attributeCallCount += LoadVertexAttribute(*info, *attribute, (GLsizei) instances->GetItemSize(), 1);
+        }
+      }
+    }
+
+    if(instancesBound) {
+      GLCMD(glBindBuffer(GL_ARRAY_BUFFER, aboId));
+    }
+  }
+
+  created = true;
+  vertexArrays.push_back(vertexArray);
+
+  return &vertexArrays.back();
+}
+
+void OpenGLArrayBuffer::ReleaseVertexArrays() {
+  for(auto& vertexArray: vertexArrays) {
+    GLCMD(glDeleteVertexArrays(1, &vertexArray.vaoId));
+  }
+
+  vertexArrays.clear();
+}
+
+size_t OpenGLArrayBuffer::LoadVertexAttribute(const OpenGLProgramAttributeInfo& info, const ArrayBufferAttribute& attribute, GLsizei stride, GLuint divisor) {
+  size_t offset = attribute.GetOffset();
+  ArrayBufferAttributeType type = attribute.GetType();
+  size_t callCount = 0;
+
+  if(type != ArrayBufferAttributeTypeF32) {
+    GLuint loc = (GLuint) info.loc;
+    GLenum typeGL = OpenGLArrayBufferAttributeTypeTable[type];
+    GLint componentCount = (GLint) attribute.GetComponentCount();
+
+    GLCMD(glEnableVertexAttribArray(loc));
+    if(type == ArrayBufferAttributeTypeU16Int || type == ArrayBufferAttributeTypeU8Int) {
+      GLCMD(glVertexAttribIPointer(loc, componentCount, typeGL, stride, (const GLvoid*) offset));
+    }
+    else {
+      GLCMD(glVertexAttribPointer(loc, componentCount, typeGL, GL_TRUE, stride, (const GLvoid*) offset));
+    }
+    callCount += 2;
+
+    if(divisor) {
+      GLCMD(__PrimeOpenGLVertexAttribDivisor(loc, divisor));
+      callCount++;
+    }
+
+    return callCount;
+  }
+
+  // Matrix attributes take one location per column.
+  size_t columnSize = info.size > sizeof(f32) * 4 ? sizeof(f32) * 4 : info.size;
+  size_t columnCount = columnSize > 0 ? info.size / columnSize : 0;
+
+  for(size_t i = 0; i < columnCount; i++) {
+    GLuint loc = (GLuint) info.loc + (GLuint) i;
+    GLCMD(glEnableVertexAttribArray(loc));
+    GLCMD(glVertexAttribPointer(loc, (GLint) (columnSize / sizeof(f32)), GL_FLOAT, GL_FALSE, stride, (const GLvoid*) (offset + columnSize * i)));
+    callCount += 2;
+
+    if(divisor) {
+      GLCMD(__PrimeOpenGLVertexAttribDivisor(loc, divisor));
+      callCount++;
+    }
+  }
+
+  return callCount;
+}
+
 #endif
@@ -0,0 +1,249 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetOpenGL)
+
+#include <Prime/Graphics/opengl/OpenGLGPUTimer.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+
+#define OpenGLGPUTimerQueryGrowCount 32
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+OpenGLGPUTimer::OpenGLGPUTimer():
+queryCounter(nullptr),
+getQueryObjectui64v(nullptr),
+frameIndex(0),
+frameStarted(false),
+droppedFrameCount(0) {
+
+}
+
+OpenGLGPUTimer::~OpenGLGPUTimer() {
+  Shutdown();
+}
+
+bool OpenGLGPUTimer::Init(size_t frameCount) {
+  PxRequireMainThread;
+
+  if(IsSupported())
+    return true;
+
+  if(frameCount == 0)
+    return false;
+
+  // The loader is generated for GL 3.2, so the GL 3.3 timer query entry points
+  // are fetched here when the driver exposes them.
+  if(!glfwExtensionSupported("GL_ARB_timer_query")) {
+    dbgprintf("[Warning] GL_ARB_timer_query is not supported; GPU timers are disabled.\n");
+    return false;
+  }
+
+  queryCounter = (OpenGLQueryCounterProc) glfwGetProcAddress("glQueryCounter");
+  getQueryObjectui64v = (OpenGLGetQueryObjectui64vProc) glfwGetProcAddress("glGetQueryObjectui64v");
+  if(!IsSupported()) {
+    queryCounter = nullptr;
+    getQueryObjectui64v = nullptr;
+    return false;
+  }
+
+  frames.resize(frameCount);
+  for(OpenGLGPUTimerFrame& frame: frames) {
+    frame.queryIdCount = 0;
+    frame.pending = false;
+  }
+
+  frameIndex = 0;
+  frameStarted = false;
+  droppedFrameCount = 0;
+
+  return true;
+}
+
+void OpenGLGPUTimer::Shutdown() {
+  for(OpenGLGPUTimerFrame& frame: frames) {
+    if(!frame.queryIds.empty()) {
+      GLCMD(glDeleteQueries((GLsizei) frame.queryIds.size(), frame.queryIds.data()));
+    }
+  }
+
+  frames.clear();
+  openTimers.clear();
+  results.clear();
+  resultTimestamps.clear();
+
+  queryCounter = nullptr;
+  getQueryObjectui64v = nullptr;
+  frameStarted = false;
+}
+
+void OpenGLGPUTimer::StartFrame() {
+  if(!IsSupported())
+    return;
+
+  // Timestamps complete in submission order, so frames are polled oldest
+  // first and polling stops at the first one still in flight.
+  size_t frameCount = frames.size();
+  for(size_t i = 1; i <= frameCount; i++) {
+    OpenGLGPUTimerFrame& frame = frames[(frameIndex + i) % frameCount];
+    if(frame.pending) {
+      ReadFrame(frame);
+      if(frame.pending)
+        break;
+    }
+  }
+
+  frameIndex = (frameIndex + 1) % frameCount;
+
+  OpenGLGPUTimerFrame& frame = frames[frameIndex];
+  if(frame.pending) {
+    droppedFrameCount++;
+    frame.pending = false;
+  }
+
+  frame.timers.clear();
+  frame.queryIdCount = 0;
+  openTimers.clear();
+  frameStarted = true;
+}
+
+void OpenGLGPUTimer::EndFrame() {
+  if(!frameStarted)
+    return;
+
+  PrimeAssert(openTimers.empty(), "GPU timer %s was not ended before the end of the frame.", frames[frameIndex].timers[openTimers.back()].name);
+  while(!openTimers.empty()) {
+    End();
+  }
+
+  OpenGLGPUTimerFrame& frame = frames[frameIndex];
+  frame.pending = !frame.timers.empty();
+  frameStarted = false;
+}
+
+void OpenGLGPUTimer::Start(const char* name) {
+  if(!frameStarted)
+    return;
+
+  OpenGLGPUTimerFrame& frame = frames[frameIndex];
+
+  OpenGLGPUTimerQuery timer;
+  timer.name = name;
+  timer.depth = (u32) openTimers.size();
+  timer.startQuery = AddQuery(frame);
+  timer.endQuery = timer.startQuery;
+#if OGALIB_PROFILER
+  timer.cpuStart = ogalib::Profiler::GetTime();
+#else
+  timer.cpuStart = 0;
+#endif
+
+  GLCMD(queryCounter(frame.queryIds[timer.startQuery], GL_TIMESTAMP));
+
+  openTimers.push_back(frame.timers.size());
+  frame.timers.push_back(timer);
+}
+
+void OpenGLGPUTimer::End() {
+  if(!frameStarted)
+    return;
+
+  if(openTimers.empty()) {
+    PrimeAssert(false, "GPU timer ended without a matching start.");
+    return;
+  }
+
+  OpenGLGPUTimerFrame& frame = frames[frameIndex];
+  OpenGLGPUTimerQuery& timer = frame.timers[openTimers.back()];
+  openTimers.pop_back();
+
+  timer.endQuery = AddQuery(frame);
+  GLCMD(queryCounter(frame.queryIds[timer.endQuery], GL_TIMESTAMP));
+}
+
+size_t OpenGLGPUTimer::AddQuery(OpenGLGPUTimerFrame& frame) {
+  if(frame.queryIdCount == frame.queryIds.size()) {
+    size_t oldCount = frame.queryIds.size();
+    frame.queryIds.resize(oldCount + OpenGLGPUTimerQueryGrowCount);
+    GLCMD(glGenQueries(OpenGLGPUTimerQueryGrowCount, frame.queryIds.data() + oldCount));
+  }
+
+  return frame.queryIdCount++;
+}
+
+void OpenGLGPUTimer::ReadFrame(OpenGLGPUTimerFrame& frame) {
+  if(frame.queryIdCount == 0) {
+    frame.pending = false;
+    return;
+  }
+
+  GLint available = 0;
+  GLCMD(glGetQueryObjectiv(frame.queryIds[frame.queryIdCount - 1], GL_QUERY_RESULT_AVAILABLE, &available));
+  if(!available)
+    return;
+
+  resultTimestamps.resize(frame.queryIdCount);
+  for(size_t i = 0; i < frame.queryIdCount; i++) {
+    GLCMD(getQueryObjectui64v(frame.queryIds[i], GL_QUERY_RESULT, &resultTimestamps[i]));
+  }
+
+  results.clear();
+  for(const OpenGLGPUTimerQuery& timer: frame.timers) {
+    GLuint64 start = resultTimestamps[timer.startQuery];
+    GLuint64 end = resultTimestamps[timer.endQuery];
+    results.push_back({timer.name, end > start ? (end - start) * 1.0e-9 : 0.0, timer.depth});
+  }
+
+#if OGALIB_PROFILER
+  // GPU timestamps are on their own clock, so the frame is placed on the
+  // profiler timeline at the CPU time its first timer was issued.
+  const OpenGLGPUTimerQuery& first = frame.timers.front();
+  GLuint64 gpuBase = resultTimestamps[first.startQuery];
+  for(const OpenGLGPUTimerQuery& timer: frame.timers) {
+    GLuint64 start = resultTimestamps[timer.startQuery];
+    GLuint64 end = resultTimestamps[timer.endQuery];
+    if(start >= gpuBase && end >= start) {
+      ogalib::Profiler::AddGPUScope(timer.name, first.cpuStart + (start - gpuBase), first.cpuStart + (end - gpuBase), timer.depth);
+    }
+  }
+#endif
+
+  frame.pending = false;
+}
+
+#endif
@@ -55,6 +55,7 @@ using namespace Prime;
 ////////////////////////////////////////////////////////////////////////////////
 
 bool __PrimeOpenGLOutOfMemoryError;
+OpenGLVertexAttribDivisorProc __PrimeOpenGLVertexAttribDivisor;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constants
@@ -74,6 +75,23 @@ static const GLenum OpenGLIndexBufferTypeTable[] = {
   GL_UNSIGNED_INT,
 };
 
+static const ProgramVariableHandle mvpHandle("mvp");
+static const ProgramVariableHandle modelHandle("model");
+static const ProgramVariableHandle viewHandle("view");
+static const ProgramVariableHandle vpHandle("vp");
+static const ProgramVariableHandle mvHandle("mv");
+static const ProgramVariableHandle normalMatHandle("normalMat");
+static const ProgramVariableHandle gposMatHandle("gposMat");
+static const ProgramVariableHandle clipPlaneHandle[] = {
+  ProgramVariableHandle("clipPlane0"),
+  ProgramVariableHandle("clipPlane1"),
+  ProgramVariableHandle("clipPlane2"),
+  ProgramVariableHandle("clipPlane3"),
+  ProgramVariableHandle("clipPlane4"),
+  ProgramVariableHandle("clipPlane5"),
+};
+static const size_t clipPlaneHandleCount = sizeof(clipPlaneHandle) / sizeof(clipPlaneHandle[0]);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,7 +120,17 @@ OpenGLGraphics& OpenGLGraphics::GetInstance() {
 
 OpenGLGraphics::OpenGLGraphics():
 screenWindow(nullptr),
-currentTextureStacks(nullptr) {
+currentTextureStacks(nullptr),
+currentVAOId(GL_NONE),
+drawMatProjectionVersion(0),
+drawMatViewVersion(0),
+drawMatModelVersion(0),
+drawMatNearZ(0.0f),
+drawMatFarZ(0.0f),
+drawMatValidMask(0),
+currentClipMask(0),
+renderQueueEnabled(false),
+vertexArrayCacheEnabled(true) {
   currentIBOId = GL_NONE;
   currentABOId = GL_NONE;
   currentProgramId = GL_NONE;
@@ -111,6 +139,9 @@ currentTextureStacks(nullptr) {
   currentViewport = viewport;
   currentDepthMask = depthMask;
   currentDepthEnabled = depthEnabled;
+
+  memset(&frameStats, 0, sizeof(frameStats));
+  memset(&lastFrameStats, 0, sizeof(lastFrameStats));
 }
 
 OpenGLGraphics::~OpenGLGraphics() {
@@ -120,12 +151,6 @@ OpenGLGraphics::~OpenGLGraphics() {
 void OpenGLGraphics::Init() {
   Graphics::Init();
 
-  drawMatMVP.LoadIdentity();
-  drawMatModel.LoadIdentity();
-  drawMatView.LoadIdentity();
-  drawMatVP.LoadIdentity();
-  drawMatMV.LoadIdentity();
-
   // Init GLFW Graphics
   glfwInit();
 
@@ -135,6 +160,9 @@ void OpenGLGraphics::Init() {
 void OpenGLGraphics::Shutdown() {
   OpenGLTex::ShutdownGlobal();
 
+  uniformRing.Shutdown();
+  gpuTimer.Shutdown();
+
   glfwDestroyWindow(screenWindow);
   glfwTerminate();
 
@@ -180,6 +208,12 @@ void OpenGLGraphics::ShowScreen(const GraphicsScreenConfig* config) {
   glfwSwapInterval(useConfig->swapInterval);
   gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
 
+  // The loader only covers OpenGL 3.2, so fetch the 3.3 instancing entry point.
+  __PrimeOpenGLVertexAttribDivisor = (OpenGLVertexAttribDivisorProc) glfwGetProcAddress("glVertexAttribDivisor");
+  if(!__PrimeOpenGLVertexAttribDivisor) {
+    __PrimeOpenGLVertexAttribDivisor = (OpenGLVertexAttribDivisorProc) glfwGetProcAddress("glVertexAttribDivisorARB");
+  }
+
   // Get OpenGL info.
   GLint intValue;
 
@@ -204,6 +238,9 @@ void OpenGLGraphics::ShowScreen(const GraphicsScreenConfig* config) {
   GLCMD(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
   GLCMD(glEnable(GL_BLEND));
 
+  uniformRing.Init();
+  gpuTimer.Init();
+
   glfwSetKeyCallback(screenWindow, OnKeyCallback);
   glfwSetScrollCallback(screenWindow, OnScrollCallback);
 }
@@ -256,10 +293,25 @@ void OpenGLGraphics::StartFrame() {
 
   viewport.Push() = Viewport(0.0f, 0.0f, (f32) w, (f32) h);
 
+  uniformRing.StartFrame();
+
+  lastFrameStats = frameStats;
+  memset(&frameStats, 0, sizeof(frameStats));
+
+  ogalibProfileCounter("Graphics draws", lastFrameStats.drawCount);
+  ogalibProfileCounter("Graphics triangles", lastFrameStats.triangleCount);
+  ogalibProfileCounter("Graphics uniform bytes", GetFrameUniformBytesUploaded());
+  ogalibProfileCounter("Graphics texture bytes", lastFrameStats.texUploadBytes);
+
+  gpuTimer.StartFrame();
+  gpuTimer.Start("Graphics::Frame");
+
   Graphics::StartFrame();
 }
 
 void OpenGLGraphics::EndFrame() {
+  FlushRenderQueue();
+
   Graphics::EndFrame();
 
   viewport.Pop();
@@ -267,7 +319,15 @@ void OpenGLGraphics::EndFrame() {
   if(!screenWindow)
     return;
 
-  glfwSwapBuffers(screenWindow);
+  uniformRing.EndFrame();
+
+  gpuTimer.End();
+  gpuTimer.EndFrame();
+
+  {
+    ogalibProfileScope("Graphics::SwapBuffers");
+    glfwSwapBuffers(screenWindow);
+  }
   glfwPollEvents();
 
   if(glfwWindowShouldClose(screenWindow)) {
@@ -276,6 +336,8 @@ void OpenGLGraphics::EndFrame() {
 }
 
 void OpenGLGraphics::ClearScreen() {
+  FlushRenderQueue();
+
   if(currentClearScreenColor != clearScreenColor) {
     currentClearScreenColor = clearScreenColor;
     GLCMD(glClearColor(currentClearScreenColor.r, currentClearScreenColor.g, currentClearScreenColor.b, currentClearScreenColor.a));
@@ -289,6 +351,8 @@ void OpenGLGraphics::ClearScreen() {
 }
 
 void OpenGLGraphics::ClearColor() {
+  FlushRenderQueue();
+
   if(currentClearScreenColor != clearScreenColor) {
     currentClearScreenColor = clearScreenColor;
     GLCMD(glClearColor(currentClearScreenColor.r, currentClearScreenColor.g, currentClearScreenColor.b, currentClearScreenColor.a));
@@ -298,6 +362,8 @@ void OpenGLGraphics::ClearColor() {
 }
 
 void OpenGLGraphics::ClearDepth() {
+  FlushRenderQueue();
+
   if(currentClearScreenDepth != clearScreenDepth) {
     currentClearScreenDepth = clearScreenDepth;
     GLCMD(glClearDepth(currentClearScreenDepth));
@@ -307,14 +373,102 @@ void OpenGLGraphics::ClearDepth() {
 }
 
 void OpenGLGraphics::Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, TexChannelTuple const* tupleList, size_t tupleCount) {
+  DrawElements(ab, ib, start, count, nullptr, 0, tupleList, tupleCount);
+}
+
+void OpenGLGraphics::DrawInstanced(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) {
+  if(!instances || instanceCount == 0)
+    return;
+
+  DrawElements(ab, ib, start, count, instances, instanceCount, tupleList, tupleCount);
+}
+
+void OpenGLGraphics::SetRenderQueueEnabled(bool enabled) {
+  if(renderQueueEnabled && !enabled) {
+    FlushRenderQueue();
+  }
+
+  renderQueueEnabled = enabled;
+}
+
+bool OpenGLGraphics::IsRenderQueueEnabled() const {
+  return renderQueueEnabled;
+}
+
+void OpenGLGraphics::Submit(const GraphicsSubmit& submit) {
+  if(renderQueueEnabled) {
+    RecordRenderPacket(submit);
+  }
+  else {
+    Graphics::Submit(submit);
+  }
+}
+
+bool OpenGLGraphics::IsGPUTimingSupported() const {
+  return gpuTimer.IsSupported();
+}
+
+void OpenGLGraphics::StartGPUTimer(const char* name) {
+  // Queued draws execute in FlushRenderQueue, so with the render queue on a
+  // timer only covers the draws that are flushed while it is open.
+  gpuTimer.Start(name);
+}
+
+void OpenGLGraphics::EndGPUTimer() {
+  gpuTimer.End();
+}
+
+const std::vector<GraphicsGPUTime>& OpenGLGraphics::GetGPUTimes() const {
+  return gpuTimer.GetResults();
+}
+
+void OpenGLGraphics::GetFrameStats(GraphicsFrameStats& stats) const {
+  stats.drawCount = lastFrameStats.drawCount;
+  stats.instanceCount = lastFrameStats.instanceCount;
+  stats.triangleCount = lastFrameStats.triangleCount;
+  stats.uniformBytesUploaded = GetFrameUniformBytesUploaded();
+  stats.uniformOverflowCount = uniformRing.GetLastFrameStats().overflowCount;
+  stats.texBytesUploaded = lastFrameStats.texUploadBytes;
+
+  // The frame timer is started before any other, so it is always first.
+  const std::vector<GraphicsGPUTime>& gpuTimes = gpuTimer.GetResults();
+  stats.gpuFrameTime = gpuTimes.empty() ? 0.0 : gpuTimes.front().time;
+}
+
+void OpenGLGraphics::AddTexUpload(size_t bytes) {
+  frameStats.texUploadCount++;
+  frameStats.texUploadBytes += bytes;
+}
+
+void OpenGLGraphics::DrawElements(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, TexChannelTuple const* tupleList, size_t tupleCount) {
+  ogalibProfileScope("Graphics::Draw");
+
   if(!program)
     return;
 
+  if(renderQueueEnabled) {
+    GraphicsSubmit submit;
+    submit.program = program;
+    submit.ab = ab;
+    submit.ib = ib;
+    submit.start = start;
+    submit.count = count;
+    submit.instances = instances;
+    submit.instanceCount = instanceCount;
+    submit.tupleList = tupleList;
+    submit.tupleCount = tupleCount;
+    submit.model = model;
+    submit.variables = nullptr;
+    submit.variableCount = 0;
+    RecordRenderPacket(submit);
+    return;
+  }
+
   PushDrawTexChannelTupleList(tupleList, tupleCount);
   PushDrawArrayBuffer(ab);
   PushDrawIndexBuffer(ib);
   PushDrawProgram(program);
-  PushDrawMatrices();
+  UpdateDrawMatrices();
 
   LoadDrawViewport();
   LoadDrawDepth();
@@ -331,59 +485,37 @@ void OpenGLGraphics::Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t
   }
 
   {
-    static const std::string mvpStr("mvp");
-    static const std::string modelStr("model");
-    static const std::string viewStr("view");
-    static const std::string vpStr("vp");
-    static const std::string mvStr("mv");
-    static const std::string normalMatStr("normalMat");
-    static const std::string gposMatStr("gposMat");
-    static const std::string clipPlaneStr[] = {
-      "clipPlane0",
-      "clipPlane1",
-      "clipPlane2",
-      "clipPlane3",
-      "clipPlane4",
-      "clipPlane5",
-    };
-    static const size_t clipPlaneStrCount = sizeof(clipPlaneStr) / sizeof(clipPlaneStr[0]);
-
+    // Products are only built for the variables the program declares, and
+    // are reused while the stacks they come from are unchanged.
     if(prog.HasVariableMVP())
-      prog.SetVariable(mvpStr, drawMatMVP);
+      prog.SetVariable(mvpHandle, GetDrawMatMVP());
 
     if(prog.HasVariableModel())
-      prog.SetVariable(modelStr, drawMatModel);
+      prog.SetVariable(modelHandle, model);
 
     if(prog.HasVariableView())
-      prog.SetVariable(viewStr, drawMatView);
+      prog.SetVariable(viewHandle, view);
 
     if(prog.HasVariableVP())
-      prog.SetVariable(vpStr, drawMatVP);
+      prog.SetVariable(vpHandle, GetDrawMatVP());
 
     if(prog.HasVariableMV())
-      prog.SetVariable(mvStr, drawMatMV);
+      prog.SetVariable(mvHandle, GetDrawMatMV());
 
-    if(prog.HasVariableNormalMat()) {
-      Mat44 normalMat = drawMatMV;
-      normalMat.Invert();
-      normalMat.Transpose();
+    if(prog.HasVariableNormalMat())
+      prog.SetVariable(normalMatHandle, GetDrawMatNormal());
 
-      prog.SetVariable(normalMatStr, normalMat);
-    }
+    if(prog.HasVariableGPosMat())
+      prog.SetVariable(gposMatHandle, GetDrawMatGPos());
 
-    if(prog.HasVariableGPosMat()) {
-      Mat44 gposMat = drawMatMV;
-      f32 normalizeRange = 1.0f / (farZ - nearZ);
-      gposMat = Mat44().LoadScaling(normalizeRange, normalizeRange, normalizeRange) * gposMat;
-      prog.SetVariable(gposMatStr, gposMat);
-    }
+    u32 clipMask = 0;
 
     for(u32 i = 0; i < PRIME_DEVICE_PROGRAM_CLIP_PLANE_COUNT; i++) {
       bool enabled = clipPlaneEnabled[i];
 
       if(enabled && prog.HasVariableClipPlane(i)) {
-        if(i < clipPlaneStrCount) {
-          prog.SetVariable(clipPlaneStr[i], clipPlane[i]);
+        if(i < clipPlaneHandleCount) {
+          prog.SetVariable(clipPlaneHandle[i], clipPlane[i]);
         }
         else {
           prog.SetVariable(string_printf("clipPlane%zu", i), clipPlane[i]);
@@ -391,37 +523,267 @@ void OpenGLGraphics::Draw(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t
       }
 
       if(enabled) {
-        GLCMD(glEnable(GL_CLIP_DISTANCE0 + i));
-      }
-      else {
-        GLCMD(glDisable(GL_CLIP_DISTANCE0 + i));
+        clipMask |= 1 << i;
       }
     }
+
+    LoadDrawClipPlanes(clipMask);
   }
 
   prog.LoadVariablesToShaderStage();
 
-  GLsizei vertexStride = (GLsizei) ab->GetItemSize();
+  ExecuteDrawElements(ab, ib, start, count, instances, instanceCount, prog);
 
-  size_t attributeCount = programOpenGL.GetAttributeCount();
-  for(size_t i = 0; i < attributeCount; i++) {
-    const OpenGLProgramAttributeInfo* info = programOpenGL.GetAttributeInfo(i);
-    if(info) {
-      const ArrayBufferAttribute* attribute = ab->GetAttribute(info->name);
-      if(attribute) {
-        GLCMD(glEnableVertexAttribArray(info->loc));
-        GLCMD(glVertexAttribPointer(info->loc, (GLsizei) (info->size / sizeof(f32)), GL_FLOAT, GL_FALSE, vertexStride, (const GLvoid*) attribute->GetOffset()));
+  PopDrawProgram();
+  PopDrawIndexBuffer();
+  PopDrawArrayBuffer();
+  PopDrawTexChannelTupleList();
+}
+
+void OpenGLGraphics::ExecuteDrawElements(ArrayBuffer* ab, IndexBuffer* ib, size_t start, size_t count, ArrayBuffer* instances, size_t instanceCount, OpenGLProgram& prog) {
+  if(LoadDrawVertexArray(ab, ib, prog, instances)) {
+    GLenum primitive = OpenGLBufferPrimitiveTable[ab->GetPrimitive()];
+    GLenum indexType = OpenGLIndexBufferTypeTable[ib->GetFormat()];
+    const GLvoid* indexOffset = (const GLvoid*) (ib->GetIndexSize() * start);
+
+    if(instances) {
+      GLCMD(glDrawElementsInstanced(primitive, (GLsizei) count, indexType, indexOffset, (GLsizei) instanceCount));
+      frameStats.instancedDrawCount++;
+      frameStats.instanceCount += instanceCount;
+    }
+    else {
+      GLCMD(glDrawElements(primitive, (GLsizei) count, indexType, indexOffset));
+    }
+
+    frameStats.drawCount++;
+    frameStats.triangleCount += GetBufferPrimitiveTriangleCount(ab->GetPrimitive(), count) * (instances ? instanceCount : 1);
+  }
+}
+
+void OpenGLGraphics::RecordRenderPacket(const GraphicsSubmit& submit) {
+  if(!submit.program || !submit.ab || !submit.ib || submit.count == 0)
+    return;
+
+  if(submit.instances && submit.instanceCount == 0)
+    return;
+
+  OpenGLProgram& prog = *static_cast<OpenGLProgram*>(submit.program);
+
+  // The variable layout is only known once the program is linked, and that
+  // needs the GL context, so a worker cannot record with an unloaded program.
+  if(!prog.IsLoadedIntoVRAM()) {
+    if(!Thread::IsMainThread())
+      return;
+
+    prog.LoadIntoVRAM();
+    if(!prog.IsLoadedIntoVRAM())
+      return;
+  }
+
+  OpenGLRenderQueueBucket& bucket = renderQueue.GetThreadBucket();
+
+  const Mat44& projectionMat = projection;
+  const Mat44& viewMat = view;
+  if(!bucket.vpValid || memcmp(bucket.projection.e, projectionMat.e, sizeof(projectionMat.e)) != 0 || memcmp(bucket.view.e, viewMat.e, sizeof(viewMat.e)) != 0) {
+    bucket.projection = projectionMat;
+    bucket.view = viewMat;
+    bucket.vp.LoadProduct(projectionMat, viewMat);
+    bucket.vpValid = true;
+  }
+
+  const Mat44& vpMat = bucket.vp;
+  const Mat44& modelMat = submit.model;
+
+  // The sort depth only needs the view space z of the model origin, so the
+  // full model view product is left to programs that declare it.
+  f32 viewZ = viewMat.e31 * modelMat.e14 + viewMat.e32 * modelMat.e24 + viewMat.e33 * modelMat.e34 + viewMat.e34 * modelMat.e44;
+
+  f32 drawNearZ = nearZ;
+  f32 drawFarZ = farZ;
+  f32 depth = 0.0f;
+  if(drawFarZ > drawNearZ) {
+    depth = (-viewZ - drawNearZ) / (drawFarZ - drawNearZ);
+  }
+
+  size_t usedSize = prog.GetVariableBufferUsedSize();
+  size_t blockSize = usedSize;
+  for(size_t i = 0; i < submit.variableCount; i++) {
+    const GraphicsSubmitVariable& variable = submit.variables[i];
+    blockSize = max(blockSize, prog.GetVariableBlockExtent(variable.handle, variable.itemSize, variable.count));
+  }
+
+  size_t uniformOffset = bucket.uniformData.size();
+  bucket.uniformData.resize(uniformOffset + blockSize);
+  u8* block = bucket.uniformData.data() + uniformOffset;
+  memcpy(block, prog.GetVariableBuffer(), usedSize);
+
+  if(prog.HasVariableMVP()) {
+    Mat44 mvpMat;
+    mvpMat.LoadProduct(vpMat, modelMat);
+    prog.WriteVariableBlockData(block, mvpHandle, mvpMat.e, 16, 1);
+  }
+
+  if(prog.HasVariableModel())
+    prog.WriteVariableBlockData(block, modelHandle, modelMat.e, 16, 1);
+
+  if(prog.HasVariableView())
+    prog.WriteVariableBlockData(block, viewHandle, viewMat.e, 16, 1);
+
+  if(prog.HasVariableVP())
+    prog.WriteVariableBlockData(block, vpHandle, vpMat.e, 16, 1);
+
+  if(prog.HasVariableMV() || prog.HasVariableNormalMat() || prog.HasVariableGPosMat()) {
+    Mat44 mvMat;
+    mvMat.LoadProduct(viewMat, modelMat);
+
+    if(prog.HasVariableMV())
+      prog.WriteVariableBlockData(block, mvHandle, mvMat.e, 16, 1);
+
+    if(prog.HasVariableNormalMat()) {
+      Mat44 normalMat = mvMat;
+      if(normalMat.IsAffine())
+        normalMat.InvertAffine();
+      else
+        normalMat.Invert();
+      normalMat.Transpose();
+      prog.WriteVariableBlockData(block, normalMatHandle, normalMat.e, 16, 1);
+    }
+
+    if(prog.HasVariableGPosMat()) {
+      f32 normalizeRange = 1.0f / (drawFarZ - drawNearZ);
+      Mat44 gposMat = Mat44().LoadScaling(normalizeRange, normalizeRange, normalizeRange) * mvMat;
+      prog.WriteVariableBlockData(block, gposMatHandle, gposMat.e, 16, 1);
+    }
+  }
+
+  u32 clipMask = 0;
+  for(u32 i = 0; i < PRIME_DEVICE_PROGRAM_CLIP_PLANE_COUNT && i < clipPlaneHandleCount; i++) {
+    if(clipPlaneEnabled[i]) {
+      clipMask |= 1 << i;
+
+      if(prog.HasVariableClipPlane(i)) {
+        const Vec4& plane = clipPlane[i];
+        prog.WriteVariableBlockData(block, clipPlaneHandle[i], &plane.x, 4, 1);
+      }
+    }
+  }
+
+  for(size_t i = 0; i < submit.variableCount; i++) {
+    const GraphicsSubmitVariable& variable = submit.variables[i];
+    prog.WriteVariableBlockData(block, variable.handle, variable.data, variable.itemSize, variable.count);
+  }
+
+  PrimeAssert(submit.tupleCount <= OpenGLRenderPacketMaxTexCount, "Too many textures for a render packet: %zu", submit.tupleCount);
+
+  OpenGLRenderPacket packet;
+  packet.program = &prog;
+  packet.ab = submit.ab;
+  packet.ib = submit.ib;
+  packet.instances = submit.instances;
+  packet.texCount = 0;
+  if(submit.tupleList) {
+    packet.texCount = min(submit.tupleCount, (size_t) OpenGLRenderPacketMaxTexCount);
+    for(size_t i = 0; i < packet.texCount; i++) {
+      packet.textures[i] = submit.tupleList[i];
+    }
+  }
+  packet.start = submit.start;
+  packet.count = submit.count;
+  packet.instanceCount = submit.instances ? submit.instanceCount : 0;
+  packet.uniformOffset = uniformOffset;
+  packet.uniformSize = blockSize;
+  packet.viewport = viewport;
+  packet.clipMask = clipMask;
+  packet.depthMask = depthMask;
+  packet.depthEnabled = depthEnabled;
+
+  Tex* tex = packet.texCount > 0 ? packet.textures[0].tex : nullptr;
+
+  OpenGLRenderPacketLayer layer = OpenGLRenderPacketLayerOpaque;
+  if(!packet.depthEnabled) {
+    layer = OpenGLRenderPacketLayerOverlay;
+  }
+  else if(tex && tex->HasA()) {
+    layer = OpenGLRenderPacketLayerTransparent;
+  }
+
+  packet.key = OpenGLRenderQueue::MakeKey(layer, prog.GetLayoutId(), tex, submit.ab, depth, renderQueue.GetNextSequence());
+
+  bucket.packets.push_back(packet);
+}
+
+void OpenGLGraphics::FlushRenderQueue() {
+  PxRequireMainThread;
+  ogalibProfileScope("Graphics::FlushRenderQueue");
+
+  const std::vector<OpenGLRenderQueueItem>& items = renderQueue.Sort();
+  if(items.empty())
+    return;
+
+  // Packets replace the current state in place instead of pushing it, so that
+  // consecutive packets sharing a program, texture or buffer skip the rebind.
+  for(size_t i = 0; i < maxTexUnits; i++) {
+    currentTextureStacks[i].Push();
+  }
+  currentABOId.Push();
+  currentIBOId.Push();
+  currentProgramId.Push();
+
+  const OpenGLProgram* lastProgram = nullptr;
+  const u8* lastUniformData = nullptr;
+  size_t lastUniformSize = 0;
+
+  for(const OpenGLRenderQueueItem& item: items) {
+    const OpenGLRenderPacket& packet = *item.packet;
+    OpenGLProgram& prog = *packet.program;
+
+    GLuint programId = currentProgramId;
+    LoadDrawProgram(&prog);
+    if(currentProgramId != programId || &prog != lastProgram) {
+      for(size_t i = 0; i < maxTexUnits; i++) {
+        GLint textureLoc = prog.GetTextureLoc(i);
+        if(textureLoc != -1) {
+          GLCMD(glUniform1i(textureLoc, (GLint) i));
+        }
       }
     }
+
+    size_t unit = 0;
+    for(; unit < packet.texCount; unit++) {
+      LoadDrawTex(packet.textures[unit].tex, unit, packet.textures[unit].channel);
+    }
+    for(; unit < maxTexUnits; unit++) {
+      LoadDrawTex(nullptr, unit);
+    }
+
+    LoadDrawArrayBuffer(packet.ab);
+    LoadDrawIndexBuffer(packet.ib);
+
+    LoadDrawViewport(packet.viewport);
+    LoadDrawDepth(packet.depthMask, packet.depthEnabled);
+    LoadDrawClipPlanes(packet.clipMask);
+
+    if(&prog != lastProgram || packet.uniformSize != lastUniformSize || memcmp(item.uniformData, lastUniformData, packet.uniformSize) != 0) {
+      prog.LoadVariableBlockToShaderStage(item.uniformData, packet.uniformSize);
+      lastProgram = &prog;
+      lastUniformData = item.uniformData;
+      lastUniformSize = packet.uniformSize;
+    }
+    else {
+      uniformRing.CountReuse();
+    }
+
+    ExecuteDrawElements(packet.ab, packet.ib, packet.start, packet.count, packet.instances, packet.instanceCount, prog);
   }
 
-  GLCMD(glDrawElements(OpenGLBufferPrimitiveTable[ab->GetPrimitive()], (GLsizei) count, OpenGLIndexBufferTypeTable[ib->GetFormat()], (const GLvoid*) (ib->GetIndexSize() * start)));
+  frameStats.queuedDrawCount += items.size();
 
-  PopDrawMatrices();
   PopDrawProgram();
   PopDrawIndexBuffer();
   PopDrawArrayBuffer();
   PopDrawTexChannelTupleList();
+
+  renderQueue.Clear();
 }
 
 GLFWwindow* OpenGLGraphics::GetOpenGLGLFWScreenWindow() const {
@@ -446,6 +808,8 @@ void OpenGLGraphics::ResetRenderState() {
   currentIBOId = 0;
   currentABOId = 0;
   currentProgramId = 0;
+  currentVAOId = 0;
+  currentClipMask = 0;
 }
 
 void OpenGLGraphics::PushDrawTexChannelTupleList(TexChannelTuple const* tupleList, size_t tupleCount) {
@@ -467,12 +831,208 @@ void OpenGLGraphics::PushDrawTex(Tex* tex, size_t unit, TexChannel channel) {
   if(unit >= maxTexUnits)
     return;
 
+  currentTextureStacks[unit].Push();
+  LoadDrawTex(tex, unit, channel);
+}
+
+void OpenGLGraphics::PushDrawIndexBuffer(IndexBuffer* ib) {
+  currentIBOId.Push();
+  LoadDrawIndexBuffer(ib);
+}
+
+void OpenGLGraphics::PushDrawArrayBuffer(ArrayBuffer* ab) {
+  currentABOId.Push();
+  LoadDrawArrayBuffer(ab);
+}
+
+void OpenGLGraphics::PushDrawProgram(DeviceProgram* deviceProgram) {
+  currentProgramId.Push();
+  LoadDrawProgram(deviceProgram);
+}
+
+void OpenGLGraphics::PopDrawTexChannelTupleList() {
+  for(size_t i = 0; i < maxTexUnits; i++) {
+    PopDrawTex(i);
+  }
+}
+
+void OpenGLGraphics::PopDrawTex(size_t unit) {
+  if(unit >= maxTexUnits)
+    return;
+
   GLint unitGL = (GLint) unit;
   auto& currentTextureStack = currentTextureStacks[unit];
-  currentTextureStack.Push();
+  OpenGLGraphicsCurrentTexture prevTexture = currentTextureStack;
+  currentTextureStack.Pop();
 
   OpenGLGraphicsCurrentTexture& currentTexture = currentTextureStack;
 
+  if(currentTexture.tex) {
+    OpenGLTex& texOpenGL = *static_cast<OpenGLTex*>((Tex*) currentTexture.tex);
+
+    if(!texOpenGL.IsLoadedIntoVRAM())
+      texOpenGL.LoadIntoVRAM();
+
+    if(texOpenGL.IsLoadedIntoVRAM()) {
+      if(currentTexture.tex != prevTexture.tex || currentTexture.channel != prevTexture.channel) {
+        if(prevTexture.channel == TexChannelMain) {
+          LoadDrawTexId(unitGL, texOpenGL.GetTextureId());
+        }
+        else if(prevTexture.channel == TexChannelDepth) {
+          LoadDrawTexId(unitGL, texOpenGL.GetDepthTextureId());
+        }
+        else {
+          currentTexture.enabled = false;
+          LoadDrawTexId(unitGL, 0);
+        }
+      }
+    }
+    else {
+      currentTexture.enabled = false;
+      LoadDrawTexId(unitGL, 0);
+    }
+  }
+  else {
+    if(prevTexture.tex != nullptr) {
+      LoadDrawTexId(unitGL, 0);
+    }
+  }
+}
+
+void OpenGLGraphics::PopDrawIndexBuffer() {
+  currentIBOId.Pop();
+}
+
+void OpenGLGraphics::PopDrawArrayBuffer() {
+  currentABOId.Pop();
+}
+
+void OpenGLGraphics::PopDrawProgram() {
+  currentProgramId.Pop();
+}
+
+void OpenGLGraphics::UpdateDrawMatrices() {
+  u64 projectionVersion = projection.GetVersion();
+  u64 viewVersion = view.GetVersion();
+  u64 modelVersion = model.GetVersion();
+
+  if(projectionVersion != drawMatProjectionVersion || viewVersion != drawMatViewVersion) {
+    drawMatValidMask = 0;
+  }
+  else if(modelVersion != drawMatModelVersion) {
+    drawMatValidMask &= OpenGLGraphicsDrawMatVP;
+  }
+
+  if(nearZ != drawMatNearZ || farZ != drawMatFarZ) {
+    drawMatValidMask &= ~OpenGLGraphicsDrawMatGPos;
+  }
+
+  drawMatProjectionVersion = projectionVersion;
+  drawMatViewVersion = viewVersion;
+  drawMatModelVersion = modelVersion;
+  drawMatNearZ = nearZ;
+  drawMatFarZ = farZ;
+}
+
+const Mat44& OpenGLGraphics::GetDrawMatVP() {
+  if(!(drawMatValidMask & OpenGLGraphicsDrawMatVP)) {
+    if(view.IsVersionIdentity()) {
+      drawMatVP = projection;
+    }
+    else if(projection.IsVersionIdentity()) {
+      drawMatVP = view;
+    }
+    else {
+      drawMatVP.LoadProduct(projection, view);
+      frameStats.matrixMultiplyCount++;
+    }
+
+    drawMatValidMask |= OpenGLGraphicsDrawMatVP;
+  }
+
+  return drawMatVP;
+}
+
+const Mat44& OpenGLGraphics::GetDrawMatMV() {
+  if(!(drawMatValidMask & OpenGLGraphicsDrawMatMV)) {
+    if(model.IsVersionIdentity()) {
+      drawMatMV = view;
+    }
+    else if(view.IsVersionIdentity()) {
+      drawMatMV = model;
+    }
+    else {
+      drawMatMV.LoadProduct(view, model);
+      frameStats.matrixMultiplyCount++;
+    }
+
+    drawMatValidMask |= OpenGLGraphicsDrawMatMV;
+  }
+
+  return drawMatMV;
+}
+
+const Mat44& OpenGLGraphics::GetDrawMatMVP() {
+  if(!(drawMatValidMask & OpenGLGraphicsDrawMatMVP)) {
+    const Mat44& vp = GetDrawMatVP();
+
+    if(model.IsVersionIdentity()) {
+      drawMatMVP = vp;
+    }
+    else {
+      drawMatMVP.LoadProduct(vp, model);
+      frameStats.matrixMultiplyCount++;
+    }
+
+    drawMatValidMask |= OpenGLGraphicsDrawMatMVP;
+  }
+
+  return drawMatMVP;
+}
+
+const Mat44& OpenGLGraphics::GetDrawMatNormal() {
+  if(!(drawMatValidMask & OpenGLGraphicsDrawMatNormal)) {
+    drawMatNormal = GetDrawMatMV();
+
+    if(!view.IsVersionIdentity() || !model.IsVersionIdentity()) {
+      if(drawMatNormal.IsAffine())
+        drawMatNormal.InvertAffine();
+      else
+        drawMatNormal.Invert();
+      drawMatNormal.Transpose();
+      frameStats.matrixInvertCount++;
+    }
+
+    drawMatValidMask |= OpenGLGraphicsDrawMatNormal;
+  }
+
+  return drawMatNormal;
+}
+
+const Mat44& OpenGLGraphics::GetDrawMatGPos() {
+  if(!(drawMatValidMask & OpenGLGraphicsDrawMatGPos)) {
+    // Scaling from the left only scales the first three rows.
+    f32 normalizeRange = 1.0f / (drawMatFarZ - drawMatNearZ);
+    drawMatGPos = GetDrawMatMV();
+    for(size_t i = 0; i < 16; i++) {
+      if((i & 3) != 3) {
+        drawMatGPos.e[i] *= normalizeRange;
+      }
+    }
+
+    drawMatValidMask |= OpenGLGraphicsDrawMatGPos;
+  }
+
+  return drawMatGPos;
+}
+
+void OpenGLGraphics::LoadDrawTex(Tex* tex, size_t unit, TexChannel channel) {
+  if(unit >= maxTexUnits)
+    return;
+
+  GLint unitGL = (GLint) unit;
+  OpenGLGraphicsCurrentTexture& currentTexture = currentTextureStacks[unit];
+
   if(tex) {
     OpenGLTex& texOpenGL = *static_cast<OpenGLTex*>(tex);
 
@@ -488,35 +1048,25 @@ void OpenGLGraphics::PushDrawTex(Tex* tex, size_t unit, TexChannel channel) {
         currentTexture.hasAlpha = texOpenGL.HasA();
 
         if(currentTexture.channel == TexChannelMain) {
-          GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-          GLCMD(glBindTexture(GL_TEXTURE_2D, texOpenGL.GetTextureId()));
-          GLCMD(glActiveTexture(GL_TEXTURE0));
+          LoadDrawTexId(unitGL, texOpenGL.GetTextureId());
         }
         else if(currentTexture.channel == TexChannelDepth) {
-          GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-          GLCMD(glBindTexture(GL_TEXTURE_2D, texOpenGL.GetDepthTextureId()));
-          GLCMD(glActiveTexture(GL_TEXTURE0));
+          LoadDrawTexId(unitGL, texOpenGL.GetDepthTextureId());
         }
         else {
           currentTexture.enabled = false;
-          GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-          GLCMD(glBindTexture(GL_TEXTURE_2D, 0));
-          GLCMD(glActiveTexture(GL_TEXTURE0));
+          LoadDrawTexId(unitGL, 0);
         }
       }
     }
     else {
       currentTexture.enabled = false;
-      GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-      GLCMD(glBindTexture(GL_TEXTURE_2D, 0));
-      GLCMD(glActiveTexture(GL_TEXTURE0));
+      LoadDrawTexId(unitGL, 0);
     }
   }
   else {
     if(currentTexture.tex != nullptr) {
-      GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-      GLCMD(glBindTexture(GL_TEXTURE_2D, 0));
-      GLCMD(glActiveTexture(GL_TEXTURE0));
+      LoadDrawTexId(unitGL, 0);
       currentTexture.tex = nullptr;
     }
 
@@ -526,8 +1076,15 @@ void OpenGLGraphics::PushDrawTex(Tex* tex, size_t unit, TexChannel channel) {
   }
 }
 
-void OpenGLGraphics::PushDrawIndexBuffer(IndexBuffer* ib) {
-  currentIBOId.Push();
+void OpenGLGraphics::LoadDrawTexId(GLint unit, GLuint textureId) {
+  GLCMD(glActiveTexture(GL_TEXTURE0 + unit));
+  GLCMD(glBindTexture(GL_TEXTURE_2D, textureId));
+  GLCMD(glActiveTexture(GL_TEXTURE0));
+  frameStats.textureBindCount++;
+}
+
+void OpenGLGraphics::LoadDrawIndexBuffer(IndexBuffer* ib) {
+  GLuint iboId = 0;
 
   if(ib) {
     OpenGLIndexBuffer& ibOpenGL = *static_cast<OpenGLIndexBuffer*>(ib);
@@ -539,29 +1096,17 @@ void OpenGLGraphics::PushDrawIndexBuffer(IndexBuffer* ib) {
       ibOpenGL.LoadIntoVRAM();
 
     if(ibOpenGL.IsLoadedIntoVRAM()) {
-      GLuint iboId = ibOpenGL.GetIBOId();
-      if(iboId != currentIBOId) {
-        GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId));
-        currentIBOId = iboId;
-      }
-    }
-    else {
-      if(currentIBOId != 0) {
-        GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-        currentIBOId = 0;
-      }
-    }
-  }
-  else {
-    if(currentIBOId != 0) {
-      GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-      currentIBOId = 0;
+      iboId = ibOpenGL.GetIBOId();
     }
   }
+
+  // The element array binding is vertex array state, so it is applied in
+  // LoadDrawVertexArray once the right vertex array is bound.
+  currentIBOId = iboId;
 }
 
-void OpenGLGraphics::PushDrawArrayBuffer(ArrayBuffer* ab) {
-  currentABOId.Push();
+void OpenGLGraphics::LoadDrawArrayBuffer(ArrayBuffer* ab) {
+  GLuint aboId = 0;
 
   if(ab) {
     OpenGLArrayBuffer& abOpenGL = *static_cast<OpenGLArrayBuffer*>(ab);
@@ -573,160 +1118,138 @@ void OpenGLGraphics::PushDrawArrayBuffer(ArrayBuffer* ab) {
       abOpenGL.LoadIntoVRAM();
 
     if(abOpenGL.IsLoadedIntoVRAM()) {
-      GLuint aboId = abOpenGL.GetABOId();
-      if(aboId != currentABOId) {
-        GLCMD(glBindBuffer(GL_ARRAY_BUFFER, aboId));
-        currentABOId = aboId;
-      }
-    }
-    else {
-      if(currentABOId != 0) {
-        GLCMD(glBindBuffer(GL_ARRAY_BUFFER, 0));
-        currentABOId = 0;
-      }
+      aboId = abOpenGL.GetABOId();
     }
   }
-  else {
-    if(currentABOId != 0) {
-      GLCMD(glBindBuffer(GL_ARRAY_BUFFER, 0));
-      currentABOId = 0;
-    }
+
+  if(aboId != currentABOId) {
+    GLCMD(glBindBuffer(GL_ARRAY_BUFFER, aboId));
+    currentABOId = aboId;
+    frameStats.arrayBufferBindCount++;
   }
 }
 
-void OpenGLGraphics::PushDrawProgram(DeviceProgram* deviceProgram) {
-  currentProgramId.Push();
+void OpenGLGraphics::LoadDrawProgram(DeviceProgram* deviceProgram) {
+  GLuint programId = 0;
 
-  if(program) {
+  if(deviceProgram) {
     OpenGLProgram& deviceProgramOpenGL = *static_cast<OpenGLProgram*>(deviceProgram);
 
     if(!deviceProgramOpenGL.IsLoadedIntoVRAM())
       deviceProgramOpenGL.LoadIntoVRAM();
 
     if(deviceProgramOpenGL.IsLoadedIntoVRAM()) {
-      GLuint programId = deviceProgramOpenGL.GetProgramId();
-      if(programId != currentProgramId) {
-        GLCMD(glUseProgram(programId));
-        currentProgramId = programId;
-      }
-    }
-    else {
-      if(currentProgramId != 0) {
-        GLCMD(glUseProgram(0));
-        currentProgramId = 0;
-      }
+      programId = deviceProgramOpenGL.GetProgramId();
     }
   }
-  else {
-    if(currentProgramId != 0) {
-      GLCMD(glUseProgram(0));
-      currentProgramId = 0;
-    }
+
+  if(programId != currentProgramId) {
+    GLCMD(glUseProgram(programId));
+    currentProgramId = programId;
+    frameStats.programChangeCount++;
   }
 }
 
-void OpenGLGraphics::PushDrawMatrices() {
-  drawMatVP.Push().LoadIdentity();
+bool OpenGLGraphics::LoadDrawVertexArray(ArrayBuffer* ab, IndexBuffer* ib, OpenGLProgram& prog, ArrayBuffer* instances) {
+  OpenGLArrayBuffer& abOpenGL = *static_cast<OpenGLArrayBuffer*>(ab);
+  GLuint iboId = currentIBOId;
 
-  drawMatView.Push() = view;
-
-  drawMatVP.Multiply(projection * drawMatView);
+  // LoadDrawIndexBuffer has already loaded the index buffer when it could.
+  OpenGLIndexBuffer* ibOpenGL = nullptr;
+  if(ib && ib->IsLoadedIntoVRAM()) {
+    ibOpenGL = static_cast<OpenGLIndexBuffer*>(ib);
+  }
 
-  drawMatModel.Push() = model;
+  OpenGLArrayBuffer* instancesOpenGL = nullptr;
+  if(instances) {
+    instancesOpenGL = static_cast<OpenGLArrayBuffer*>(instances);
 
-  drawMatMV.Push() = drawMatView * drawMatModel;
-  drawMatMVP.Push() = drawMatVP * drawMatModel;
-}
+    if(instancesOpenGL->IsDataModified())
+      instancesOpenGL->Sync();
 
-void OpenGLGraphics::PopDrawTexChannelTupleList() {
-  for(size_t i = 0; i < maxTexUnits; i++) {
-    PopDrawTex(i);
+    if(!instancesOpenGL->IsLoadedIntoVRAM())
+      instancesOpenGL->LoadIntoVRAM();
   }
-}
 
-void OpenGLGraphics::PopDrawTex(size_t unit) {
-  if(unit >= maxTexUnits)
-    return;
+  // Instanced draws always go through a vertex array since the per-instance
+  // attributes need divisors that the default vertex array should not keep.
+  if((vertexArrayCacheEnabled || instances) && abOpenGL.IsLoadedIntoVRAM()) {
+    bool created;
+    OpenGLArrayBufferVertexArray* vertexArray = abOpenGL.GetVertexArray(prog, ibOpenGL, instancesOpenGL, created);
+    if(vertexArray) {
+      if(created) {
+        currentVAOId = vertexArray->vaoId;
+        frameStats.vertexArrayBuildCount++;
+        frameStats.vertexAttributeCallCount += vertexArray->attributeCallCount;
+      }
+      else if(vertexArray->vaoId != currentVAOId) {
+        GLCMD(glBindVertexArray(vertexArray->vaoId));
+        currentVAOId = vertexArray->vaoId;
+        frameStats.vertexArrayBindCount++;
+      }
 
-  GLint unitGL = (GLint) unit;
-  auto& currentTextureStack = currentTextureStacks[unit];
-  OpenGLGraphicsCurrentTexture prevTexture = currentTextureStack;
-  currentTextureStack.Pop();
+      // Compare serials rather than GL names, since an unloaded index buffer's
+      // name can be handed out again to a different buffer.
+      u64 indexSerial = ibOpenGL ? ibOpenGL->GetSerial() : 0;
+      if(vertexArray->indexSerial != indexSerial) {
+        GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId));
+        vertexArray->indexSerial = indexSerial;
+        frameStats.indexBufferBindCount++;
+      }
 
-  OpenGLGraphicsCurrentTexture& currentTexture = currentTextureStack;
+      return true;
+    }
+  }
 
-  if(currentTexture.tex) {
-    OpenGLTex& texOpenGL = *static_cast<OpenGLTex*>((Tex*) currentTexture.tex);
+  if(instances)
+    return false;
 
-    if(!texOpenGL.IsLoadedIntoVRAM())
-      texOpenGL.LoadIntoVRAM();
+  // Uncached path: set up the default vertex array attribute by attribute.
+  if(currentVAOId != 0) {
+    GLCMD(glBindVertexArray(0));
+    currentVAOId = 0;
+    frameStats.vertexArrayBindCount++;
+  }
 
-    if(texOpenGL.IsLoadedIntoVRAM()) {
-      if(currentTexture.tex != prevTexture.tex || currentTexture.channel != prevTexture.channel) {
-        if(prevTexture.channel == TexChannelMain) {
-          GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-          GLCMD(glBindTexture(GL_TEXTURE_2D, texOpenGL.GetTextureId()));
-          GLCMD(glActiveTexture(GL_TEXTURE0));
-        }
-        else if(prevTexture.channel == TexChannelDepth) {
-          GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-          GLCMD(glBindTexture(GL_TEXTURE_2D, texOpenGL.GetDepthTextureId()));
-          GLCMD(glActiveTexture(GL_TEXTURE0));
-        }
-        else {
-          currentTexture.enabled = false;
-          GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-          GLCMD(glBindTexture(GL_TEXTURE_2D, 0));
-          GLCMD(glActiveTexture(GL_TEXTURE0));
-        }
+  GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId));
+  frameStats.indexBufferBindCount++;
+
+  GLsizei vertexStride = (GLsizei) ab->GetItemSize();
+
+  size_t attributeCount = prog.GetAttributeCount();
+  for(size_t i = 0; i < attributeCount; i++) {
+    const OpenGLProgramAttributeInfo* info = prog.GetAttributeInfo(i);
+    if(info) {
+      const ArrayBufferAttribute* attribute = ab->GetAttribute(info->name);
+      if(attribute) {
+        frameStats.vertexAttributeCallCount += OpenGLArrayBuffer::LoadVertexAttribute(*info, *attribute, vertexStride, 0);
       }
     }
-    else {
-      currentTexture.enabled = false;
-      GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-      GLCMD(glBindTexture(GL_TEXTURE_2D, 0));
-      GLCMD(glActiveTexture(GL_TEXTURE0));
-    }
-  }
-  else {
-    if(prevTexture.tex != nullptr) {
-      GLCMD(glActiveTexture(GL_TEXTURE0 + unitGL));
-      GLCMD(glBindTexture(GL_TEXTURE_2D, 0));
-      GLCMD(glActiveTexture(GL_TEXTURE0));
-    }
   }
-}
 
-void OpenGLGraphics::PopDrawIndexBuffer() {
-  currentIBOId.Pop();
+  return true;
 }
 
-void OpenGLGraphics::PopDrawArrayBuffer() {
-  currentABOId.Pop();
-}
-
-void OpenGLGraphics::PopDrawProgram() {
-  currentProgramId.Pop();
-}
-
-void OpenGLGraphics::PopDrawMatrices() {
-  drawMatMVP.Pop();
-  drawMatModel.Pop();
-  drawMatView.Pop();
-  drawMatVP.Pop();
-  drawMatMV.Pop();
+void OpenGLGraphics::LoadDrawViewport() {
+  LoadDrawViewport(viewport);
 }
 
-void OpenGLGraphics::LoadDrawViewport() {
-  if(viewport.x != currentViewport.x || viewport.y != currentViewport.y || viewport.w != currentViewport.w || viewport.h != currentViewport.h) {
-    currentViewport = viewport;
+void OpenGLGraphics::LoadDrawViewport(const Viewport& drawViewport) {
+  if(drawViewport.x != currentViewport.x || drawViewport.y != currentViewport.y || drawViewport.w != currentViewport.w || drawViewport.h != currentViewport.h) {
+    currentViewport = drawViewport;
     GLCMD(glViewport((GLint) currentViewport.x, (GLint) currentViewport.y, (GLsizei) currentViewport.w, (GLsizei) currentViewport.h));
+    frameStats.viewportChangeCount++;
   }
 }
 
 void OpenGLGraphics::LoadDrawDepth() {
-  if(depthMask != currentDepthMask) {
-    currentDepthMask = depthMask;
+  LoadDrawDepth(depthMask, depthEnabled);
+}
+
+void OpenGLGraphics::LoadDrawDepth(bool drawDepthMask, bool drawDepthEnabled) {
+  if(drawDepthMask != currentDepthMask) {
+    currentDepthMask = drawDepthMask;
+    frameStats.depthStateChangeCount++;
     if(currentDepthMask) {
       GLCMD(glDepthMask(GL_TRUE));
     }
@@ -735,8 +1258,9 @@ void OpenGLGraphics::LoadDrawDepth() {
     }
   }
 
-  if(depthEnabled != currentDepthEnabled) {
-    currentDepthEnabled = depthEnabled;
+  if(drawDepthEnabled != currentDepthEnabled) {
+    currentDepthEnabled = drawDepthEnabled;
+    frameStats.depthStateChangeCount++;
     if(currentDepthEnabled) {
       GLCMD(glEnable(GL_DEPTH_TEST));
     }
@@ -746,6 +1270,27 @@ void OpenGLGraphics::LoadDrawDepth() {
   }
 }
 
+void OpenGLGraphics::LoadDrawClipPlanes(u32 clipMask) {
+  u32 changed = clipMask ^ currentClipMask;
+  if(!changed)
+    return;
+
+  for(u32 i = 0; i < PRIME_DEVICE_PROGRAM_CLIP_PLANE_COUNT; i++) {
+    u32 bit = 1 << i;
+    if(changed & bit) {
+      if(clipMask & bit) {
+        GLCMD(glEnable(GL_CLIP_DISTANCE0 + i));
+      }
+      else {
+        GLCMD(glDisable(GL_CLIP_DISTANCE0 + i));
+      }
+    }
+  }
+
+  currentClipMask = clipMask;
+  frameStats.clipStateChangeCount++;
+}
+
 void OnKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
   PxOpenGLKeyboard.OnKey(window, key, scancode, action, mods);
 }
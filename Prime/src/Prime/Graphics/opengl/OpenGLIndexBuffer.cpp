@@ -37,6 +37,12 @@ SOFTWARE.
 
 using namespace Prime;
 
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static u64 serialCounter = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Constants
 ////////////////////////////////////////////////////////////////////////////////
@@ -53,7 +59,8 @@ static const size_t IndexBufferDataSizeTable[] = {
 ////////////////////////////////////////////////////////////////////////////////
 
 OpenGLIndexBuffer::OpenGLIndexBuffer(IndexFormat format, const void* data, size_t indexCount): IndexBuffer(format, data, indexCount),
-iboId(GL_NONE) {
+iboId(GL_NONE),
+serial(0) {
   dataSize = indexCount * IndexBufferDataSizeTable[format];
 
   this->data = malloc(dataSize);
@@ -92,6 +99,10 @@ bool OpenGLIndexBuffer::LoadIntoVRAM() {
 
   GLCMD(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id));
 
+  // GL buffer names are reused after deletion, so vertex arrays that hold this
+  // buffer as their element array key on the serial instead.
+  serial = ++serialCounter;
+
   dataModified = false;
 
   loadedIntoVRAM = true;
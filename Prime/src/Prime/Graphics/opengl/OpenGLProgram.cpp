@@ -35,15 +35,40 @@ SOFTWARE.
 
 using namespace Prime;
 
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static u64 layoutIdCounter = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t GetVariableStride(const OpenGLProgramVariableInfo* info, size_t itemSize) {
+  if(info->arraySize) {
+    return (info->itemSize + (info->itemAlignmentSize - 1)) / info->itemAlignmentSize * info->itemAlignmentSize;
+  }
+
+  return itemSize;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
 
 OpenGLProgram::OpenGLProgram(const void* vertexShaderData, size_t vertexShaderDataSize, const void* fragmentShaderData, size_t fragmentShaderDataSize): DeviceProgram(vertexShaderData, vertexShaderDataSize, fragmentShaderData, fragmentShaderDataSize),
+layoutId(0),
 variableBufferId(GL_NONE),
 uniformBlockIndex(GL_INVALID_INDEX),
 variableBuffer(nullptr),
 variableBufferSize(0),
+variableBufferUsedSize(0),
+variableDirtyBegin(0),
+variableDirtyEnd(0),
+variableBufferIdSynced(false),
+variableRingSerial(0),
+variableRingOffset(0),
 variableInfo(nullptr),
 variableInfoCount(0),
 attributeInfo(nullptr),
@@ -52,10 +77,17 @@ attributeInfoCount(0) {
 }
 
 OpenGLProgram::OpenGLProgram(DeviceShader* vertexShader, DeviceShader* fragmentShader): DeviceProgram(vertexShader, fragmentShader),
+layoutId(0),
 variableBufferId(GL_NONE),
 uniformBlockIndex(GL_INVALID_INDEX),
 variableBuffer(nullptr),
 variableBufferSize(0),
+variableBufferUsedSize(0),
+variableDirtyBegin(0),
+variableDirtyEnd(0),
+variableBufferIdSynced(false),
+variableRingSerial(0),
+variableRingOffset(0),
 variableInfo(nullptr),
 variableInfoCount(0),
 attributeInfo(nullptr),
@@ -64,10 +96,17 @@ attributeInfoCount(0) {
 }
 
 OpenGLProgram::OpenGLProgram(const char* vertexShaderPath, const char* fragmentShaderPath): DeviceProgram(vertexShaderPath, fragmentShaderPath),
+layoutId(0),
 variableBufferId(GL_NONE),
 uniformBlockIndex(GL_INVALID_INDEX),
 variableBuffer(nullptr),
 variableBufferSize(0),
+variableBufferUsedSize(0),
+variableDirtyBegin(0),
+variableDirtyEnd(0),
+variableBufferIdSynced(false),
+variableRingSerial(0),
+variableRingOffset(0),
 variableInfo(nullptr),
 variableInfoCount(0),
 attributeInfo(nullptr),
@@ -116,6 +155,10 @@ bool OpenGLProgram::LoadIntoVRAM() {
   GLCMD(glBufferData(GL_UNIFORM_BUFFER, variableBufferSize, variableBuffer, GL_STATIC_DRAW));
   GLCMD(glBindBufferBase(GL_UNIFORM_BUFFER, 0, variableBufferId));
   GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, oldVariableBufferId));
+  PxOpenGLGraphics.GetUniformRing().ResetBinding();
+
+  variableBufferIdSynced = true;
+  variableRingSerial = 0;
 
   loadedIntoVRAM = true;
 
@@ -150,6 +193,10 @@ bool OpenGLProgram::UnloadFromVRAM() {
 }
 
 void OpenGLProgram::ProcessOpenGLProgramData() {
+  // Every link gets a new layout id so cached vertex arrays built against an
+  // older link, or another program reusing the same GL name, are not matched.
+  layoutId = ++layoutIdCounter;
+
   uniformBlockIndex = GLCMD(glGetUniformBlockIndex(programId, "ShaderUniformBlock"));
   if(uniformBlockIndex != GL_INVALID_INDEX) {
     GLCMD(glUniformBlockBinding(programId, uniformBlockIndex, 0));
@@ -161,10 +208,14 @@ void OpenGLProgram::ProcessOpenGLProgramData() {
 
   variableBuffer = memalign(64, variableBufferSize);
   memset(variableBuffer, 0, variableBufferSize);
+  variableBufferUsedSize = 0;
+  variableDirtyBegin = variableBufferSize;
+  variableDirtyEnd = 0;
 
   GLint queryVariableInfoCount = 0;
   GLCMD(glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &queryVariableInfoCount));
   variableInfoCount = queryVariableInfoCount;
+  variableInfoByHandle.clear();
 
   if(variableInfoCount > 0) {
     variableInfo = new OpenGLProgramVariableInfo[variableInfoCount];
@@ -186,7 +237,14 @@ void OpenGLProgram::ProcessOpenGLProgramData() {
           name = name.substr(0, charPos);
         }
 
-        PrimeAssert(!variableInfoLookup.HasKey(name), "Variable info already exists by name: %s", name.c_str());
+        ProgramVariableHandle handle(name);
+        if(handle.GetId() >= variableInfoByHandle.size()) {
+          variableInfoByHandle.resize(handle.GetId() + 1, nullptr);
+        }
+
+        PrimeAssert(!variableInfoByHandle[handle.GetId()], "Variable info already exists by name: %s", name.c_str());
+
+        info.name = name;
 
         GLint uniformParam = 0;
 
@@ -217,9 +275,16 @@ void OpenGLProgram::ProcessOpenGLProgramData() {
           else {
             info.arraySize = 0;
           }
+
+          // Scalars, vectors and matrices always count as used so a ring upload
+          // never leaves them stale. Arrays grow the used size as they are set.
+          size_t usedEnd = info.arraySize ? info.addr : std::min(info.addr + sizeof(Mat44), variableBufferSize);
+          if(usedEnd > variableBufferUsedSize) {
+            variableBufferUsedSize = usedEnd;
+          }
         }
 
-        variableInfoLookup[name] = &info;
+        variableInfoByHandle[handle.GetId()] = &info;
       }
     }
   }
@@ -271,6 +336,15 @@ void OpenGLProgram::ProcessOpenGLProgramData() {
           itemSize = sizeof(Vec4);
           break;
 
+        case GL_FLOAT_MAT4:
+          itemSize = sizeof(Mat44);
+          break;
+
+        case GL_UNSIGNED_INT_VEC4:
+        case GL_INT_VEC4:
+          itemSize = sizeof(u32) * 4;
+          break;
+
         default:
           dbgprintf("[Warning] Unsupported attribute type: name = %s", name.c_str());
           break;
@@ -300,389 +374,333 @@ void OpenGLProgram::CheckVariableStatus() {
   }
 }
 
-void OpenGLProgram::SetVariable(const std::string& name, s32 v) {
+void OpenGLProgram::SetVariable(ProgramVariableHandle handle, s32 v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t addr = variableInfo->addr;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      s32* p = (s32*)&(((u8*) variableBuffer)[addr]);
-      *p = v;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableData(variableInfo->addr, &v, sizeof(s32));
     }
   }
   else {
-    DeviceProgram::SetVariable(name, v);
+    DeviceProgram::SetVariable(handle, v);
   }
 }
 
-void OpenGLProgram::SetVariable(const std::string& name, f32 v) {
+void OpenGLProgram::SetVariable(ProgramVariableHandle handle, f32 v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t addr = variableInfo->addr;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p = v;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableData(variableInfo->addr, &v, sizeof(f32));
     }
   }
   else {
-    DeviceProgram::SetVariable(name, v);
+    DeviceProgram::SetVariable(handle, v);
   }
 }
 
-void OpenGLProgram::SetVariable(const std::string& name, const Vec2& v) {
+void OpenGLProgram::SetVariable(ProgramVariableHandle handle, const Vec2& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t addr = variableInfo->addr;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v.x;
-      *p++ = v.y;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableData(variableInfo->addr, &v.x, sizeof(f32) * 2);
     }
   }
   else {
-    DeviceProgram::SetVariable(name, v);
+    DeviceProgram::SetVariable(handle, v);
   }
 }
 
-void OpenGLProgram::SetVariable(const std::string& name, const Vec3& v) {
+void OpenGLProgram::SetVariable(ProgramVariableHandle handle, const Vec3& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t addr = variableInfo->addr;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v.x;
-      *p++ = v.y;
-      *p++ = v.z;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableData(variableInfo->addr, &v.x, sizeof(f32) * 3);
     }
   }
   else {
-    DeviceProgram::SetVariable(name, v);
+    DeviceProgram::SetVariable(handle, v);
   }
 }
 
-void OpenGLProgram::SetVariable(const std::string& name, const Vec4& v) {
+void OpenGLProgram::SetVariable(ProgramVariableHandle handle, const Vec4& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t addr = variableInfo->addr;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v.x;
-      *p++ = v.y;
-      *p++ = v.z;
-      *p++ = v.w;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableData(variableInfo->addr, &v.x, sizeof(f32) * 4);
     }
   }
   else {
-    DeviceProgram::SetVariable(name, v);
+    DeviceProgram::SetVariable(handle, v);
   }
 }
 
-void OpenGLProgram::SetVariable(const std::string& name, const Mat44& v) {
+void OpenGLProgram::SetVariable(ProgramVariableHandle handle, const Mat44& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t addr = variableInfo->addr;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      for(u32 i = 0; i < 16; i++) {
-        *p++ = v.e[i];
-      }
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableData(variableInfo->addr, v.e, sizeof(v.e));
     }
   }
   else {
-    DeviceProgram::SetVariable(name, v);
+    DeviceProgram::SetVariable(handle, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, s32 v) {
+void OpenGLProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, s32 v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t useItemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-      size_t addr = variableInfo->addr + useItemSize * arrayIndex;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      s32* p = (s32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
+      WriteVariableData(variableInfo->addr + itemSize * arrayIndex, &v, sizeof(s32));
     }
     else {
       PrimeAssert(false, "Setting array variable on a non-array uniform.");
     }
   }
   else {
-    DeviceProgram::SetArrayVariable(name, arrayIndex, v);
+    DeviceProgram::SetArrayVariable(handle, arrayIndex, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, f32 v) {
+void OpenGLProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, f32 v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      size_t useItemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-      size_t addr = variableInfo->addr + useItemSize * arrayIndex;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v;
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
+      WriteVariableData(variableInfo->addr + itemSize * arrayIndex, &v, sizeof(f32));
     }
   }
   else {
-    DeviceProgram::SetArrayVariable(name, arrayIndex, v);
+    DeviceProgram::SetArrayVariable(handle, arrayIndex, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec2& v) {
+void OpenGLProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec2& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
+    if(auto variableInfo = GetVariableInfo(handle)) {
       size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-      size_t addr = variableInfo->addr + itemSize * arrayIndex;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v.x;
-      *p++ = v.y;
+      WriteVariableData(variableInfo->addr + itemSize * arrayIndex, &v.x, sizeof(f32) * 2);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable(name, arrayIndex, v);
+    DeviceProgram::SetArrayVariable(handle, arrayIndex, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec3& v) {
+void OpenGLProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec3& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
+    if(auto variableInfo = GetVariableInfo(handle)) {
       size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-      size_t addr = variableInfo->addr + itemSize * arrayIndex;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v.x;
-      *p++ = v.y;
-      *p++ = v.z;
+      WriteVariableData(variableInfo->addr + itemSize * arrayIndex, &v.x, sizeof(f32) * 3);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable(name, arrayIndex, v);
+    DeviceProgram::SetArrayVariable(handle, arrayIndex, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Vec4& v) {
+void OpenGLProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Vec4& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
+    if(auto variableInfo = GetVariableInfo(handle)) {
       size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-      size_t addr = variableInfo->addr + itemSize * arrayIndex;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      *p++ = v.x;
-      *p++ = v.y;
-      *p++ = v.z;
-      *p++ = v.w;
+      WriteVariableData(variableInfo->addr + itemSize * arrayIndex, &v.x, sizeof(f32) * 4);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable(name, arrayIndex, v);
+    DeviceProgram::SetArrayVariable(handle, arrayIndex, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable(const std::string& name, size_t arrayIndex, const Mat44& v) {
+void OpenGLProgram::SetArrayVariable(ProgramVariableHandle handle, size_t arrayIndex, const Mat44& v) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
+    if(auto variableInfo = GetVariableInfo(handle)) {
       size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-      size_t addr = variableInfo->addr + itemSize * arrayIndex;
-      PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-      f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-      for(u32 i = 0; i < 16; i++) {
-        *p++ = v.e[i];
-      }
+      WriteVariableData(variableInfo->addr + itemSize * arrayIndex, v.e, sizeof(v.e));
     }
   }
   else {
-    DeviceProgram::SetArrayVariable(name, arrayIndex, v);
+    DeviceProgram::SetArrayVariable(handle, arrayIndex, v);
   }
 }
 
-void OpenGLProgram::SetArrayVariable1fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void OpenGLProgram::SetArrayVariable1fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      if(variableInfo->arraySize) {
-        size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          *p = v[i];
-        }
-      }
-      else {
-        size_t itemSize = sizeof(f32);
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          *p = v[i];
-        }
-      }
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableArrayData(variableInfo, v, sizeof(f32) * 1, count, start);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable1fv(name, v, count, start);
+    DeviceProgram::SetArrayVariable1fv(handle, v, count, start);
   }
 }
 
-void OpenGLProgram::SetArrayVariable2fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void OpenGLProgram::SetArrayVariable2fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      if(variableInfo->arraySize) {
-        size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i << 1];
-          *p++ = *s++;
-          *p++ = *s++;
-        }
-      }
-      else {
-        size_t itemSize = sizeof(f32) * 2;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i << 1];
-          *p++ = *s++;
-          *p++ = *s++;
-        }
-      }
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableArrayData(variableInfo, v, sizeof(f32) * 2, count, start);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable2fv(name, v, count, start);
+    DeviceProgram::SetArrayVariable2fv(handle, v, count, start);
   }
 }
 
-void OpenGLProgram::SetArrayVariable3fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void OpenGLProgram::SetArrayVariable3fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      if(variableInfo->arraySize) {
-        size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i * 3];
-          *p++ = *s++;
-          *p++ = *s++;
-          *p++ = *s++;
-        }
-      }
-      else {
-        size_t itemSize = sizeof(f32) * 3;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i * 3];
-          *p++ = *s++;
-          *p++ = *s++;
-          *p++ = *s++;
-        }
-      }
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableArrayData(variableInfo, v, sizeof(f32) * 3, count, start);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable3fv(name, v, count, start);
+    DeviceProgram::SetArrayVariable3fv(handle, v, count, start);
   }
 }
 
-void OpenGLProgram::SetArrayVariable4fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void OpenGLProgram::SetArrayVariable4fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      if(variableInfo->arraySize) {
-        size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i << 2];
-          *p++ = *s++;
-          *p++ = *s++;
-          *p++ = *s++;
-          *p++ = *s++;
-        }
-      }
-      else {
-        size_t itemSize = sizeof(f32) * 4;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i << 2];
-          *p++ = *s++;
-          *p++ = *s++;
-          *p++ = *s++;
-          *p++ = *s++;
-        }
-      }
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableArrayData(variableInfo, v, sizeof(f32) * 4, count, start);
     }
   }
   else {
-    DeviceProgram::SetArrayVariable4fv(name, v, count, start);
+    DeviceProgram::SetArrayVariable4fv(handle, v, count, start);
   }
 }
 
-void OpenGLProgram::SetArrayVariableMat44fv(const std::string& name, const f32* v, size_t count, size_t start) {
+void OpenGLProgram::SetArrayVariableMat44fv(ProgramVariableHandle handle, const f32* v, size_t count, size_t start) {
   if(loadedIntoVRAM) {
-    if(auto it = variableInfoLookup.Find(name)) {
-      auto variableInfo = it.value();
-      if(variableInfo->arraySize) {
-        size_t itemSize = (variableInfo->itemSize + (variableInfo->itemAlignmentSize - 1)) / variableInfo->itemAlignmentSize * variableInfo->itemAlignmentSize;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i << 4];
-          for(u32 j = 0; j < 16; j++) {
-            p[j] = s[j];
-          }
-        }
-      }
-      else {
-        size_t itemSize = sizeof(f32) * 16;
-        for(size_t i = 0; i < count; i++) {
-          size_t addr = variableInfo->addr + itemSize * (i + start);
-          PrimeAssert(addr < variableBufferSize, "Program variable address is out of range.");
-          f32* p = (f32*)&(((u8*) variableBuffer)[addr]);
-          const f32* s = &v[i << 4];
-          for(u32 j = 0; j < 16; j++) {
-            p[j] = s[j];
-          }
-        }
-      }
+    if(auto variableInfo = GetVariableInfo(handle)) {
+      WriteVariableArrayData(variableInfo, v, sizeof(f32) * 16, count, start);
     }
   }
   else {
-    DeviceProgram::SetArrayVariableMat44fv(name, v, count, start);
+    DeviceProgram::SetArrayVariableMat44fv(handle, v, count, start);
   }
 }
 
 void OpenGLProgram::LoadVariablesToShaderStage() {
-  if(uniformBlockIndex != -1) {
-    GLint id;
-    GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &id));
-    GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, variableBufferId));
-    GLCMD(glBufferData(GL_UNIFORM_BUFFER, variableBufferSize, variableBuffer, GL_STATIC_DRAW));
-    GLCMD(glBindBufferBase(GL_UNIFORM_BUFFER, 0, variableBufferId));
-    GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, id));
+  if(uniformBlockIndex == -1)
+    return;
+
+  OpenGLUniformRing& ring = PxOpenGLGraphics.GetUniformRing();
+  bool dirty = variableDirtyBegin < variableDirtyEnd;
+
+  if(ring.IsReady()) {
+    if(!dirty && variableRingSerial == ring.GetFrameSerial()) {
+      // Nothing changed since this program's last upload in the current frame,
+      // so the block already in the ring can be bound again as is.
+      ring.CountReuse();
+      ring.BindRange(0, variableRingOffset, (GLsizeiptr) variableBufferSize);
+      return;
+    }
+
+    GLintptr offset;
+    if(ring.Upload(variableBuffer, variableBufferUsedSize, variableBufferSize, offset)) {
+      variableRingSerial = ring.GetFrameSerial();
+      variableRingOffset = offset;
+      variableBufferIdSynced = false;
+      variableDirtyBegin = variableBufferSize;
+      variableDirtyEnd = 0;
+
+      ring.BindRange(0, offset, (GLsizeiptr) variableBufferSize);
+      return;
+    }
+  }
+
+  // The ring is unavailable or full for this frame, so use the program's own
+  // buffer. Earlier draws may still be reading it, so it is orphaned rather
+  // than written in place; nothing needs to go up while it is in sync.
+  size_t uploadSize = 0;
+  if(!variableBufferIdSynced || dirty) {
+    uploadSize = variableBufferUsedSize;
+  }
+
+  GLint id;
+  GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &id));
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, variableBufferId));
+  if(uploadSize > 0) {
+    GLCMD(glBufferData(GL_UNIFORM_BUFFER, variableBufferSize, nullptr, GL_STREAM_DRAW));
+    GLCMD(glBufferSubData(GL_UNIFORM_BUFFER, 0, (GLsizeiptr) uploadSize, variableBuffer));
   }
+  GLCMD(glBindBufferBase(GL_UNIFORM_BUFFER, 0, variableBufferId));
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, id));
+
+  ring.ResetBinding();
+  ring.CountFallback(uploadSize);
+
+  variableRingSerial = 0;
+  variableBufferIdSynced = true;
+  variableDirtyBegin = variableBufferSize;
+  variableDirtyEnd = 0;
+}
+
+size_t OpenGLProgram::GetVariableBlockExtent(ProgramVariableHandle handle, size_t itemSize, size_t count) const {
+  if(count == 0)
+    return 0;
+
+  if(auto variableInfo = GetVariableInfo(handle)) {
+    size_t stride = GetVariableStride(variableInfo, itemSize * sizeof(f32));
+    return min(variableInfo->addr + stride * (count - 1) + itemSize * sizeof(f32), variableBufferSize);
+  }
+
+  return 0;
+}
+
+void OpenGLProgram::WriteVariableBlockData(void* block, ProgramVariableHandle handle, const f32* data, size_t itemSize, size_t count) const {
+  if(count == 0)
+    return;
+
+  if(auto variableInfo = GetVariableInfo(handle)) {
+    size_t itemBytes = itemSize * sizeof(f32);
+    size_t stride = GetVariableStride(variableInfo, itemBytes);
+    u8* d = (u8*) block;
+    const u8* s = (const u8*) data;
+
+    if(stride == itemBytes) {
+      PrimeAssert(variableInfo->addr + itemBytes * count <= variableBufferSize, "Program variable address is out of range.");
+      memcpy(&d[variableInfo->addr], s, itemBytes * count);
+    }
+    else {
+      PrimeAssert(variableInfo->addr + stride * (count - 1) + itemBytes <= variableBufferSize, "Program variable address is out of range.");
+      for(size_t i = 0; i < count; i++) {
+        memcpy(&d[variableInfo->addr + stride * i], s + itemBytes * i, itemBytes);
+      }
+    }
+  }
+}
+
+size_t OpenGLProgram::GetVariableBlockExtent(const std::string& name, size_t itemSize, size_t count) const {
+  return GetVariableBlockExtent(ProgramVariableHandle::Find(name), itemSize, count);
+}
+
+void OpenGLProgram::WriteVariableBlockData(void* block, const std::string& name, const f32* data, size_t itemSize, size_t count) const {
+  WriteVariableBlockData(block, ProgramVariableHandle::Find(name), data, itemSize, count);
+}
+
+void OpenGLProgram::LoadVariableBlockToShaderStage(const void* block, size_t blockSize) {
+  if(uniformBlockIndex == -1)
+    return;
+
+  PrimeAssert(blockSize <= variableBufferSize, "Program variable block is too large.");
+
+  // The bound block no longer reflects this program's own variables, so the
+  // next immediate draw has to upload them again.
+  variableRingSerial = 0;
+
+  OpenGLUniformRing& ring = PxOpenGLGraphics.GetUniformRing();
+
+  if(ring.IsReady()) {
+    GLintptr offset;
+    if(ring.Upload(block, blockSize, variableBufferSize, offset)) {
+      ring.BindRange(0, offset, (GLsizeiptr) variableBufferSize);
+      return;
+    }
+  }
+
+  GLint id;
+  GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &id));
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, variableBufferId));
+  GLCMD(glBufferData(GL_UNIFORM_BUFFER, variableBufferSize, nullptr, GL_STREAM_DRAW));
+  GLCMD(glBufferSubData(GL_UNIFORM_BUFFER, 0, (GLsizeiptr) blockSize, block));
+  GLCMD(glBindBufferBase(GL_UNIFORM_BUFFER, 0, variableBufferId));
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, id));
+
+  ring.ResetBinding();
+  ring.CountFallback(blockSize);
+
+  variableBufferIdSynced = false;
 }
 
 const OpenGLProgramVariableInfo* OpenGLProgram::GetVariableInfo(size_t index) const {
@@ -693,11 +711,7 @@ const OpenGLProgramVariableInfo* OpenGLProgram::GetVariableInfo(size_t index) co
 }
 
 const OpenGLProgramVariableInfo* OpenGLProgram::GetVariableInfo(const std::string& name) const {
-  if(auto it = variableInfoLookup.Find(name)) {
-    return it.value();
-  }
-
-  return nullptr;
+  return GetVariableInfo(ProgramVariableHandle::Find(name));
 }
 
 const OpenGLProgramAttributeInfo* OpenGLProgram::GetAttributeInfo(size_t index) const {
@@ -715,6 +729,53 @@ GLint OpenGLProgram::GetTextureLoc(size_t unit) const {
   return -1;
 }
 
+void OpenGLProgram::WriteVariableData(size_t addr, const void* data, size_t size) {
+  PrimeAssert(addr + size <= variableBufferSize, "Program variable address is out of range.");
+
+  // Growing the used size extends what goes up with the block, so the new tail
+  // is dirty even when its bytes already match the values being written.
+  size_t end = addr + size;
+  if(end > variableBufferUsedSize) {
+    if(variableBufferUsedSize < variableDirtyBegin) {
+      variableDirtyBegin = variableBufferUsedSize;
+    }
+    if(end > variableDirtyEnd) {
+      variableDirtyEnd = end;
+    }
+    variableBufferUsedSize = end;
+  }
+
+  u8* p = &((u8*) variableBuffer)[addr];
+  if(memcmp(p, data, size) == 0)
+    return;
+
+  memcpy(p, data, size);
+
+  if(addr < variableDirtyBegin) {
+    variableDirtyBegin = addr;
+  }
+  if(end > variableDirtyEnd) {
+    variableDirtyEnd = end;
+  }
+}
+
+void OpenGLProgram::WriteVariableArrayData(const OpenGLProgramVariableInfo* info, const f32* data, size_t itemSize, size_t count, size_t start) {
+  if(count == 0)
+    return;
+
+  size_t stride = GetVariableStride(info, itemSize);
+
+  if(stride == itemSize) {
+    WriteVariableData(info->addr + stride * start, data, itemSize * count);
+  }
+  else {
+    const u8* s = (const u8*) data;
+    for(size_t i = 0; i < count; i++) {
+      WriteVariableData(info->addr + stride * (i + start), s + itemSize * i, itemSize);
+    }
+  }
+}
+
 void OpenGLProgram::InitOpenGLProgram(DeviceShader* vertexShader, DeviceShader* fragmentShader) {
   OpenGLShader* vertexShaderOpenGL = static_cast<OpenGLShader*>(vertexShader);
   OpenGLShader* fragmentShaderOpenGL = static_cast<OpenGLShader*>(fragmentShader);
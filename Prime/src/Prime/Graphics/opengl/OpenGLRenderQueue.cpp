@@ -0,0 +1,183 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetOpenGL)
+
+#include <Prime/Graphics/opengl/OpenGLRenderQueue.h>
+#include <algorithm>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static std::atomic<u64> queueIdCounter(0);
+static thread_local OpenGLRenderQueueBucket* threadBucket = nullptr;
+static thread_local u64 threadBucketQueueId = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static u64 HashKeyPointer(const void* p) {
+  u64 v = (u64) (uintptr_t) p;
+  v ^= v >> 29;
+  v *= 0x9E3779B97F4A7C15ULL;
+  return v ^ (v >> 32);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+OpenGLRenderQueue::OpenGLRenderQueue():
+id(++queueIdCounter),
+bucketMutex(nullptr),
+sequence(0) {
+  bucketMutex = new ThreadMutex("Render Queue");
+}
+
+OpenGLRenderQueue::~OpenGLRenderQueue() {
+  for(auto bucket: buckets) {
+    delete bucket;
+  }
+
+  PrimeSafeDelete(bucketMutex);
+}
+
+OpenGLRenderQueueBucket& OpenGLRenderQueue::GetThreadBucket() {
+  if(threadBucket && threadBucketQueueId == id)
+    return *threadBucket;
+
+  OpenGLRenderQueueBucket* bucket = new OpenGLRenderQueueBucket;
+  bucket->vpValid = false;
+
+  bucketMutex->Lock();
+  buckets.push_back(bucket);
+  bucketMutex->Unlock();
+
+  threadBucket = bucket;
+  threadBucketQueueId = id;
+
+  return *bucket;
+}
+
+u64 OpenGLRenderQueue::GetNextSequence() {
+  return sequence++;
+}
+
+bool OpenGLRenderQueue::IsEmpty() const {
+  return GetPacketCount() == 0;
+}
+
+size_t OpenGLRenderQueue::GetPacketCount() const {
+  size_t count = 0;
+
+  bucketMutex->Lock();
+  for(auto bucket: buckets) {
+    count += bucket->packets.size();
+  }
+  bucketMutex->Unlock();
+
+  return count;
+}
+
+const std::vector<OpenGLRenderQueueItem>& OpenGLRenderQueue::Sort() {
+  PxRequireMainThread;
+
+  items.clear();
+
+  bucketMutex->Lock();
+  for(auto bucket: buckets) {
+    const u8* uniformData = bucket->uniformData.data();
+    for(const OpenGLRenderPacket& packet: bucket->packets) {
+      OpenGLRenderQueueItem item;
+      item.key = packet.key;
+      item.packet = &packet;
+      item.uniformData = uniformData + packet.uniformOffset;
+      items.push_back(item);
+    }
+  }
+  bucketMutex->Unlock();
+
+  std::stable_sort(items.begin(), items.end(), [](const OpenGLRenderQueueItem& a, const OpenGLRenderQueueItem& b) {
+    return a.key < b.key;
+  });
+
+  return items;
+}
+
+void OpenGLRenderQueue::Clear() {
+  PxRequireMainThread;
+
+  items.clear();
+
+  bucketMutex->Lock();
+  for(auto bucket: buckets) {
+    bucket->packets.clear();
+    bucket->uniformData.clear();
+  }
+  bucketMutex->Unlock();
+}
+
+u64 OpenGLRenderQueue::MakeKey(OpenGLRenderPacketLayer layer, u64 programId, const void* tex, const void* ab, f32 depth, u64 sequence) {
+  u64 key = ((u64) layer & 0x3) << 62;
+
+  if(depth < 0.0f) {
+    depth = 0.0f;
+  }
+  else if(depth > 1.0f) {
+    depth = 1.0f;
+  }
+
+  switch(layer) {
+  case OpenGLRenderPacketLayerOpaque: {
+    u64 depthBits = (u64) (depth * 65535.0f);
+    key |= (programId & 0xFFFF) << 46;
+    key |= (HashKeyPointer(tex) & 0xFFFF) << 30;
+    key |= (HashKeyPointer(ab) & 0x3FFF) << 16;
+    key |= depthBits;
+    break;
+  }
+  case OpenGLRenderPacketLayerTransparent: {
+    u64 depthBits = 0xFFFFFF - (u64) (depth * 16777215.0f);
+    key |= depthBits << 38;
+    key |= (programId & 0xFFFF) << 22;
+    key |= (HashKeyPointer(tex) & 0xFFFF) << 6;
+    key |= HashKeyPointer(ab) & 0x3F;
+    break;
+  }
+  default:
+    key |= sequence & 0x3FFFFFFFFFFFFFFFULL;
+    break;
+  }
+
+  return key;
+}
+
+#endif
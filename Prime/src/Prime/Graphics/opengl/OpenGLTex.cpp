@@ -238,6 +238,7 @@ bool OpenGLTex::LoadIntoVRAMOpenGLTex() {
   if(levelCount > 0) {
     TexData* prevTexData = nullptr;
     size_t level = 0;
+    size_t uploadBytes = 0;
     for(const auto& item: levels) {
       TexData* texData = item.texData;
 
@@ -247,6 +248,7 @@ bool OpenGLTex::LoadIntoVRAMOpenGLTex() {
 
       if(LoadPixelDataIntoBuffer(texData)) {
         GLint levelGL = (GLint) level;
+        u32 prevLoadedLevelCount = loadedLevelCount;
 
         if(texData->format == TexFormatNative) {
           const std::string& formatName = texData->formatName;
@@ -338,6 +340,10 @@ bool OpenGLTex::LoadIntoVRAMOpenGLTex() {
             break;
           }
         }
+
+        if(loadedLevelCount != prevLoadedLevelCount) {
+          uploadBytes += texData->pixels->GetSize();
+        }
       }
 
       level++;
@@ -346,6 +352,8 @@ bool OpenGLTex::LoadIntoVRAMOpenGLTex() {
 
     GLCMD(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint) loadedLevelCount - 1));
 
+    PxOpenGLGraphics.AddTexUpload(uploadBytes);
+
     if(filteringEnabled) {
       GLCMD(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
       if(loadedLevelCount > 1) {
@@ -0,0 +1,313 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetOpenGL)
+
+#include <Prime/Graphics/opengl/OpenGLUniformRing.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define OpenGLUniformRingFenceTimeout 1000000000ULL
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+
+typedef void (APIENTRYP OpenGLBufferStorageProc)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+OpenGLUniformRing::OpenGLUniformRing():
+bufferId(GL_NONE),
+mapping(nullptr),
+persistent(false),
+frameSize(0),
+frameCount(0),
+frameIndex(0),
+frameHead(0),
+frameDemand(0),
+frameSerial(0),
+frameFences(nullptr),
+offsetAlignment(256),
+boundIndex(GL_INVALID_INDEX),
+boundOffset(0),
+boundSize(0) {
+  memset(&stats, 0, sizeof(stats));
+  memset(&lastFrameStats, 0, sizeof(lastFrameStats));
+}
+
+OpenGLUniformRing::~OpenGLUniformRing() {
+  Shutdown();
+}
+
+bool OpenGLUniformRing::Init(size_t frameSize, size_t frameCount) {
+  PxRequireMainThread;
+
+  if(bufferId)
+    return true;
+
+  if(frameSize == 0 || frameCount == 0)
+    return false;
+
+  GLint queryAlignment = 0;
+  GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &queryAlignment));
+  if(queryAlignment > 0) {
+    offsetAlignment = (size_t) queryAlignment;
+  }
+
+  this->frameSize = (frameSize + (offsetAlignment - 1)) / offsetAlignment * offsetAlignment;
+  this->frameCount = frameCount;
+  size_t totalSize = this->frameSize * frameCount;
+
+  OpenGLBufferStorageProc bufferStorage = nullptr;
+  if(glfwExtensionSupported("GL_ARB_buffer_storage")) {
+    bufferStorage = (OpenGLBufferStorageProc) glfwGetProcAddress("glBufferStorage");
+  }
+
+  GLint oldBufferId;
+  GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &oldBufferId));
+  GLCMD(glGenBuffers(1, &bufferId));
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, bufferId));
+
+  if(bufferStorage) {
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLCMD(bufferStorage(GL_UNIFORM_BUFFER, (GLsizeiptr) totalSize, nullptr, flags));
+    if(!IsOpenGLOutOfMemory()) {
+      mapping = (u8*) GLCMD(glMapBufferRange(GL_UNIFORM_BUFFER, 0, (GLsizeiptr) totalSize, flags));
+    }
+
+    persistent = mapping != nullptr;
+    if(!persistent) {
+      // Immutable storage cannot be respecified, so start over with a plain buffer.
+      GLCMD(glDeleteBuffers(1, &bufferId));
+      GLCMD(glGenBuffers(1, &bufferId));
+      GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, bufferId));
+    }
+  }
+
+  if(!persistent) {
+    GLCMD(glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr) totalSize, nullptr, GL_STREAM_DRAW));
+  }
+
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, oldBufferId));
+
+  if(IsOpenGLOutOfMemory()) {
+    dbgprintf("[Warning] Could not allocate uniform ring of %zu bytes.\n", totalSize);
+    ResetOpenGLOutOfMemory();
+    Shutdown();
+    return false;
+  }
+
+  frameFences = new GLsync[frameCount];
+  for(size_t i = 0; i < frameCount; i++) {
+    frameFences[i] = nullptr;
+  }
+
+  frameIndex = 0;
+  frameHead = 0;
+  frameDemand = 0;
+  frameSerial = 1;
+
+  return true;
+}
+
+void OpenGLUniformRing::Shutdown() {
+  if(frameFences) {
+    for(size_t i = 0; i < frameCount; i++) {
+      if(frameFences[i]) {
+        GLCMD(glDeleteSync(frameFences[i]));
+      }
+    }
+    PrimeSafeDeleteArray(frameFences);
+  }
+
+  if(bufferId) {
+    if(mapping) {
+      GLint oldBufferId;
+      GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &oldBufferId));
+      GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, bufferId));
+      GLCMD(glUnmapBuffer(GL_UNIFORM_BUFFER));
+      GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, oldBufferId == (GLint) bufferId ? GL_NONE : oldBufferId));
+      mapping = nullptr;
+    }
+
+    GLCMD(glDeleteBuffers(1, &bufferId));
+    bufferId = GL_NONE;
+  }
+
+  persistent = false;
+  frameSize = 0;
+  frameCount = 0;
+  ResetBinding();
+}
+
+void OpenGLUniformRing::StartFrame() {
+  if(!bufferId)
+    return;
+
+  lastFrameStats = stats;
+  memset(&stats, 0, sizeof(stats));
+
+  if(frameDemand > frameSize && frameSize < OpenGLUniformRingMaxFrameSize) {
+    if(Grow(frameDemand)) {
+      stats.growCount++;
+    }
+  }
+
+  frameIndex = (frameIndex + 1) % frameCount;
+  frameHead = 0;
+  frameDemand = 0;
+  frameSerial++;
+
+  GLsync& fence = frameFences[frameIndex];
+  if(fence) {
+    GLenum result = GLCMD(glClientWaitSync(fence, 0, 0));
+    if(result == GL_TIMEOUT_EXPIRED) {
+      stats.stallCount++;
+      do {
+        result = GLCMD(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, OpenGLUniformRingFenceTimeout));
+      } while(result == GL_TIMEOUT_EXPIRED);
+    }
+
+    GLCMD(glDeleteSync(fence));
+    fence = nullptr;
+  }
+}
+
+void OpenGLUniformRing::EndFrame() {
+  if(!bufferId)
+    return;
+
+  GLsync& fence = frameFences[frameIndex];
+  if(fence) {
+    GLCMD(glDeleteSync(fence));
+  }
+
+  fence = GLCMD(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+bool OpenGLUniformRing::Upload(const void* data, size_t dataSize, size_t allocSize, GLintptr& offset) {
+  if(!bufferId)
+    return false;
+
+  PrimeAssert(dataSize <= allocSize, "Uniform ring upload is larger than its allocation.");
+
+  size_t alignedSize = (allocSize + (offsetAlignment - 1)) / offsetAlignment * offsetAlignment;
+  frameDemand += alignedSize;
+  if(frameHead + alignedSize > frameSize) {
+    stats.overflowCount++;
+    return false;
+  }
+
+  size_t ringOffset = frameIndex * frameSize + frameHead;
+  frameHead += alignedSize;
+
+  if(dataSize > 0) {
+    if(persistent) {
+      memcpy(mapping + ringOffset, data, dataSize);
+    }
+    else {
+      GLint oldBufferId;
+      GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &oldBufferId));
+      GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, bufferId));
+      GLCMD(glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr) ringOffset, (GLsizeiptr) dataSize, data));
+      GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, oldBufferId));
+    }
+  }
+
+  offset = (GLintptr) ringOffset;
+
+  stats.bytesUploaded += dataSize;
+  stats.uploadCount++;
+
+  return true;
+}
+
+void OpenGLUniformRing::BindRange(GLuint index, GLintptr offset, GLsizeiptr size) {
+  if(boundIndex == index && boundOffset == offset && boundSize == size)
+    return;
+
+  // glBindBufferRange also changes the generic binding, so restore it.
+  GLint oldBufferId;
+  GLCMD(glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &oldBufferId));
+  GLCMD(glBindBufferRange(GL_UNIFORM_BUFFER, index, bufferId, offset, size));
+  GLCMD(glBindBuffer(GL_UNIFORM_BUFFER, oldBufferId));
+
+  boundIndex = index;
+  boundOffset = offset;
+  boundSize = size;
+}
+
+void OpenGLUniformRing::ResetBinding() {
+  boundIndex = GL_INVALID_INDEX;
+  boundOffset = 0;
+  boundSize = 0;
+}
+
+bool OpenGLUniformRing::Grow(size_t demand) {
+  size_t grownFrameSize = frameSize;
+  while(grownFrameSize < demand && grownFrameSize < OpenGLUniformRingMaxFrameSize) {
+    grownFrameSize *= 2;
+  }
+  grownFrameSize = min(grownFrameSize, (size_t) OpenGLUniformRingMaxFrameSize);
+
+  // The old buffer may still be read by frames in flight; GL defers freeing it
+  // until they complete. Serials keep counting so no program mistakes an
+  // offset from the old buffer for one in the new buffer.
+  size_t oldFrameSize = frameSize;
+  size_t oldFrameCount = frameCount;
+  u64 oldFrameSerial = frameSerial;
+
+  Shutdown();
+  bool grown = Init(grownFrameSize, oldFrameCount);
+  if(!grown) {
+    dbgprintf("[Warning] Could not grow uniform ring to %zu bytes per frame.\n", grownFrameSize);
+    Init(oldFrameSize, oldFrameCount);
+  }
+
+  frameSerial = oldFrameSerial;
+  frameIndex = oldFrameCount - 1;
+
+  return grown;
+}
+
+void OpenGLUniformRing::CountReuse() {
+  stats.reuseCount++;
+}
+
+void OpenGLUniformRing::CountFallback(size_t dataSize) {
+  stats.bytesUploaded += dataSize;
+  stats.fallbackCount++;
+}
+
+#endif
@@ -360,10 +360,10 @@ bool ImagemapContent::Load(const json& data, const json& info) {
     std::string imgPath = it.GetString();
 
     if(!imgPath.empty()) {
-      new Job(nullptr, [=](Job& job) {
+      Job::Create(nullptr, [=](Job& job) {
         GetContentRaw(imgPath, [=](const void* data, size_t dataSize) {
           tex = Tex::Create();
-          tex->AddTexData("", std::string((const char*) data, dataSize));
+          tex->AddTexData("", ByteBuffer::Copy(data, dataSize), json());
         });
       });
     }
@@ -386,10 +386,30 @@ bool ImagemapContent::Load(const void* data, size_t dataSize, const json& info)
   return false;
 }
 
+bool ImagemapContent::Load(refptr<ByteBuffer> buffer, const json& info) {
+  if(!buffer)
+    return false;
+
+  // BC data is handed to the texture as is, so keep the buffer rather than
+  // copying it. PNG and JPEG data is decoded here and not kept.
+  if(IsFormatBC(buffer->GetData(), buffer->GetSize(), info)) {
+    return LoadFromBC(buffer, info);
+  }
+
+  return Load(buffer->GetData(), buffer->GetSize(), info);
+}
+
 bool ImagemapContent::LoadFromBC(const void* data, size_t dataSize, const json& info) {
   if(data == nullptr || dataSize == 0)
     return false;
 
+  return LoadFromBC(ByteBuffer::Copy(data, dataSize), info);
+}
+
+bool ImagemapContent::LoadFromBC(refptr<ByteBuffer> buffer, const json& info) {
+  if(!buffer || buffer->GetSize() == 0)
+    return false;
+
   u32 w = 0;
   u32 h = 0;
 
@@ -410,8 +430,6 @@ bool ImagemapContent::LoadFromBC(const void* data, size_t dataSize, const json&
   if(w == 0 || h == 0)
     return false;
 
-  std::string dataCopy((const char*) data, dataSize);
-
   const size_t rectIndex = 0;
   rectCount = 1;
   rects = new ImagemapContentRect[rectCount];
@@ -445,9 +463,9 @@ bool ImagemapContent::LoadFromBC(const void* data, size_t dataSize, const json&
   wrapModeX = WrapModeNone;
   wrapModeY = WrapModeNone;
 
-  new Job(nullptr, [=](Job& job) {
+  Job::Create(nullptr, [=](Job& job) {
     tex = Tex::Create();
-    tex->AddTexData("", dataCopy, info);
+    tex->AddTexData("", buffer, info);
   });
 
   return true;
@@ -462,7 +480,6 @@ bool ImagemapContent::LoadFromPNG(const void* data, size_t dataSize, const json&
   if(!Tex::LoadPixelsFromPNG(data, dataSize, texData))
     return false;
 
-  std::string dataCopy((const char*) data, dataSize);
   u32 w = texData.w;
   u32 h = texData.h;
 
@@ -499,7 +516,7 @@ bool ImagemapContent::LoadFromPNG(const void* data, size_t dataSize, const json&
   wrapModeX = WrapModeNone;
   wrapModeY = WrapModeNone;
 
-  new Job(nullptr, [=](Job& job) {
+  Job::Create(nullptr, [=](Job& job) {
     tex = Tex::Create();
     tex->AddTexData("", texData);
   });
@@ -516,7 +533,6 @@ bool ImagemapContent::LoadFromJPEG(const void* data, size_t dataSize, const json
   if(!Tex::LoadPixelsFromJPEG(data, dataSize, texData))
     return false;
 
-  std::string dataCopy((const char*) data, dataSize);
   u32 w = texData.w;
   u32 h = texData.h;
 
@@ -553,7 +569,7 @@ bool ImagemapContent::LoadFromJPEG(const void* data, size_t dataSize, const json
   wrapModeX = WrapModeNone;
   wrapModeY = WrapModeNone;
 
-  new Job(nullptr, [=](Job& job) {
+  Job::Create(nullptr, [=](Job& job) {
     tex = Tex::Create();
     tex->AddTexData("", texData);
   });
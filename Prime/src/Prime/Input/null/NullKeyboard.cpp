@@ -0,0 +1,67 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetNull)
+
+#include <Prime/Input/null/NullKeyboard.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Engine.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+NullKeyboard& NullKeyboard::GetInstance() {
+  PxRequireInit;
+
+  if(instance) {
+    PrimeAssert(dynamic_cast<NullKeyboard*>(instance), "Keyboard instance is not a NullKeyboard instance.");
+    return *static_cast<NullKeyboard*>(instance);
+  }
+
+  NullKeyboard* inst = new NullKeyboard();
+  PrimeAssert(inst, "Could not create NullKeyboard instance.");
+  instance = inst;
+  inst->Init();
+  return *static_cast<NullKeyboard*>(instance);
+}
+
+NullKeyboard::NullKeyboard(): Keyboard() {
+
+}
+
+NullKeyboard::~NullKeyboard() {
+
+}
+
+#endif
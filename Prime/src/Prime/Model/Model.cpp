@@ -31,6 +31,7 @@ SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <Prime/Graphics/Graphics.h>
+#include <algorithm>
 
 using namespace Prime;
 
@@ -91,6 +92,9 @@ knownPoseBlendWeight(0.0f),
 boneOverrides(nullptr),
 actionSceneNameKnown(false),
 actionIndex(PrimeNotFound),
+actionSceneIndex(PrimeNotFound),
+actionSkeletonActionIndex(PrimeNotFound),
+actionKeyFrameCursor(0),
 actionChanged(false),
 actionTimeScale(1.0f),
 actionCtr(0.0f),
@@ -99,8 +103,13 @@ actionLen(0.0f),
 actionLoopCount(0),
 actionPlayed(false),
 actionReverse(false),
-activeBoneTransforms(nullptr),
 boneTransforms(nullptr),
+activeBoneTransforms(nullptr),
+bonePalettes(nullptr),
+bonePaletteOffsets(nullptr),
+activeBoneGlobalTransforms(nullptr),
+activeBoneIndices(nullptr),
+bonePaletteCount(0),
 activeMeshCount(0),
 activeBoneCount(0),
 totalBoneCount(0),
@@ -143,6 +152,9 @@ void Model::SetContent(ModelContent* content) {
   actionSceneName.clear();
   actionSceneNameKnown = false;
   actionIndex = PrimeNotFound;
+  actionSceneIndex = PrimeNotFound;
+  actionSkeletonActionIndex = PrimeNotFound;
+  actionKeyFrameCursor = 0;
   actionChanged = false;
   actionTimeScale = 1.0f;
   actionCtr = 0.0f;
@@ -153,12 +165,6 @@ void Model::SetContent(ModelContent* content) {
   actionReverse = false;
   mappedActionName.Clear();
 
-  activeBoneTransforms = nullptr;
-  boneTransforms = nullptr;
-  activeMeshCount = 0;
-  activeBoneCount = 0;
-  totalBoneCount = 0;
-
   textureOverrides.Clear();
   textureFilteringEnabled = true;
 
@@ -194,6 +200,8 @@ void Model::SetContent(ModelContent* content) {
 }
 
 void Model::Calc(f32 dt) {
+  ogalibProfileScope("Model::Calc");
+
   if(!HasContent())
     return;
 
@@ -242,9 +250,18 @@ void Model::Calc(f32 dt) {
 }
 
 void Model::Draw() {
+  DrawInstanced(nullptr, 0);
+}
+
+void Model::DrawInstanced(ArrayBuffer* instances, size_t instanceCount) {
+  ogalibProfileScope("Model::Draw");
+
   if(!HasContent())
     return;
 
+  if(instances && instanceCount == 0)
+    return;
+
   const ModelContentScene* scenePtr = GetActiveScene();
   if(scenePtr) {
     const ModelContentScene& scene = *scenePtr;
@@ -254,13 +271,116 @@ void Model::Draw() {
 
     for(size_t i = 0; i < scene.GetMeshCount(); i++) {
       const ModelContentMesh& mesh = scene.GetMesh(i);
-      DrawMesh(mesh, mesh.GetMeshIndex());
+      DrawMeshInstanced(mesh, mesh.GetMeshIndex(), instances, instanceCount);
     }
 
     g.model.Pop();
   }
 }
 
+void Model::Submit(const Mat44& transform, DeviceProgram* program) {
+  static const ProgramVariableHandle boneTransformHandle("boneTransform");
+  static const ProgramVariableHandle meshPosScaleHandle("meshPosScale");
+  static const ProgramVariableHandle meshPosOffsetHandle("meshPosOffset");
+  static const ProgramVariableHandle meshUVScaleOffsetHandle("meshUVScaleOffset");
+  static const std::string compactStr("compact");
+
+  if(!program || !HasContent())
+    return;
+
+  const ModelContentScene* scenePtr = GetActiveScene();
+  if(!scenePtr)
+    return;
+
+  const ModelContentScene& scene = *scenePtr;
+  Graphics& g = PxGraphics;
+
+  bool cull = g.IsCullingEnabled();
+  Mat44 vpMat;
+  if(cull) {
+    vpMat = g.projection * g.view;
+  }
+
+  Mat44 sceneTransform = transform;
+  sceneTransform.Multiply(scene.GetBaseTransform());
+
+  for(size_t i = 0; i < scene.GetMeshCount(); i++) {
+    const ModelContentMesh& mesh = scene.GetMesh(i);
+    size_t meshIndex = mesh.GetMeshIndex();
+
+    Tex* tex = GetMeshTex(mesh);
+    if(!tex)
+      continue;
+
+    DeviceProgram* meshProgram = program;
+    bool compact = mesh.GetVertexFormat() == ModelContentMeshVertexFormatCompact;
+    if(compact) {
+      meshProgram = program->GetVariant(compactStr);
+      PrimeAssert(meshProgram, "Program has no compact variant for mesh: %s", mesh.GetName().c_str());
+      if(!meshProgram)
+        continue;
+    }
+
+    TexChannelTuple tuple(tex);
+
+    GraphicsSubmit submit;
+    submit.program = meshProgram;
+    submit.ab = mesh.ab;
+    submit.ib = mesh.ib;
+    submit.start = 0;
+    submit.count = mesh.ib->GetSyncCount();
+    submit.instances = nullptr;
+    submit.instanceCount = 0;
+    submit.tupleList = &tuple;
+    submit.tupleCount = 1;
+    submit.model = sceneTransform;
+    submit.model.Multiply(mesh.GetBaseTransform());
+    submit.variables = nullptr;
+    submit.variableCount = 0;
+
+    if(auto it = meshTransforms.Find(mesh.name))
+      submit.model.Multiply(it.value());
+
+    // Skinned vertices can move outside their bind pose bounds, so only
+    // static meshes are culled.
+    if(cull && !mesh.GetAnim()) {
+      Frustum frustum(vpMat * submit.model);
+      if(!frustum.TestAABB(mesh.GetBoundsMin(), mesh.GetBoundsMax()))
+        continue;
+    }
+
+    GraphicsSubmitVariable variables[4];
+    size_t variableCount = 0;
+
+    if(compact) {
+      ProgramVariableHandle handles[3] = {meshPosScaleHandle, meshPosOffsetHandle, meshUVScaleOffsetHandle};
+      const Vec4* values[3] = {&mesh.GetPosScale(), &mesh.GetPosOffset(), &mesh.GetUVScaleOffset()};
+      for(size_t j = 0; j < 3; j++) {
+        GraphicsSubmitVariable& variable = variables[variableCount++];
+        variable.handle = handles[j];
+        variable.data = &values[j]->x;
+        variable.itemSize = 4;
+        variable.count = 1;
+      }
+    }
+
+    if(mesh.GetAnim() && meshIndex < activeMeshCount) {
+      GraphicsSubmitVariable& variable = variables[variableCount++];
+      variable.handle = boneTransformHandle;
+      variable.data = activeBoneTransforms[meshIndex][0].e;
+      variable.itemSize = 16;
+      variable.count = activeBoneCount;
+    }
+
+    if(variableCount) {
+      submit.variables = variables;
+      submit.variableCount = variableCount;
+    }
+
+    g.Submit(submit);
+  }
+}
+
 f32 Model::GetUniformSize() const {
   const Vec3& vertexMin = GetVertexMin();
   const Vec3& vertexMax = GetVertexMax();
@@ -273,6 +393,47 @@ f32 Model::GetUniformSize() const {
   return size;
 }
 
+bool Model::GetBounds(Vec3& boundsMin, Vec3& boundsMax) const {
+  const ModelContentScene* scenePtr = GetActiveScene();
+  if(!scenePtr)
+    return false;
+
+  const ModelContentScene& scene = *scenePtr;
+  bool found = false;
+
+  for(size_t i = 0; i < scene.GetMeshCount(); i++) {
+    const ModelContentMesh& mesh = scene.GetMesh(i);
+    if(mesh.GetVertexCount() == 0)
+      continue;
+
+    Mat44 transform = scene.GetBaseTransform();
+    transform.Multiply(mesh.GetBaseTransform());
+
+    if(auto it = meshTransforms.Find(mesh.name))
+      transform.Multiply(it.value());
+
+    Vec3 meshBoundsMin;
+    Vec3 meshBoundsMax;
+    transform.MultiplyBounds(mesh.GetBoundsMin(), mesh.GetBoundsMax(), meshBoundsMin, meshBoundsMax);
+
+    if(found) {
+      boundsMin.x = min(boundsMin.x, meshBoundsMin.x);
+      boundsMin.y = min(boundsMin.y, meshBoundsMin.y);
+      boundsMin.z = min(boundsMin.z, meshBoundsMin.z);
+      boundsMax.x = max(boundsMax.x, meshBoundsMax.x);
+      boundsMax.y = max(boundsMax.y, meshBoundsMax.y);
+      boundsMax.z = max(boundsMax.z, meshBoundsMax.z);
+    }
+    else {
+      boundsMin = meshBoundsMin;
+      boundsMax = meshBoundsMax;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
 void Model::SetAction(const std::string& name) {
   if(!HasContent())
     return;
@@ -468,34 +629,7 @@ void Model::SetActionByIndex(size_t index) {
 
     if(discardedAction) {
       DiscardAction();
-
-      size_t meshCount = scene.GetMeshCount();
-      size_t boneCount = skeleton.GetBoneCount();
-      size_t actionPoseBoneCount = skeleton.GetActionPoseBoneCount();
-
-      if(meshCount) {
-        activeMeshCount = meshCount;
-
-        if(actionPoseBoneCount) {
-          activeBoneCount = actionPoseBoneCount;
-          activeBoneTransforms = new Mat44*[activeMeshCount];
-          if(activeBoneTransforms) {
-            for(size_t i = 0; i < activeMeshCount; i++) {
-              activeBoneTransforms[i] = new Mat44[activeBoneCount];
-            }
-          }
-        }
-
-        if(boneCount) {
-          totalBoneCount = boneCount;
-          boneTransforms = new Mat44*[activeMeshCount];
-          if(boneTransforms) {
-            for(size_t i = 0; i < activeMeshCount; i++) {
-              boneTransforms[i] = new Mat44[totalBoneCount];
-            }
-          }
-        }
-      }
+      CreateBoneTransforms(scene, skeleton);
 
       currActionPose1.SetContent(content, index);
       currActionPose2.SetContent(content, index);
@@ -515,6 +649,7 @@ void Model::SetActionByIndex(size_t index) {
   }
 
   actionIndex = index;
+  actionSceneIndex = content->GetSceneIndexByName(action.scene);
   actionChanged = true;
   actionCtr = 0.0f;
   actionLoopedCtr = 0.0f;
@@ -523,8 +658,13 @@ void Model::SetActionByIndex(size_t index) {
   actionLoopCount = 0;
   actionPlayed = false;
 
-  const ModelContentSkeletonAction* skeletonAction = skeleton.GetActionByName(action.sceneActionName);
-  if(skeletonAction) {
+  // Resolved once here so CalcPose does not look the action up by name.
+  actionSkeletonActionIndex = skeleton.GetActionIndexByName(action.sceneActionName);
+  actionKeyFrameCursor = 0;
+
+  const ModelContentSkeletonAction* skeletonAction = nullptr;
+  if(actionSkeletonActionIndex != PrimeNotFound) {
+    skeletonAction = &skeleton.GetAction(actionSkeletonActionIndex);
     actionLen = skeletonAction->GetLen();
   }
   else {
@@ -602,16 +742,10 @@ const ModelContentScene* Model::GetActiveScene() const {
     }
   }
   else {
-    if(actionIndex >= content->GetActionCount())
-      return nullptr;
-
-    const ModelContentAction& action = content->GetAction(actionIndex);
-
-    size_t sceneIndex = content->GetSceneIndexByName(action.scene);
-    if(sceneIndex == PrimeNotFound)
+    if(actionIndex >= content->GetActionCount() || actionSceneIndex == PrimeNotFound)
       return nullptr;
 
-    return &content->GetScene(sceneIndex);
+    return &content->GetScene(actionSceneIndex);
   }
 }
 
@@ -622,16 +756,10 @@ const ModelContentSkeleton* Model::GetActiveSkeleton(const ModelContentScene** a
   if(actionIndex == PrimeNotFound)
     return nullptr;
 
-  if(actionIndex >= content->GetActionCount())
-    return nullptr;
-
-  const ModelContentAction& action = content->GetAction(actionIndex);
-
-  size_t sceneIndex = content->GetSceneIndexByName(action.scene);
-  if(sceneIndex == PrimeNotFound)
+  if(actionIndex >= content->GetActionCount() || actionSceneIndex == PrimeNotFound)
     return nullptr;
 
-  const ModelContentScene& scene = content->GetScene(sceneIndex);
+  const ModelContentScene& scene = content->GetScene(actionSceneIndex);
   if(associatedScene) {
     *associatedScene = &scene;
   }
@@ -696,8 +824,11 @@ void Model::CalcPose(f32 dt) {
     const ModelContentSkeleton* skeletonPtr = GetActiveSkeleton();
     if(skeletonPtr) {
       const ModelContentSkeleton& skeleton = *skeletonPtr;
-      const ModelContentAction& action = content->GetAction(actionIndex);
-      const ModelContentSkeletonAction* skeletonAction = skeleton.GetActionByName(action.sceneActionName);
+      const ModelContentSkeletonAction* skeletonAction = nullptr;
+      if(actionSkeletonActionIndex != PrimeNotFound) {
+        skeletonAction = &skeleton.GetAction(actionSkeletonActionIndex);
+      }
+
       if(skeletonAction) {
         size_t keyFrameCount = skeletonAction->GetKeyFrameCount();
         if(keyFrameCount >= 2) {
@@ -727,24 +858,15 @@ void Model::CalcPose(f32 dt) {
             currActionPoseI.Interpolate(lastActionPoseTemp, lastActionPose, t, &boneCancelActionBlend);
           }
 
-          size_t rootBoneIndex = skeleton.GetRootBoneIndex();
-          if(rootBoneIndex != PrimeNotFound) {
-            for(size_t j = 0; j < activeMeshCount; j++) {
-              Mat44 transformation;
-              transformation.LoadIdentity();
-              UpdateBoneTransformsForModelPose(*content, skeleton, j, rootBoneIndex, transformation, currActionPoseI);
-            }
-          }
+          UpdateBoneTransforms(skeleton, currActionPoseI);
         }
       }
       else {
-        for(size_t j = 0; j < activeMeshCount; j++) {
-          for(size_t i = 0; i < activeBoneCount; i++) {
-            activeBoneTransforms[j][i].LoadIdentity();
-          }
-          for(size_t i = 0; i < totalBoneCount; i++) {
-            boneTransforms[j][i].LoadIdentity();
-          }
+        for(size_t i = 0; i < bonePaletteCount * activeBoneCount; i++) {
+          bonePalettes[i].LoadIdentity();
+        }
+        for(size_t i = 0; i < totalBoneCount; i++) {
+          boneTransforms[i].LoadIdentity();
         }
       }
     }
@@ -784,10 +906,73 @@ void Model::ClearMeshTransform(const std::string& name) {
 }
 
 void Model::DrawMesh(const ModelContentMesh& mesh, size_t meshIndex) {
-  static const std::string boneTransformStr("boneTransform");
+  DrawMeshInstanced(mesh, meshIndex, nullptr, 0);
+}
+
+void Model::DrawMeshInstanced(const ModelContentMesh& mesh, size_t meshIndex, ArrayBuffer* instances, size_t instanceCount) {
+  static const ProgramVariableHandle boneTransformHandle("boneTransform");
+  static const ProgramVariableHandle meshPosScaleHandle("meshPosScale");
+  static const ProgramVariableHandle meshPosOffsetHandle("meshPosOffset");
+  static const ProgramVariableHandle meshUVScaleOffsetHandle("meshUVScaleOffset");
+  static const std::string compactStr("compact");
   Graphics& g = PxGraphics;
 
-  refptr<Tex> directTex;
+  Tex* directTex = GetMeshTex(mesh);
+  if(!directTex)
+    return;
+
+  bool anim = mesh.GetAnim();
+
+  DeviceProgram* program = g.program;
+  if(!program)
+    return;
+
+  bool compact = mesh.GetVertexFormat() == ModelContentMeshVertexFormatCompact;
+  if(compact) {
+    program = program->GetVariant(compactStr);
+    PrimeAssert(program, "Program has no compact variant for mesh: %s", mesh.GetName().c_str());
+    if(!program)
+      return;
+
+    program->SetVariable(meshPosScaleHandle, mesh.GetPosScale());
+    program->SetVariable(meshPosOffsetHandle, mesh.GetPosOffset());
+    program->SetVariable(meshUVScaleOffsetHandle, mesh.GetUVScaleOffset());
+    g.program.Push() = program;
+  }
+
+  if(anim && meshIndex < activeMeshCount) {
+    program->SetArrayVariableMat44fv(boneTransformHandle, (f32*) activeBoneTransforms[meshIndex][0].e, activeBoneCount);
+  }
+
+  g.model.Push().Multiply(mesh.GetBaseTransform());
+
+  if(auto it = meshTransforms.Find(mesh.name))
+    g.model.Multiply(it.value());
+
+  // Instances carry their own transforms and skinned vertices can move
+  // outside their bind pose bounds, so only single static draws are culled.
+  bool culled = false;
+  if(!instances && !anim && g.IsCullingEnabled()) {
+    Frustum frustum(g.projection * g.view * g.model);
+    culled = !frustum.TestAABB(mesh.GetBoundsMin(), mesh.GetBoundsMax());
+  }
+
+  if(instances) {
+    g.DrawInstanced(mesh.ab, mesh.ib, instances, instanceCount, directTex);
+  }
+  else if(!culled) {
+    g.Draw(mesh.ab, mesh.ib, directTex);
+  }
+
+  g.model.Pop();
+
+  if(compact) {
+    g.program.Pop();
+  }
+}
+
+Tex* Model::GetMeshTex(const ModelContentMesh& mesh) const {
+  Tex* directTex = nullptr;
 
   if(auto it = textureOverrides.Find(mesh.GetName())) {
     directTex = it.value();
@@ -832,29 +1017,7 @@ void Model::DrawMesh(const ModelContentMesh& mesh, size_t meshIndex) {
     }
   }
 
-  if(!directTex)
-    return;
-
-  bool anim = mesh.GetAnim();
-
-  DeviceProgram* program = g.program;
-  if(!program)
-    return;
-
-  if(anim && meshIndex < activeMeshCount) {
-    program->SetArrayVariableMat44fv(boneTransformStr, (f32*) activeBoneTransforms[meshIndex][0].e, activeBoneCount);
-  }
-
-  bool pushedColorScale = false;
-
-  g.model.Push().Multiply(mesh.GetBaseTransform());
-
-  if(auto it = meshTransforms.Find(mesh.name))
-    g.model.Multiply(it.value());
-
-  g.Draw(mesh.ab, mesh.ib, directTex);
-
-  g.model.Pop();
+  return directTex;
 }
 
 const Mat44* Model::GetActiveBoneTransform(size_t meshIndex, size_t activePoseBoneIndex) const {
@@ -882,7 +1045,7 @@ const Mat44* Model::GetBoneTransform(size_t meshIndex, size_t boneIndex) const {
 
   if(meshIndex < activeMeshCount) {
     if(boneIndex < totalBoneCount) {
-      return &boneTransforms[meshIndex][boneIndex];
+      return &boneTransforms[boneIndex];
     }
   }
 
@@ -923,6 +1086,9 @@ void Model::DiscardAction() {
   actionSceneName.clear();
   actionSceneNameKnown = false;
   actionIndex = PrimeNotFound;
+  actionSceneIndex = PrimeNotFound;
+  actionSkeletonActionIndex = PrimeNotFound;
+  actionKeyFrameCursor = 0;
   actionChanged = false;
   actionCtr = 0.0f;
   actionLen = 0.0f;
@@ -956,60 +1122,45 @@ void Model::GetActionKeyFrames(const ModelContentSkeleton& skeleton, const Model
     useActionCtr = actionLen;
   }
 
-  const ModelContentSkeletonActionKeyFrame* kf1 = &skeletonAction.GetKeyFrame(0);
-  const ModelContentSkeletonActionKeyFrame* kf2 = kf1;
-  const ModelContentSkeletonActionKeyFrame& firstKeyFrame = skeletonAction.GetKeyFrame(0);
-  f32 firstKeyFrame1Time = firstKeyFrame.GetTime();
-  f32 keyFrame1Time = kf1->GetTime() - firstKeyFrame1Time;
-  f32 keyFrame2Time = keyFrame1Time;
-
-  size_t kf1Index = 0;
-  size_t kf2Index = 0;
-
-  for(size_t i = 0; i < keyFrameCount; i++) {
-    const ModelContentSkeletonActionKeyFrame& keyFrame = skeletonAction.GetKeyFrame(i);
-    const ModelContentSkeletonActionKeyFrame& nextKeyFrame = skeletonAction.GetKeyFrame((i == keyFrameCount - 1) ? i : (i + 1));
-    f32 keyFrameTime = keyFrame.GetTime() - firstKeyFrame1Time;
-    f32 nextKeyFrameTime = nextKeyFrame.GetTime() - firstKeyFrame1Time;
-    if(keyFrameTime >= 0.0f) {
-      if(actionReverse) {
-        if(useActionCtr < nextKeyFrameTime) {
-          kf1 = &keyFrame;
-          if(i == 0) {
-            kf2 = &skeletonAction.GetKeyFrame(keyFrameCount - 1);
-          }
-          else {
-            kf2 = &skeletonAction.GetKeyFrame(i - 1);
-          }
-          break;
+  const ModelContentSkeletonActionKeyFrame* kf1;
+  const ModelContentSkeletonActionKeyFrame* kf2;
+  f32 firstKeyFrame1Time = skeletonAction.GetKeyFrame(0).GetTime();
+  f32 keyFrame1Time;
+  f32 keyFrame2Time = 0.0f;
+  size_t kf1Index;
+
+  size_t index = FindActionKeyFrame(skeletonAction, useActionCtr);
+  if(index == keyFrameCount) {
+    // Past the last key frame, so it pairs with the first.
+    kf1Index = keyFrameCount - 1;
+    kf1 = &skeletonAction.GetKeyFrame(kf1Index);
+    kf2 = &skeletonAction.GetKeyFrame(0);
+    keyFrame1Time = kf1->GetTime() - firstKeyFrame1Time;
+  }
+  else {
+    kf1 = &skeletonAction.GetKeyFrame(index);
+    keyFrame1Time = kf1->GetTime() - firstKeyFrame1Time;
+
+    if(actionReverse) {
+      kf1Index = index ? index - 1 : 0;
+      kf2 = &skeletonAction.GetKeyFrame(index ? index - 1 : keyFrameCount - 1);
+    }
+    else {
+      kf1Index = index;
+      if(index == keyFrameCount - 1) {
+        size_t nextIndex = 0;
+        do {
+          kf2 = &skeletonAction.GetKeyFrame(nextIndex);
+          nextIndex++;
         }
+        while(kf2->GetTime() < 0.0f);
+        keyFrame2Time = keyFrame1Time;
       }
       else {
-        if(useActionCtr < nextKeyFrameTime) {
-          kf1 = &keyFrame;
-          kf1Index = i;
-          if(i == keyFrameCount - 1) {
-            size_t nextIndex = 0;
-            do {
-              kf2 = &skeletonAction.GetKeyFrame(nextIndex);
-              kf2Index = nextIndex;
-              nextIndex++;
-            }
-            while(kf2->GetTime() < 0.0f);
-          }
-          else {
-            kf2 = &skeletonAction.GetKeyFrame(i + 1);
-            kf2Index = i + 1;
-          }
-          keyFrame2Time = nextKeyFrameTime;
-          break;
-        }
+        kf2 = &skeletonAction.GetKeyFrame(index + 1);
+        keyFrame2Time = kf2->GetTime() - firstKeyFrame1Time;
       }
     }
-
-    kf1 = &keyFrame;
-    kf1Index = i;
-    keyFrame1Time = nextKeyFrameTime;
   }
 
   const ModelContentAction& action = content->GetAction(actionIndex);
@@ -1017,14 +1168,12 @@ void Model::GetActionKeyFrames(const ModelContentSkeleton& skeleton, const Model
     if(actionReverse) {
       if(kf1Index == 0) {
         kf2 = kf1;
-        kf2Index = kf1Index;
         keyFrame2Time = keyFrame1Time;
       }
     }
     else {
       if(kf1Index == keyFrameCount - 1) {
         kf2 = kf1;
-        kf2Index = kf1Index;
         keyFrame2Time = keyFrame1Time;
       }
     }
@@ -1048,115 +1197,189 @@ void Model::GetActionKeyFrames(const ModelContentSkeleton& skeleton, const Model
   }
 }
 
-void Model::UpdateBoneTransformsForPoses(const ModelContent& content, const ModelContentSkeleton& skeleton, size_t meshIndex, size_t boneIndex, Mat44 transformation, const ModelContentSkeletonPose* pose1, const ModelContentSkeletonPose* pose2, f32 t) {
-  Mat44 boneTransformation;
-  boneTransformation.LoadIdentity();
-  const ModelContentSkeletonBone& bone = skeleton.GetBone(boneIndex);
-  size_t actionPoseBoneIndex = bone.GetActionPoseBoneIndex();
-
-  Mat44 poseTransform;
-  poseTransform.LoadIdentity();
-  bool defaultPoseTransform = true;
-
-  const ModelContentSkeletonPoseBone& poseBone1 = pose1->GetPoseBone(boneIndex);
-  const ModelContentSkeletonPoseBone& poseBone2 = pose2->GetPoseBone(boneIndex);
-  if(poseBone1.GetBoneIndex() != PrimeNotFound && poseBone2.GetBoneIndex() != PrimeNotFound) {
-    if(poseBone1 == poseBone2) {
-      poseTransform.Translate(poseBone1.GetTranslation());
-      poseTransform.Multiply(poseBone1.GetRotation().GetRotationMat44());
-      poseTransform.Scale(poseBone1.GetScaling());
-      defaultPoseTransform = false;
-    }
-    else {
-      Vec3 translation = poseBone1.GetTranslation().GetLerp(poseBone2.GetTranslation(), t);
-      Quat rotation = poseBone1.GetRotation().Interpolate(poseBone2.GetRotation(), t);
-      Vec3 scaling = poseBone1.GetScaling().GetLerp(poseBone2.GetScaling(), t);
-      poseTransform.Translate(translation);
-      poseTransform.Multiply(rotation.GetRotationMat44());
-      poseTransform.Scale(scaling);
-      defaultPoseTransform = false;
+size_t Model::FindActionKeyFrame(const ModelContentSkeletonAction& skeletonAction, f32 time) {
+  // Returns the first key frame whose next key frame is later than the time,
+  // or the key frame count if there is none. Key frames are sorted when loaded,
+  // so the cursor from the last lookup, or the one after it, usually brackets
+  // the time and a binary search is only needed after a seek.
+  size_t keyFrameCount = skeletonAction.GetKeyFrameCount();
+  const ModelContentSkeletonActionKeyFrame* keyFrames = &skeletonAction.GetKeyFrame(0);
+  f32 firstKeyFrameTime = keyFrames[0].GetTime();
+
+  auto getKeyFrameTime = [&](size_t index) {
+    return keyFrames[index].GetTime() - firstKeyFrameTime;
+  };
+
+  size_t cursor = actionKeyFrameCursor;
+  if(cursor == keyFrameCount) {
+    if(time >= getKeyFrameTime(keyFrameCount - 1))
+      return cursor;
+  }
+  else {
+    for(size_t i = cursor; i < cursor + 2 && i + 1 < keyFrameCount; i++) {
+      if(getKeyFrameTime(i) <= time && time < getKeyFrameTime(i + 1)) {
+        actionKeyFrameCursor = i;
+        return i;
+      }
     }
   }
 
-  if(defaultPoseTransform) {
-    poseTransform = bone.GetTransformation();
+  const ModelContentSkeletonActionKeyFrame* it = std::upper_bound(keyFrames, keyFrames + keyFrameCount, time, [&](f32 value, const ModelContentSkeletonActionKeyFrame& keyFrame) {
+    return value < keyFrame.GetTime() - firstKeyFrameTime;
+  });
+
+  size_t index = (size_t) (it - keyFrames);
+  if(index < keyFrameCount && index > 0) {
+    index--;
   }
 
-  boneTransformation = transformation * poseTransform;
+  actionKeyFrameCursor = index;
+  return index;
+}
 
-  if(actionPoseBoneIndex != PrimeNotFound) {
-    if(bone.IsMeshTransformationValid(meshIndex)) {
-      activeBoneTransforms[meshIndex][actionPoseBoneIndex] = boneTransformation * bone.GetMeshTransformation(meshIndex);
-    }
-    else {
-      activeBoneTransforms[meshIndex][actionPoseBoneIndex] = boneTransformation;
-    }
-  }
-  boneTransforms[meshIndex][boneIndex] = boneTransformation;
+void Model::CreateBoneTransforms(const ModelContentScene& scene, const ModelContentSkeleton& skeleton) {
+  size_t meshCount = scene.GetMeshCount();
+  size_t boneCount = skeleton.GetBoneCount();
+  size_t actionPoseBoneCount = skeleton.GetActionPoseBoneCount();
+
+  if(meshCount == 0)
+    return;
+
+  activeMeshCount = meshCount;
 
-  size_t childBoneIndexCount = bone.GetChildBoneIndexCount();
-  for(size_t i = 0; i < childBoneIndexCount; i++) {
-    size_t childBoneIndex = bone.GetChildBoneIndex(i);
-    UpdateBoneTransformsForPoses(content, skeleton, meshIndex, childBoneIndex, boneTransformation, pose1, pose2, t);
+  if(boneCount) {
+    totalBoneCount = boneCount;
+    boneTransforms = new Mat44[totalBoneCount];
+    for(size_t i = 0; i < totalBoneCount; i++) {
+      boneTransforms[i].LoadIdentity();
+    }
   }
-}
 
-void Model::UpdateBoneTransformsForModelPose(const ModelContent& content, const ModelContentSkeleton& skeleton, size_t meshIndex, size_t boneIndex, Mat44 transformation, const ModelPose& pose) {
-  Mat44 boneTransformation;
-  boneTransformation.LoadIdentity();
-  const ModelContentSkeletonBone& bone = skeleton.GetBone(boneIndex);
-  size_t actionPoseBoneIndex = bone.GetActionPoseBoneIndex();
+  if(actionPoseBoneCount == 0)
+    return;
 
-  Mat44 poseTransform;
-  poseTransform.LoadIdentity();
-  bool defaultPoseTransform = true;
+  activeBoneCount = actionPoseBoneCount;
+  activeBoneTransforms = new Mat44*[activeMeshCount];
+  bonePalettes = new Mat44[activeMeshCount * activeBoneCount];
+  bonePaletteOffsets = new Mat44[activeMeshCount * activeBoneCount];
+  activeBoneGlobalTransforms = new Mat44[activeBoneCount];
+  activeBoneIndices = new size_t[activeBoneCount];
 
-  const ModelPoseBone* poseBone = pose.GetBone(boneIndex);
-  if(poseBone && poseBone->poseValid) {
-    poseTransform.Translate(poseBone->translation);
-    poseTransform.Multiply(poseBone->rotation.GetRotationMat44());
-    poseTransform.Scale(poseBone->scaling);
-    defaultPoseTransform = false;
+  for(size_t i = 0; i < activeBoneCount; i++) {
+    activeBoneIndices[i] = PrimeNotFound;
   }
 
-  if(defaultPoseTransform) {
-    poseTransform = bone.GetTransformation();
+  for(size_t i = 0; i < boneCount; i++) {
+    size_t actionPoseBoneIndex = skeleton.GetBone(i).GetActionPoseBoneIndex();
+    if(actionPoseBoneIndex < activeBoneCount) {
+      activeBoneIndices[actionPoseBoneIndex] = i;
+    }
   }
 
-  boneTransformation = transformation * poseTransform;
+  // Bones without a mesh transformation use the identity, which leaves their
+  // global transform unchanged. Meshes whose offsets match an earlier mesh
+  // share its palette.
+  for(size_t i = 0; i < activeMeshCount; i++) {
+    Mat44* offsets = &bonePaletteOffsets[bonePaletteCount * activeBoneCount];
+    for(size_t j = 0; j < activeBoneCount; j++) {
+      size_t boneIndex = activeBoneIndices[j];
+      if(boneIndex != PrimeNotFound && skeleton.GetBone(boneIndex).IsMeshTransformationValid(i)) {
+        offsets[j] = skeleton.GetBone(boneIndex).GetMeshTransformation(i);
+      }
+      else {
+        offsets[j].LoadIdentity();
+      }
+    }
 
-  if(actionPoseBoneIndex != PrimeNotFound) {
-    if(bone.IsMeshTransformationValid(meshIndex)) {
-      activeBoneTransforms[meshIndex][actionPoseBoneIndex] = boneTransformation * bone.GetMeshTransformation(meshIndex);
+    size_t paletteIndex = 0;
+    while(paletteIndex < bonePaletteCount && memcmp(&bonePaletteOffsets[paletteIndex * activeBoneCount], offsets, sizeof(Mat44) * activeBoneCount) != 0) {
+      paletteIndex++;
     }
-    else {
-      activeBoneTransforms[meshIndex][actionPoseBoneIndex] = boneTransformation;
+
+    if(paletteIndex == bonePaletteCount) {
+      Mat44* palette = &bonePalettes[bonePaletteCount * activeBoneCount];
+      for(size_t j = 0; j < activeBoneCount; j++) {
+        palette[j].LoadIdentity();
+      }
+      bonePaletteCount++;
     }
-  }
-  boneTransforms[meshIndex][boneIndex] = boneTransformation;
 
-  size_t childBoneIndexCount = bone.GetChildBoneIndexCount();
-  for(size_t i = 0; i < childBoneIndexCount; i++) {
-    size_t childBoneIndex = bone.GetChildBoneIndex(i);
-    UpdateBoneTransformsForModelPose(content, skeleton, meshIndex, childBoneIndex, boneTransformation, pose);
+    activeBoneTransforms[i] = &bonePalettes[paletteIndex * activeBoneCount];
   }
 }
 
-void Model::DestroyBoneTransforms() {
-  if(activeBoneTransforms) {
-    for(size_t i = 0; i < activeMeshCount; i++) {
-      PrimeSafeDeleteArray(activeBoneTransforms[i]);
+void Model::UpdateBoneTransforms(const ModelContentSkeleton& skeleton, const ModelPose& pose) {
+  if(!boneTransforms)
+    return;
+
+  // Parents come before their children, so a single pass computes every
+  // global transform.
+  size_t orderedBoneCount = skeleton.GetOrderedBoneCount();
+  for(size_t i = 0; i < orderedBoneCount; i++) {
+    size_t boneIndex = skeleton.GetOrderedBoneIndex(i);
+    size_t parentBoneIndex = skeleton.GetOrderedBoneParentIndex(i);
+
+    Mat44 poseTransform;
+    const ModelPoseBone* poseBone = pose.GetBone(boneIndex);
+    if(poseBone && poseBone->poseValid) {
+      // Translation * rotation * scaling, built without the two products.
+      const Vec3& translation = poseBone->translation;
+      const Vec3& scaling = poseBone->scaling;
+      poseTransform = poseBone->rotation.GetRotationMat44();
+      poseTransform.e11 *= scaling.x;
+      poseTransform.e21 *= scaling.x;
+      poseTransform.e31 *= scaling.x;
+      poseTransform.e12 *= scaling.y;
+      poseTransform.e22 *= scaling.y;
+      poseTransform.e32 *= scaling.y;
+      poseTransform.e13 *= scaling.z;
+      poseTransform.e23 *= scaling.z;
+      poseTransform.e33 *= scaling.z;
+      poseTransform.e14 = translation.x;
+      poseTransform.e24 = translation.y;
+      poseTransform.e34 = translation.z;
+    }
+    else {
+      poseTransform = skeleton.GetBone(boneIndex).GetTransformation();
+    }
+
+    if(parentBoneIndex == PrimeNotFound) {
+      boneTransforms[boneIndex] = poseTransform;
+    }
+    else {
+      boneTransforms[boneIndex].LoadProduct(boneTransforms[parentBoneIndex], poseTransform);
     }
-    PrimeSafeDeleteArray(activeBoneTransforms);
   }
 
-  if(boneTransforms) {
-    for(size_t i = 0; i < activeMeshCount; i++) {
-      PrimeSafeDeleteArray(boneTransforms[i]);
+  if(bonePaletteCount == 0)
+    return;
+
+  for(size_t i = 0; i < activeBoneCount; i++) {
+    size_t boneIndex = activeBoneIndices[i];
+    if(boneIndex != PrimeNotFound) {
+      activeBoneGlobalTransforms[i] = boneTransforms[boneIndex];
+    }
+    else {
+      activeBoneGlobalTransforms[i].LoadIdentity();
     }
-    PrimeSafeDeleteArray(boneTransforms);
   }
 
+  for(size_t i = 0; i < bonePaletteCount; i++) {
+    size_t offset = i * activeBoneCount;
+    Mat44::MultiplyPairs(activeBoneGlobalTransforms, &bonePaletteOffsets[offset], &bonePalettes[offset], activeBoneCount);
+  }
+}
+
+void Model::DestroyBoneTransforms() {
+  PrimeSafeDeleteArray(boneTransforms);
+  PrimeSafeDeleteArray(activeBoneTransforms);
+  PrimeSafeDeleteArray(bonePalettes);
+  PrimeSafeDeleteArray(bonePaletteOffsets);
+  PrimeSafeDeleteArray(activeBoneGlobalTransforms);
+  PrimeSafeDeleteArray(activeBoneIndices);
+
+  bonePaletteCount = 0;
   activeMeshCount = 0;
   activeBoneCount = 0;
+  totalBoneCount = 0;
 }
@@ -83,6 +83,14 @@ bool ModelContent::LoadFromGLTF(const void* data, size_t dataSize, const json& i
 
   sceneLookup[scene.name] = 0;
 
+  if(auto it = info.find("vertexFormat")) {
+    scene.SetCompactVertices(it.GetString() == "compact");
+  }
+
+  if(auto it = info.find("optimizeMeshes")) {
+    scene.SetOptimizeMeshes(it.GetBool());
+  }
+
   scene.ReadModelUsingTinyGLTF(data, dataSize);
 
   actionCount = scene.GetAnimationCount();
@@ -129,6 +137,14 @@ bool ModelContent::LoadFromFBX(const void* data, size_t dataSize, const json& in
 
   sceneLookup[scene.name] = 0;
 
+  if(auto it = info.find("vertexFormat")) {
+    scene.SetCompactVertices(it.GetString() == "compact");
+  }
+
+  if(auto it = info.find("optimizeMeshes")) {
+    scene.SetOptimizeMeshes(it.GetBool());
+  }
+
   scene.ReadModelUsingAssimp(data, dataSize);
 
   actionCount = scene.GetAnimationCount();
@@ -186,6 +202,10 @@ bool ModelContent::LoadFromOBJ(const void* data, size_t dataSize, const json& in
 
   sceneLookup[scene.name] = 0;
 
+  if(auto it = info.find("optimizeMeshes")) {
+    scene.SetOptimizeMeshes(it.GetBool());
+  }
+
   scene.ReadModelUsingAssimp(data, dataSize);
 
   textureCount = scene.GetTextureCount();
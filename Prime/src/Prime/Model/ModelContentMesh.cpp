@@ -41,11 +41,20 @@ indices(nullptr),
 ab(nullptr),
 ib(nullptr),
 vertexCount(0),
+vertexSize(0),
 indexCount(0),
+vertexFormat(ModelContentMeshVertexFormatStandard),
+posScale(Vec4(1.0f, 1.0f, 1.0f, 0.0f)),
+posOffset(Vec4(0.0f, 0.0f, 0.0f, 0.0f)),
+uvScaleOffset(Vec4(1.0f, 1.0f, 0.0f, 0.0f)),
 anim(false),
 vertexMin(Vec3(0.0f, 0.0f, 0.0f)),
-vertexMax(Vec3(0.0f, 0.0f, 0.0f)) {
-
+vertexMax(Vec3(0.0f, 0.0f, 0.0f)),
+boundsMin(Vec3(0.0f, 0.0f, 0.0f)),
+boundsMax(Vec3(0.0f, 0.0f, 0.0f)),
+boundsCenter(Vec3(0.0f, 0.0f, 0.0f)),
+boundsRadius(0.0f) {
+  memset(&optimizeStats, 0, sizeof(optimizeStats));
 
 }
 
@@ -69,6 +78,47 @@ void ModelContentMesh::SetDirectTex(Tex* directTex) {
   this->directTex = directTex;
 }
 
+void ModelContentMesh::CalcBounds() {
+  // Every uncompacted vertex format starts with its position.
+  if(!vertices || vertexCount == 0 || vertexSize < sizeof(f32) * 3) {
+    boundsMin = Vec3(0.0f, 0.0f, 0.0f);
+    boundsMax = Vec3(0.0f, 0.0f, 0.0f);
+    boundsCenter = Vec3(0.0f, 0.0f, 0.0f);
+    boundsRadius = 0.0f;
+    return;
+  }
+
+  Vec3 pos;
+  GetVertexElement3(pos, 0, vertexSize);
+  boundsMin = pos;
+  boundsMax = pos;
+
+  for(size_t i = 1; i < vertexCount; i++) {
+    GetVertexElement3(pos, i, vertexSize);
+    boundsMin.x = min(boundsMin.x, pos.x);
+    boundsMin.y = min(boundsMin.y, pos.y);
+    boundsMin.z = min(boundsMin.z, pos.z);
+    boundsMax.x = max(boundsMax.x, pos.x);
+    boundsMax.y = max(boundsMax.y, pos.y);
+    boundsMax.z = max(boundsMax.z, pos.z);
+  }
+
+  // Centering the sphere on the box and measuring the furthest vertex gives a
+  // tighter radius than half the box diagonal.
+  boundsCenter = Vec3((boundsMin.x + boundsMax.x) * 0.5f, (boundsMin.y + boundsMax.y) * 0.5f, (boundsMin.z + boundsMax.z) * 0.5f);
+
+  f32 radiusSquared = 0.0f;
+  for(size_t i = 0; i < vertexCount; i++) {
+    GetVertexElement3(pos, i, vertexSize);
+    f32 dx = pos.x - boundsCenter.x;
+    f32 dy = pos.y - boundsCenter.y;
+    f32 dz = pos.z - boundsCenter.z;
+    radiusSquared = max(radiusSquared, dx * dx + dy * dy + dz * dz);
+  }
+
+  boundsRadius = sqrtf(radiusSquared);
+}
+
 f32 ModelContentMesh::GetVertexElement(size_t index, size_t vertexSize, size_t elementOffset) const {
   u8* vertexPtr = (u8*) vertices;
   return *(f32*) &vertexPtr[index * vertexSize + elementOffset];
@@ -31,6 +31,7 @@ SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <Prime/Model/ModelContent.h>
+#include <Prime/Model/ModelMeshOptimizer.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <png/png.h>
@@ -78,6 +79,8 @@ typedef struct _ModelMeshAnimVertex {
 
 static const aiNode* FindSceneNodeByName(const aiNode* node, const aiString& name);
 static const aiNode* FindSceneNodeByMeshIndex(const aiNode* node, size_t meshIndex);
+static s16 EncodeSNorm16(f32 value);
+static void EncodeOctahedralNormal(f32 nx, f32 ny, f32 nz, s16& x, s16& y);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
@@ -91,8 +94,12 @@ skeletonCount(0),
 animations(nullptr),
 animationCount(0),
 loadTextures(true),
+compactVertices(false),
+optimizeMeshes(true),
 vertexMin(Vec3(0.0f, 0.0f, 0.0f)),
-vertexMax(Vec3(0.0f, 0.0f, 0.0f)) {
+vertexMax(Vec3(0.0f, 0.0f, 0.0f)),
+boundsMin(Vec3(0.0f, 0.0f, 0.0f)),
+boundsMax(Vec3(0.0f, 0.0f, 0.0f)) {
 
 }
 
@@ -107,6 +114,14 @@ void ModelContentScene::SetLoadTextures(bool loadTextures) {
   this->loadTextures = loadTextures;
 }
 
+void ModelContentScene::SetCompactVertices(bool compactVertices) {
+  this->compactVertices = compactVertices;
+}
+
+void ModelContentScene::SetOptimizeMeshes(bool optimizeMeshes) {
+  this->optimizeMeshes = optimizeMeshes;
+}
+
 size_t ModelContentScene::GetMeshIndexByName(const std::string& name) const {
   for(size_t i = 0; i < meshCount; i++) {
     const ModelContentMesh& mesh = meshes[i];
@@ -720,66 +735,38 @@ void ModelContentScene::ReadModelUsingTinyGLTF(const void* data, size_t dataSize
             }
           }
 
-          void* meshIndices = nullptr;
-          IndexFormat indexFormat = IndexFormatNone;
+          u32* meshIndices = nullptr;
 
           if(indices) {
+            meshIndices = (u32*) calloc(indicesCount, sizeof(u32));
             if(indicesComponentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
-              meshIndices = calloc(indicesCount, sizeof(u8));
-              u8* meshIndices8 = (u8*) meshIndices;
               const u8* index = (const u8*) indices;
               for(size_t j = 0; j < indicesCount; j++) {
-                *meshIndices8++ = *index++;
+                meshIndices[j] = *index++;
               }
-              indexFormat = IndexFormatSize8;
             }
             else if(indicesComponentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-              meshIndices = calloc(indicesCount, sizeof(u16));
-              u16* meshIndices16 = (u16*) meshIndices;
               const u16* index = (const u16*) indices;
               for(size_t j = 0; j < indicesCount; j++) {
-                *meshIndices16++ = *index++;
+                meshIndices[j] = *index++;
               }
-              indexFormat = IndexFormatSize16;
             }
             else if(indicesComponentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-              meshIndices = calloc(indicesCount, sizeof(u32));
-              u32* meshIndices32 = (u32*) meshIndices;
               const u32* index = (const u32*) indices;
               for(size_t j = 0; j < indicesCount; j++) {
-                *meshIndices32++ = *index++;
+                meshIndices[j] = *index++;
               }
-              indexFormat = IndexFormatSize32;
             }
           }
 
-          mesh.ab = ArrayBuffer::Create(sizeof(ModelMeshAnimVertex), vertices, vertexCount, BufferPrimitiveTriangles);
-          mesh.ab->LoadAttribute("vPos", sizeof(f32) * 3);
-          mesh.ab->LoadAttribute("vUVBoneCount", sizeof(f32) * 3);
-          mesh.ab->LoadAttribute("vNormal", sizeof(f32) * 3);
-          mesh.ab->LoadAttribute("vBoneIndex1", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneIndex2", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneIndex3", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneIndex4", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneWeight1", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneWeight2", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneWeight3", sizeof(f32) * 4);
-          mesh.ab->LoadAttribute("vBoneWeight4", sizeof(f32) * 4);
-
-          if(meshIndices) {
-            mesh.ib = IndexBuffer::Create(indexFormat, meshIndices, indicesCount);
-
-            mesh.indices = meshIndices;
-            mesh.indexCount = indicesCount;
-          }
-          else {
-            PrimeAssert(false, "Could not create index buffer.");
-            mesh.indices = nullptr;
-            mesh.indexCount = 0;
-          }
+          PrimeAssert(meshIndices, "Could not create index buffer.");
 
           mesh.vertices = vertices;
           mesh.vertexCount = vertexCount;
+          mesh.vertexSize = sizeof(ModelMeshAnimVertex);
+
+          mesh.indices = meshIndices;
+          mesh.indexCount = meshIndices ? indicesCount : 0;
         }
         else {
           size_t vertexCount = positionsCount / 3;
@@ -825,58 +812,38 @@ void ModelContentScene::ReadModelUsingTinyGLTF(const void* data, size_t dataSize
             mesh.vertexMax.z = max(mesh.vertexMax.z, vertex->z);
           }
 
-          void* meshIndices = nullptr;
-          IndexFormat indexFormat = IndexFormatNone;
+          u32* meshIndices = nullptr;
 
           if(indices) {
+            meshIndices = (u32*) calloc(indicesCount, sizeof(u32));
             if(indicesComponentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
-              meshIndices = calloc(indicesCount, sizeof(u8));
-              u8* meshIndices8 = (u8*) meshIndices;
               const u8* index = (const u8*) indices;
               for(size_t j = 0; j < indicesCount; j++) {
-                *meshIndices8++ = *index++;
+                meshIndices[j] = *index++;
               }
-              indexFormat = IndexFormatSize8;
             }
             else if(indicesComponentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-              meshIndices = calloc(indicesCount, sizeof(u16));
-              u16* meshIndices16 = (u16*) meshIndices;
               const u16* index = (const u16*) indices;
               for(size_t j = 0; j < indicesCount; j++) {
-                *meshIndices16++ = *index++;
+                meshIndices[j] = *index++;
               }
-              indexFormat = IndexFormatSize16;
             }
             else if(indicesComponentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-              meshIndices = calloc(indicesCount, sizeof(u32));
-              u32* meshIndices32 = (u32*) meshIndices;
               const u32* index = (const u32*) indices;
               for(size_t j = 0; j < indicesCount; j++) {
-                *meshIndices32++ = *index++;
+                meshIndices[j] = *index++;
               }
-              indexFormat = IndexFormatSize32;
             }
           }
 
-          mesh.ab = ArrayBuffer::Create(sizeof(ModelMeshVertex), vertices, vertexCount, BufferPrimitiveTriangles);
-          mesh.ab->LoadAttribute("vPos", sizeof(f32) * 3);
-          mesh.ab->LoadAttribute("vUV", sizeof(f32) * 2);
-          mesh.ab->LoadAttribute("vNormal", sizeof(f32) * 3);
-
-          if(meshIndices) {
-            mesh.ib = IndexBuffer::Create(indexFormat, meshIndices, indicesCount);
-
-            mesh.indices = meshIndices;
-            mesh.indexCount = indicesCount;
-          }
-          else {
-            PrimeAssert(false, "Could not create index buffer.");
-            mesh.indices = nullptr;
-            mesh.indexCount = 0;
-          }
+          PrimeAssert(meshIndices, "Could not create index buffer.");
 
           mesh.vertices = vertices;
           mesh.vertexCount = vertexCount;
+          mesh.vertexSize = sizeof(ModelMeshVertex);
+
+          mesh.indices = meshIndices;
+          mesh.indexCount = meshIndices ? indicesCount : 0;
         }
       }
 
@@ -899,6 +866,8 @@ void ModelContentScene::ReadModelUsingTinyGLTF(const void* data, size_t dataSize
     }
   }
 
+  LoadMeshBuffers();
+
   if(loadTextures) {
     size_t textureCount = model.textures.size();
     for(size_t i = 0; i < textureCount; i++) {
@@ -926,9 +895,9 @@ void ModelContentScene::ReadModelUsingTinyGLTF(const void* data, size_t dataSize
         }
 
         if(!subFormat.empty()) {
-          std::string imageData((char*) &image.image[0], (size_t) image.image.size());
+          refptr<ByteBuffer> imageData = ByteBuffer::Copy(&image.image[0], image.image.size());
 
-          new Job(nullptr, [=](Job& job) {
+          Job::Create(nullptr, [=](Job& job) {
             Tex* tex = Tex::Create();
 
             tex->AddTexData("", imageData, {
@@ -1048,114 +1017,35 @@ void ModelContentScene::ReadModelUsingAssimp(const void* data, size_t dataSize)
           }
         }
 
-        void* indices = nullptr;
-        IndexFormat indexFormat = IndexFormatNone;
-
-        if(indexCount < 0x100) {
-          u8* indices8 = (u8*) calloc(indexCount, sizeof(u8));
-          u8* index = indices8;
-          indices = indices8;
-          indexFormat = IndexFormatSize8;
-
-          for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
-            const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
-            if(sceneFace->mNumIndices == 3) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-            }
-            else if(sceneFace->mNumIndices == 4) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
+        u32* indices = (u32*) calloc(indexCount, sizeof(u32));
+        u32* index = indices;
 
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[2];
-              *index++ = sceneFace->mIndices[3];
-            }
-            else if(sceneFace->mNumIndices >= 5) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              size_t triangleCount = sceneFace->mNumIndices - 2;
-              for(size_t i = 1; i < triangleCount; i++) {
-                *index++ = sceneFace->mIndices[0];
-                *index++ = sceneFace->mIndices[i + 1];
-                *index++ = sceneFace->mIndices[i + 2];
-              }
-            }
+        for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
+          const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
+          if(sceneFace->mNumIndices == 3) {
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[1];
+            *index++ = sceneFace->mIndices[2];
           }
-        }
-        else if(indexCount < 0x10000) {
-          u16* indices16 = (u16*) calloc(indexCount, sizeof(u16));
-          u16* index = indices16;
-          indices = indices16;
-          indexFormat = IndexFormatSize16;
-
-          for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
-            const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
-            if(sceneFace->mNumIndices == 3) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-            }
-            else if(sceneFace->mNumIndices == 4) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
+          else if(sceneFace->mNumIndices == 4) {
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[1];
+            *index++ = sceneFace->mIndices[2];
 
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[2];
-              *index++ = sceneFace->mIndices[3];
-            }
-            else if(sceneFace->mNumIndices >= 5) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              size_t triangleCount = sceneFace->mNumIndices - 2;
-              for(size_t i = 1; i < triangleCount; i++) {
-                *index++ = sceneFace->mIndices[0];
-                *index++ = sceneFace->mIndices[i + 1];
-                *index++ = sceneFace->mIndices[i + 2];
-              }
-            }
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[2];
+            *index++ = sceneFace->mIndices[3];
           }
-        }
-        else {
-          u32* indices32 = (u32*) calloc(indexCount, sizeof(u32));
-          u32* index = indices32;
-          indices = indices32;
-          indexFormat = IndexFormatSize32;
-
-          for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
-            const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
-            if(sceneFace->mNumIndices == 3) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-            }
-            else if(sceneFace->mNumIndices == 4) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
+          else if(sceneFace->mNumIndices >= 5) {
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[1];
+            *index++ = sceneFace->mIndices[2];
 
+            size_t triangleCount = sceneFace->mNumIndices - 2;
+            for(size_t i = 1; i < triangleCount; i++) {
               *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[2];
-              *index++ = sceneFace->mIndices[3];
-            }
-            else if(sceneFace->mNumIndices >= 5) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              size_t triangleCount = sceneFace->mNumIndices - 2;
-              for(size_t i = 1; i < triangleCount; i++) {
-                *index++ = sceneFace->mIndices[0];
-                *index++ = sceneFace->mIndices[i + 1];
-                *index++ = sceneFace->mIndices[i + 2];
-              }
+              *index++ = sceneFace->mIndices[i + 1];
+              *index++ = sceneFace->mIndices[i + 2];
             }
           }
         }
@@ -1204,23 +1094,9 @@ void ModelContentScene::ReadModelUsingAssimp(const void* data, size_t dataSize)
           node = node->mParent;
         }
 
-        mesh.ab = ArrayBuffer::Create(sizeof(ModelMeshAnimVertex), vertices, vertexCount, BufferPrimitiveTriangles);
-        mesh.ab->LoadAttribute("vPos", sizeof(f32) * 3);
-        mesh.ab->LoadAttribute("vUVBoneCount", sizeof(f32) * 3);
-        mesh.ab->LoadAttribute("vNormal", sizeof(f32) * 3);
-        mesh.ab->LoadAttribute("vBoneIndex1", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneIndex2", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneIndex3", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneIndex4", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneWeight1", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneWeight2", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneWeight3", sizeof(f32) * 4);
-        mesh.ab->LoadAttribute("vBoneWeight4", sizeof(f32) * 4);
-
-        mesh.ib = IndexBuffer::Create(indexFormat, indices, indexCount);
-
         mesh.vertices = vertices;
         mesh.vertexCount = vertexCount;
+        mesh.vertexSize = sizeof(ModelMeshAnimVertex);
 
         mesh.indices = indices;
         mesh.indexCount = indexCount;
@@ -1275,114 +1151,35 @@ void ModelContentScene::ReadModelUsingAssimp(const void* data, size_t dataSize)
           }
         }
 
-        void* indices = nullptr;
-        IndexFormat indexFormat = IndexFormatNone;
-
-        if(indexCount < 0x100) {
-          u8* indices8 = (u8*) calloc(indexCount, sizeof(u8));
-          u8* index = indices8;
-          indices = indices8;
-          indexFormat = IndexFormatSize8;
+        u32* indices = (u32*) calloc(indexCount, sizeof(u32));
+        u32* index = indices;
 
-          for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
-            const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
-            if(sceneFace->mNumIndices == 3) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-            }
-            else if(sceneFace->mNumIndices == 4) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[2];
-              *index++ = sceneFace->mIndices[3];
-            }
-            else if(sceneFace->mNumIndices >= 5) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              size_t triangleCount = sceneFace->mNumIndices - 2;
-              for(size_t i = 1; i < triangleCount; i++) {
-                *index++ = sceneFace->mIndices[0];
-                *index++ = sceneFace->mIndices[i + 1];
-                *index++ = sceneFace->mIndices[i + 2];
-              }
-            }
+        for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
+          const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
+          if(sceneFace->mNumIndices == 3) {
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[1];
+            *index++ = sceneFace->mIndices[2];
           }
-        }
-        else if(indexCount < 0x10000) {
-          u16* indices16 = (u16*) calloc(indexCount, sizeof(u16));
-          u16* index = indices16;
-          indices = indices16;
-          indexFormat = IndexFormatSize16;
-
-          for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
-            const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
-            if(sceneFace->mNumIndices == 3) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-            }
-            else if(sceneFace->mNumIndices == 4) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
+          else if(sceneFace->mNumIndices == 4) {
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[1];
+            *index++ = sceneFace->mIndices[2];
 
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[2];
-              *index++ = sceneFace->mIndices[3];
-            }
-            else if(sceneFace->mNumIndices >= 5) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              size_t triangleCount = sceneFace->mNumIndices - 2;
-              for(size_t i = 1; i < triangleCount; i++) {
-                *index++ = sceneFace->mIndices[0];
-                *index++ = sceneFace->mIndices[i + 1];
-                *index++ = sceneFace->mIndices[i + 2];
-              }
-            }
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[2];
+            *index++ = sceneFace->mIndices[3];
           }
-        }
-        else {
-          u32* indices32 = (u32*) calloc(indexCount, sizeof(u32));
-          u32* index = indices32;
-          indices = indices32;
-          indexFormat = IndexFormatSize32;
-
-          for(size_t j = 0; j < sceneMesh->mNumFaces; j++) {
-            const struct aiFace* sceneFace = &sceneMesh->mFaces[j];
-            if(sceneFace->mNumIndices == 3) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-            }
-            else if(sceneFace->mNumIndices == 4) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
+          else if(sceneFace->mNumIndices >= 5) {
+            *index++ = sceneFace->mIndices[0];
+            *index++ = sceneFace->mIndices[1];
+            *index++ = sceneFace->mIndices[2];
 
+            size_t triangleCount = sceneFace->mNumIndices - 2;
+            for(size_t i = 1; i < triangleCount; i++) {
               *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[2];
-              *index++ = sceneFace->mIndices[3];
-            }
-            else if(sceneFace->mNumIndices >= 5) {
-              *index++ = sceneFace->mIndices[0];
-              *index++ = sceneFace->mIndices[1];
-              *index++ = sceneFace->mIndices[2];
-
-              size_t triangleCount = sceneFace->mNumIndices - 2;
-              for(size_t i = 1; i < triangleCount; i++) {
-                *index++ = sceneFace->mIndices[0];
-                *index++ = sceneFace->mIndices[i + 1];
-                *index++ = sceneFace->mIndices[i + 2];
-              }
+              *index++ = sceneFace->mIndices[i + 1];
+              *index++ = sceneFace->mIndices[i + 2];
             }
           }
         }
@@ -1398,15 +1195,9 @@ void ModelContentScene::ReadModelUsingAssimp(const void* data, size_t dataSize)
           node = node->mParent;
         }
 
-        mesh.ab = ArrayBuffer::Create(sizeof(ModelMeshVertex), vertices, vertexCount, BufferPrimitiveTriangles);
-        mesh.ab->LoadAttribute("vPos", sizeof(f32) * 3);
-        mesh.ab->LoadAttribute("vUV", sizeof(f32) * 2);
-        mesh.ab->LoadAttribute("vNormal", sizeof(f32) * 3);
-
-        mesh.ib = IndexBuffer::Create(indexFormat, indices, indexCount);
-
         mesh.vertices = vertices;
         mesh.vertexCount = vertexCount;
+        mesh.vertexSize = sizeof(ModelMeshVertex);
 
         mesh.indices = indices;
         mesh.indexCount = indexCount;
@@ -1436,17 +1227,19 @@ void ModelContentScene::ReadModelUsingAssimp(const void* data, size_t dataSize)
     }
   }
 
+  LoadMeshBuffers();
+
   if(loadTextures && scene->mNumTextures) {
     for(size_t i = 0; i < scene->mNumTextures; i++) {
       aiTexture* texture = scene->mTextures[i];
       std::string formatHint(texture->achFormatHint);
 
       if(formatHint == "png" && png_sig_cmp((png_bytep) texture->pcData, 0, 8) == 0) {
-        std::string pngData((const char*) texture->pcData, texture->mWidth);
+        refptr<ByteBuffer> pngData = ByteBuffer::Copy(texture->pcData, texture->mWidth);
 
-        new Job(nullptr, [=](Job& job) {
+        Job::Create(nullptr, [=](Job& job) {
           Tex* tex = Tex::Create();
-          tex->AddTexData("", pngData);
+          tex->AddTexData("", pngData, json());
           textures.Add(tex);
         });
       }
@@ -1454,6 +1247,248 @@ void ModelContentScene::ReadModelUsingAssimp(const void* data, size_t dataSize)
   }
 }
 
+void ModelContentScene::LoadMeshBuffers() {
+  // Optimizing is the slow part of an import and each mesh is independent, so
+  // spread it across the job workers before creating buffers. Bounds are
+  // measured here too, while positions are still uncompacted.
+  ParallelFor(0, meshCount, 1, [this](size_t start, size_t end) {
+    for(size_t i = start; i < end; i++) {
+      ModelContentMesh& mesh = meshes[i];
+      mesh.CalcBounds();
+
+      if(optimizeMeshes) {
+        ModelMeshOptimizer::Optimize(mesh.vertices, mesh.vertexCount, mesh.vertexSize, 0, (u32*) mesh.indices, mesh.indexCount, &mesh.optimizeStats);
+      }
+    }
+  });
+
+  boundsMin = Vec3(0.0f, 0.0f, 0.0f);
+  boundsMax = Vec3(0.0f, 0.0f, 0.0f);
+  bool boundsSet = false;
+
+  for(size_t i = 0; i < meshCount; i++) {
+    const ModelContentMesh& mesh = meshes[i];
+    if(!mesh.vertices)
+      continue;
+
+    Vec3 meshBoundsMin;
+    Vec3 meshBoundsMax;
+    mesh.baseTransform.MultiplyBounds(mesh.boundsMin, mesh.boundsMax, meshBoundsMin, meshBoundsMax);
+
+    if(boundsSet) {
+      boundsMin.x = min(boundsMin.x, meshBoundsMin.x);
+      boundsMin.y = min(boundsMin.y, meshBoundsMin.y);
+      boundsMin.z = min(boundsMin.z, meshBoundsMin.z);
+      boundsMax.x = max(boundsMax.x, meshBoundsMax.x);
+      boundsMax.y = max(boundsMax.y, meshBoundsMax.y);
+      boundsMax.z = max(boundsMax.z, meshBoundsMax.z);
+    }
+    else {
+      boundsMin = meshBoundsMin;
+      boundsMax = meshBoundsMax;
+      boundsSet = true;
+    }
+  }
+
+  for(size_t i = 0; i < meshCount; i++) {
+    ModelContentMesh& mesh = meshes[i];
+    if(!mesh.vertices)
+      continue;
+
+    if(mesh.anim) {
+      LoadMeshAnimVertices(mesh, mesh.vertices, mesh.vertexCount);
+    }
+    else {
+      mesh.ab = ArrayBuffer::Create(sizeof(ModelMeshVertex), mesh.vertices, mesh.vertexCount, BufferPrimitiveTriangles);
+      mesh.ab->LoadAttribute("vPos", sizeof(f32) * 3);
+      mesh.ab->LoadAttribute("vUV", sizeof(f32) * 2);
+      mesh.ab->LoadAttribute("vNormal", sizeof(f32) * 3);
+    }
+
+    if(mesh.indices) {
+      IndexFormat indexFormat;
+      void* indices = ModelMeshOptimizer::CreatePackedIndices((const u32*) mesh.indices, mesh.indexCount, mesh.vertexCount, indexFormat);
+      PrimeSafeFree(mesh.indices);
+
+      mesh.indices = indices;
+      mesh.ib = IndexBuffer::Create(indexFormat, indices, mesh.indexCount);
+    }
+  }
+}
+
+void ModelContentScene::LoadMeshAnimVertices(ModelContentMesh& mesh, void* vertices, size_t vertexCount) {
+  ModelMeshAnimVertex* animVertices = (ModelMeshAnimVertex*) vertices;
+
+  if(!compactVertices) {
+    mesh.ab = ArrayBuffer::Create(sizeof(ModelMeshAnimVertex), vertices, vertexCount, BufferPrimitiveTriangles);
+    mesh.ab->LoadAttribute("vPos", sizeof(f32) * 3);
+    mesh.ab->LoadAttribute("vUVBoneCount", sizeof(f32) * 3);
+    mesh.ab->LoadAttribute("vNormal", sizeof(f32) * 3);
+    mesh.ab->LoadAttribute("vBoneIndex1", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneIndex2", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneIndex3", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneIndex4", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneWeight1", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneWeight2", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneWeight3", sizeof(f32) * 4);
+    mesh.ab->LoadAttribute("vBoneWeight4", sizeof(f32) * 4);
+
+    mesh.vertices = vertices;
+    mesh.vertexCount = vertexCount;
+    mesh.vertexSize = sizeof(ModelMeshAnimVertex);
+    mesh.vertexFormat = ModelContentMeshVertexFormatStandard;
+    return;
+  }
+
+  // Measure the ranges the quantized attributes are stored relative to, and
+  // whether the mesh needs a second set of influences or wide bone indices.
+  Vec3 posMin(std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max());
+  Vec3 posMax(std::numeric_limits<f32>::lowest(), std::numeric_limits<f32>::lowest(), std::numeric_limits<f32>::lowest());
+  Vec2 uvMin(std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max());
+  Vec2 uvMax(std::numeric_limits<f32>::lowest(), std::numeric_limits<f32>::lowest());
+  size_t influenceCount = 4;
+  size_t boneIndexMax = 0;
+
+  for(size_t i = 0; i < vertexCount; i++) {
+    const ModelMeshAnimVertex& vertex = animVertices[i];
+
+    posMin.x = min(posMin.x, vertex.x);
+    posMin.y = min(posMin.y, vertex.y);
+    posMin.z = min(posMin.z, vertex.z);
+    posMax.x = max(posMax.x, vertex.x);
+    posMax.y = max(posMax.y, vertex.y);
+    posMax.z = max(posMax.z, vertex.z);
+    uvMin.x = min(uvMin.x, vertex.u);
+    uvMin.y = min(uvMin.y, vertex.v);
+    uvMax.x = max(uvMax.x, vertex.u);
+    uvMax.y = max(uvMax.y, vertex.v);
+
+    size_t boneCount = min((size_t) roundf(vertex.boneCount), (size_t) MODEL_MESH_VERTEX_MAX_BONE_WEIGHT_COUNT);
+    if(boneCount > 4) {
+      influenceCount = 8;
+    }
+
+    for(size_t j = 0; j < boneCount; j++) {
+      boneIndexMax = max(boneIndexMax, (size_t) roundf(vertex.boneIndex[j]));
+    }
+  }
+
+  if(vertexCount == 0) {
+    posMin = posMax = Vec3(0.0f, 0.0f, 0.0f);
+    uvMin = uvMax = Vec2(0.0f, 0.0f);
+  }
+
+  Vec3 posCenter((posMin.x + posMax.x) * 0.5f, (posMin.y + posMax.y) * 0.5f, (posMin.z + posMax.z) * 0.5f);
+  Vec3 posExtent((posMax.x - posMin.x) * 0.5f, (posMax.y - posMin.y) * 0.5f, (posMax.z - posMin.z) * 0.5f);
+  Vec2 uvExtent(uvMax.x - uvMin.x, uvMax.y - uvMin.y);
+  if(posExtent.x <= 0.0f) posExtent.x = 1.0f;
+  if(posExtent.y <= 0.0f) posExtent.y = 1.0f;
+  if(posExtent.z <= 0.0f) posExtent.z = 1.0f;
+  if(uvExtent.x <= 0.0f) uvExtent.x = 1.0f;
+  if(uvExtent.y <= 0.0f) uvExtent.y = 1.0f;
+
+  bool boneIndexWide = boneIndexMax > 0xFF;
+  size_t boneIndexSize = boneIndexWide ? sizeof(u16) : sizeof(u8);
+  size_t vertexSize = sizeof(s16) * 4 + sizeof(u16) * 2 + sizeof(s16) * 2 + (boneIndexSize * 4 + sizeof(u8) * 4) * (influenceCount / 4);
+
+  u8* compactData = (u8*) calloc(vertexCount, vertexSize);
+  PrimeAssert(compactData || vertexCount == 0, "Could not create compact vertices.");
+
+  u8* out = compactData;
+  for(size_t i = 0; i < vertexCount; i++) {
+    const ModelMeshAnimVertex& vertex = animVertices[i];
+
+    s16 pos[4];
+    pos[0] = EncodeSNorm16((vertex.x - posCenter.x) / posExtent.x);
+    pos[1] = EncodeSNorm16((vertex.y - posCenter.y) / posExtent.y);
+    pos[2] = EncodeSNorm16((vertex.z - posCenter.z) / posExtent.z);
+    pos[3] = EncodeSNorm16(1.0f);
+    memcpy(out, pos, sizeof(pos));
+    out += sizeof(pos);
+
+    u16 uv[2];
+    uv[0] = (u16) roundf(clamp((vertex.u - uvMin.x) / uvExtent.x, 0.0f, 1.0f) * 65535.0f);
+    uv[1] = (u16) roundf(clamp((vertex.v - uvMin.y) / uvExtent.y, 0.0f, 1.0f) * 65535.0f);
+    memcpy(out, uv, sizeof(uv));
+    out += sizeof(uv);
+
+    s16 normal[2];
+    EncodeOctahedralNormal(vertex.nx, vertex.ny, vertex.nz, normal[0], normal[1]);
+    memcpy(out, normal, sizeof(normal));
+    out += sizeof(normal);
+
+    // Keep the strongest influences and renormalize them so the quantized
+    // weights still sum to exactly one.
+    size_t boneCount = min((size_t) roundf(vertex.boneCount), (size_t) MODEL_MESH_VERTEX_MAX_BONE_WEIGHT_COUNT);
+    size_t order[MODEL_MESH_VERTEX_MAX_BONE_WEIGHT_COUNT];
+    for(size_t j = 0; j < boneCount; j++) {
+      order[j] = j;
+    }
+    std::stable_sort(order, order + boneCount, [&vertex](size_t a, size_t b) {
+      return vertex.boneWeight[a] > vertex.boneWeight[b];
+    });
+
+    size_t keepCount = min(boneCount, influenceCount);
+    f32 weightSum = 0.0f;
+    for(size_t j = 0; j < keepCount; j++) {
+      weightSum += max(vertex.boneWeight[order[j]], 0.0f);
+    }
+
+    u16 boneIndex[8] = {0};
+    u8 boneWeight[8] = {0};
+    if(weightSum > 0.0f) {
+      s32 weightTotal = 0;
+      for(size_t j = 0; j < keepCount; j++) {
+        boneIndex[j] = (u16) roundf(vertex.boneIndex[order[j]]);
+        boneWeight[j] = (u8) roundf(max(vertex.boneWeight[order[j]], 0.0f) / weightSum * 255.0f);
+        weightTotal += boneWeight[j];
+      }
+      boneWeight[0] = (u8) clamp((s32) boneWeight[0] + 255 - weightTotal, 0, 255);
+    }
+
+    for(size_t set = 0; set < influenceCount / 4; set++) {
+      for(size_t j = 0; j < 4; j++) {
+        if(boneIndexWide) {
+          u16 index = boneIndex[set * 4 + j];
+          memcpy(out, &index, sizeof(index));
+          out += sizeof(index);
+        }
+        else {
+          *out++ = (u8) boneIndex[set * 4 + j];
+        }
+      }
+
+      for(size_t j = 0; j < 4; j++) {
+        *out++ = boneWeight[set * 4 + j];
+      }
+    }
+  }
+
+  ArrayBufferAttributeType boneIndexType = boneIndexWide ? ArrayBufferAttributeTypeU16Int : ArrayBufferAttributeTypeU8Int;
+
+  mesh.ab = ArrayBuffer::Create(vertexSize, compactData, vertexCount, BufferPrimitiveTriangles);
+  mesh.ab->LoadAttribute("vPos", ArrayBufferAttributeTypeS16Norm, 4);
+  mesh.ab->LoadAttribute("vUV", ArrayBufferAttributeTypeU16Norm, 2);
+  mesh.ab->LoadAttribute("vNormal", ArrayBufferAttributeTypeS16Norm, 2);
+  mesh.ab->LoadAttribute("vBoneIndex1", boneIndexType, 4);
+  mesh.ab->LoadAttribute("vBoneWeight1", ArrayBufferAttributeTypeU8Norm, 4);
+  if(influenceCount > 4) {
+    mesh.ab->LoadAttribute("vBoneIndex2", boneIndexType, 4);
+    mesh.ab->LoadAttribute("vBoneWeight2", ArrayBufferAttributeTypeU8Norm, 4);
+  }
+
+  mesh.posScale = Vec4(posExtent.x, posExtent.y, posExtent.z, 0.0f);
+  mesh.posOffset = Vec4(posCenter.x, posCenter.y, posCenter.z, (f32) influenceCount);
+  mesh.uvScaleOffset = Vec4(uvExtent.x, uvExtent.y, uvMin.x, uvMin.y);
+
+  PrimeSafeFree(vertices);
+
+  mesh.vertices = compactData;
+  mesh.vertexCount = vertexCount;
+  mesh.vertexSize = vertexSize;
+  mesh.vertexFormat = ModelContentMeshVertexFormatCompact;
+}
+
 const aiNode* FindSceneNodeByName(const aiNode* node, const aiString& name) {
   if(node->mName == name) {
     return node;
@@ -1487,3 +1522,28 @@ const aiNode* FindSceneNodeByMeshIndex(const aiNode* node, size_t meshIndex) {
 
   return nullptr;
 }
+
+s16 EncodeSNorm16(f32 value) {
+  return (s16) roundf(clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+void EncodeOctahedralNormal(f32 nx, f32 ny, f32 nz, s16& x, s16& y) {
+  f32 length = fabsf(nx) + fabsf(ny) + fabsf(nz);
+  if(length <= 0.0f) {
+    x = 0;
+    y = 0;
+    return;
+  }
+
+  f32 ox = nx / length;
+  f32 oy = ny / length;
+  if(nz < 0.0f) {
+    f32 fx = (1.0f - fabsf(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+    f32 fy = (1.0f - fabsf(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+    ox = fx;
+    oy = fy;
+  }
+
+  x = EncodeSNorm16(ox);
+  y = EncodeSNorm16(oy);
+}
@@ -44,6 +44,9 @@ bones(nullptr),
 boneCount(0),
 rootBoneIndex(PrimeNotFound),
 actionPoseBoneCount(0),
+orderedBoneIndices(nullptr),
+orderedBoneParentIndices(nullptr),
+orderedBoneCount(0),
 poses(nullptr),
 poseCount(0),
 actions(nullptr),
@@ -55,6 +58,7 @@ signature(0) {
 ModelContentSkeleton::~ModelContentSkeleton() {
   DestroyActions();
   DestroyPoses();
+  DestroyBoneOrder();
   DestroyBones();
 }
 
@@ -289,6 +293,8 @@ void ModelContentSkeleton::Load(const aiScene& scene) {
     }
   }
 
+  BuildBoneOrder();
+
   signature = 0;
   char intBuffer[64];
   for(size_t i = 0; i < boneCount; i++) {
@@ -808,6 +814,8 @@ void ModelContentSkeleton::Load(const tinygltf::Model& model) {
     }
   }
 
+  BuildBoneOrder();
+
   signature = 0;
   char intBuffer[64];
   for(size_t i = 0; i < boneCount; i++) {
@@ -850,6 +858,13 @@ void ModelContentSkeleton::ApplyBoneAffectingVertices(const std::string& name) {
   }
 }
 
+size_t ModelContentSkeleton::GetActionIndexByName(const std::string& name) const {
+  if(auto it = lookupActionIndexByName.Find(name))
+    return it.value();
+
+  return PrimeNotFound;
+}
+
 const ModelContentSkeletonAction* ModelContentSkeleton::GetActionByName(const std::string& name) const {
   if(auto it = lookupActionIndexByName.Find(name)) {
     return &actions[it.value()];
@@ -1185,11 +1200,46 @@ void ModelContentSkeleton::EnsureKeyFrameTransformations(ModelContentSkeletonAct
   }
 }
 
+void ModelContentSkeleton::BuildBoneOrder() {
+  DestroyBoneOrder();
+
+  if(rootBoneIndex == PrimeNotFound || rootBoneIndex >= boneCount)
+    return;
+
+  orderedBoneIndices = new size_t[boneCount];
+  orderedBoneParentIndices = new size_t[boneCount];
+  if(!orderedBoneIndices || !orderedBoneParentIndices) {
+    DestroyBoneOrder();
+    return;
+  }
+
+  // Breadth first from the root, so each bone is appended after its parent.
+  orderedBoneIndices[0] = rootBoneIndex;
+  orderedBoneParentIndices[0] = PrimeNotFound;
+  orderedBoneCount = 1;
+
+  for(size_t i = 0; i < orderedBoneCount; i++) {
+    const ModelContentSkeletonBone& bone = bones[orderedBoneIndices[i]];
+    size_t childBoneIndexCount = bone.GetChildBoneIndexCount();
+    for(size_t j = 0; j < childBoneIndexCount && orderedBoneCount < boneCount; j++) {
+      orderedBoneIndices[orderedBoneCount] = bone.GetChildBoneIndex(j);
+      orderedBoneParentIndices[orderedBoneCount] = orderedBoneIndices[i];
+      orderedBoneCount++;
+    }
+  }
+}
+
 void ModelContentSkeleton::DestroyBones() {
   PrimeSafeDeleteArray(bones);
   boneCount = 0;
 }
 
+void ModelContentSkeleton::DestroyBoneOrder() {
+  PrimeSafeDeleteArray(orderedBoneIndices);
+  PrimeSafeDeleteArray(orderedBoneParentIndices);
+  orderedBoneCount = 0;
+}
+
 void ModelContentSkeleton::DestroyPoses() {
   PrimeSafeDeleteArray(poses);
   poseCount = 0;
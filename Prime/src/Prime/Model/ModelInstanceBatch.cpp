@@ -0,0 +1,146 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Model/ModelInstanceBatch.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/Graphics.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+ModelInstanceBatch::ModelInstanceBatch(Model* model):
+model(model),
+instanceBuffer(nullptr),
+instanceBufferCapacity(0),
+instancesModified(false) {
+
+}
+
+ModelInstanceBatch::~ModelInstanceBatch() {
+  PrimeSafeDelete(instanceBuffer);
+}
+
+void ModelInstanceBatch::SetModel(Model* model) {
+  this->model = model;
+}
+
+size_t ModelInstanceBatch::AddInstance(const Mat44& transform, const Color& tint) {
+  size_t index = instances.size();
+  instances.resize(index + 1);
+  SetInstance(index, transform, tint);
+  return index;
+}
+
+void ModelInstanceBatch::SetInstance(size_t index, const Mat44& transform) {
+  PrimeAssert(index < instances.size(), "Invalid model instance index.");
+
+  memcpy(instances[index].transform, transform.e, sizeof(instances[index].transform));
+  instancesModified = true;
+}
+
+void ModelInstanceBatch::SetInstance(size_t index, const Mat44& transform, const Color& tint) {
+  PrimeAssert(index < instances.size(), "Invalid model instance index.");
+
+  ModelInstance& instance = instances[index];
+  memcpy(instance.transform, transform.e, sizeof(instance.transform));
+  instance.tint[0] = tint.r;
+  instance.tint[1] = tint.g;
+  instance.tint[2] = tint.b;
+  instance.tint[3] = tint.a;
+  instancesModified = true;
+}
+
+void ModelInstanceBatch::RemoveInstance(size_t index) {
+  if(index >= instances.size())
+    return;
+
+  // Order does not matter to an instanced draw, so fill the gap with the last
+  // instance.
+  if(index != instances.size() - 1) {
+    instances[index] = instances.back();
+  }
+
+  instances.pop_back();
+  instancesModified = true;
+}
+
+void ModelInstanceBatch::ClearInstances() {
+  instances.clear();
+  instancesModified = true;
+}
+
+void ModelInstanceBatch::ReserveInstances(size_t count) {
+  instances.reserve(count);
+}
+
+void ModelInstanceBatch::Draw() {
+  if(!model || instances.empty())
+    return;
+
+  if(instancesModified) {
+    SyncInstanceBuffer();
+  }
+
+  if(!instanceBuffer)
+    return;
+
+  model->DrawInstanced(instanceBuffer, instances.size());
+}
+
+void ModelInstanceBatch::SyncInstanceBuffer() {
+  size_t count = instances.size();
+
+  if(count > instanceBufferCapacity) {
+    size_t capacity = instanceBufferCapacity * 2;
+    if(capacity < count) {
+      capacity = count;
+    }
+    if(capacity < ModelInstanceBatchMinCapacity) {
+      capacity = ModelInstanceBatchMinCapacity;
+    }
+
+    PrimeSafeDelete(instanceBuffer);
+
+    instanceBuffer = ArrayBuffer::Create(sizeof(ModelInstance), nullptr, capacity, BufferPrimitiveTriangles);
+    instanceBuffer->LoadAttribute("iModel", sizeof(f32) * 16);
+    instanceBuffer->LoadAttribute("iTint", sizeof(f32) * 4);
+    instanceBufferCapacity = capacity;
+  }
+
+  for(size_t i = 0; i < count; i++) {
+    instanceBuffer->SetItem(i, &instances[i]);
+  }
+
+  instanceBuffer->SetSyncCount(count);
+  instancesModified = false;
+}
@@ -0,0 +1,475 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Model/ModelMeshOptimizer.h>
+#include <Prime/Types/Vec3.h>
+#include <algorithm>
+#include <vector>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////
+
+static const f32 ForsythCacheDecayPower = 1.5f;
+static const f32 ForsythLastTriangleScore = 0.75f;
+static const f32 ForsythValenceBoostScale = 2.0f;
+static const f32 ForsythValenceBoostPower = 0.5f;
+
+static const u32 ModelMeshOptimizerNoIndex = 0xFFFFFFFF;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static f32 CalcForsythVertexScore(s32 cachePosition, u32 remainingValence);
+static size_t SimulateCacheTriangle(const u32* triangle, std::vector<u32>& stamps, u32& time, size_t cacheSize);
+static const f32* GetVertexPosition(const void* vertices, size_t vertexSize, size_t positionOffset, u32 index);
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+void ModelMeshOptimizer::Optimize(void*& vertices, size_t& vertexCount, size_t vertexSize, size_t positionOffset, u32* indices, size_t indexCount, ModelMeshOptimizerStats* stats) {
+  if(stats) {
+    stats->vertexCountBefore = vertexCount;
+    stats->vertexCountAfter = vertexCount;
+    stats->triangleCount = indexCount / 3;
+    stats->acmrBefore = CalcACMR(indices, indexCount, vertexCount);
+    stats->acmrAfter = stats->acmrBefore;
+  }
+
+  if(!vertices || vertexCount == 0 || !indices || indexCount < 3)
+    return;
+
+  if(indexCount % 3 != 0) {
+    PrimeAssert(false, "Mesh index count is not a multiple of 3: %zu", indexCount);
+    return;
+  }
+
+  for(size_t i = 0; i < indexCount; i++) {
+    if(indices[i] >= vertexCount) {
+      PrimeAssert(false, "Mesh index out of range: %u >= %zu", indices[i], vertexCount);
+      return;
+    }
+  }
+
+  vertexCount = WeldVertices(vertices, vertexCount, vertexSize, indices, indexCount);
+  OptimizeVertexCache(indices, indexCount, vertexCount);
+  OptimizeOverdraw(indices, indexCount, vertices, vertexCount, vertexSize, positionOffset);
+  vertexCount = OptimizeVertexFetch(vertices, vertexCount, vertexSize, indices, indexCount);
+
+  if(void* shrunkVertices = realloc(vertices, vertexCount * vertexSize)) {
+    vertices = shrunkVertices;
+  }
+
+  if(stats) {
+    stats->vertexCountAfter = vertexCount;
+    stats->acmrAfter = CalcACMR(indices, indexCount, vertexCount);
+  }
+}
+
+size_t ModelMeshOptimizer::WeldVertices(void* vertices, size_t vertexCount, size_t vertexSize, u32* indices, size_t indexCount) {
+  if(vertexCount == 0)
+    return 0;
+
+  size_t tableSize = 1;
+  while(tableSize < vertexCount * 2) {
+    tableSize <<= 1;
+  }
+
+  std::vector<u32> table(tableSize, ModelMeshOptimizerNoIndex);
+  std::vector<u32> remap(vertexCount);
+  u8* vertexData = (u8*) vertices;
+  size_t uniqueCount = 0;
+
+  for(size_t i = 0; i < vertexCount; i++) {
+    const u8* vertex = &vertexData[i * vertexSize];
+
+    u32 hash = 2166136261u;
+    for(size_t j = 0; j < vertexSize; j++) {
+      hash = (hash ^ vertex[j]) * 16777619u;
+    }
+
+    size_t slot = hash & (tableSize - 1);
+    while(table[slot] != ModelMeshOptimizerNoIndex && memcmp(&vertexData[table[slot] * vertexSize], vertex, vertexSize) != 0) {
+      slot = (slot + 1) & (tableSize - 1);
+    }
+
+    if(table[slot] == ModelMeshOptimizerNoIndex) {
+      // Earlier unique vertices all sit below uniqueCount, so moving this one
+      // down never overwrites data the table still refers to.
+      if(uniqueCount != i) {
+        memcpy(&vertexData[uniqueCount * vertexSize], vertex, vertexSize);
+      }
+
+      table[slot] = (u32) uniqueCount;
+      uniqueCount++;
+    }
+
+    remap[i] = table[slot];
+  }
+
+  for(size_t i = 0; i < indexCount; i++) {
+    indices[i] = remap[indices[i]];
+  }
+
+  return uniqueCount;
+}
+
+void ModelMeshOptimizer::OptimizeVertexCache(u32* indices, size_t indexCount, size_t vertexCount) {
+  size_t triangleCount = indexCount / 3;
+  if(triangleCount == 0 || vertexCount == 0)
+    return;
+
+  // Build each vertex's list of triangles. The first valence[v] entries of a
+  // vertex's list are the triangles that have not been emitted yet.
+  std::vector<u32> valence(vertexCount, 0);
+  for(size_t i = 0; i < triangleCount * 3; i++) {
+    valence[indices[i]]++;
+  }
+
+  std::vector<u32> adjacencyOffset(vertexCount + 1, 0);
+  for(size_t i = 0; i < vertexCount; i++) {
+    adjacencyOffset[i + 1] = adjacencyOffset[i] + valence[i];
+  }
+
+  std::vector<u32> adjacency(triangleCount * 3);
+  std::vector<u32> adjacencyFill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+  for(size_t i = 0; i < triangleCount * 3; i++) {
+    adjacency[adjacencyFill[indices[i]]++] = (u32) (i / 3);
+  }
+
+  std::vector<s32> cachePosition(vertexCount, -1);
+  std::vector<f32> vertexScore(vertexCount);
+  for(size_t i = 0; i < vertexCount; i++) {
+    vertexScore[i] = CalcForsythVertexScore(-1, valence[i]);
+  }
+
+  std::vector<u8> triangleEmitted(triangleCount, 0);
+
+  std::vector<u32> output(triangleCount * 3);
+  u32 cache[ModelMeshOptimizerCacheSize + 3];
+  u32 nextCache[ModelMeshOptimizerCacheSize + 3];
+  size_t cacheCount = 0;
+  size_t scanCursor = 0;
+  u32 bestTriangle = ModelMeshOptimizerNoIndex;
+
+  for(size_t emitted = 0; emitted < triangleCount; emitted++) {
+    // With nothing in the cache to continue from, restart at the next
+    // triangle in the input order.
+    if(bestTriangle == ModelMeshOptimizerNoIndex) {
+      while(triangleEmitted[scanCursor]) {
+        scanCursor++;
+      }
+      bestTriangle = (u32) scanCursor;
+    }
+
+    const u32* triangle = &indices[bestTriangle * 3];
+    output[emitted * 3 + 0] = triangle[0];
+    output[emitted * 3 + 1] = triangle[1];
+    output[emitted * 3 + 2] = triangle[2];
+    triangleEmitted[bestTriangle] = 1;
+
+    for(size_t i = 0; i < 3; i++) {
+      u32 v = triangle[i];
+      u32* list = &adjacency[adjacencyOffset[v]];
+      for(u32 j = 0; j < valence[v]; j++) {
+        if(list[j] == bestTriangle) {
+          list[j] = list[valence[v] - 1];
+          valence[v]--;
+          break;
+        }
+      }
+    }
+
+    // The emitted triangle's vertices move to the front of the cache.
+    size_t nextCacheCount = 0;
+    for(size_t i = 0; i < 3; i++) {
+      nextCache[nextCacheCount++] = triangle[i];
+    }
+    for(size_t i = 0; i < cacheCount; i++) {
+      u32 v = cache[i];
+      if(v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+        nextCache[nextCacheCount++] = v;
+      }
+    }
+
+    for(size_t i = 0; i < nextCacheCount; i++) {
+      u32 v = nextCache[i];
+      cachePosition[v] = i < ModelMeshOptimizerCacheSize ? (s32) i : -1;
+      vertexScore[v] = CalcForsythVertexScore(cachePosition[v], valence[v]);
+    }
+
+    f32 bestScore = -1.0f;
+    bestTriangle = ModelMeshOptimizerNoIndex;
+    for(size_t i = 0; i < nextCacheCount; i++) {
+      u32 v = nextCache[i];
+      const u32* list = &adjacency[adjacencyOffset[v]];
+      for(u32 j = 0; j < valence[v]; j++) {
+        u32 t = list[j];
+        const u32* adjacentTriangle = &indices[t * 3];
+        f32 score = vertexScore[adjacentTriangle[0]] + vertexScore[adjacentTriangle[1]] + vertexScore[adjacentTriangle[2]];
+        if(score > bestScore) {
+          bestScore = score;
+          bestTriangle = t;
+        }
+      }
+    }
+
+    cacheCount = min(nextCacheCount, (size_t) ModelMeshOptimizerCacheSize);
+    memcpy(cache, nextCache, cacheCount * sizeof(u32));
+  }
+
+  memcpy(indices, output.data(), triangleCount * 3 * sizeof(u32));
+}
+
+void ModelMeshOptimizer::OptimizeOverdraw(u32* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset, f32 threshold) {
+  size_t triangleCount = indexCount / 3;
+  if(triangleCount < 2 || vertexCount == 0)
+    return;
+
+  f32 meshACMR = CalcACMR(indices, indexCount, vertexCount);
+
+  // Hard boundaries are where the cache order already restarts, which is
+  // where a triangle misses on all of its vertices. Within those, start a new
+  // cluster as soon as the current one is close enough to the mesh ACMR.
+  std::vector<u32> clusterStarts;
+  std::vector<u32> stamps(vertexCount, 0);
+  u32 time = ModelMeshOptimizerACMRCacheSize + 1;
+  size_t clusterMisses = 0;
+  size_t clusterTriangles = 0;
+
+  for(size_t i = 0; i < triangleCount; i++) {
+    size_t misses = SimulateCacheTriangle(&indices[i * 3], stamps, time, ModelMeshOptimizerACMRCacheSize);
+    bool softSplit = clusterTriangles > 0 && (f32) clusterMisses <= meshACMR * threshold * clusterTriangles;
+    if(i == 0 || misses == 3 || softSplit) {
+      clusterStarts.push_back((u32) i);
+      clusterMisses = 0;
+      clusterTriangles = 0;
+    }
+
+    clusterMisses += misses;
+    clusterTriangles++;
+  }
+
+  size_t clusterCount = clusterStarts.size();
+  if(clusterCount < 2)
+    return;
+
+  clusterStarts.push_back((u32) triangleCount);
+
+  // Sort clusters so the ones facing away from the mesh center come first.
+  Vec3 meshCenter(0.0f, 0.0f, 0.0f);
+  f32 meshArea = 0.0f;
+  std::vector<Vec3> clusterCenters(clusterCount);
+  std::vector<Vec3> clusterNormals(clusterCount);
+  std::vector<f32> clusterAreas(clusterCount);
+
+  for(size_t i = 0; i < clusterCount; i++) {
+    Vec3 center(0.0f, 0.0f, 0.0f);
+    Vec3 normal(0.0f, 0.0f, 0.0f);
+    f32 area = 0.0f;
+
+    for(size_t j = clusterStarts[i]; j < clusterStarts[i + 1]; j++) {
+      const f32* p0 = GetVertexPosition(vertices, vertexSize, positionOffset, indices[j * 3 + 0]);
+      const f32* p1 = GetVertexPosition(vertices, vertexSize, positionOffset, indices[j * 3 + 1]);
+      const f32* p2 = GetVertexPosition(vertices, vertexSize, positionOffset, indices[j * 3 + 2]);
+
+      Vec3 e1(p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]);
+      Vec3 e2(p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]);
+      Vec3 n(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+      f32 triangleArea = sqrtf(n.x * n.x + n.y * n.y + n.z * n.z);
+
+      center.x += (p0[0] + p1[0] + p2[0]) * triangleArea / 3.0f;
+      center.y += (p0[1] + p1[1] + p2[1]) * triangleArea / 3.0f;
+      center.z += (p0[2] + p1[2] + p2[2]) * triangleArea / 3.0f;
+      normal.x += n.x;
+      normal.y += n.y;
+      normal.z += n.z;
+      area += triangleArea;
+    }
+
+    meshCenter.x += center.x;
+    meshCenter.y += center.y;
+    meshCenter.z += center.z;
+    meshArea += area;
+
+    if(area > 0.0f) {
+      center.x /= area;
+      center.y /= area;
+      center.z /= area;
+    }
+
+    clusterCenters[i] = center;
+    clusterNormals[i] = normal;
+    clusterAreas[i] = area;
+  }
+
+  if(meshArea <= 0.0f)
+    return;
+
+  meshCenter.x /= meshArea;
+  meshCenter.y /= meshArea;
+  meshCenter.z /= meshArea;
+
+  std::vector<f32> clusterSortKeys(clusterCount);
+  std::vector<u32> clusterOrder(clusterCount);
+  for(size_t i = 0; i < clusterCount; i++) {
+    const Vec3& center = clusterCenters[i];
+    const Vec3& normal = clusterNormals[i];
+    f32 normalLength = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    f32 facing = (center.x - meshCenter.x) * normal.x + (center.y - meshCenter.y) * normal.y + (center.z - meshCenter.z) * normal.z;
+    clusterSortKeys[i] = normalLength > 0.0f ? facing / normalLength : 0.0f;
+    clusterOrder[i] = (u32) i;
+  }
+
+  std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](u32 a, u32 b) {
+    return clusterSortKeys[a] > clusterSortKeys[b];
+  });
+
+  std::vector<u32> output;
+  output.reserve(triangleCount * 3);
+  for(u32 cluster: clusterOrder) {
+    output.insert(output.end(), &indices[clusterStarts[cluster] * 3], &indices[clusterStarts[cluster + 1] * 3]);
+  }
+
+  memcpy(indices, output.data(), triangleCount * 3 * sizeof(u32));
+}
+
+size_t ModelMeshOptimizer::OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t vertexSize, u32* indices, size_t indexCount) {
+  std::vector<u32> remap(vertexCount, ModelMeshOptimizerNoIndex);
+  u32 nextVertex = 0;
+
+  for(size_t i = 0; i < indexCount; i++) {
+    u32& index = indices[i];
+    if(remap[index] == ModelMeshOptimizerNoIndex) {
+      remap[index] = nextVertex++;
+    }
+    index = remap[index];
+  }
+
+  u8* vertexData = (u8*) vertices;
+  std::vector<u8> source(vertexData, vertexData + vertexCount * vertexSize);
+  for(size_t i = 0; i < vertexCount; i++) {
+    if(remap[i] != ModelMeshOptimizerNoIndex) {
+      memcpy(&vertexData[remap[i] * vertexSize], &source[i * vertexSize], vertexSize);
+    }
+  }
+
+  return nextVertex;
+}
+
+f32 ModelMeshOptimizer::CalcACMR(const u32* indices, size_t indexCount, size_t vertexCount, size_t cacheSize) {
+  size_t triangleCount = indexCount / 3;
+  if(!indices || triangleCount == 0 || vertexCount == 0)
+    return 0.0f;
+
+  std::vector<u32> stamps(vertexCount, 0);
+  u32 time = (u32) cacheSize + 1;
+  size_t misses = 0;
+
+  for(size_t i = 0; i < triangleCount; i++) {
+    const u32* triangle = &indices[i * 3];
+    if(triangle[0] >= vertexCount || triangle[1] >= vertexCount || triangle[2] >= vertexCount)
+      return 0.0f;
+
+    misses += SimulateCacheTriangle(triangle, stamps, time, cacheSize);
+  }
+
+  return (f32) misses / (f32) triangleCount;
+}
+
+void* ModelMeshOptimizer::CreatePackedIndices(const u32* indices, size_t indexCount, size_t vertexCount, IndexFormat& indexFormat) {
+  if(vertexCount <= 0x10000) {
+    u16* indices16 = (u16*) calloc(indexCount, sizeof(u16));
+    PrimeAssert(indices16 || indexCount == 0, "Could not create indices.");
+    for(size_t i = 0; i < indexCount; i++) {
+      indices16[i] = (u16) indices[i];
+    }
+
+    indexFormat = IndexFormatSize16;
+    return indices16;
+  }
+  else {
+    u32* indices32 = (u32*) calloc(indexCount, sizeof(u32));
+    PrimeAssert(indices32 || indexCount == 0, "Could not create indices.");
+    memcpy(indices32, indices, indexCount * sizeof(u32));
+
+    indexFormat = IndexFormatSize32;
+    return indices32;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+f32 CalcForsythVertexScore(s32 cachePosition, u32 remainingValence) {
+  if(remainingValence == 0)
+    return -1.0f;
+
+  f32 score = 0.0f;
+  if(cachePosition >= 0) {
+    if(cachePosition < 3) {
+      // The last triangle's vertices get a fixed score so the next triangle
+      // does not simply reuse the same edge every time.
+      score = ForsythLastTriangleScore;
+    }
+    else {
+      const f32 scaler = 1.0f / (ModelMeshOptimizerCacheSize - 3);
+      score = powf(1.0f - (cachePosition - 3) * scaler, ForsythCacheDecayPower);
+    }
+  }
+
+  // Favour vertices with few triangles left so they leave the mesh early.
+  score += ForsythValenceBoostScale * powf((f32) remainingValence, -ForsythValenceBoostPower);
+
+  return score;
+}
+
+size_t SimulateCacheTriangle(const u32* triangle, std::vector<u32>& stamps, u32& time, size_t cacheSize) {
+  size_t misses = 0;
+
+  for(size_t i = 0; i < 3; i++) {
+    u32 v = triangle[i];
+    if(time - stamps[v] > cacheSize) {
+      stamps[v] = time++;
+      misses++;
+    }
+  }
+
+  return misses;
+}
+
+const f32* GetVertexPosition(const void* vertices, size_t vertexSize, size_t positionOffset, u32 index) {
+  return (const f32*) &((const u8*) vertices)[index * vertexSize + positionOffset];
+}
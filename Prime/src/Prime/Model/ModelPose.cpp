@@ -90,15 +90,11 @@ void ModelPose::SetContent(refptr<ModelContent> content, size_t actionIndex) {
 }
 
 void ModelPose::Copy(const ModelContentSkeletonPose& pose) {
-  if(!HasContent())
-    return;
-  
-  const ModelContentSkeleton* skeleton = GetSkeleton();
-  if(!skeleton)
+  // Bones are only allocated once the skeleton is resolved in SetContent, so
+  // there is no need to look it up again by name here.
+  if(!HasContent() || !bones)
     return;
 
-  size_t boneCount = skeleton->GetBoneCount();
-
   for(size_t i = 0; i < boneCount; i++) {
     const ModelContentSkeletonPoseBone& skeletonPoseBone = pose.GetPoseBone(i);
     ModelPoseBone& bone = bones[i];
@@ -130,11 +126,7 @@ void ModelPose::Copy(const ModelPose& pose) {
 }
 
 void ModelPose::Interpolate(const ModelPose& pose1, const ModelPose& pose2, f32 weight, const Set<std::string>* boneCancelInterpolate) {
-  if(!HasContent())
-    return;
-  
-  const ModelContentSkeleton* skeleton = GetSkeleton();
-  if(!skeleton)
+  if(!HasContent() || !bones)
     return;
 
   for(size_t i = 0; i < boneCount; i++) {
@@ -144,7 +136,7 @@ void ModelPose::Interpolate(const ModelPose& pose1, const ModelPose& pose2, f32
 
     if(poseBone1.poseValid && poseBone2.poseValid) {
       bone.translation = poseBone1.translation.GetLerp(poseBone2.translation, weight);
-      bone.rotation = poseBone1.rotation.Interpolate(poseBone2.rotation, weight);
+      bone.rotation = poseBone1.rotation.InterpolateFast(poseBone2.rotation, weight);
       bone.scaling = poseBone1.scaling.GetLerp(poseBone2.scaling, weight);
       bone.poseValid = true;
     }
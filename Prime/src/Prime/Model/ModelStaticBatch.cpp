@@ -0,0 +1,438 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <Prime/Model/ModelStaticBatch.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/Graphics/Graphics.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+ModelStaticBatch::ModelStaticBatch():
+nextPlacementId(0),
+pendingPlacementCount(0) {
+  memset(&stats, 0, sizeof(stats));
+}
+
+ModelStaticBatch::~ModelStaticBatch() {
+  // Rebuild jobs hold a reference to the batch, so none are in flight here.
+  for(ModelStaticBatchGroup* group: groups) {
+    PrimeSafeDelete(group->ib);
+    PrimeSafeDelete(group->ab);
+    PrimeSafeDelete(group);
+  }
+}
+
+size_t ModelStaticBatch::Add(Model* model, const Mat44& transform) {
+  if(!model)
+    return PrimeNotFound;
+
+  size_t id = nextPlacementId++;
+
+  Placement& placement = placements[id];
+  placement.model = model;
+  placement.transform = transform;
+  placement.pending = true;
+  pendingPlacementCount++;
+
+  return id;
+}
+
+void ModelStaticBatch::Remove(size_t id) {
+  auto it = placements.Find(id);
+  if(!it)
+    return;
+
+  Placement& placement = it.value();
+  if(placement.pending) {
+    pendingPlacementCount--;
+  }
+  else {
+    ReleasePlacement(id, placement);
+  }
+
+  placements.Remove(id);
+}
+
+void ModelStaticBatch::Clear() {
+  for(ModelStaticBatchGroup* group: groups) {
+    group->parts.Clear();
+    group->modified = true;
+  }
+
+  placements.Clear();
+  pendingPlacementCount = 0;
+}
+
+void ModelStaticBatch::Update() {
+  PxRequireMainThread;
+
+  if(pendingPlacementCount > 0) {
+    for(auto it: placements) {
+      Placement& placement = it.value();
+      if(placement.pending && ResolvePlacement(it.key(), placement)) {
+        placement.pending = false;
+        pendingPlacementCount--;
+      }
+    }
+  }
+
+  for(size_t i = 0; i < groups.size();) {
+    ModelStaticBatchGroup* group = groups[i];
+
+    if(!group->building) {
+      if(group->parts.GetCount() == 0) {
+        PrimeSafeDelete(group->ib);
+        PrimeSafeDelete(group->ab);
+        PrimeSafeDelete(group);
+        groups.erase(groups.begin() + i);
+        continue;
+      }
+
+      if(group->modified) {
+        StartRebuild(group);
+      }
+    }
+
+    i++;
+  }
+
+  UpdateStats();
+}
+
+void ModelStaticBatch::Draw() {
+  ogalibProfileScope("ModelStaticBatch::Draw");
+
+  Update();
+
+  stats.drawCount = 0;
+
+  Graphics& g = PxGraphics;
+
+  DeviceProgram* program = g.program;
+  if(!program)
+    return;
+
+  for(ModelStaticBatchGroup* group: groups) {
+    if(group->ab && group->ib) {
+      g.Draw(group->ab, group->ib, group->tex);
+      stats.drawCount++;
+    }
+  }
+}
+
+bool ModelStaticBatch::GetBounds(Vec3& boundsMin, Vec3& boundsMax) const {
+  bool found = false;
+
+  for(const ModelStaticBatchGroup* group: groups) {
+    if(!group->ab)
+      continue;
+
+    if(found) {
+      boundsMin.x = min(boundsMin.x, group->boundsMin.x);
+      boundsMin.y = min(boundsMin.y, group->boundsMin.y);
+      boundsMin.z = min(boundsMin.z, group->boundsMin.z);
+      boundsMax.x = max(boundsMax.x, group->boundsMax.x);
+      boundsMax.y = max(boundsMax.y, group->boundsMax.y);
+      boundsMax.z = max(boundsMax.z, group->boundsMax.z);
+    }
+    else {
+      boundsMin = group->boundsMin;
+      boundsMax = group->boundsMax;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+bool ModelStaticBatch::ResolvePlacement(size_t id, Placement& placement) {
+  Model& model = *placement.model;
+  if(!model.HasContent())
+    return false;
+
+  const ModelContentScene* scene = model.GetActiveScene();
+  if(!scene)
+    return true;
+
+  Mat44 sceneTransform = placement.transform;
+  sceneTransform.Multiply(scene->GetBaseTransform());
+
+  for(size_t i = 0; i < scene->GetMeshCount(); i++) {
+    const ModelContentMesh& mesh = scene->GetMesh(i);
+
+    // Only the standard static vertex layout can be merged. Animated and
+    // compact meshes should be drawn through Model instead.
+    if(mesh.anim || mesh.vertexFormat != ModelContentMeshVertexFormatStandard || mesh.vertexSize != sizeof(ModelStaticBatchVertex) || !mesh.vertices) {
+      dbgprintf("[Warning] Static batch skipped mesh: %s\n", mesh.GetName().c_str());
+      stats.skippedMeshCount++;
+      continue;
+    }
+
+    Tex* tex = model.GetMeshTex(mesh);
+    if(!tex)
+      continue;
+
+    ModelStaticBatchPart part;
+    part.content = model.GetModelContent();
+    part.mesh = &mesh;
+    part.transform = sceneTransform;
+    part.transform.Multiply(mesh.GetBaseTransform());
+
+    if(auto it = model.meshTransforms.Find(mesh.GetName()))
+      part.transform.Multiply(it.value());
+
+    ModelStaticBatchGroup* group = GetGroup(tex);
+    group->parts[id].push_back(part);
+    group->modified = true;
+
+    if(std::find(placement.groups.begin(), placement.groups.end(), group) == placement.groups.end()) {
+      placement.groups.push_back(group);
+    }
+  }
+
+  return true;
+}
+
+void ModelStaticBatch::ReleasePlacement(size_t id, Placement& placement) {
+  for(ModelStaticBatchGroup* group: placement.groups) {
+    group->parts.Remove(id);
+    group->modified = true;
+  }
+
+  placement.groups.clear();
+}
+
+ModelStaticBatchGroup* ModelStaticBatch::GetGroup(Tex* tex) {
+  for(ModelStaticBatchGroup* group: groups) {
+    if(group->tex == tex)
+      return group;
+  }
+
+  ModelStaticBatchGroup* group = new ModelStaticBatchGroup();
+  group->tex = tex;
+  group->ab = nullptr;
+  group->ib = nullptr;
+  group->vertexCount = 0;
+  group->indexCount = 0;
+  group->boundsMin = Vec3(0.0f, 0.0f, 0.0f);
+  group->boundsMax = Vec3(0.0f, 0.0f, 0.0f);
+  group->modified = false;
+  group->building = false;
+  groups.push_back(group);
+
+  return group;
+}
+
+void ModelStaticBatch::StartRebuild(ModelStaticBatchGroup* group) {
+  ModelStaticBatchBuild* build = new ModelStaticBatchBuild();
+  build->vertices = nullptr;
+  build->indices = nullptr;
+  build->vertexCount = 0;
+  build->indexCount = 0;
+  build->indexFormat = IndexFormatNone;
+
+  for(auto it: group->parts) {
+    const std::vector<ModelStaticBatchPart>& parts = it.value();
+    build->parts.insert(build->parts.end(), parts.begin(), parts.end());
+  }
+
+  group->modified = false;
+  group->building = true;
+  stats.rebuildCount++;
+
+  IncRef();
+
+  Job::Create([=](Job& job) {
+    ogalibProfileScope("ModelStaticBatch::Build");
+    BuildGroup(*build);
+  }, [=](Job& job) {
+    FinishRebuild(group, build);
+    DecRef();
+  });
+}
+
+void ModelStaticBatch::FinishRebuild(ModelStaticBatchGroup* group, ModelStaticBatchBuild* build) {
+  PrimeSafeDelete(group->ib);
+  PrimeSafeDelete(group->ab);
+  group->vertexCount = 0;
+  group->indexCount = 0;
+
+  if(build->vertices && build->indices) {
+    group->ab = ArrayBuffer::Create(sizeof(ModelStaticBatchVertex), build->vertices, build->vertexCount, BufferPrimitiveTriangles);
+    group->ab->LoadAttribute("vPos", sizeof(f32) * 3);
+    group->ab->LoadAttribute("vUV", sizeof(f32) * 2);
+    group->ab->LoadAttribute("vNormal", sizeof(f32) * 3);
+    group->ib = IndexBuffer::Create(build->indexFormat, build->indices, build->indexCount);
+    group->vertexCount = build->vertexCount;
+    group->indexCount = build->indexCount;
+    group->boundsMin = build->boundsMin;
+    group->boundsMax = build->boundsMax;
+  }
+
+  group->building = false;
+
+  PrimeSafeFree(build->vertices);
+  PrimeSafeFree(build->indices);
+  PrimeSafeDelete(build);
+
+  UpdateStats();
+}
+
+void ModelStaticBatch::UpdateStats() {
+  stats.placementCount = placements.GetCount();
+  stats.pendingPlacementCount = pendingPlacementCount;
+  stats.groupCount = groups.size();
+  stats.meshCount = 0;
+  stats.vertexCount = 0;
+  stats.indexCount = 0;
+
+  for(const ModelStaticBatchGroup* group: groups) {
+    for(auto it: group->parts) {
+      stats.meshCount += it.value().size();
+    }
+
+    stats.vertexCount += group->vertexCount;
+    stats.indexCount += group->indexCount;
+  }
+}
+
+void ModelStaticBatch::BuildGroup(ModelStaticBatchBuild& build) {
+  size_t vertexCount = 0;
+  size_t indexCount = 0;
+
+  for(const ModelStaticBatchPart& part: build.parts) {
+    const ModelContentMesh& mesh = *part.mesh;
+    vertexCount += mesh.GetVertexCount();
+    indexCount += mesh.indices ? mesh.indexCount : mesh.GetVertexCount();
+  }
+
+  if(vertexCount == 0 || indexCount == 0)
+    return;
+
+  ModelStaticBatchVertex* vertices = (ModelStaticBatchVertex*) malloc(vertexCount * sizeof(ModelStaticBatchVertex));
+  u32* indices = (u32*) malloc(indexCount * sizeof(u32));
+  PrimeAssert(vertices && indices, "Could not create static batch data.");
+  if(!vertices || !indices) {
+    PrimeSafeFree(vertices);
+    PrimeSafeFree(indices);
+    return;
+  }
+
+  ModelStaticBatchVertex* vertex = vertices;
+  u32* index = indices;
+  u32 baseVertex = 0;
+  bool boundsSet = false;
+
+  for(const ModelStaticBatchPart& part: build.parts) {
+    const ModelContentMesh& mesh = *part.mesh;
+    const Mat44& transform = part.transform;
+
+    // Normals are transformed by the inverse transpose so non-uniform scales
+    // keep them perpendicular to the surface.
+    Mat44 normalTransform = transform;
+    normalTransform.e14 = 0.0f;
+    normalTransform.e24 = 0.0f;
+    normalTransform.e34 = 0.0f;
+    if(normalTransform.IsAffine() ? normalTransform.InvertAffine() : normalTransform.Invert()) {
+      normalTransform.Transpose();
+    }
+
+    const ModelStaticBatchVertex* meshVertex = (const ModelStaticBatchVertex*) mesh.vertices;
+    size_t meshVertexCount = mesh.GetVertexCount();
+
+    for(size_t i = 0; i < meshVertexCount; i++, meshVertex++, vertex++) {
+      Vec3 pos = transform.Multiply(Vec3(meshVertex->x, meshVertex->y, meshVertex->z));
+      Vec3 normal = normalTransform.Multiply(Vec3(meshVertex->nx, meshVertex->ny, meshVertex->nz), 0.0f);
+      normal.Normalize();
+
+      vertex->x = pos.x;
+      vertex->y = pos.y;
+      vertex->z = pos.z;
+      vertex->u = meshVertex->u;
+      vertex->v = meshVertex->v;
+      vertex->nx = normal.x;
+      vertex->ny = normal.y;
+      vertex->nz = normal.z;
+
+      if(boundsSet) {
+        build.boundsMin.x = min(build.boundsMin.x, pos.x);
+        build.boundsMin.y = min(build.boundsMin.y, pos.y);
+        build.boundsMin.z = min(build.boundsMin.z, pos.z);
+        build.boundsMax.x = max(build.boundsMax.x, pos.x);
+        build.boundsMax.y = max(build.boundsMax.y, pos.y);
+        build.boundsMax.z = max(build.boundsMax.z, pos.z);
+      }
+      else {
+        build.boundsMin = pos;
+        build.boundsMax = pos;
+        boundsSet = true;
+      }
+    }
+
+    if(mesh.indices) {
+      IndexFormat indexFormat = mesh.ib ? mesh.ib->GetFormat() : IndexFormatSize32;
+      for(size_t i = 0; i < mesh.indexCount; i++) {
+        u32 value;
+        switch(indexFormat) {
+        case IndexFormatSize8:
+          value = ((const u8*) mesh.indices)[i];
+          break;
+        case IndexFormatSize16:
+          value = ((const u16*) mesh.indices)[i];
+          break;
+        default:
+          value = ((const u32*) mesh.indices)[i];
+          break;
+        }
+
+        *index++ = baseVertex + value;
+      }
+    }
+    else {
+      for(size_t i = 0; i < meshVertexCount; i++) {
+        *index++ = baseVertex + (u32) i;
+      }
+    }
+
+    baseVertex += (u32) meshVertexCount;
+  }
+
+  build.vertices = vertices;
+  build.vertexCount = vertexCount;
+  build.indices = ModelMeshOptimizer::CreatePackedIndices(indices, indexCount, vertexCount, build.indexFormat);
+  build.indexCount = indexCount;
+
+  PrimeSafeFree(indices);
+}
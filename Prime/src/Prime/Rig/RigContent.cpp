@@ -100,7 +100,7 @@ bool RigContent::Load(const json& data, const json& info) {
             }
           }
 
-          new Job(nullptr, [=](Job& job) {
+          Job::Create(nullptr, [=](Job& job) {
             newChildren->Assign(contentNode, nodeIndex);
             if(newChildren->IsFullyAssigned()) {
               children = newChildren;
@@ -433,6 +433,8 @@ void Skeleton::SetDefaultSkinset() {
 }
 
 void Skeleton::Calc(f32 dt) {
+  ogalibProfileScope("Skeleton::Calc");
+
   if(!HasContent())
     return;
 
@@ -1028,6 +1030,8 @@ void Skeleton::ClearBoneOverrideScale(const char* bone) {
 }
 
 void Skeleton::Draw() {
+  ogalibProfileScope("Skeleton::Draw");
+
   if(!HasContent())
     return;
 
@@ -1616,6 +1620,8 @@ void Skeleton::UpdateBufferPieces() {
 }
 
 void Skeleton::UpdateBufferPose() {
+  ogalibProfileScope("Skeleton::UpdateBufferPose");
+
   if(!HasContent())
     return;
 
@@ -2087,13 +2093,13 @@ void Skeleton::SetProcessingModeInTree(SkeletonProcessingMode mode, size_t minDe
 }
 
 void Skeleton::UpdateProgramBoneData(DeviceProgram* deviceProgram) {
-  static const std::string boneTransform1Str("boneTransform1");
-  static const std::string boneTransform2Str("boneTransform2");
-  static const std::string boneTransformStr("boneTransform");
+  static const ProgramVariableHandle boneTransform1Handle("boneTransform1");
+  static const ProgramVariableHandle boneTransform2Handle("boneTransform2");
+  static const ProgramVariableHandle boneTransformHandle("boneTransform");
 
   if(deviceProgram && programDataBoneCount > 0) {
-    deviceProgram->SetArrayVariable3fv(boneTransform1Str, programData1, programDataBoneCount);
-    deviceProgram->SetArrayVariable3fv(boneTransform2Str, programData2, programDataBoneCount);
-    deviceProgram->SetArrayVariableMat44fv(boneTransformStr, (f32*) skeletonBoneRootTransforms, programDataBoneCount);
+    deviceProgram->SetArrayVariable3fv(boneTransform1Handle, programData1, programDataBoneCount);
+    deviceProgram->SetArrayVariable3fv(boneTransform2Handle, programData2, programDataBoneCount);
+    deviceProgram->SetArrayVariableMat44fv(boneTransformHandle, (f32*) skeletonBoneRootTransforms, programDataBoneCount);
   }
 }
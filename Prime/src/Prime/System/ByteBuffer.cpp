@@ -0,0 +1,98 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/System/ByteBuffer.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+ByteBuffer::ByteBuffer():
+_refCount(0),
+data(nullptr),
+size(0),
+ownedData(nullptr),
+parent(nullptr) {
+
+}
+
+ByteBuffer::ByteBuffer(void* data, size_t size):
+_refCount(0),
+data(data),
+size(size),
+ownedData(data),
+parent(nullptr) {
+
+}
+
+ByteBuffer::~ByteBuffer() {
+  PrimeSafeFree(ownedData);
+
+  if(parent) {
+    parent->DecRef();
+  }
+}
+
+void ByteBuffer::IncRef() {
+  _refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ByteBuffer::DecRef() {
+  u32 refCount = _refCount.fetch_sub(1, std::memory_order_acq_rel);
+  PrimeAssert(refCount > 0, "Released too many references.");
+
+  if(refCount == 1) {
+    delete this;
+  }
+}
+
+ByteBuffer* ByteBuffer::Slice(size_t offset, size_t size) {
+  if(offset > this->size || size > this->size - offset)
+    return nullptr;
+
+  // The slice shares this buffer's bytes and keeps it alive until released.
+  ByteBuffer* slice = new ByteBuffer();
+  slice->data = (const u8*) data + offset;
+  slice->size = size;
+  slice->parent = this;
+  IncRef();
+
+  return slice;
+}
+
+ByteBuffer* ByteBuffer::Copy(const void* data, size_t size) {
+  if(data == nullptr || size == 0)
+    return nullptr;
+
+  void* copy = malloc(size);
+  if(!copy)
+    return nullptr;
+
+  memcpy(copy, data, size);
+  return new ByteBuffer(copy, size);
+}
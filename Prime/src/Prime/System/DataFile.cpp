@@ -26,6 +26,12 @@ SOFTWARE.
 
 #include <Prime/System/DataFile.h>
 
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
 using namespace Prime;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,10 +30,9 @@ SOFTWARE.
 // Includes
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <png/png.h>
-#include <png/pngstruct.h>
-#include <png/pnginfo.h>
 #include <zlib/zlib.h>
+#include <algorithm>
+#include <atomic>
 
 using namespace Prime;
 
@@ -48,23 +47,39 @@ using namespace Prime;
 // Constants
 ////////////////////////////////////////////////////////////////////////////////
 
-static const char PrimePackFormatHeader[] = {'\xE3', 'P', 'P', 'F', '\x0D', '\x0A', '\x01', '\0'};
+static const char PrimePackFormatHeader[] = PrimePackFormatHeaderBytes;
+static const uint8_t PrimePackFormatPNGSignature[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
 
 static const std::unordered_map<std::string, std::string> PrimePackFormatEmptyMetadata;
 
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static std::atomic<uint64_t> ppfItemsOpened(0);
+static std::atomic<uint64_t> ppfBytesRead(0);
+static std::atomic<uint64_t> ppfBytesCopied(0);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-static void ReadPNGFromFile(png_structp png, png_bytep data, png_size_t size);
-static int ReadPNGChunk(png_structp png, png_unknown_chunkp chunk);
+static bool FindPNGChunk(const void* data, size_t dataSize, const char* type, const void** chunk, size_t* chunkSize);
+static size_t DeflateBound(size_t srcSize);
+static size_t DeflateEncode(const void* src, size_t srcSize, void* dest, size_t destCapacity);
+static bool DeflateDecode(const void* src, size_t srcSize, void* dest, size_t destSize);
+
+// Ids after deflate are free; projects that add codecs register them at startup.
+static PrimePackFormatCodec ppfCodecs[PrimePackFormatCodecMax] = {
+  {"none", nullptr, nullptr, nullptr},
+  {"deflate", DeflateBound, DeflateEncode, DeflateDecode},
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
 
 PrimePackFormat::PrimePackFormat():
-ppfData(nullptr),
 loadChunk(nullptr),
 loadChunkSize(0),
 version(0),
@@ -73,7 +88,6 @@ error(PrimePackFormatErrorNone) {
 }
 
 PrimePackFormat::PrimePackFormat(void* data, size_t dataSize):
-ppfData(nullptr),
 loadChunk(nullptr),
 loadChunkSize(0),
 version(0),
@@ -82,7 +96,6 @@ error(PrimePackFormatErrorNone) {
 }
 
 PrimePackFormat::PrimePackFormat(PrimePackFormatError error):
-ppfData(nullptr),
 loadChunk(nullptr),
 loadChunkSize(0),
 version(0),
@@ -98,18 +111,8 @@ PrimePackFormat::~PrimePackFormat() {
     }
   }
 
-  for(auto it: items) {
-    auto item = it.second;
-    if(item) {
-      delete item;
-    }
-  }
-
   if(loadChunk)
     free(loadChunk);
-
-  if(ppfData)
-    delete ppfData;
 }
 
 bool PrimePackFormat::HasItem(const std::string& path) const {
@@ -117,11 +120,7 @@ bool PrimePackFormat::HasItem(const std::string& path) const {
     return true;
   }
 
-  if(items.find(path) != items.end()) {
-    return true;
-  }
-
-  return false;
+  return GetItem(path) != nullptr;
 }
 
 size_t PrimePackFormat::GetItemCount() const {
@@ -136,8 +135,8 @@ void PrimePackFormat::GetItemPaths(std::vector<std::string>& paths) const {
     }
   }
 
-  for(auto it: items) {
-    const std::string& path = it.first;
+  for(const auto& item: items) {
+    const std::string& path = item.path;
     if(std::find(paths.begin(), paths.end(), path) == paths.end()) {
       paths.push_back(path);
     }
@@ -160,114 +159,227 @@ BlockBuffer* PrimePackFormat::GetItemData(const std::string& path, size_t blockS
     }
   }
 
-  auto itItem = items.find(path);
-  if(itItem == items.end())
+  const PrimePackFormatItem* item = GetItem(path);
+  if(!item)
     return nullptr;
 
-  PrimePackFormatItem* itemPtr = itItem->second;
-  if(!itemPtr)
+  PrimePackFormatReader* reader = OpenItem(path);
+  if(!reader)
     return nullptr;
 
-  PrimePackFormatItem& item = *itemPtr;
-  BlockBuffer* blockBuffer = nullptr;
+  size_t useBlockSize = blockSize == 0 ? PPFBlockBufferBlockSize : blockSize;
+  uint64_t itemSize = GetItemSize(path);
+  if(itemSize > 0 && useBlockSize > itemSize)
+    useBlockSize = (size_t) itemSize;
+
+  BlockBuffer* blockBuffer = new BlockBuffer(useBlockSize);
+  size_t readBufferSize = std::min((size_t) PPFBlockBufferReadSize, std::max(useBlockSize, (size_t) 1));
+  uint8_t* buffer = (uint8_t*) malloc(readBufferSize);
+  if(buffer) {
+    while(!reader->IsDone()) {
+      size_t bytesRead = reader->Read(buffer, readBufferSize);
+      if(bytesRead == 0)
+        break;
 
-  if(item.size > 0) {
-    size_t ppfBlockBufferBlockSize = PPFBlockBufferBlockSize;
-    size_t ppfBlockBufferReadSize = PPFBlockBufferReadSize;
+      blockBuffer->Append(buffer, bytesRead);
+      CountBytes(0, bytesRead);
+    }
+    free(buffer);
+  }
 
-    size_t useBlockSize = blockSize == 0 ? ppfBlockBufferBlockSize : blockSize;
-    if(useBlockSize > item.size)
-      useBlockSize = item.size;
+  if(!buffer || reader->HasFailed()) {
+    PrimeSafeDelete(blockBuffer);
+  }
 
-    blockBuffer = new BlockBuffer(useBlockSize);
-    if(blockBuffer) {
-      size_t readBufferSize = std::min(ppfBlockBufferReadSize, item.size);
-      uint8_t* buffer = (uint8_t*) malloc(readBufferSize);
-      if(buffer) {
-        size_t bytesRemaining = item.size;
-        size_t bytesRead;
-        do {
-          size_t bytesToRead = std::min(readBufferSize, bytesRemaining);
-          bytesRead = ppfData->Read(buffer, item.offset + (item.size - bytesRemaining), bytesToRead);
-          if(bytesRead > 0) {
-            blockBuffer->Append(buffer, bytesRead);
-            bytesRemaining -= bytesRead;
-          }
-          else {
-            break;
-          }
-        }
-        while(bytesRemaining > 0);
-        free(buffer);
-      }
-      else {
-        if(blockBuffer) {
-          delete blockBuffer;
-        }
-      }
+  delete reader;
 
-      if(blockBuffer) {
-        if(item.compression == 1) {
-          BlockBuffer* uncompressedBlockBuffer = new BlockBuffer(useBlockSize);
-          void* bufferIn = malloc(ppfBlockBufferReadSize);
-          void* bufferOut = malloc(ppfBlockBufferReadSize);
-
-          z_stream stream;
-          stream.zalloc = Z_NULL;
-          stream.zfree = Z_NULL;
-          stream.opaque = Z_NULL;
-
-          inflateInit(&stream);
-
-          size_t bytesRead = 0;
-          size_t bytesUncompressed = 0;
-          while(bytesUncompressed < item.size) {
-            size_t readSize = blockBuffer->Read(bufferIn, bytesRead, ppfBlockBufferReadSize);
-            if(readSize > 0) {
-              bool inflateFailure = false;
-              stream.avail_in = (uInt) readSize;
-              stream.next_in = (Bytef*) bufferIn;
-
-              do {
-                stream.avail_out = (uInt) ppfBlockBufferReadSize;
-                stream.next_out = (Bytef*) bufferOut;
-
-                int inflateResult = inflate(&stream, Z_NO_FLUSH);
-                if(inflateResult == Z_OK || inflateResult == Z_STREAM_END) {
-                  size_t uncompressedSize = ppfBlockBufferReadSize - stream.avail_out;
-                  uncompressedBlockBuffer->Append(bufferOut, uncompressedSize);
-                  bytesUncompressed += uncompressedSize;
-                }
-                else {
-                  inflateFailure = true;
-                  break;
-                }
-              }
-              while(stream.avail_in > 0 && stream.avail_out == 0);
-
-              if(inflateFailure)
-                break;
-
-              bytesRead += readSize;
-            }
-            else {
-              break;
-            }
-          }
+  return blockBuffer;
+}
 
-          inflateEnd(&stream);
+const PrimePackFormatItem* PrimePackFormat::GetItem(const std::string& path) const {
+  auto it = std::lower_bound(items.begin(), items.end(), path, [](const PrimePackFormatItem& item, const std::string& path) {
+    return item.path < path;
+  });
 
-          free(bufferOut);
-          free(bufferIn);
-          delete blockBuffer;
+  if(it != items.end() && it->path == path)
+    return &*it;
 
-          blockBuffer = uncompressedBlockBuffer;
-        }
-      }
+  return nullptr;
+}
+
+uint64_t PrimePackFormat::GetItemSize(const std::string& path) const {
+  auto itAddedItem = addedItems.find(path);
+  if(itAddedItem != addedItems.end()) {
+    return itAddedItem->second ? itAddedItem->second->GetSize() : 0;
+  }
+
+  const PrimePackFormatItem* item = GetItem(path);
+  if(!item)
+    return 0;
+
+  // Stored items are the same size on disk; deflated items rely on the index.
+  return item->compression == 0 ? item->size : item->dataSize;
+}
+
+bool PrimePackFormat::GetItemSpan(const std::string& path, const void** data, size_t* dataSize) const {
+  if(error)
+    return false;
+
+  const PrimePackFormatItem* item = GetItem(path);
+  if(!item || item->compression != 0)
+    return false;
+
+  const void* input;
+  size_t inputSize;
+  if(!GetItemInput(*item, &input, &inputSize))
+    return false;
+
+  *data = input;
+  *dataSize = inputSize;
+
+  ppfItemsOpened.fetch_add(1, std::memory_order_relaxed);
+  CountBytes(inputSize, 0);
+
+  return true;
+}
+
+PrimePackFormatReader* PrimePackFormat::OpenItem(const std::string& path) const {
+  if(error)
+    return nullptr;
+
+  const PrimePackFormatItem* item = GetItem(path);
+  if(!item)
+    return nullptr;
+
+  if(!item->blocks.empty()) {
+    ppfItemsOpened.fetch_add(1, std::memory_order_relaxed);
+    return new PrimePackFormatReader(packBuffer, *item);
+  }
+
+  const void* input;
+  size_t inputSize;
+  if(!GetItemInput(*item, &input, &inputSize))
+    return nullptr;
+
+  ppfItemsOpened.fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t itemSize = item->compression == 0 ? item->size : item->dataSize;
+  return new PrimePackFormatReader(packBuffer, input, inputSize, itemSize, item->compression);
+}
+
+bool PrimePackFormat::ReadItem(const std::string& path, void* dest, size_t destSize) const {
+  uint64_t itemSize = GetItemSize(path);
+  if(itemSize == 0 || itemSize != destSize)
+    return false;
+
+  if(!ReadItemRange(path, 0, dest, destSize))
+    return false;
+
+  const PrimePackFormatItem* item = GetItem(path);
+  if(item && item->hash != 0 && addedItems.find(path) == addedItems.end()) {
+    return HashData(dest, destSize) == item->hash;
+  }
+
+  return true;
+}
+
+bool PrimePackFormat::ReadItemRange(const std::string& path, uint64_t offset, void* dest, size_t size) const {
+  if(error || dest == nullptr)
+    return false;
+
+  uint64_t itemSize = GetItemSize(path);
+  if(offset > itemSize || size > itemSize - offset)
+    return false;
+
+  if(size == 0)
+    return true;
+
+  auto itAddedItem = addedItems.find(path);
+  if(itAddedItem != addedItems.end()) {
+    BlockBuffer* blockBuffer = itAddedItem->second;
+    if(!blockBuffer)
+      return false;
+
+    size_t bytesRead = blockBuffer->Read(dest, (size_t) offset, size);
+    CountBytes(bytesRead, bytesRead);
+    return bytesRead == size;
+  }
+
+  const PrimePackFormatItem* item = GetItem(path);
+  if(!item)
+    return false;
+
+  if(!item->blocks.empty()) {
+    return ReadItemBlocks(*item, offset, dest, size);
+  }
+
+  PrimePackFormatReader* reader = OpenItem(path);
+  if(!reader)
+    return false;
+
+  bool result = reader->Skip(offset);
+  size_t bytesRead = 0;
+  while(result && bytesRead < size && !reader->IsDone()) {
+    size_t readSize = reader->Read((uint8_t*) dest + bytesRead, size - bytesRead);
+    if(readSize == 0)
+      break;
+
+    bytesRead += readSize;
+  }
+
+  result = result && bytesRead == size && !reader->HasFailed();
+  delete reader;
+
+  return result;
+}
+
+refptr<ByteBuffer> PrimePackFormat::GetItemBuffer(const std::string& path) const {
+  if(error)
+    return nullptr;
+
+  // Stored items are handed out as a slice of the pack without copying.
+  const PrimePackFormatItem* item = GetItem(path);
+  if(item && item->compression == 0 && addedItems.find(path) == addedItems.end()) {
+    const void* input;
+    size_t inputSize;
+    if(!GetItemInput(*item, &input, &inputSize) || inputSize == 0)
+      return nullptr;
+
+    ppfItemsOpened.fetch_add(1, std::memory_order_relaxed);
+    CountBytes(inputSize, 0);
+
+    return packBuffer->Slice((const uint8_t*) input - (const uint8_t*) packBuffer->GetData(), inputSize);
+  }
+
+  // Deflated items with a known size are inflated straight into the result.
+  uint64_t itemSize = GetItemSize(path);
+  if(item && itemSize > 0 && itemSize <= SIZE_MAX && addedItems.find(path) == addedItems.end()) {
+    void* data = malloc((size_t) itemSize);
+    if(!data)
+      return nullptr;
+
+    if(!ReadItem(path, data, (size_t) itemSize)) {
+      free(data);
+      return nullptr;
     }
+
+    return new ByteBuffer(data, (size_t) itemSize);
   }
 
-  return blockBuffer;
+  BlockBuffer* blockBuffer = GetItemData(path);
+  if(!blockBuffer)
+    return nullptr;
+
+  size_t dataSize;
+  void* data = blockBuffer->ConvertToBytes(&dataSize);
+  delete blockBuffer;
+
+  if(!data)
+    return nullptr;
+
+  CountBytes(0, dataSize);
+
+  return new ByteBuffer(data, dataSize);
 }
 
 void PrimePackFormat::AddItem(const std::string& path, void* data, size_t dataSize, bool replace) {
@@ -315,97 +427,50 @@ void PrimePackFormat::AddItem(const std::string& path, const std::string& data,
 }
 
 void PrimePackFormat::InitFromData(const void* data, size_t dataSize) {
-  if(data == nullptr || dataSize == 0)
-    return;
-
-  bool dataIsPNG = false;
+  if(loadChunk) {
+    ByteBuffer* chunk = new ByteBuffer(loadChunk, loadChunkSize);
+    loadChunk = nullptr;
+    loadChunkSize = 0;
 
-  DataFile* file = new DataFile(data, dataSize);
-  if(file) {
-    if(dataSize >= 8 && png_sig_cmp((png_bytep) data, 0, 8) == 0) {
-      png_structp png;
-      png_infop pngInfo = nullptr;
-      png_infop pngEndInfo = nullptr;
-
-      dataIsPNG = true;
-
-      png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-      if(png) {
-        pngInfo = png_create_info_struct(png);
-        if(pngInfo) {
-          pngEndInfo = png_create_info_struct(png);
-          if(pngEndInfo) {
-            png_byte chunkList[] = {
-              "cPPF",
-            };
-
-            if(setjmp(png_jmpbuf(png))) {
-              goto endReadPNG;
-            }
-
-            png_set_keep_unknown_chunks(png, PNG_HANDLE_CHUNK_IF_SAFE, chunkList, 1);
-            png_set_read_user_chunk_fn(png, this, ReadPNGChunk);
-            png_set_read_fn(png, file, ReadPNGFromFile);
-            png_set_option(png, PNG_SKIP_sRGB_CHECK_PROFILE, PNG_OPTION_OFF);
-
-            if(setjmp(png_jmpbuf(png))) {
-              goto endReadPNG;
-            }
-
-            png_read_info(png, pngInfo);
-
-            uint32_t h = pngInfo->height;
-            for(uint32_t i = 0; i < h; i++) {
-              png_read_row(png, nullptr, nullptr);
-            }
-
-            if(setjmp(png_jmpbuf(png))) {
-              goto endReadPNG;
-            }
-
-            png_read_end(png, pngEndInfo);
-          }
-        }
-      }
+    InitFromBuffer(chunk);
+    return;
+  }
 
-endReadPNG:
-      png_destroy_read_struct(&png, &pngInfo, &pngEndInfo);
-    }
+  if(data == nullptr || dataSize == 0)
+    return;
 
-    delete file;
-  }
+  // The caller keeps ownership of the data, so the pack takes its own copy.
+  size_t packOffset;
+  size_t packSize;
+  if(!FindPackData(data, dataSize, &packOffset, &packSize))
+    return;
 
-  if(dataIsPNG && !loadChunk) {
-    error = PrimePackFormatErrorChunkNotFoundInPNG;
+  ByteBuffer* buffer = ByteBuffer::Copy((const uint8_t*) data + packOffset, packSize);
+  if(!buffer) {
+    error = PrimePackFormatErrorOutOfMemory;
     return;
   }
 
-  if(loadChunk) {
-    size_t chunkSize = loadChunkSize;
-    void* chunk = malloc(chunkSize);
-    if(chunk) {
-      memcpy(chunk, loadChunk, chunkSize);
-    }
-    else {
-      chunkSize = 0;
-    }
-
-    SetLoadChunk(nullptr, 0);
+  InitFromBuffer(buffer);
+}
 
-    if(chunk) {
-      InitFromData(chunk, chunkSize);
-      if(chunk) {
-        free(chunk);
-      }
-    }
-    else {
-      error = PrimePackFormatErrorOutOfMemory;
-    }
+void PrimePackFormat::InitFromBuffer(refptr<ByteBuffer> buffer) {
+  if(!buffer || buffer->GetSize() == 0)
+    return;
 
+  size_t packOffset;
+  size_t packSize;
+  if(!FindPackData(buffer->GetData(), buffer->GetSize(), &packOffset, &packSize))
     return;
+
+  if(packOffset != 0 || packSize != buffer->GetSize()) {
+    buffer = buffer->Slice(packOffset, packSize);
   }
 
-  file = new DataFile(data, dataSize);
+  const void* data = buffer->GetData();
+  size_t dataSize = buffer->GetSize();
+
+  DataFile* file = new DataFile(data, dataSize);
   if(file) {
     do {
       char header[sizeof(PrimePackFormatHeader)];
@@ -424,7 +489,7 @@ endReadPNG:
       version = file->ReadU32V();
 
       if(version == 1) {
-        error = ParseVersion1(*file);
+        error = ParseVersion1(*file, dataSize);
         if(error) {
           break;
         }
@@ -435,7 +500,19 @@ endReadPNG:
           error = PrimePackFormatErrorInvalidFileSize;
         }
         else {
-          error = ParseVersion2(*file);
+          error = ParseVersion2(*file, dataSize);
+          if(error) {
+            break;
+          }
+        }
+      }
+      else if(version == 3) {
+        uint64_t fileSize = file->ReadU64();
+        if(fileSize != dataSize) {
+          error = PrimePackFormatErrorInvalidFileSize;
+        }
+        else {
+          error = ParseVersion3(*file, dataSize);
           if(error) {
             break;
           }
@@ -460,40 +537,12 @@ endReadPNG:
 
   if(error) {
     version = 0;
-    for(auto it: items) {
-      auto item = it.second;
-      if(item) {
-        delete item;
-      }
-    }
     items.clear();
     metadata.clear();
   }
   else {
-    size_t ptfBlockBufferBlockSize = PPFBlockBufferBlockSize;
-    size_t useBlockSize = ptfBlockBufferBlockSize;
-    if(useBlockSize > dataSize)
-      useBlockSize = dataSize;
-
-    ppfData = new BlockBuffer(useBlockSize);
-    if(ppfData) {
-      ppfData->Append(data, dataSize);
-    }
-    else {
-      error = PrimePackFormatErrorOutOfMemory;
-    }
-
-    if(error) {
-      version = 0;
-      for(auto it: items) {
-        auto item = it.second;
-        if(item) {
-          delete item;
-        }
-      }
-      items.clear();
-      metadata.clear();
-    }
+    SortItems();
+    packBuffer = buffer;
   }
 }
 
@@ -520,7 +569,7 @@ void PrimePackFormat::SetContentPath(const std::string& contentPath) {
   this->contentPath = contentPath;
 }
 
-PrimePackFormatError PrimePackFormat::ParseVersion1(DataFile& file) {
+PrimePackFormatError PrimePackFormat::ParseVersion1(DataFile& file, size_t dataSize) {
   uint32_t metadataCount = file.ReadU32V();
 
   for(uint32_t i = 0; i < metadataCount; i++) {
@@ -532,47 +581,45 @@ PrimePackFormatError PrimePackFormat::ParseVersion1(DataFile& file) {
   }
 
   uint32_t itemCount = file.ReadU32V();
+  if(itemCount > dataSize)
+    return PrimePackFormatErrorInvalidItem;
+
   if(itemCount > 0) {
+    items.reserve(itemCount);
     for(uint32_t i = 0; i < itemCount; i++) {
-      PrimePackFormatItem* itemPtr = new PrimePackFormatItem();
-      if(itemPtr) {
-        PrimePackFormatItem& item = *itemPtr;
-
-        file.Read(item.path);
-
-        item.size = file.ReadU32V();
-        item.binaryFormat = file.ReadU32V();
-        item.compression = file.ReadU32V();
-        item.dataSize  = file.ReadU32V();
-        item.offset = file.ReadU32();
-
-        uint32_t itemMetadataCount = file.ReadU32V();
-
-        for(uint32_t j = 0; j < itemMetadataCount; j++) {
-          std::string name;
-          std::string value;
-          file.Read(name);
-          file.Read(value);
-          item.metadata[name] = value;
-        }
+      items.emplace_back();
+      PrimePackFormatItem& item = items.back();
 
-        auto itItem = items.find(item.path);
-        if(itItem != items.end()) {
-          PrimePackFormatItem* existingItem = itItem->second;
-          if(existingItem) {
-            delete existingItem;
-          }
-        }
+      file.Read(item.path);
+
+      item.size = file.ReadU32V();
+      item.binaryFormat = file.ReadU32V();
+      item.compression = file.ReadU32V();
+      item.dataSize  = file.ReadU32V();
+      item.offset = file.ReadU32();
+
+      uint32_t itemMetadataCount = file.ReadU32V();
 
-        items[item.path] = itemPtr;
+      for(uint32_t j = 0; j < itemMetadataCount; j++) {
+        std::string name;
+        std::string value;
+        file.Read(name);
+        file.Read(value);
+        item.metadata[name] = value;
       }
+
+      auto itHash = item.metadata.find("hash");
+      if(itHash != item.metadata.end()) {
+        item.hash = strtoull(itHash->second.c_str(), nullptr, 16);
+      }
+
     }
   }
 
   return PrimePackFormatErrorNone;
 }
 
-PrimePackFormatError PrimePackFormat::ParseVersion2(DataFile& file) {
+PrimePackFormatError PrimePackFormat::ParseVersion2(DataFile& file, size_t dataSize) {
   uint64_t metadataCount = file.ReadU64V();
 
   for(uint64_t i = 0; i < metadataCount; i++) {
@@ -584,53 +631,323 @@ PrimePackFormatError PrimePackFormat::ParseVersion2(DataFile& file) {
   }
 
   uint64_t itemCount = file.ReadU64V();
+  if(itemCount > dataSize)
+    return PrimePackFormatErrorInvalidItem;
+
   if(itemCount > 0) {
+    items.reserve((size_t) itemCount);
     for(uint64_t i = 0; i < itemCount; i++) {
-      PrimePackFormatItem* itemPtr = new PrimePackFormatItem();
-      if(itemPtr) {
-        PrimePackFormatItem& item = *itemPtr;
-
-        file.Read(item.path);
-
-        item.size = file.ReadU64V();
-        item.binaryFormat = file.ReadU32V();
-        item.compression = file.ReadU32V();
-        item.dataSize  = file.ReadU64V();
-        item.offset = file.ReadU64();
-
-        uint64_t itemMetadataCount = file.ReadU64V();
-
-        for(uint64_t j = 0; j < itemMetadataCount; j++) {
-          std::string name;
-          std::string value;
-          file.Read(name);
-          file.Read(value);
-          item.metadata[name] = value;
-        }
+      items.emplace_back();
+      PrimePackFormatItem& item = items.back();
 
-        auto itItem = items.find(item.path);
-        if(itItem != items.end()) {
-          PrimePackFormatItem* existingItem = itItem->second;
-          if(existingItem) {
-            delete existingItem;
-          }
-        }
+      file.Read(item.path);
+
+      item.size = file.ReadU64V();
+      item.binaryFormat = file.ReadU32V();
+      item.compression = file.ReadU32V();
+      item.dataSize  = file.ReadU64V();
+      item.offset = file.ReadU64();
 
-        items[item.path] = itemPtr;
+      uint64_t itemMetadataCount = file.ReadU64V();
+
+      for(uint64_t j = 0; j < itemMetadataCount; j++) {
+        std::string name;
+        std::string value;
+        file.Read(name);
+        file.Read(value);
+        item.metadata[name] = value;
+      }
+
+      auto itHash = item.metadata.find("hash");
+      if(itHash != item.metadata.end()) {
+        item.hash = strtoull(itHash->second.c_str(), nullptr, 16);
       }
+
+    }
+  }
+
+  return PrimePackFormatErrorNone;
+}
+
+PrimePackFormatError PrimePackFormat::ParseVersion3(DataFile& file, size_t dataSize) {
+  uint64_t metadataCount = file.ReadU64V();
+
+  for(uint64_t i = 0; i < metadataCount; i++) {
+    std::string name;
+    std::string value;
+    file.Read(name);
+    file.Read(value);
+    metadata[name] = value;
+  }
+
+  uint64_t itemCount = file.ReadU64V();
+  if(itemCount > dataSize)
+    return PrimePackFormatErrorInvalidItem;
+
+  items.reserve((size_t) itemCount);
+
+  for(uint64_t i = 0; i < itemCount; i++) {
+    items.emplace_back();
+    PrimePackFormatItem& item = items.back();
+
+    file.Read(item.path);
+
+    item.dataSize = file.ReadU64V();
+    item.binaryFormat = file.ReadU32V();
+    item.compression = file.ReadU32V();
+    item.blockSize = file.ReadU32V();
+    item.hash = file.ReadU64();
+
+    uint64_t itemMetadataCount = file.ReadU64V();
+
+    for(uint64_t j = 0; j < itemMetadataCount; j++) {
+      std::string name;
+      std::string value;
+      file.Read(name);
+      file.Read(value);
+      item.metadata[name] = value;
+    }
+
+    uint64_t blockCount = file.ReadU64V();
+    uint64_t expectedBlockCount = item.blockSize > 0 ? (item.dataSize + item.blockSize - 1) / item.blockSize : 0;
+    if(blockCount != expectedBlockCount || blockCount > dataSize)
+      return PrimePackFormatErrorInvalidItem;
+
+    item.blocks.resize((size_t) blockCount);
+
+    bool stored = true;
+    for(uint64_t j = 0; j < blockCount; j++) {
+      PrimePackFormatBlock& block = item.blocks[(size_t) j];
+      block.offset = file.ReadU64();
+      block.size = file.ReadU64V();
+
+      if(block.offset > dataSize || block.size > dataSize - block.offset)
+        return PrimePackFormatErrorInvalidItem;
+
+      if(block.size != item.GetBlockDataSize((size_t) j) || (j > 0 && block.offset != item.blocks[(size_t) j - 1].offset + item.blocks[(size_t) j - 1].size)) {
+        stored = false;
+      }
+
+      item.size += block.size;
+    }
+
+    item.offset = blockCount > 0 ? item.blocks[0].offset : 0;
+
+    // Items whose blocks were all stored back to back are served as one span.
+    if(stored) {
+      item.compression = PrimePackFormatCodecNone;
+      item.blocks.clear();
     }
   }
 
   return PrimePackFormatErrorNone;
 }
 
-void ReadPNGFromFile(png_structp png, png_bytep data, png_size_t size) {
-  DataFile* file = (DataFile*) png_get_io_ptr(png);
-  file->ReadBytes(data, size);
+void PrimePackFormat::SortItems() {
+  // Later entries for the same path replace earlier ones, so keep the last of each run.
+  std::stable_sort(items.begin(), items.end(), [](const PrimePackFormatItem& a, const PrimePackFormatItem& b) {
+    return a.path < b.path;
+  });
+
+  auto last = items.begin();
+  for(auto it = items.begin(); it != items.end(); ++it) {
+    auto next = it + 1;
+    if(next == items.end() || next->path != it->path) {
+      if(last != it) {
+        *last = std::move(*it);
+      }
+      ++last;
+    }
+  }
+  items.erase(last, items.end());
+}
+
+bool PrimePackFormat::FindPackData(const void* data, size_t dataSize, size_t* packOffset, size_t* packSize) {
+  // A pack embedded in a PNG lives in a cPPF chunk. Walk the chunk headers to
+  // find it rather than decoding the image.
+  if(dataSize >= sizeof(PrimePackFormatPNGSignature) && memcmp(data, PrimePackFormatPNGSignature, sizeof(PrimePackFormatPNGSignature)) == 0) {
+    const void* chunk;
+    size_t chunkSize;
+    if(!FindPNGChunk(data, dataSize, "cPPF", &chunk, &chunkSize)) {
+      error = PrimePackFormatErrorChunkNotFoundInPNG;
+      return false;
+    }
+
+    *packOffset = (const uint8_t*) chunk - (const uint8_t*) data;
+    *packSize = chunkSize;
+    return true;
+  }
+
+  *packOffset = 0;
+  *packSize = dataSize;
+  return true;
+}
+
+bool PrimePackFormat::GetItemInput(const PrimePackFormatItem& item, const void** input, size_t* inputSize) const {
+  if(!packBuffer)
+    return false;
+
+  size_t packSize = packBuffer->GetSize();
+  if(item.offset > packSize || item.size > packSize - item.offset)
+    return false;
+
+  *input = (const uint8_t*) packBuffer->GetData() + item.offset;
+  *inputSize = (size_t) item.size;
+  return true;
+}
+
+bool PrimePackFormat::ReadItemBlocks(const PrimePackFormatItem& item, uint64_t offset, void* dest, size_t size) const {
+  const uint8_t* packData = (const uint8_t*) packBuffer->GetData();
+  uint8_t* out = (uint8_t*) dest;
+  size_t firstBlock = (size_t) (offset / item.blockSize);
+  size_t lastBlock = (size_t) ((offset + size - 1) / item.blockSize);
+  std::atomic<bool> failed(false);
+  std::atomic<uint64_t> copied(0);
+
+  // Blocks are compressed independently, so each one decodes on its own worker.
+  // Blocks fully inside the range decode in place; the partial ends go through a scratch block.
+  ParallelFor(firstBlock, lastBlock + 1, 1, [&](size_t begin, size_t end) {
+    for(size_t i = begin; i < end && !failed.load(std::memory_order_relaxed); i++) {
+      const PrimePackFormatBlock& block = item.blocks[i];
+      uint64_t blockBegin = (uint64_t) i * item.blockSize;
+      size_t blockDataSize = item.GetBlockDataSize(i);
+      uint64_t copyBegin = std::max(offset, blockBegin);
+      uint64_t copyEnd = std::min(offset + size, blockBegin + blockDataSize);
+      uint8_t* target = out + (copyBegin - offset);
+
+      if(copyBegin == blockBegin && copyEnd == blockBegin + blockDataSize) {
+        if(!DecodeBlock(item.compression, packData + block.offset, (size_t) block.size, target, blockDataSize)) {
+          failed = true;
+        }
+      }
+      else {
+        uint8_t* scratch = (uint8_t*) malloc(blockDataSize);
+        if(scratch && DecodeBlock(item.compression, packData + block.offset, (size_t) block.size, scratch, blockDataSize)) {
+          memcpy(target, scratch + (copyBegin - blockBegin), (size_t) (copyEnd - copyBegin));
+          copied.fetch_add(copyEnd - copyBegin, std::memory_order_relaxed);
+        }
+        else {
+          failed = true;
+        }
+        PrimeSafeFree(scratch);
+      }
+    }
+  });
+
+  CountBytes(size, copied.load(std::memory_order_relaxed));
+
+  return !failed.load(std::memory_order_relaxed);
+}
+
+uint64_t PrimePackFormat::HashData(const void* data, size_t dataSize) {
+  // 64-bit FNV-1a.
+  const uint8_t* bytes = (const uint8_t*) data;
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for(size_t i = 0; i < dataSize; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001B3ull;
+  }
+
+  return hash;
+}
+
+void PrimePackFormat::RegisterCodec(uint32_t type, const PrimePackFormatCodec& codec) {
+  PrimeAssert(type > PrimePackFormatCodecNone && type < PrimePackFormatCodecMax, "Invalid codec type.");
+  if(type > PrimePackFormatCodecNone && type < PrimePackFormatCodecMax) {
+    ppfCodecs[type] = codec;
+  }
+}
+
+const PrimePackFormatCodec* PrimePackFormat::GetCodec(uint32_t type) {
+  if(type >= PrimePackFormatCodecMax || ppfCodecs[type].name == nullptr)
+    return nullptr;
+
+  return &ppfCodecs[type];
+}
+
+bool PrimePackFormat::DecodeBlock(uint32_t type, const void* src, size_t srcSize, void* dest, size_t destSize) {
+  // Blocks that did not shrink are stored as is.
+  if(srcSize == destSize) {
+    memcpy(dest, src, destSize);
+    return true;
+  }
+
+  const PrimePackFormatCodec* codec = GetCodec(type);
+  if(!codec || !codec->decode)
+    return false;
+
+  return codec->decode(src, srcSize, dest, destSize);
 }
 
-int ReadPNGChunk(png_structp png, png_unknown_chunkp chunk) {
-  PrimePackFormat* ppf = (PrimePackFormat*) png_get_user_chunk_ptr(png);
-  ppf->SetLoadChunk(chunk->data, chunk->size);
-  return 1;
+void PrimePackFormat::GetStats(PrimePackFormatStats& stats) {
+  stats.itemsOpened = ppfItemsOpened.load(std::memory_order_relaxed);
+  stats.bytesRead = ppfBytesRead.load(std::memory_order_relaxed);
+  stats.bytesCopied = ppfBytesCopied.load(std::memory_order_relaxed);
+}
+
+void PrimePackFormat::ResetStats() {
+  ppfItemsOpened.store(0, std::memory_order_relaxed);
+  ppfBytesRead.store(0, std::memory_order_relaxed);
+  ppfBytesCopied.store(0, std::memory_order_relaxed);
+}
+
+void PrimePackFormat::CountBytes(uint64_t bytesRead, uint64_t bytesCopied) {
+  ppfBytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+  ppfBytesCopied.fetch_add(bytesCopied, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static bool FindPNGChunk(const void* data, size_t dataSize, const char* type, const void** chunk, size_t* chunkSize) {
+  const uint8_t* bytes = (const uint8_t*) data;
+  size_t offset = sizeof(PrimePackFormatPNGSignature);
+
+  // Each chunk is a big-endian length, a four character type, the payload and a CRC.
+  while(dataSize - offset >= 12) {
+    const uint8_t* header = bytes + offset;
+    size_t length = ((size_t) header[0] << 24) | ((size_t) header[1] << 16) | ((size_t) header[2] << 8) | (size_t) header[3];
+    if(length > 0x7FFFFFFF || length > dataSize - offset - 12)
+      return false;
+
+    const uint8_t* payload = header + 8;
+    if(memcmp(header + 4, type, 4) == 0) {
+      const uint8_t* crcBytes = payload + length;
+      uLong crc = ((uLong) crcBytes[0] << 24) | ((uLong) crcBytes[1] << 16) | ((uLong) crcBytes[2] << 8) | (uLong) crcBytes[3];
+      if(crc32(crc32(0L, Z_NULL, 0), header + 4, (uInt) length + 4) != crc)
+        return false;
+
+      *chunk = payload;
+      *chunkSize = length;
+      return true;
+    }
+
+    if(memcmp(header + 4, "IEND", 4) == 0)
+      return false;
+
+    offset += length + 12;
+  }
+
+  return false;
+}
+
+static size_t DeflateBound(size_t srcSize) {
+  return (size_t) compressBound((uLong) srcSize);
+}
+
+static size_t DeflateEncode(const void* src, size_t srcSize, void* dest, size_t destCapacity) {
+  uLongf destSize = (uLongf) destCapacity;
+  if(compress2((Bytef*) dest, &destSize, (const Bytef*) src, (uLong) srcSize, Z_BEST_COMPRESSION) != Z_OK)
+    return 0;
+
+  return (size_t) destSize;
+}
+
+static bool DeflateDecode(const void* src, size_t srcSize, void* dest, size_t destSize) {
+  uLongf uncompressedSize = (uLongf) destSize;
+  if(uncompress((Bytef*) dest, &uncompressedSize, (const Bytef*) src, (uLong) srcSize) != Z_OK)
+    return false;
+
+  return uncompressedSize == destSize;
 }
@@ -26,6 +26,12 @@ SOFTWARE.
 
 #include <Prime/System/PrimePackFormatItem.h>
 
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
 using namespace Prime;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,11 +42,15 @@ PrimePackFormatItem::PrimePackFormatItem():
 size(0),
 dataSize(0),
 offset(0),
+hash(0),
 binaryFormat(0),
-compression(0) {
+compression(0),
+blockSize(0) {
 
 }
 
-PrimePackFormatItem::~PrimePackFormatItem() {
-
+size_t PrimePackFormatItem::GetBlockDataSize(size_t index) const {
+  // Every block holds blockSize bytes except the last, which holds the remainder.
+  uint64_t begin = (uint64_t) index * blockSize;
+  return (size_t) std::min((uint64_t) blockSize, dataSize - begin);
 }
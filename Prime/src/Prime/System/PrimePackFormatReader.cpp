@@ -0,0 +1,245 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/System/PrimePackFormatReader.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/System/PrimePackFormat.h>
+#include <zlib/zlib.h>
+#include <limits.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+PrimePackFormatReader::PrimePackFormatReader(refptr<ByteBuffer> source, const void* input, size_t inputSize, uint64_t size, uint32_t compression):
+source(source),
+input((const uint8_t*) input),
+inputSize(inputSize),
+inputOffset(0),
+size(size),
+position(0),
+compression(compression),
+stream(nullptr),
+finished(false),
+failed(false),
+blockSize(0),
+blockIndex(0),
+scratch(nullptr),
+scratchOffset(0),
+scratchSize(0) {
+  if(compression == PrimePackFormatCodecDeflate) {
+    z_stream* z = (z_stream*) calloc(1, sizeof(z_stream));
+    if(z && inflateInit(z) == Z_OK) {
+      stream = z;
+    }
+    else {
+      PrimeSafeFree(z);
+      failed = true;
+    }
+  }
+  else if(compression != PrimePackFormatCodecNone) {
+    failed = true;
+  }
+}
+
+PrimePackFormatReader::PrimePackFormatReader(refptr<ByteBuffer> source, const PrimePackFormatItem& item):
+source(source),
+input((const uint8_t*) source->GetData()),
+inputSize(source->GetSize()),
+inputOffset(0),
+size(item.dataSize),
+position(0),
+compression(item.compression),
+stream(nullptr),
+finished(item.blocks.empty()),
+failed(false),
+blocks(item.blocks),
+blockSize(item.blockSize),
+blockIndex(0),
+scratch(nullptr),
+scratchOffset(0),
+scratchSize(0) {
+
+}
+
+PrimePackFormatReader::~PrimePackFormatReader() {
+  if(stream) {
+    inflateEnd((z_stream*) stream);
+    free(stream);
+  }
+
+  PrimeSafeFree(scratch);
+}
+
+size_t PrimePackFormatReader::Read(void* dest, size_t destSize) {
+  if(IsDone() || dest == nullptr || destSize == 0)
+    return 0;
+
+  uint8_t* out = (uint8_t*) dest;
+  size_t written = 0;
+
+  if(!blocks.empty()) {
+    written = ReadBlocks(out, destSize);
+  }
+  else if(compression == PrimePackFormatCodecNone) {
+    written = std::min(destSize, inputSize - inputOffset);
+    memcpy(out, input + inputOffset, written);
+    inputOffset += written;
+    finished = inputOffset == inputSize;
+
+    PrimePackFormat::CountBytes(written, written);
+  }
+  else {
+    z_stream* z = (z_stream*) stream;
+
+    while(written < destSize) {
+      if(z->avail_in == 0 && inputOffset < inputSize) {
+        size_t inputChunk = std::min(inputSize - inputOffset, (size_t) UINT_MAX);
+        z->next_in = (Bytef*) input + inputOffset;
+        z->avail_in = (uInt) inputChunk;
+        inputOffset += inputChunk;
+      }
+
+      uInt outputChunk = (uInt) std::min(destSize - written, (size_t) UINT_MAX);
+      z->next_out = out + written;
+      z->avail_out = outputChunk;
+
+      int result = inflate(z, Z_NO_FLUSH);
+      written += outputChunk - z->avail_out;
+
+      if(result == Z_STREAM_END) {
+        finished = true;
+        break;
+      }
+      else if(result != Z_OK) {
+        failed = true;
+        break;
+      }
+    }
+
+    PrimePackFormat::CountBytes(written, 0);
+  }
+
+  position += written;
+  return written;
+}
+
+bool PrimePackFormatReader::Skip(uint64_t count) {
+  if(blocks.empty() && compression == PrimePackFormatCodecNone) {
+    if(count > inputSize - inputOffset)
+      return false;
+
+    inputOffset += (size_t) count;
+    position += count;
+    finished = inputOffset == inputSize;
+    return true;
+  }
+
+  // Whole blocks ahead of the target are skipped without decoding them.
+  if(!blocks.empty() && scratchOffset == scratchSize) {
+    while(blockIndex < blocks.size()) {
+      uint64_t blockDataSize = std::min((uint64_t) blockSize, size - (uint64_t) blockIndex * blockSize);
+      if(count < blockDataSize)
+        break;
+
+      blockIndex++;
+      position += blockDataSize;
+      count -= blockDataSize;
+    }
+  }
+
+  uint8_t discard[4 * 1024];
+  while(count > 0) {
+    size_t bytesRead = Read(discard, (size_t) std::min(count, (uint64_t) sizeof(discard)));
+    if(bytesRead == 0)
+      return false;
+
+    count -= bytesRead;
+  }
+
+  return true;
+}
+
+size_t PrimePackFormatReader::ReadBlocks(uint8_t* out, size_t destSize) {
+  size_t written = 0;
+  size_t copied = 0;
+
+  while(written < destSize) {
+    if(scratchOffset < scratchSize) {
+      size_t copySize = std::min(destSize - written, scratchSize - scratchOffset);
+      memcpy(out + written, scratch + scratchOffset, copySize);
+      scratchOffset += copySize;
+      written += copySize;
+      copied += copySize;
+      continue;
+    }
+
+    if(blockIndex >= blocks.size())
+      break;
+
+    const PrimePackFormatBlock& block = blocks[blockIndex];
+    size_t blockDataSize = (size_t) std::min((uint64_t) blockSize, size - (uint64_t) blockIndex * blockSize);
+    const uint8_t* blockInput = input + block.offset;
+
+    if(destSize - written >= blockDataSize) {
+      if(!PrimePackFormat::DecodeBlock(compression, blockInput, (size_t) block.size, out + written, blockDataSize)) {
+        failed = true;
+        break;
+      }
+      written += blockDataSize;
+    }
+    else {
+      if(!scratch) {
+        scratch = (uint8_t*) malloc(blockSize);
+        if(!scratch) {
+          failed = true;
+          break;
+        }
+      }
+
+      if(!PrimePackFormat::DecodeBlock(compression, blockInput, (size_t) block.size, scratch, blockDataSize)) {
+        failed = true;
+        break;
+      }
+      scratchOffset = 0;
+      scratchSize = blockDataSize;
+    }
+
+    blockIndex++;
+  }
+
+  finished = blockIndex >= blocks.size() && scratchOffset == scratchSize;
+
+  PrimePackFormat::CountBytes(written, copied);
+
+  return written;
+}
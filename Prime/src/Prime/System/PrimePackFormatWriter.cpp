@@ -0,0 +1,255 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/System/PrimePackFormatWriter.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct _PrimePackFormatWriterBlock {
+  size_t entry;
+  size_t index;
+  uint8_t* encoded;
+  size_t size;
+  size_t patchPos;
+} PrimePackFormatWriterBlock;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static void WriteVarint(std::vector<uint8_t>& out, uint64_t v);
+static void WriteU64(std::vector<uint8_t>& out, uint64_t v);
+static void WriteString(std::vector<uint8_t>& out, const std::string& v);
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+PrimePackFormatWriter::PrimePackFormatWriter(uint32_t codec, uint32_t blockSize):
+codec(codec),
+blockSize(blockSize > 0 ? blockSize : PrimePackFormatDefaultBlockSize) {
+
+}
+
+PrimePackFormatWriter::~PrimePackFormatWriter() {
+
+}
+
+void PrimePackFormatWriter::SetCodec(uint32_t codec) {
+  this->codec = codec;
+}
+
+void PrimePackFormatWriter::SetMetadata(const std::string& name, const std::string& value) {
+  metadata[name] = value;
+}
+
+void PrimePackFormatWriter::AddItem(const std::string& path, const void* data, size_t dataSize) {
+  AddItem(path, ByteBuffer::Copy(data, dataSize));
+}
+
+void PrimePackFormatWriter::AddItem(const std::string& path, refptr<ByteBuffer> data) {
+  auto it = entryIndices.find(path);
+  if(it != entryIndices.end()) {
+    Entry& entry = entries[it->second];
+    entry.data = data;
+    entry.codec = codec;
+    return;
+  }
+
+  entryIndices[path] = entries.size();
+
+  Entry entry;
+  entry.path = path;
+  entry.data = data;
+  entry.codec = codec;
+  entries.push_back(entry);
+}
+
+ByteBuffer* PrimePackFormatWriter::Write() const {
+  std::vector<PrimePackFormatWriterBlock> blocks;
+  std::vector<uint64_t> hashes(entries.size(), 0);
+
+  for(size_t i = 0; i < entries.size(); i++) {
+    size_t dataSize = entries[i].data ? entries[i].data->GetSize() : 0;
+    size_t blockCount = (dataSize + blockSize - 1) / blockSize;
+    for(size_t j = 0; j < blockCount; j++) {
+      PrimePackFormatWriterBlock block;
+      block.entry = i;
+      block.index = j;
+      block.encoded = nullptr;
+      block.size = std::min((size_t) blockSize, dataSize - j * blockSize);
+      block.patchPos = 0;
+      blocks.push_back(block);
+    }
+  }
+
+  ParallelFor(0, entries.size(), 1, [&](size_t begin, size_t end) {
+    for(size_t i = begin; i < end; i++) {
+      if(entries[i].data) {
+        hashes[i] = PrimePackFormat::HashData(entries[i].data->GetData(), entries[i].data->GetSize());
+      }
+    }
+  });
+
+  // Blocks that do not shrink are kept as is; readers detect them by size.
+  ParallelFor(0, blocks.size(), 1, [&](size_t begin, size_t end) {
+    for(size_t i = begin; i < end; i++) {
+      PrimePackFormatWriterBlock& block = blocks[i];
+      const Entry& entry = entries[block.entry];
+      const PrimePackFormatCodec* blockCodec = PrimePackFormat::GetCodec(entry.codec);
+      if(!blockCodec || !blockCodec->encode || !blockCodec->bound)
+        continue;
+
+      const uint8_t* src = (const uint8_t*) entry.data->GetData() + block.index * blockSize;
+      size_t capacity = blockCodec->bound(block.size);
+      uint8_t* encoded = (uint8_t*) malloc(capacity);
+      size_t encodedSize = encoded ? blockCodec->encode(src, block.size, encoded, capacity) : 0;
+      if(encodedSize > 0 && encodedSize < block.size) {
+        block.encoded = encoded;
+        block.size = encodedSize;
+      }
+      else {
+        PrimeSafeFree(encoded);
+      }
+    }
+  });
+
+  std::vector<uint8_t> index;
+  const char header[] = PrimePackFormatHeaderBytes;
+  index.insert(index.end(), header, header + sizeof(header));
+  WriteVarint(index, PrimePackFormatLatestVersion);
+
+  size_t fileSizePos = index.size();
+  WriteU64(index, 0);
+
+  WriteVarint(index, metadata.size());
+  for(const auto& it: metadata) {
+    WriteString(index, it.first);
+    WriteString(index, it.second);
+  }
+
+  WriteVarint(index, entries.size());
+
+  size_t blockIndex = 0;
+  for(size_t i = 0; i < entries.size(); i++) {
+    const Entry& entry = entries[i];
+    size_t dataSize = entry.data ? entry.data->GetSize() : 0;
+    size_t blockCount = (dataSize + blockSize - 1) / blockSize;
+
+    WriteString(index, entry.path);
+    WriteVarint(index, dataSize);
+    WriteVarint(index, 0);
+    WriteVarint(index, entry.codec);
+    WriteVarint(index, blockSize);
+    WriteU64(index, hashes[i]);
+    WriteVarint(index, 0);
+    WriteVarint(index, blockCount);
+
+    for(size_t j = 0; j < blockCount; j++) {
+      PrimePackFormatWriterBlock& block = blocks[blockIndex++];
+      block.patchPos = index.size();
+      WriteU64(index, 0);
+      WriteVarint(index, block.size);
+    }
+  }
+
+  size_t totalSize = index.size();
+  for(const auto& block: blocks) {
+    totalSize += block.size;
+  }
+
+  uint8_t* data = (uint8_t*) malloc(totalSize);
+  if(data) {
+    memcpy(data, index.data(), index.size());
+
+    uint64_t fileSize = totalSize;
+    memcpy(data + fileSizePos, &fileSize, sizeof(fileSize));
+
+    size_t pos = index.size();
+    for(const auto& block: blocks) {
+      uint64_t offset = pos;
+      memcpy(data + block.patchPos, &offset, sizeof(offset));
+
+      const void* src = block.encoded ? (const void*) block.encoded : (const void*) ((const uint8_t*) entries[block.entry].data->GetData() + block.index * blockSize);
+      memcpy(data + pos, src, block.size);
+      pos += block.size;
+    }
+  }
+
+  for(auto& block: blocks) {
+    PrimeSafeFree(block.encoded);
+  }
+
+  return data ? new ByteBuffer(data, totalSize) : nullptr;
+}
+
+bool PrimePackFormatWriter::Save(const std::string& path) const {
+  refptr<ByteBuffer> buffer = Write();
+  if(!buffer)
+    return false;
+
+  FILE* file = fopen(path.c_str(), "wb");
+  if(!file)
+    return false;
+
+  size_t bytesWritten = fwrite(buffer->GetData(), 1, buffer->GetSize(), file);
+  fclose(file);
+
+  return bytesWritten == buffer->GetSize();
+}
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t v) {
+  do {
+    uint8_t b = (uint8_t) (v & 0x7F);
+    v >>= 7;
+    if(v) {
+      b |= 0x80;
+    }
+    out.push_back(b);
+  }
+  while(v);
+}
+
+void WriteU64(std::vector<uint8_t>& out, uint64_t v) {
+  uint8_t bytes[sizeof(v)];
+  memcpy(bytes, &v, sizeof(v));
+  out.insert(out.end(), bytes, bytes + sizeof(bytes));
+}
+
+void WriteString(std::vector<uint8_t>& out, const std::string& v) {
+  WriteVarint(out, v.size());
+  out.insert(out.end(), v.begin(), v.end());
+}
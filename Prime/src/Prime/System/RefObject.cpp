@@ -80,7 +80,7 @@ void RefObject::WaitForNoRefs() {
 
 void RefObject::AddJob(std::function<void(Job&)> callback, std::function<void(Job&)> response, JobType type) {
   IncRef();
-  new Job(callback, [=](Job& job) {
+  Job::Create(callback, [=](Job& job) {
     if(response) {
       response(job);
     }
@@ -91,7 +91,7 @@ void RefObject::AddJob(std::function<void(Job&)> callback, std::function<void(Jo
 
 void RefObject::AddJob(std::function<void(Job&)> callback, std::function<void(Job&)> response, const json& data, JobType type) {
   IncRef();
-  new Job(callback, [=](Job& job) {
+  Job::Create(callback, [=](Job& job) {
     if(response) {
       response(job);
     }
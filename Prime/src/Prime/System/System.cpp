@@ -99,6 +99,9 @@ static Dictionary<std::string, bool> contentDataLoadingLocked;
 static Dictionary<std::string, size_t> contentDataLoading;
 static Dictionary<std::string, refptr<ContentPPF>> contentPPFItems;
 static Dictionary<std::string, std::string> contentURIMap;
+static Dictionary<std::string, refptr<ByteBuffer>> contentPrefetched;
+static Dictionary<std::string, Stack<std::function<void (refptr<ByteBuffer>)>>> contentPrefetching;
+static size_t contentPendingCount = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
@@ -110,13 +113,15 @@ void ShutdownContent();
 void ProcessContentRefs();
 void ReleaseAllContent();
 
-static void GetContentByData(const std::string& uri, const void* data, size_t dataSize, const json& info, const std::function<void (Content*)>& callback);
+// Content declares this as a friend, which gives it external linkage.
+void SetupLoadingContent(Content* content, const std::string& uri, const json& info);
+
+static void GetContentByData(const std::string& uri, refptr<ByteBuffer> buffer, const json& info, const std::function<void (Content*)>& callback);
 
 static bool IncContentDataLoading(const std::string& uri);
 static void DecContentDataLoading(const std::string& uri, bool locked);
 static void WaitForContentDataLoading(const std::string& uri);
 static void OnContentLoadingDone(Content* content, const std::string& uri, bool locked, const std::function<void (Content*)>& callback);
-static void SetupLoadingContent(Content* content, const std::string& uri, const json& info);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -143,6 +148,13 @@ void Prime::GetContent(const std::string& uri, const json& info, const std::func
     return;
   }
 
+  // Track loads in flight so callers can tell when all requested content has arrived.
+  contentPendingCount++;
+  std::function<void (Content*)> pendingCallback = [callback](Content* content) {
+    contentPendingCount--;
+    callback(content);
+  };
+
   for(auto it: contentPPFItems) {
     auto ppf = it.value()->GetPPF();
     const std::string& ppfContentPath = ppf->GetContentPath();
@@ -150,16 +162,11 @@ void Prime::GetContent(const std::string& uri, const json& info, const std::func
     if(StartsWith(uri, ppfContentPath)) {
       std::string subPath = uri.substr(ppfContentPath.length());
       if(ppf->HasItem(subPath)) {
-        BlockBuffer* blockBuffer = ppf->GetItemData(subPath);
-        if(blockBuffer) {
-          size_t dataSize;
-          void* data = blockBuffer->ConvertToBytes(&dataSize);
-          delete blockBuffer;
-          if(data) {
-            GetContentByData(uri, data, dataSize, info, callback);
-            free(data);
-            return;
-          }
+        // Stored items are shared with the pack; deflated items are inflated once.
+        refptr<ByteBuffer> buffer = ppf->GetItemBuffer(subPath);
+        if(buffer) {
+          GetContentByData(uri, buffer, info, pendingCallback);
+          return;
         }
       }
     }
@@ -169,17 +176,11 @@ void Prime::GetContent(const std::string& uri, const json& info, const std::func
       if(!parentURI.empty()) {
         if(StartsWith(parentURI, ppfContentPath)) {
           if(ppf->HasItem(uri)) {
-            BlockBuffer* blockBuffer = ppf->GetItemData(uri);
-            if(blockBuffer) {
-              size_t dataSize;
-              void* data = blockBuffer->ConvertToBytes(&dataSize);
-              delete blockBuffer;
-              if(data) {
-                std::string useURI = ppfContentPath + uri;
-                GetContentByData(useURI, data, dataSize, info, callback);
-                free(data);
-                return;
-              }
+            refptr<ByteBuffer> buffer = ppf->GetItemBuffer(uri);
+            if(buffer) {
+              std::string useURI = ppfContentPath + uri;
+              GetContentByData(useURI, buffer, info, pendingCallback);
+              return;
             }
           }
         }
@@ -194,19 +195,28 @@ void Prime::GetContent(const std::string& uri, const json& info, const std::func
       if(auto it = response.find("data")) {
         size_t dataSize;
         const void* data = it.GetStringData(&dataSize);
-        GetContentByData(mappedURI, data, dataSize, info, callback);
+        GetContentByData(mappedURI, ByteBuffer::Copy(data, dataSize), info, pendingCallback);
       }
       else {
-        callback(nullptr);
+        pendingCallback(nullptr);
       }
     });
   }
+  else if(auto it = contentPrefetched.Find(mappedURI)) {
+    refptr<ByteBuffer> buffer = it.value();
+    contentPrefetched.Remove(mappedURI);
+    GetContentByData(mappedURI, buffer, info, pendingCallback);
+  }
+  else if(auto it = contentPrefetching.Find(mappedURI)) {
+    // Wait for the prefetch in flight rather than mapping the file a second time.
+    it.value().Push([=](refptr<ByteBuffer> buffer) {
+      GetContentByData(mappedURI, buffer, info, pendingCallback);
+    });
+  }
   else {
-    ReadFile(mappedURI, [=](void* data, size_t dataSize) {
-      GetContentByData(mappedURI, data, dataSize, info, callback);
-      if(data) {
-        free(data);
-      }
+    // The file view is shared with the decode job without copying.
+    ReadFileBuffer(mappedURI, [=](refptr<ByteBuffer> buffer) {
+      GetContentByData(mappedURI, buffer, info, pendingCallback);
     });
   }
 }
@@ -233,16 +243,10 @@ void Prime::GetContentRaw(const std::string& uri, const json& info, const std::f
     if(StartsWith(uri, ppfContentPath)) {
       std::string subPath = uri.substr(ppfContentPath.length());
       if(ppf->HasItem(subPath)) {
-        BlockBuffer* blockBuffer = ppf->GetItemData(subPath);
-        if(blockBuffer) {
-          size_t dataSize;
-          void* data = blockBuffer->ConvertToBytes(&dataSize);
-          delete blockBuffer;
-          if(data) {
-            callback(data, dataSize);
-            free(data);
-            return;
-          }
+        refptr<ByteBuffer> buffer = ppf->GetItemBuffer(subPath);
+        if(buffer) {
+          callback(buffer->GetData(), buffer->GetSize());
+          return;
         }
       }
     }
@@ -252,16 +256,10 @@ void Prime::GetContentRaw(const std::string& uri, const json& info, const std::f
       if(!parentURI.empty()) {
         if(StartsWith(parentURI, ppfContentPath)) {
           if(ppf->HasItem(uri)) {
-            BlockBuffer* blockBuffer = ppf->GetItemData(uri);
-            if(blockBuffer) {
-              size_t dataSize;
-              void* data = blockBuffer->ConvertToBytes(&dataSize);
-              delete blockBuffer;
-              if(data) {
-                callback(data, dataSize);
-                free(data);
-                return;
-              }
+            refptr<ByteBuffer> buffer = ppf->GetItemBuffer(uri);
+            if(buffer) {
+              callback(buffer->GetData(), buffer->GetSize());
+              return;
             }
           }
         }
@@ -284,15 +282,50 @@ void Prime::GetContentRaw(const std::string& uri, const json& info, const std::f
     });
   }
   else {
-    ReadFile(mappedURI, [=](void* data, size_t dataSize) {
-      callback(data, dataSize);
-      if(data) {
-        free(data);
+    ReadFileBuffer(mappedURI, [=](refptr<ByteBuffer> buffer) {
+      if(buffer) {
+        callback(buffer->GetData(), buffer->GetSize());
+      }
+      else {
+        callback(nullptr, 0);
       }
     });
   }
 }
 
+void Prime::PrefetchContent(const std::string& uri) {
+  PxRequireMainThread;
+
+  const std::string& mappedURI = GetMapppedContentURI(uri);
+
+  if(mappedURI.empty() || contentData.Find(mappedURI) || contentPrefetched.Find(mappedURI) || contentPrefetching.Find(mappedURI))
+    return;
+
+  if(StartsWith(ToLower(mappedURI), "http"))
+    return;
+
+  // Map the file and start reading it in so a later GetContent finds its pages
+  // resident. Loads requested while the read is in flight wait for its buffer.
+  contentPrefetching[mappedURI];
+
+  PrefetchFile(mappedURI, [=](refptr<ByteBuffer> buffer) {
+    Stack<std::function<void (refptr<ByteBuffer>)>> waiters;
+    if(auto it = contentPrefetching.Find(mappedURI)) {
+      waiters = it.value();
+      contentPrefetching.Remove(mappedURI);
+    }
+
+    if(waiters.GetCount() > 0) {
+      for(auto& waiter: waiters) {
+        waiter(buffer);
+      }
+    }
+    else if(buffer && !contentData.Find(mappedURI)) {
+      contentPrefetched[mappedURI] = buffer;
+    }
+  });
+}
+
 void Prime::MapContentURI(const std::string& mappedURI, const std::string& uri) {
   PxRequireMainThread;
 
@@ -310,6 +343,10 @@ const std::string& Prime::GetMapppedContentURI(const std::string& uri) {
   }
 }
 
+size_t Prime::GetPendingContentCount() {
+  return contentPendingCount;
+}
+
 void Prime::GetPackFilenames(const std::string& uri, Stack<std::string>& filenames) {
   if(auto it = contentPPFItems.Find(uri)) {
     auto ppf = it.value()->GetPPF();
@@ -376,15 +413,19 @@ void Prime::ProcessContentRefs() {
 void Prime::ReleaseAllContent() {
   ProcessContentRefs();
   contentPPFItems.Clear();
+  contentPrefetched.Clear();
   contentData.Clear();
 }
 
-void Prime::GetContentByData(const std::string& uri, const void* data, size_t dataSize, const json& info, const std::function<void (Content*)>& callback) {
-  if(data == nullptr || dataSize == 0) {
+void Prime::GetContentByData(const std::string& uri, refptr<ByteBuffer> buffer, const json& info, const std::function<void (Content*)>& callback) {
+  if(!buffer || buffer->GetSize() == 0) {
     callback(nullptr);
     return;
   }
 
+  const void* data = buffer->GetData();
+  size_t dataSize = buffer->GetSize();
+
   if(IsFormatBC(data, dataSize, info)) {
     bool locked = IncContentDataLoading(uri);
     refptr<ImagemapContent> content;
@@ -392,12 +433,11 @@ void Prime::GetContentByData(const std::string& uri, const void* data, size_t da
       content = new ImagemapContent();
     }
 
-    std::string dataCopy((const char*) data, dataSize);
-    new Job([=](Job& job) {
+    Job::Create([=](Job& job) {
       if(locked) {
         if(content) {
           SetupLoadingContent(content, uri, info);
-          content->Load(dataCopy.c_str(), dataCopy.size(), info);
+          content->Load(buffer, info);
         }
       }
       else {
@@ -450,7 +490,7 @@ void Prime::GetContentByData(const std::string& uri, const void* data, size_t da
 #endif
       }
 
-      new Job([=](Job& job) {
+      Job::Create([=](Job& job) {
         if(locked) {
           if(content) {
             SetupLoadingContent(content, uri, info);
@@ -475,35 +515,45 @@ void Prime::GetContentByData(const std::string& uri, const void* data, size_t da
       content = new ImagemapContent();
     }
 
-    std::string dataCopy((const char*) data, dataSize);
-    new Job([=](Job& job) {
-      if(locked) {
-        if(content) {
+    // Decoding the image and scanning it for an embedded PPF are independent, so
+    // they run as parallel graph jobs with a single hand-off to the main thread.
+    JobGraph* graph = new JobGraph();
+    Job* ppfJob = nullptr;
+
+    if(locked) {
+      if(content) {
+        graph->Add([=](Job& job) {
           SetupLoadingContent(content, uri, info);
-          content->Load(dataCopy.c_str(), dataCopy.size(), info);
+          content->Load(buffer, info);
+        });
 
+        ppfJob = graph->Add([=](Job& job) {
           PrimePackFormat* ppf = new PrimePackFormat();
           if(ppf) {
-            ppf->InitFromData(dataCopy.c_str(), dataCopy.size());
-            if(ppf->GetError() == PrimePackFormatErrorNone) {
-              if(ppf->GetItemCount() > 0) {
-                ppf->SetContentPath(uri);
-                job.data["ppf"] = ppf;
-              }
+            ppf->InitFromBuffer(buffer);
+            if(ppf->GetError() == PrimePackFormatErrorNone && ppf->GetItemCount() > 0) {
+              ppf->SetContentPath(uri);
+              job.SetResult(0, ppf);
             }
             else {
               delete ppf;
             }
           }
-        }
+        });
       }
-      else {
+    }
+    else {
+      graph->Add([=](Job& job) {
         WaitForContentDataLoading(uri);
-      }
-    }, [=](Job& job) {
-      if(auto it = job.data.find("ppf")) {
-        PrimePackFormat* ppf = it.GetPtr<PrimePackFormat>();
-        contentPPFItems[uri] = new ContentPPF(ppf);
+      });
+    }
+
+    graph->Start([=](JobGraph& graph) {
+      if(ppfJob) {
+        PrimePackFormat* ppf = ppfJob->GetResult<PrimePackFormat*>(0);
+        if(ppf) {
+          contentPPFItems[uri] = new ContentPPF(ppf);
+        }
       }
       OnContentLoadingDone(content, uri, locked, callback);
     });
@@ -515,12 +565,11 @@ void Prime::GetContentByData(const std::string& uri, const void* data, size_t da
       content = new ModelContent();
     }
 
-    std::string dataCopy((const char*) data, dataSize);
-    new Job([=](Job& job) {
+    Job::Create([=](Job& job) {
       if(locked) {
         if(content) {
           SetupLoadingContent(content, uri, info);
-          content->Load(dataCopy.c_str(), dataCopy.size(), info);
+          content->Load(buffer, info);
         }
       }
       else {
@@ -537,12 +586,11 @@ void Prime::GetContentByData(const std::string& uri, const void* data, size_t da
       content = new ImagemapContent();
     }
 
-    std::string dataCopy((const char*) data, dataSize);
-    new Job([=](Job& job) {
+    Job::Create([=](Job& job) {
       if(locked) {
         if(content) {
           SetupLoadingContent(content, uri, info);
-          content->Load(dataCopy.c_str(), dataCopy.size(), info);
+          content->Load(buffer, info);
         }
       }
       else {
@@ -559,12 +607,11 @@ void Prime::GetContentByData(const std::string& uri, const void* data, size_t da
       content = new FontContent();
     }
 
-    std::string dataCopy((const char*) data, dataSize);
-    new Job([=](Job& job) {
+    Job::Create([=](Job& job) {
       if(locked) {
         if(content) {
           SetupLoadingContent(content, uri, info);
-          content->Load(dataCopy.c_str(), dataCopy.size(), info);
+          content->Load(buffer, info);
         }
       }
       else {
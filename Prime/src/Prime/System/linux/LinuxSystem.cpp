@@ -0,0 +1,299 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetLinux)
+
+#include <Prime/Graphics/linux/LinuxShader.h>
+#include <Prime/Graphics/linux/LinuxProgram.h>
+#include <Prime/Graphics/linux/LinuxIndexBuffer.h>
+#include <Prime/Graphics/linux/LinuxArrayBuffer.h>
+#include <Prime/Graphics/linux/LinuxTex.h>
+#include <Prime/Graphics/Graphics.h>
+#include <Prime/System/MappedFile.h>
+
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <sys/resource.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+f64 Prime::GetSystemTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (f64) ts.tv_sec + (f64) ts.tv_nsec / 1000000000.0;
+}
+
+f64 Prime::GetTargetRTCSeconds() {
+  auto now = std::chrono::system_clock::now();
+  auto duration = now.time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1000000000.0;
+}
+
+size_t Prime::GetPeakMemoryUsage() {
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) == 0) {
+    // Linux reports the peak resident set size in kilobytes.
+    return (size_t) usage.ru_maxrss * 1024;
+  }
+
+  return 0;
+}
+
+void* Prime::ReadFile(const std::string& path, size_t* size) {
+  void* result = nullptr;
+  size_t resultSize = 0;
+
+  FILE* file = fopen(path.c_str(), "rb");
+  if(file) {
+    fseek(file, 0, SEEK_END);
+    size_t fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    result = malloc(fileSize);
+    if(result) {
+      u8* d = (u8*) result;
+      while(resultSize < fileSize) {
+        size_t bytesToRead = fileSize - resultSize;
+        size_t bytesRead = fread(d + resultSize, 1, bytesToRead, file);
+        if(bytesRead > 0) {
+          resultSize += bytesRead;
+        }
+        else {
+          break;
+        }
+      }
+    }
+
+    fclose(file);
+  }
+
+  if(size) {
+    *size = resultSize;
+  }
+
+  return result;
+}
+
+static std::string GetFullFilePath(const std::string& path) {
+  // Force paths to be read from folder tree below the working directory.
+  char cwd[PATH_MAX];
+  if(!getcwd(cwd, sizeof(cwd))) {
+    cwd[0] = 0;
+  }
+
+  std::string fullPath = cwd;
+
+  if(StartsWith(path, "/") || StartsWith(path, "\\")) {
+    fullPath += "/" + path.substr(1);
+  }
+  else {
+    fullPath += "/" + path;
+  }
+
+  return fullPath;
+}
+
+static ByteBuffer* OpenFileBuffer(const std::string& fullPath, MappedFileAdvice advice) {
+  if(MappedFile* file = MappedFile::Open(fullPath)) {
+    file->Advise(advice);
+    return file;
+  }
+
+  // Empty files and files that cannot be mapped fall back to a buffered read.
+  size_t size;
+  void* data = ReadFile(fullPath, &size);
+  if(data) {
+    return new ByteBuffer(data, size);
+  }
+
+  return nullptr;
+}
+
+static void ReadMappedFile(const std::string& path, MappedFileAdvice advice, const std::function<void (refptr<ByteBuffer>)>& callback) {
+  if(path.empty()) {
+    callback(nullptr);
+    return;
+  }
+
+  std::string fullPath = GetFullFilePath(path);
+
+  Job::Create([=](Job& cb) {
+    // The job result holds a reference until the response hands the buffer over.
+    ByteBuffer* buffer = OpenFileBuffer(fullPath, advice);
+    if(buffer) {
+      buffer->IncRef();
+    }
+    cb.SetResult(0, buffer);
+  }, [=](Job& cb) {
+    ByteBuffer* buffer = cb.GetResult<ByteBuffer*>(0);
+    refptr<ByteBuffer> result = buffer;
+    if(buffer) {
+      buffer->DecRef();
+    }
+    callback(result);
+  });
+}
+
+void Prime::ReadFile(const std::string& path, const std::function<void (void*, size_t)>& callback) {
+  if(path.empty()) {
+    callback(nullptr, 0);
+    return;
+  }
+
+  std::string fullPath = GetFullFilePath(path);
+
+  Job::Create([=](Job& cb) {
+    size_t size;
+    void* result = ReadFile(fullPath.c_str(), &size);
+    cb.SetResult(0, result);
+    cb.SetResult(1, size);
+  }, [=](Job& cb) {
+    void* result = cb.GetResult<void*>(0);
+    size_t size = cb.GetResult<size_t>(1);
+    callback(result, size);
+  });
+}
+
+refptr<ByteBuffer> Prime::ReadFileBuffer(const std::string& path) {
+  if(path.empty())
+    return nullptr;
+
+  return OpenFileBuffer(GetFullFilePath(path), MappedFileAdviceSequential);
+}
+
+void Prime::ReadFileBuffer(const std::string& path, const std::function<void (refptr<ByteBuffer>)>& callback) {
+  ReadMappedFile(path, MappedFileAdviceSequential, callback);
+}
+
+void Prime::PrefetchFile(const std::string& path, const std::function<void (refptr<ByteBuffer>)>& callback) {
+  ReadMappedFile(path, MappedFileAdviceWillNeed, callback);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create Functions (Shader)
+////////////////////////////////////////////////////////////////////////////////
+
+DeviceShader* DeviceShader::Create(ShaderType type, const void* data, size_t dataSize) {
+  return new LinuxShader(type, data, dataSize);
+}
+
+DeviceShader* DeviceShader::Create(ShaderType type, const char* path) {
+  return new LinuxShader(type, path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create Functions (Program)
+////////////////////////////////////////////////////////////////////////////////
+
+DeviceProgram* DeviceProgram::Create(const void* vertexShaderData, size_t vertexShaderDataSize, const void* fragmentShaderData, size_t fragmentShaderDataSize) {
+  return new LinuxProgram(vertexShaderData, vertexShaderDataSize, fragmentShaderData, fragmentShaderDataSize);
+}
+
+DeviceProgram* DeviceProgram::Create(DeviceShader* vertexShader, DeviceShader* fragmentShader) {
+  return new LinuxProgram(vertexShader, fragmentShader);
+}
+
+DeviceProgram* DeviceProgram::Create(const char* vertexShaderPath, const char* fragmentShaderPath) {
+  return new LinuxProgram(vertexShaderPath, fragmentShaderPath);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create Functions (Index Buffer)
+////////////////////////////////////////////////////////////////////////////////
+
+IndexBuffer* IndexBuffer::Create(IndexFormat format, const void* data, size_t indexCount) {
+  return new LinuxIndexBuffer(format, data, indexCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create Functions (Array Buffer)
+////////////////////////////////////////////////////////////////////////////////
+
+ArrayBuffer* ArrayBuffer::Create(size_t itemSize, const void* data, size_t itemCount, BufferPrimitive primitive) {
+  return new LinuxArrayBuffer(itemSize, data, itemCount, primitive);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create Functions (Tex)
+////////////////////////////////////////////////////////////////////////////////
+
+Tex* Tex::Create(u32 w, u32 h, TexFormat format, const void* pixels, const json& options) {
+  return new LinuxTex(w, h, format, pixels, options);
+}
+
+Tex* Tex::Create(u32 w, u32 h, TexFormat format, const json& options) {
+  return new LinuxTex(w, h, format, options);
+}
+
+Tex* Tex::Create(u32 w, u32 h, TexFormat format, const void* pixels) {
+  return new LinuxTex(w, h, format, pixels);
+}
+
+Tex* Tex::Create() {
+  return new LinuxTex();
+}
+
+Tex* Tex::Create(const std::string& name, const std::string& data) {
+  return new LinuxTex(name, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Assert
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_DEBUG)
+void Prime::AssertCore(const char* file, u32 line, const char* f, ...) {
+  va_list ap, ap2;
+  std::string buffer;
+
+  buffer.append("A failed assertion has occurred.\n");
+  buffer.append(string_printf("File: %s\n", file));
+  buffer.append(string_printf("Line: %d\n\n", line));
+
+  va_start(ap, f);
+  va_start(ap2, f);
+  buffer.append(string_vprintf(f, ap, ap2));
+  dbgprintf("%s", buffer.c_str());
+  dbgprintf("\n");
+  fflush(stdout);
+
+  va_end(ap2);
+  va_end(ap);
+
+  // Headless runs have nobody to dismiss a dialog or attach to a spinning
+  // process, so fail the run instead.
+  abort();
+}
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetLinux)
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/System/MappedFile.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+bool MappedFile::Map(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0)
+    return false;
+
+  struct stat st;
+  if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+  // The mapping holds its own reference to the file, so the descriptor can be closed.
+  void* view = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(view == MAP_FAILED)
+    return false;
+
+  mapping = view;
+  mappingSize = (size_t) st.st_size;
+
+  return true;
+}
+
+void MappedFile::Unmap() {
+  if(mapping) {
+    munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+  }
+}
+
+void MappedFile::Advise(MappedFileAdvice advice, size_t offset, size_t length) const {
+  if(!mapping || offset >= mappingSize)
+    return;
+
+  if(length == 0 || length > mappingSize - offset) {
+    length = mappingSize - offset;
+  }
+
+  // madvise requires a page-aligned start address.
+  size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+  size_t begin = offset - offset % pageSize;
+  size_t end = offset + length;
+
+  int flags = MADV_NORMAL;
+  switch(advice) {
+  case MappedFileAdviceSequential:
+    flags = MADV_SEQUENTIAL;
+    break;
+
+  case MappedFileAdviceRandom:
+    flags = MADV_RANDOM;
+    break;
+
+  case MappedFileAdviceWillNeed:
+    flags = MADV_WILLNEED;
+    break;
+
+  default:
+    break;
+  }
+
+  madvise((u8*) mapping + begin, end - begin, flags);
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Prime/Config.h>
+#if defined(PrimeTargetWindows)
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Prime/System/MappedFile.h>
+
+#include <Windows.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+bool MappedFile::Map(const std::string& path) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER fileSize;
+  if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || (u64) fileSize.QuadPart > (u64) SIZE_MAX) {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The view keeps both the mapping object and the file open after the handles are closed.
+  HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if(!fileMapping)
+    return false;
+
+  void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(fileMapping);
+  if(!view)
+    return false;
+
+  mapping = view;
+  mappingSize = (size_t) fileSize.QuadPart;
+
+  return true;
+}
+
+void MappedFile::Unmap() {
+  if(mapping) {
+    UnmapViewOfFile(mapping);
+    mapping = nullptr;
+    mappingSize = 0;
+  }
+}
+
+void MappedFile::Advise(MappedFileAdvice advice, size_t offset, size_t length) const {
+  if(!mapping || offset >= mappingSize)
+    return;
+
+  if(length == 0 || length > mappingSize - offset) {
+    length = mappingSize - offset;
+  }
+
+  // Access pattern hints are given to CreateFileA; only read-ahead has a Windows equivalent.
+  if(advice == MappedFileAdviceWillNeed) {
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = (u8*) mapping + offset;
+    range.NumberOfBytes = length;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+  }
+}
+
+#endif
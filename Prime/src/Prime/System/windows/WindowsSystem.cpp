@@ -30,8 +30,10 @@ SOFTWARE.
 #include <Prime/Graphics/windows/WindowsArrayBuffer.h>
 #include <Prime/Graphics/windows/WindowsTex.h>
 #include <Prime/Graphics/Graphics.h>
+#include <Prime/System/MappedFile.h>
 
 #include <Windows.h>
+#include <Psapi.h>
 #include <utf8/utf8.h>
 
 using namespace Prime;
@@ -54,6 +56,15 @@ f64 Prime::GetTargetRTCSeconds() {
   return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1000000000.0;
 }
 
+size_t Prime::GetPeakMemoryUsage() {
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+
+  return 0;
+}
+
 void* Prime::ReadFile(const std::string& path, size_t* size) {
   void* result = nullptr;
   size_t resultSize = 0;
@@ -89,12 +100,7 @@ void* Prime::ReadFile(const std::string& path, size_t* size) {
   return result;
 }
 
-void Prime::ReadFile(const std::string& path, const std::function<void (void*, size_t)>& callback) {
-  if(path.empty()) {
-    callback(nullptr, 0);
-    return;
-  }
-
+static std::string GetFullFilePath(const std::string& path) {
   // Force paths to be read from folder tree below the running exe file.
   CHAR cwd[8 * 1024];
   GetCurrentDirectoryA(sizeof(cwd) - 1, cwd);
@@ -108,18 +114,85 @@ void Prime::ReadFile(const std::string& path, const std::function<void (void*, s
     fullPath += "/" + path;
   }
 
-  new Job([=](Job& cb) {
+  return fullPath;
+}
+
+static ByteBuffer* OpenFileBuffer(const std::string& fullPath, MappedFileAdvice advice) {
+  if(MappedFile* file = MappedFile::Open(fullPath)) {
+    file->Advise(advice);
+    return file;
+  }
+
+  // Empty files and files that cannot be mapped fall back to a buffered read.
+  size_t size;
+  void* data = ReadFile(fullPath, &size);
+  if(data) {
+    return new ByteBuffer(data, size);
+  }
+
+  return nullptr;
+}
+
+static void ReadMappedFile(const std::string& path, MappedFileAdvice advice, const std::function<void (refptr<ByteBuffer>)>& callback) {
+  if(path.empty()) {
+    callback(nullptr);
+    return;
+  }
+
+  std::string fullPath = GetFullFilePath(path);
+
+  Job::Create([=](Job& cb) {
+    // The job result holds a reference until the response hands the buffer over.
+    ByteBuffer* buffer = OpenFileBuffer(fullPath, advice);
+    if(buffer) {
+      buffer->IncRef();
+    }
+    cb.SetResult(0, buffer);
+  }, [=](Job& cb) {
+    ByteBuffer* buffer = cb.GetResult<ByteBuffer*>(0);
+    refptr<ByteBuffer> result = buffer;
+    if(buffer) {
+      buffer->DecRef();
+    }
+    callback(result);
+  });
+}
+
+void Prime::ReadFile(const std::string& path, const std::function<void (void*, size_t)>& callback) {
+  if(path.empty()) {
+    callback(nullptr, 0);
+    return;
+  }
+
+  std::string fullPath = GetFullFilePath(path);
+
+  Job::Create([=](Job& cb) {
     size_t size;
     void* result = ReadFile(fullPath.c_str(), &size);
-    cb.data["result"] = result;
-    cb.data["size"] = size;
+    cb.SetResult(0, result);
+    cb.SetResult(1, size);
   }, [=](Job& cb) {
-    void* result = cb.data["result"].GetVoidPtr();
-    size_t size = cb.data["size"].GetSizeT();
+    void* result = cb.GetResult<void*>(0);
+    size_t size = cb.GetResult<size_t>(1);
     callback(result, size);
   });
 }
 
+refptr<ByteBuffer> Prime::ReadFileBuffer(const std::string& path) {
+  if(path.empty())
+    return nullptr;
+
+  return OpenFileBuffer(GetFullFilePath(path), MappedFileAdviceSequential);
+}
+
+void Prime::ReadFileBuffer(const std::string& path, const std::function<void (refptr<ByteBuffer>)>& callback) {
+  ReadMappedFile(path, MappedFileAdviceSequential, callback);
+}
+
+void Prime::PrefetchFile(const std::string& path, const std::function<void (refptr<ByteBuffer>)>& callback) {
+  ReadMappedFile(path, MappedFileAdviceWillNeed, callback);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Create Functions (Shader)
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,452 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <Prime/Types/BoundsTree.h>
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static __inline void UnionBounds(const BoundsTreeNode& a, const BoundsTreeNode& b, Vec3& boundsMin, Vec3& boundsMax);
+static __inline f32 GetBoundsArea(const Vec3& boundsMin, const Vec3& boundsMax);
+static __inline bool IsBoundsInside(const Vec3& innerMin, const Vec3& innerMax, const Vec3& outerMin, const Vec3& outerMax);
+static __inline bool IsBoundsOverlapping(const Vec3& aMin, const Vec3& aMax, const Vec3& bMin, const Vec3& bMax);
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+BoundsTree::BoundsTree(f32 margin):
+root(PrimeNotFound),
+freeList(PrimeNotFound),
+leafCount(0),
+margin(margin) {
+
+}
+
+BoundsTree::~BoundsTree() {
+
+}
+
+size_t BoundsTree::Add(const Vec3& boundsMin, const Vec3& boundsMax, void* data) {
+  size_t leaf = AllocateNode();
+
+  BoundsTreeNode& node = nodes[leaf];
+  node.boundsMin = Vec3(boundsMin.x - margin, boundsMin.y - margin, boundsMin.z - margin);
+  node.boundsMax = Vec3(boundsMax.x + margin, boundsMax.y + margin, boundsMax.z + margin);
+  node.data = data;
+  node.height = 0;
+
+  InsertLeaf(leaf);
+  leafCount++;
+
+  return leaf;
+}
+
+void BoundsTree::Remove(size_t id) {
+  if(id >= nodes.size() || nodes[id].height != 0)
+    return;
+
+  RemoveLeaf(id);
+  FreeNode(id);
+  leafCount--;
+}
+
+void BoundsTree::Clear() {
+  nodes.clear();
+  root = PrimeNotFound;
+  freeList = PrimeNotFound;
+  leafCount = 0;
+}
+
+bool BoundsTree::Move(size_t id, const Vec3& boundsMin, const Vec3& boundsMax) {
+  PrimeAssert(id < nodes.size() && nodes[id].height == 0, "Invalid bounds tree id.");
+  if(id >= nodes.size() || nodes[id].height != 0)
+    return false;
+
+  BoundsTreeNode& node = nodes[id];
+  if(IsBoundsInside(boundsMin, boundsMax, node.boundsMin, node.boundsMax))
+    return false;
+
+  RemoveLeaf(id);
+
+  node.boundsMin = Vec3(boundsMin.x - margin, boundsMin.y - margin, boundsMin.z - margin);
+  node.boundsMax = Vec3(boundsMax.x + margin, boundsMax.y + margin, boundsMax.z + margin);
+
+  InsertLeaf(id);
+
+  return true;
+}
+
+size_t BoundsTree::Cull(const Frustum& frustum, std::vector<void*>& results) const {
+  if(root == PrimeNotFound)
+    return 0;
+
+  size_t count = 0;
+
+  std::vector<std::pair<size_t, u32>> stack;
+  stack.reserve(64);
+  stack.push_back(std::make_pair(root, (u32) FrustumPlaneMaskAll));
+
+  while(!stack.empty()) {
+    size_t index = stack.back().first;
+    u32 planeMask = stack.back().second;
+    stack.pop_back();
+
+    const BoundsTreeNode& node = nodes[index];
+
+    // Once a node is inside every plane its mask is empty and its subtree is
+    // walked without testing.
+    if(planeMask) {
+      if(frustum.ClassifyAABB(node.boundsMin, node.boundsMax, planeMask) == FrustumTestOutside)
+        continue;
+    }
+
+    if(node.height == 0) {
+      results.push_back(node.data);
+      count++;
+    }
+    else {
+      stack.push_back(std::make_pair(node.child1, planeMask));
+      stack.push_back(std::make_pair(node.child2, planeMask));
+    }
+  }
+
+  return count;
+}
+
+size_t BoundsTree::Query(const Vec3& boundsMin, const Vec3& boundsMax, std::vector<void*>& results) const {
+  if(root == PrimeNotFound)
+    return 0;
+
+  size_t count = 0;
+
+  std::vector<size_t> stack;
+  stack.reserve(64);
+  stack.push_back(root);
+
+  while(!stack.empty()) {
+    size_t index = stack.back();
+    stack.pop_back();
+
+    const BoundsTreeNode& node = nodes[index];
+    if(!IsBoundsOverlapping(node.boundsMin, node.boundsMax, boundsMin, boundsMax))
+      continue;
+
+    if(node.height == 0) {
+      results.push_back(node.data);
+      count++;
+    }
+    else {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+
+  return count;
+}
+
+size_t BoundsTree::AllocateNode() {
+  size_t index;
+
+  if(freeList != PrimeNotFound) {
+    index = freeList;
+    freeList = nodes[index].parent;
+  }
+  else {
+    index = nodes.size();
+    nodes.resize(index + 1);
+  }
+
+  BoundsTreeNode& node = nodes[index];
+  node.data = nullptr;
+  node.parent = PrimeNotFound;
+  node.child1 = PrimeNotFound;
+  node.child2 = PrimeNotFound;
+  node.height = 0;
+
+  return index;
+}
+
+void BoundsTree::FreeNode(size_t index) {
+  BoundsTreeNode& node = nodes[index];
+  node.data = nullptr;
+  node.parent = freeList;
+  node.height = -1;
+  freeList = index;
+}
+
+void BoundsTree::InsertLeaf(size_t leaf) {
+  if(root == PrimeNotFound) {
+    root = leaf;
+    nodes[leaf].parent = PrimeNotFound;
+    return;
+  }
+
+  // Walk down towards the sibling that makes the tree's total surface area
+  // grow the least, stopping when pairing with the current node is cheaper.
+  Vec3 leafMin = nodes[leaf].boundsMin;
+  Vec3 leafMax = nodes[leaf].boundsMax;
+  size_t index = root;
+
+  while(nodes[index].height > 0) {
+    const BoundsTreeNode& node = nodes[index];
+    size_t child1 = node.child1;
+    size_t child2 = node.child2;
+
+    Vec3 combinedMin;
+    Vec3 combinedMax;
+    UnionBounds(node, nodes[leaf], combinedMin, combinedMax);
+
+    f32 area = GetBoundsArea(node.boundsMin, node.boundsMax);
+    f32 combinedArea = GetBoundsArea(combinedMin, combinedMax);
+
+    f32 cost = 2.0f * combinedArea;
+    f32 inheritanceCost = 2.0f * (combinedArea - area);
+
+    f32 childCosts[2];
+    size_t children[2] = {child1, child2};
+    for(size_t i = 0; i < 2; i++) {
+      const BoundsTreeNode& child = nodes[children[i]];
+      Vec3 childMin;
+      Vec3 childMax;
+      UnionBounds(child, nodes[leaf], childMin, childMax);
+
+      if(child.height == 0) {
+        childCosts[i] = GetBoundsArea(childMin, childMax) + inheritanceCost;
+      }
+      else {
+        childCosts[i] = GetBoundsArea(childMin, childMax) - GetBoundsArea(child.boundsMin, child.boundsMax) + inheritanceCost;
+      }
+    }
+
+    if(cost < childCosts[0] && cost < childCosts[1])
+      break;
+
+    index = childCosts[0] < childCosts[1] ? child1 : child2;
+  }
+
+  size_t sibling = index;
+  size_t oldParent = nodes[sibling].parent;
+
+  // Allocating may grow the node array, so nothing above holds a reference.
+  size_t newParent = AllocateNode();
+  BoundsTreeNode& parentNode = nodes[newParent];
+  parentNode.parent = oldParent;
+  parentNode.height = nodes[sibling].height + 1;
+  UnionBounds(nodes[sibling], nodes[leaf], parentNode.boundsMin, parentNode.boundsMax);
+  parentNode.child1 = sibling;
+  parentNode.child2 = leaf;
+
+  if(oldParent != PrimeNotFound) {
+    if(nodes[oldParent].child1 == sibling) {
+      nodes[oldParent].child1 = newParent;
+    }
+    else {
+      nodes[oldParent].child2 = newParent;
+    }
+  }
+  else {
+    root = newParent;
+  }
+
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  for(index = nodes[leaf].parent; index != PrimeNotFound; index = nodes[index].parent) {
+    index = Balance(index);
+    UpdateNode(index);
+  }
+}
+
+void BoundsTree::RemoveLeaf(size_t leaf) {
+  if(leaf == root) {
+    root = PrimeNotFound;
+    return;
+  }
+
+  size_t parent = nodes[leaf].parent;
+  size_t grandParent = nodes[parent].parent;
+  size_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+  if(grandParent != PrimeNotFound) {
+    if(nodes[grandParent].child1 == parent) {
+      nodes[grandParent].child1 = sibling;
+    }
+    else {
+      nodes[grandParent].child2 = sibling;
+    }
+
+    nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    for(size_t index = grandParent; index != PrimeNotFound; index = nodes[index].parent) {
+      index = Balance(index);
+      UpdateNode(index);
+    }
+  }
+  else {
+    root = sibling;
+    nodes[sibling].parent = PrimeNotFound;
+    FreeNode(parent);
+  }
+
+  nodes[leaf].parent = PrimeNotFound;
+}
+
+size_t BoundsTree::Balance(size_t indexA) {
+  BoundsTreeNode& a = nodes[indexA];
+  if(a.height < 2)
+    return indexA;
+
+  size_t indexB = a.child1;
+  size_t indexC = a.child2;
+  BoundsTreeNode& b = nodes[indexB];
+  BoundsTreeNode& c = nodes[indexC];
+
+  s32 balance = c.height - b.height;
+
+  // Rotate whichever child is more than one level taller above A, and give A
+  // the shorter of its grandchildren.
+  if(balance > 1) {
+    size_t indexF = c.child1;
+    size_t indexG = c.child2;
+    BoundsTreeNode& f = nodes[indexF];
+    BoundsTreeNode& g = nodes[indexG];
+
+    c.child1 = indexA;
+    c.parent = a.parent;
+    a.parent = indexC;
+
+    if(c.parent != PrimeNotFound) {
+      if(nodes[c.parent].child1 == indexA) {
+        nodes[c.parent].child1 = indexC;
+      }
+      else {
+        nodes[c.parent].child2 = indexC;
+      }
+    }
+    else {
+      root = indexC;
+    }
+
+    if(f.height > g.height) {
+      c.child2 = indexF;
+      a.child2 = indexG;
+      g.parent = indexA;
+    }
+    else {
+      c.child2 = indexG;
+      a.child2 = indexF;
+      f.parent = indexA;
+    }
+
+    UpdateNode(indexA);
+    UpdateNode(indexC);
+
+    return indexC;
+  }
+
+  if(balance < -1) {
+    size_t indexD = b.child1;
+    size_t indexE = b.child2;
+    BoundsTreeNode& d = nodes[indexD];
+    BoundsTreeNode& e = nodes[indexE];
+
+    b.child1 = indexA;
+    b.parent = a.parent;
+    a.parent = indexB;
+
+    if(b.parent != PrimeNotFound) {
+      if(nodes[b.parent].child1 == indexA) {
+        nodes[b.parent].child1 = indexB;
+      }
+      else {
+        nodes[b.parent].child2 = indexB;
+      }
+    }
+    else {
+      root = indexB;
+    }
+
+    if(d.height > e.height) {
+      b.child2 = indexD;
+      a.child1 = indexE;
+      e.parent = indexA;
+    }
+    else {
+      b.child2 = indexE;
+      a.child1 = indexD;
+      d.parent = indexA;
+    }
+
+    UpdateNode(indexA);
+    UpdateNode(indexB);
+
+    return indexB;
+  }
+
+  return indexA;
+}
+
+void BoundsTree::UpdateNode(size_t index) {
+  BoundsTreeNode& node = nodes[index];
+  const BoundsTreeNode& child1 = nodes[node.child1];
+  const BoundsTreeNode& child2 = nodes[node.child2];
+
+  node.height = 1 + max(child1.height, child2.height);
+  UnionBounds(child1, child2, node.boundsMin, node.boundsMax);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void UnionBounds(const BoundsTreeNode& a, const BoundsTreeNode& b, Vec3& boundsMin, Vec3& boundsMax) {
+  boundsMin = Vec3(min(a.boundsMin.x, b.boundsMin.x), min(a.boundsMin.y, b.boundsMin.y), min(a.boundsMin.z, b.boundsMin.z));
+  boundsMax = Vec3(max(a.boundsMax.x, b.boundsMax.x), max(a.boundsMax.y, b.boundsMax.y), max(a.boundsMax.z, b.boundsMax.z));
+}
+
+f32 GetBoundsArea(const Vec3& boundsMin, const Vec3& boundsMax) {
+  f32 x = boundsMax.x - boundsMin.x;
+  f32 y = boundsMax.y - boundsMin.y;
+  f32 z = boundsMax.z - boundsMin.z;
+  return 2.0f * (x * y + y * z + z * x);
+}
+
+bool IsBoundsInside(const Vec3& innerMin, const Vec3& innerMax, const Vec3& outerMin, const Vec3& outerMax) {
+  return innerMin.x >= outerMin.x && innerMin.y >= outerMin.y && innerMin.z >= outerMin.z &&
+    innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+}
+
+bool IsBoundsOverlapping(const Vec3& aMin, const Vec3& aMax, const Vec3& bMin, const Vec3& bMax) {
+  return aMin.x <= bMax.x && aMax.x >= bMin.x &&
+    aMin.y <= bMax.y && aMax.y >= bMin.y &&
+    aMin.z <= bMax.z && aMax.z >= bMin.z;
+}
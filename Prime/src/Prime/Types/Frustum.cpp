@@ -0,0 +1,250 @@
+/*
+Prime Engine
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <Prime/Types/Frustum.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(PrimeSIMDSSE)
+#include <xmmintrin.h>
+#elif defined(PrimeSIMDNEON)
+#include <arm_neon.h>
+#endif
+
+using namespace Prime;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+Frustum::Frustum() {
+  for(size_t i = 0; i < FrustumPlane_Count; i++) {
+    planes[i] = Vec4(0.0f, 0.0f, 0.0f, 0.0f);
+  }
+}
+
+Frustum::Frustum(const Mat44& mat) {
+  Load(mat);
+}
+
+void Frustum::Load(const Mat44& mat) {
+  // Clip space is -w <= x, y, z <= w, so each plane is the last row of the
+  // matrix plus or minus one of the others.
+  planes[FrustumPlaneLeft] = Vec4(mat.e41 + mat.e11, mat.e42 + mat.e12, mat.e43 + mat.e13, mat.e44 + mat.e14);
+  planes[FrustumPlaneRight] = Vec4(mat.e41 - mat.e11, mat.e42 - mat.e12, mat.e43 - mat.e13, mat.e44 - mat.e14);
+  planes[FrustumPlaneBottom] = Vec4(mat.e41 + mat.e21, mat.e42 + mat.e22, mat.e43 + mat.e23, mat.e44 + mat.e24);
+  planes[FrustumPlaneTop] = Vec4(mat.e41 - mat.e21, mat.e42 - mat.e22, mat.e43 - mat.e23, mat.e44 - mat.e24);
+  planes[FrustumPlaneNear] = Vec4(mat.e41 + mat.e31, mat.e42 + mat.e32, mat.e43 + mat.e33, mat.e44 + mat.e34);
+  planes[FrustumPlaneFar] = Vec4(mat.e41 - mat.e31, mat.e42 - mat.e32, mat.e43 - mat.e33, mat.e44 - mat.e34);
+
+  for(size_t i = 0; i < FrustumPlane_Count; i++) {
+    Vec4& plane = planes[i];
+    f32 len = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+    if(len > 0.0f) {
+      f32 lenInv = 1.0f / len;
+      plane.x *= lenInv;
+      plane.y *= lenInv;
+      plane.z *= lenInv;
+      plane.w *= lenInv;
+    }
+  }
+}
+
+bool Frustum::TestPoint(const Vec3& point) const {
+  for(size_t i = 0; i < FrustumPlane_Count; i++) {
+    const Vec4& plane = planes[i];
+    if(plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < 0.0f)
+      return false;
+  }
+
+  return true;
+}
+
+bool Frustum::TestSphere(const Vec3& center, f32 radius) const {
+  for(size_t i = 0; i < FrustumPlane_Count; i++) {
+    const Vec4& plane = planes[i];
+    if(plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+      return false;
+  }
+
+  return true;
+}
+
+bool Frustum::TestAABB(const Vec3& boundsMin, const Vec3& boundsMax) const {
+  for(size_t i = 0; i < FrustumPlane_Count; i++) {
+    const Vec4& plane = planes[i];
+
+    // Only the corner furthest along the plane normal needs testing.
+    f32 x = plane.x >= 0.0f ? boundsMax.x : boundsMin.x;
+    f32 y = plane.y >= 0.0f ? boundsMax.y : boundsMin.y;
+    f32 z = plane.z >= 0.0f ? boundsMax.z : boundsMin.z;
+    if(plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+      return false;
+  }
+
+  return true;
+}
+
+FrustumTest Frustum::ClassifyAABB(const Vec3& boundsMin, const Vec3& boundsMax, u32& planeMask) const {
+  for(size_t i = 0; i < FrustumPlane_Count; i++) {
+    u32 planeBit = 1 << i;
+    if(!(planeMask & planeBit))
+      continue;
+
+    const Vec4& plane = planes[i];
+
+    f32 x = plane.x >= 0.0f ? boundsMax.x : boundsMin.x;
+    f32 y = plane.y >= 0.0f ? boundsMax.y : boundsMin.y;
+    f32 z = plane.z >= 0.0f ? boundsMax.z : boundsMin.z;
+    if(plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+      return FrustumTestOutside;
+
+    x = plane.x >= 0.0f ? boundsMin.x : boundsMax.x;
+    y = plane.y >= 0.0f ? boundsMin.y : boundsMax.y;
+    z = plane.z >= 0.0f ? boundsMin.z : boundsMax.z;
+    if(plane.x * x + plane.y * y + plane.z * z + plane.w >= 0.0f) {
+      planeMask &= ~planeBit;
+    }
+  }
+
+  return planeMask ? FrustumTestIntersect : FrustumTestInside;
+}
+
+size_t Frustum::TestAABBs(const FrustumBoundsList& bounds, u8* visible) const {
+  size_t visibleCount = 0;
+  size_t i = 0;
+
+  // A box is outside a plane when its center distance plus its projected
+  // radius |n| . extent is negative.
+#if defined(PrimeSIMDSSE)
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  __m128 px[FrustumPlane_Count];
+  __m128 py[FrustumPlane_Count];
+  __m128 pz[FrustumPlane_Count];
+  __m128 pw[FrustumPlane_Count];
+  __m128 ax[FrustumPlane_Count];
+  __m128 ay[FrustumPlane_Count];
+  __m128 az[FrustumPlane_Count];
+  for(size_t j = 0; j < FrustumPlane_Count; j++) {
+    px[j] = _mm_set1_ps(planes[j].x);
+    py[j] = _mm_set1_ps(planes[j].y);
+    pz[j] = _mm_set1_ps(planes[j].z);
+    pw[j] = _mm_set1_ps(planes[j].w);
+    ax[j] = _mm_andnot_ps(signMask, px[j]);
+    ay[j] = _mm_andnot_ps(signMask, py[j]);
+    az[j] = _mm_andnot_ps(signMask, pz[j]);
+  }
+
+  for(; i + 4 <= bounds.count; i += 4) {
+    __m128 cx = _mm_loadu_ps(bounds.centerX + i);
+    __m128 cy = _mm_loadu_ps(bounds.centerY + i);
+    __m128 cz = _mm_loadu_ps(bounds.centerZ + i);
+    __m128 ex = _mm_loadu_ps(bounds.extentX + i);
+    __m128 ey = _mm_loadu_ps(bounds.extentY + i);
+    __m128 ez = _mm_loadu_ps(bounds.extentZ + i);
+    __m128 outside = _mm_setzero_ps();
+
+    for(size_t j = 0; j < FrustumPlane_Count; j++) {
+      __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[j], cx), _mm_mul_ps(py[j], cy)), _mm_add_ps(_mm_mul_ps(pz[j], cz), pw[j]));
+      __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[j], ex), _mm_mul_ps(ay[j], ey)), _mm_mul_ps(az[j], ez));
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+    }
+
+    int outsideMask = _mm_movemask_ps(outside);
+    for(size_t j = 0; j < 4; j++) {
+      u8 v = (outsideMask & (1 << j)) ? 0 : 1;
+      visible[i + j] = v;
+      visibleCount += v;
+    }
+  }
+#elif defined(PrimeSIMDNEON)
+  float32x4_t px[FrustumPlane_Count];
+  float32x4_t py[FrustumPlane_Count];
+  float32x4_t pz[FrustumPlane_Count];
+  float32x4_t pw[FrustumPlane_Count];
+  float32x4_t ax[FrustumPlane_Count];
+  float32x4_t ay[FrustumPlane_Count];
+  float32x4_t az[FrustumPlane_Count];
+  for(size_t j = 0; j < FrustumPlane_Count; j++) {
+    px[j] = vdupq_n_f32(planes[j].x);
+    py[j] = vdupq_n_f32(planes[j].y);
+    pz[j] = vdupq_n_f32(planes[j].z);
+    pw[j] = vdupq_n_f32(planes[j].w);
+    ax[j] = vabsq_f32(px[j]);
+    ay[j] = vabsq_f32(py[j]);
+    az[j] = vabsq_f32(pz[j]);
+  }
+
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+
+  for(; i + 4 <= bounds.count; i += 4) {
+    float32x4_t cx = vld1q_f32(bounds.centerX + i);
+    float32x4_t cy = vld1q_f32(bounds.centerY + i);
+    float32x4_t cz = vld1q_f32(bounds.centerZ + i);
+    float32x4_t ex = vld1q_f32(bounds.extentX + i);
+    float32x4_t ey = vld1q_f32(bounds.extentY + i);
+    float32x4_t ez = vld1q_f32(bounds.extentZ + i);
+    uint32x4_t outside = vdupq_n_u32(0);
+
+    for(size_t j = 0; j < FrustumPlane_Count; j++) {
+      float32x4_t d = vmlaq_f32(vmlaq_f32(vmlaq_f32(pw[j], px[j], cx), py[j], cy), pz[j], cz);
+      float32x4_t r = vmlaq_f32(vmlaq_f32(vmulq_f32(ax[j], ex), ay[j], ey), az[j], ez);
+      outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, r), zero));
+    }
+
+    u32 outsideLanes[4];
+    vst1q_u32(outsideLanes, outside);
+    for(size_t j = 0; j < 4; j++) {
+      u8 v = outsideLanes[j] ? 0 : 1;
+      visible[i + j] = v;
+      visibleCount += v;
+    }
+  }
+#endif
+
+  for(; i < bounds.count; i++) {
+    u8 v = 1;
+    for(size_t j = 0; j < FrustumPlane_Count; j++) {
+      const Vec4& plane = planes[j];
+      f32 d = plane.x * bounds.centerX[i] + plane.y * bounds.centerY[i] + plane.z * bounds.centerZ[i] + plane.w;
+      f32 r = fabsf(plane.x) * bounds.extentX[i] + fabsf(plane.y) * bounds.extentY[i] + fabsf(plane.z) * bounds.extentZ[i];
+      if(d + r < 0.0f) {
+        v = 0;
+        break;
+      }
+    }
+
+    visible[i] = v;
+    visibleCount += v;
+  }
+
+  return visibleCount;
+}
@@ -32,6 +32,13 @@ SOFTWARE.
 
 #include <Prime/Types/Quat.h>
 #include <math.h>
+#include <utility>
+
+#if defined(PrimeSIMDSSE)
+#include <xmmintrin.h>
+#elif defined(PrimeSIMDNEON)
+#include <arm_neon.h>
+#endif
 
 using namespace Prime;
 
@@ -251,99 +258,146 @@ Mat44& Mat44::LoadLookAt(const Vec3& eye, const Vec3& at, const Vec3& up) {
 }
 
 Mat44& Mat44::Translate(f32 x, f32 y, f32 z) {
-  if(x != 0.0f || y != 0.0f || z != 0.0f)
-    return Multiply(Mat44().LoadTranslation(x, y, z));
-  else
-    return *this;
+  if(x != 0.0f || y != 0.0f || z != 0.0f) {
+    // Only the last column changes, so the translation is applied in place
+    // instead of being multiplied in as a full matrix.
+    for(size_t i = 0; i < 4; i++) {
+      e[12 + i] = e[i] * x + e[4 + i] * y + e[8 + i] * z + e[12 + i];
+    }
+  }
+
+  return *this;
 }
 
 Mat44& Mat44::Translate(const Vec3& pos) {
-  if(pos.IsNotZero())
-    return Multiply(Mat44().LoadTranslation(pos));
-  else
-    return *this;
+  return Translate(pos.x, pos.y, pos.z);
 }
 
 Mat44& Mat44::Scale(f32 x, f32 y, f32 z) {
-  if(x != 1.0f || y != 1.0f || z != 1.0f)
-    return Multiply(Mat44().LoadScaling(x, y, z));
-  else
-    return *this;
+  if(x != 1.0f || y != 1.0f || z != 1.0f) {
+    for(size_t i = 0; i < 4; i++) {
+      e[i] *= x;
+      e[4 + i] *= y;
+      e[8 + i] *= z;
+    }
+  }
+
+  return *this;
 }
 
 Mat44& Mat44::Scale(const Vec3& scale) {
-  if(scale.IsNotOne())
-    return Multiply(Mat44().LoadScaling(scale));
-  else
-    return *this;
+  return Scale(scale.x, scale.y, scale.z);
 }
 
 Mat44& Mat44::Scale(f32 scale) {
-  if(scale != 1.0f)
-    return Multiply(Mat44().LoadScaling(scale));
-  else
-    return *this;
+  return Scale(scale, scale, scale);
 }
 
 Mat44& Mat44::Rotate(f32 angle, f32 x, f32 y, f32 z) {
-  if(angle != 0.0f)
-    return Multiply(Mat44().LoadRotation(angle, x, y, z));
-  else
-    return *this;
-}
+  if(angle != 0.0f) {
+    // The rotation only mixes the first three columns, so they are combined
+    // in place and the last column is left alone.
+    Mat44 r;
+    r.LoadRotation(angle, x, y, z);
+
+    for(size_t i = 0; i < 4; i++) {
+      f32 c0 = e[i];
+      f32 c1 = e[4 + i];
+      f32 c2 = e[8 + i];
+      e[i] = c0 * r.e11 + c1 * r.e21 + c2 * r.e31;
+      e[4 + i] = c0 * r.e12 + c1 * r.e22 + c2 * r.e32;
+      e[8 + i] = c0 * r.e13 + c1 * r.e23 + c2 * r.e33;
+    }
+  }
 
-Mat44& Mat44::Rotate(f32 angle, const Vec3& axis) {
-  if(angle != 0.0f)
-    return Multiply(Mat44().LoadRotation(angle, axis));
-  else
-    return *this;
+  return *this;
 }
 
-Mat44& Mat44::Multiply(const Mat44& by) {
-  Mat44 mat;
-
-  if(by.IsIdentity()) {
-    return *this;
+Mat44& Mat44::Rotate(f32 angle, const Vec3& axis) {
+  return Rotate(angle, axis.x, axis.y, axis.z);
+}
+
+Mat44& Mat44::LoadProduct(const Mat44& a, const Mat44& b) {
+  // Each result column is the columns of a weighted by one column of b. The
+  // sums run in the same order as the scalar path, so the results match it.
+#if defined(PrimeSIMDSSE)
+  __m128 a0 = _mm_loadu_ps(&a.e[0]);
+  __m128 a1 = _mm_loadu_ps(&a.e[4]);
+  __m128 a2 = _mm_loadu_ps(&a.e[8]);
+  __m128 a3 = _mm_loadu_ps(&a.e[12]);
+  __m128 r[4];
+
+  for(size_t j = 0; j < 4; j++) {
+    const f32* c = &b.e[j * 4];
+    __m128 v = _mm_mul_ps(a0, _mm_set1_ps(c[0]));
+    v = _mm_add_ps(v, _mm_mul_ps(a1, _mm_set1_ps(c[1])));
+    v = _mm_add_ps(v, _mm_mul_ps(a2, _mm_set1_ps(c[2])));
+    v = _mm_add_ps(v, _mm_mul_ps(a3, _mm_set1_ps(c[3])));
+    r[j] = v;
   }
 
-  if(IsIdentity()) {
-    return *this = by;
+  for(size_t j = 0; j < 4; j++) {
+    _mm_storeu_ps(&e[j * 4], r[j]);
   }
 
-  mat.e11 = e[ 0] * by.e[ 0] + e[ 4] * by.e[ 1] + e[ 8] * by.e[ 2] + e[12] * by.e[ 3];
-  mat.e12 = e[ 0] * by.e[ 4] + e[ 4] * by.e[ 5] + e[ 8] * by.e[ 6] + e[12] * by.e[ 7];
-  mat.e13 = e[ 0] * by.e[ 8] + e[ 4] * by.e[ 9] + e[ 8] * by.e[10] + e[12] * by.e[11];
-  mat.e14 = e[ 0] * by.e[12] + e[ 4] * by.e[13] + e[ 8] * by.e[14] + e[12] * by.e[15];
+  return *this;
+#elif defined(PrimeSIMDNEON)
+  float32x4_t a0 = vld1q_f32(&a.e[0]);
+  float32x4_t a1 = vld1q_f32(&a.e[4]);
+  float32x4_t a2 = vld1q_f32(&a.e[8]);
+  float32x4_t a3 = vld1q_f32(&a.e[12]);
+  float32x4_t r[4];
+
+  for(size_t j = 0; j < 4; j++) {
+    const f32* c = &b.e[j * 4];
+    float32x4_t v = vmulq_n_f32(a0, c[0]);
+    v = vaddq_f32(v, vmulq_n_f32(a1, c[1]));
+    v = vaddq_f32(v, vmulq_n_f32(a2, c[2]));
+    v = vaddq_f32(v, vmulq_n_f32(a3, c[3]));
+    r[j] = v;
+  }
 
-  mat.e21 = e[ 1] * by.e[ 0] + e[ 5] * by.e[ 1] + e[ 9] * by.e[ 2] + e[13] * by.e[ 3];
-  mat.e22 = e[ 1] * by.e[ 4] + e[ 5] * by.e[ 5] + e[ 9] * by.e[ 6] + e[13] * by.e[ 7];
-  mat.e23 = e[ 1] * by.e[ 8] + e[ 5] * by.e[ 9] + e[ 9] * by.e[10] + e[13] * by.e[11];
-  mat.e24 = e[ 1] * by.e[12] + e[ 5] * by.e[13] + e[ 9] * by.e[14] + e[13] * by.e[15];
+  for(size_t j = 0; j < 4; j++) {
+    vst1q_f32(&e[j * 4], r[j]);
+  }
 
-  mat.e31 = e[ 2] * by.e[ 0] + e[ 6] * by.e[ 1] + e[10] * by.e[ 2] + e[14] * by.e[ 3];
-  mat.e32 = e[ 2] * by.e[ 4] + e[ 6] * by.e[ 5] + e[10] * by.e[ 6] + e[14] * by.e[ 7];
-  mat.e33 = e[ 2] * by.e[ 8] + e[ 6] * by.e[ 9] + e[10] * by.e[10] + e[14] * by.e[11];
-  mat.e34 = e[ 2] * by.e[12] + e[ 6] * by.e[13] + e[10] * by.e[14] + e[14] * by.e[15];
+  return *this;
+#else
+  Mat44 mat;
 
-  if(e[3] == 0.0f && e[7] == 0.0f && e[11] == 0.0f && e[15] == 1.0f) {
-    mat.e41 = by.e[3];
-    mat.e42 = by.e[7];
-    mat.e43 = by.e[11];
-    mat.e44 = by.e[15];
+  mat.e11 = a.e[ 0] * b.e[ 0] + a.e[ 4] * b.e[ 1] + a.e[ 8] * b.e[ 2] + a.e[12] * b.e[ 3];
+  mat.e12 = a.e[ 0] * b.e[ 4] + a.e[ 4] * b.e[ 5] + a.e[ 8] * b.e[ 6] + a.e[12] * b.e[ 7];
+  mat.e13 = a.e[ 0] * b.e[ 8] + a.e[ 4] * b.e[ 9] + a.e[ 8] * b.e[10] + a.e[12] * b.e[11];
+  mat.e14 = a.e[ 0] * b.e[12] + a.e[ 4] * b.e[13] + a.e[ 8] * b.e[14] + a.e[12] * b.e[15];
+
+  mat.e21 = a.e[ 1] * b.e[ 0] + a.e[ 5] * b.e[ 1] + a.e[ 9] * b.e[ 2] + a.e[13] * b.e[ 3];
+  mat.e22 = a.e[ 1] * b.e[ 4] + a.e[ 5] * b.e[ 5] + a.e[ 9] * b.e[ 6] + a.e[13] * b.e[ 7];
+  mat.e23 = a.e[ 1] * b.e[ 8] + a.e[ 5] * b.e[ 9] + a.e[ 9] * b.e[10] + a.e[13] * b.e[11];
+  mat.e24 = a.e[ 1] * b.e[12] + a.e[ 5] * b.e[13] + a.e[ 9] * b.e[14] + a.e[13] * b.e[15];
+
+  mat.e31 = a.e[ 2] * b.e[ 0] + a.e[ 6] * b.e[ 1] + a.e[10] * b.e[ 2] + a.e[14] * b.e[ 3];
+  mat.e32 = a.e[ 2] * b.e[ 4] + a.e[ 6] * b.e[ 5] + a.e[10] * b.e[ 6] + a.e[14] * b.e[ 7];
+  mat.e33 = a.e[ 2] * b.e[ 8] + a.e[ 6] * b.e[ 9] + a.e[10] * b.e[10] + a.e[14] * b.e[11];
+  mat.e34 = a.e[ 2] * b.e[12] + a.e[ 6] * b.e[13] + a.e[10] * b.e[14] + a.e[14] * b.e[15];
+
+  if(a.e[3] == 0.0f && a.e[7] == 0.0f && a.e[11] == 0.0f && a.e[15] == 1.0f) {
+    mat.e41 = b.e[3];
+    mat.e42 = b.e[7];
+    mat.e43 = b.e[11];
+    mat.e44 = b.e[15];
   }
   else {
-    mat.e41 = e[ 3] * by.e[ 0] + e[ 7] * by.e[ 1] + e[11] * by.e[ 2] + e[15] * by.e[ 3];
-    mat.e42 = e[ 3] * by.e[ 4] + e[ 7] * by.e[ 5] + e[11] * by.e[ 6] + e[15] * by.e[ 7];
-    mat.e43 = e[ 3] * by.e[ 8] + e[ 7] * by.e[ 9] + e[11] * by.e[10] + e[15] * by.e[11];
-    mat.e44 = e[ 3] * by.e[12] + e[ 7] * by.e[13] + e[11] * by.e[14] + e[15] * by.e[15];
+    mat.e41 = a.e[ 3] * b.e[ 0] + a.e[ 7] * b.e[ 1] + a.e[11] * b.e[ 2] + a.e[15] * b.e[ 3];
+    mat.e42 = a.e[ 3] * b.e[ 4] + a.e[ 7] * b.e[ 5] + a.e[11] * b.e[ 6] + a.e[15] * b.e[ 7];
+    mat.e43 = a.e[ 3] * b.e[ 8] + a.e[ 7] * b.e[ 9] + a.e[11] * b.e[10] + a.e[15] * b.e[11];
+    mat.e44 = a.e[ 3] * b.e[12] + a.e[ 7] * b.e[13] + a.e[11] * b.e[14] + a.e[15] * b.e[15];
   }
 
   return *this = mat;
+#endif
 }
 
-Mat44& Mat44::MultiplyPre(const Mat44& by) {
-  Mat44 mat;
-
+Mat44& Mat44::Multiply(const Mat44& by) {
   if(by.IsIdentity()) {
     return *this;
   }
@@ -352,35 +406,25 @@ Mat44& Mat44::MultiplyPre(const Mat44& by) {
     return *this = by;
   }
 
-  mat.e11 = by.e[ 0] * e[ 0] + by.e[ 4] * e[ 1] + by.e[ 8] * e[ 2] + by.e[12] * e[ 3];
-  mat.e12 = by.e[ 0] * e[ 4] + by.e[ 4] * e[ 5] + by.e[ 8] * e[ 6] + by.e[12] * e[ 7];
-  mat.e13 = by.e[ 0] * e[ 8] + by.e[ 4] * e[ 9] + by.e[ 8] * e[10] + by.e[12] * e[11];
-  mat.e14 = by.e[ 0] * e[12] + by.e[ 4] * e[13] + by.e[ 8] * e[14] + by.e[12] * e[15];
-
-  mat.e21 = by.e[ 1] * e[ 0] + by.e[ 5] * e[ 1] + by.e[ 9] * e[ 2] + by.e[13] * e[ 3];
-  mat.e22 = by.e[ 1] * e[ 4] + by.e[ 5] * e[ 5] + by.e[ 9] * e[ 6] + by.e[13] * e[ 7];
-  mat.e23 = by.e[ 1] * e[ 8] + by.e[ 5] * e[ 9] + by.e[ 9] * e[10] + by.e[13] * e[11];
-  mat.e24 = by.e[ 1] * e[12] + by.e[ 5] * e[13] + by.e[ 9] * e[14] + by.e[13] * e[15];
-
-  mat.e31 = by.e[ 2] * e[ 0] + by.e[ 6] * e[ 1] + by.e[10] * e[ 2] + by.e[14] * e[ 3];
-  mat.e32 = by.e[ 2] * e[ 4] + by.e[ 6] * e[ 5] + by.e[10] * e[ 6] + by.e[14] * e[ 7];
-  mat.e33 = by.e[ 2] * e[ 8] + by.e[ 6] * e[ 9] + by.e[10] * e[10] + by.e[14] * e[11];
-  mat.e34 = by.e[ 2] * e[12] + by.e[ 6] * e[13] + by.e[10] * e[14] + by.e[14] * e[15];
+  return LoadProduct(*this, by);
+}
 
-  if(by.e[3] == 0.0f && by.e[7] == 0.0f && by.e[11] == 0.0f && by.e[15] == 1.0f) {
-    mat.e41 = e[3];
-    mat.e42 = e[7];
-    mat.e43 = e[11];
-    mat.e44 = e[15];
+Mat44& Mat44::MultiplyPre(const Mat44& by) {
+  if(by.IsIdentity()) {
+    return *this;
   }
-  else {
-    mat.e41 = by.e[ 3] * e[ 0] + by.e[ 7] * e[ 1] + by.e[11] * e[ 2] + by.e[15] * e[ 3];
-    mat.e42 = by.e[ 3] * e[ 4] + by.e[ 7] * e[ 5] + by.e[11] * e[ 6] + by.e[15] * e[ 7];
-    mat.e43 = by.e[ 3] * e[ 8] + by.e[ 7] * e[ 9] + by.e[11] * e[10] + by.e[15] * e[11];
-    mat.e44 = by.e[ 3] * e[12] + by.e[ 7] * e[13] + by.e[11] * e[14] + by.e[15] * e[15];
+
+  if(IsIdentity()) {
+    return *this = by;
   }
 
-  return *this = mat;
+  return LoadProduct(by, *this);
+}
+
+void Mat44::MultiplyPairs(const Mat44* a, const Mat44* b, Mat44* results, size_t count) {
+  for(size_t i = 0; i < count; i++) {
+    results[i].LoadProduct(a[i], b[i]);
+  }
 }
 
 Mat44& Mat44::MultiplyOrtho(f32 x, f32 y, f32 w, f32 h, f32 nearZ, f32 farZ) {
@@ -413,11 +457,90 @@ Vec3 Mat44::Multiply(const Vec3& v, f32 w) const {
 }
 
 Vec4 Mat44::Multiply(const Vec4& v) const {
-  return Vec4(
-    e11 * v.x + e12 * v.y + e13 * v.z + e14 * v.w,
-    e21 * v.x + e22 * v.y + e23 * v.z + e24 * v.w,
-    e31 * v.x + e32 * v.y + e33 * v.z + e34 * v.w,
-    e41 * v.x + e42 * v.y + e43 * v.z + e44 * v.w);
+  Vec4 result;
+  MultiplyPoints(&v, &result, 1);
+  return result;
+}
+
+void Mat44::MultiplyPoints(const Vec3* points, Vec3* results, size_t count) const {
+#if defined(PrimeSIMDSSE)
+  __m128 c0 = _mm_loadu_ps(&e[0]);
+  __m128 c1 = _mm_loadu_ps(&e[4]);
+  __m128 c2 = _mm_loadu_ps(&e[8]);
+  __m128 c3 = _mm_loadu_ps(&e[12]);
+
+  for(size_t i = 0; i < count; i++) {
+    const Vec3& p = points[i];
+    __m128 v = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+    v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+    v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+    v = _mm_add_ps(v, c3);
+
+    f32 r[4];
+    _mm_storeu_ps(r, v);
+    results[i] = Vec3(r[0], r[1], r[2]);
+  }
+#elif defined(PrimeSIMDNEON)
+  float32x4_t c0 = vld1q_f32(&e[0]);
+  float32x4_t c1 = vld1q_f32(&e[4]);
+  float32x4_t c2 = vld1q_f32(&e[8]);
+  float32x4_t c3 = vld1q_f32(&e[12]);
+
+  for(size_t i = 0; i < count; i++) {
+    const Vec3& p = points[i];
+    float32x4_t v = vmulq_n_f32(c0, p.x);
+    v = vaddq_f32(v, vmulq_n_f32(c1, p.y));
+    v = vaddq_f32(v, vmulq_n_f32(c2, p.z));
+    v = vaddq_f32(v, c3);
+
+    results[i] = Vec3(vgetq_lane_f32(v, 0), vgetq_lane_f32(v, 1), vgetq_lane_f32(v, 2));
+  }
+#else
+  for(size_t i = 0; i < count; i++) {
+    results[i] = Multiply(points[i]);
+  }
+#endif
+}
+
+void Mat44::MultiplyPoints(const Vec4* points, Vec4* results, size_t count) const {
+#if defined(PrimeSIMDSSE)
+  __m128 c0 = _mm_loadu_ps(&e[0]);
+  __m128 c1 = _mm_loadu_ps(&e[4]);
+  __m128 c2 = _mm_loadu_ps(&e[8]);
+  __m128 c3 = _mm_loadu_ps(&e[12]);
+
+  for(size_t i = 0; i < count; i++) {
+    const Vec4& p = points[i];
+    __m128 v = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+    v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+    v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+    v = _mm_add_ps(v, _mm_mul_ps(c3, _mm_set1_ps(p.w)));
+    _mm_storeu_ps(&results[i].x, v);
+  }
+#elif defined(PrimeSIMDNEON)
+  float32x4_t c0 = vld1q_f32(&e[0]);
+  float32x4_t c1 = vld1q_f32(&e[4]);
+  float32x4_t c2 = vld1q_f32(&e[8]);
+  float32x4_t c3 = vld1q_f32(&e[12]);
+
+  for(size_t i = 0; i < count; i++) {
+    const Vec4& p = points[i];
+    float32x4_t v = vmulq_n_f32(c0, p.x);
+    v = vaddq_f32(v, vmulq_n_f32(c1, p.y));
+    v = vaddq_f32(v, vmulq_n_f32(c2, p.z));
+    v = vaddq_f32(v, vmulq_n_f32(c3, p.w));
+    vst1q_f32(&results[i].x, v);
+  }
+#else
+  for(size_t i = 0; i < count; i++) {
+    const Vec4 p = points[i];
+    results[i] = Vec4(
+      e11 * p.x + e12 * p.y + e13 * p.z + e14 * p.w,
+      e21 * p.x + e22 * p.y + e23 * p.z + e24 * p.w,
+      e31 * p.x + e32 * p.y + e33 * p.z + e34 * p.w,
+      e41 * p.x + e42 * p.y + e43 * p.z + e44 * p.w);
+  }
+#endif
 }
 
 void Mat44::Multiply(s32 x, s32 y, s32& rx, s32& ry, s32& rz) const {
@@ -452,6 +575,34 @@ void Mat44::Multiply(f32 x, f32 y, f32& rx, f32& ry) const {
   ry = oy;
 }
 
+void Mat44::MultiplyBounds(const Vec3& boundsMin, const Vec3& boundsMax, Vec3& resultMin, Vec3& resultMax) const {
+  const f32 inMin[3] = {boundsMin.x, boundsMin.y, boundsMin.z};
+  const f32 inMax[3] = {boundsMax.x, boundsMax.y, boundsMax.z};
+  f32 outMin[3] = {e14, e24, e34};
+  f32 outMax[3] = {e14, e24, e34};
+
+  // Each output axis is a sum of terms, so its extremes come from taking the
+  // smaller or larger of each term independently.
+  for(size_t i = 0; i < 3; i++) {
+    for(size_t j = 0; j < 3; j++) {
+      f32 m = e[j * 4 + i];
+      f32 a = m * inMin[j];
+      f32 b = m * inMax[j];
+      if(a < b) {
+        outMin[i] += a;
+        outMax[i] += b;
+      }
+      else {
+        outMin[i] += b;
+        outMax[i] += a;
+      }
+    }
+  }
+
+  resultMin = Vec3(outMin[0], outMin[1], outMin[2]);
+  resultMax = Vec3(outMax[0], outMax[1], outMax[2]);
+}
+
 bool Mat44::Invert() {
   Mat44 temp;
   
@@ -462,6 +613,73 @@ bool Mat44::Invert() {
   return true;
 }
 
+bool Mat44::InvertAffine() {
+  // The inverse of [A t; 0 1] is [A^-1 -A^-1 t; 0 1], with A^-1 built from
+  // the cofactors of the 3x3 part.
+  f32 c11 = e22 * e33 - e23 * e32;
+  f32 c12 = e23 * e31 - e21 * e33;
+  f32 c13 = e21 * e32 - e22 * e31;
+  f32 c21 = e13 * e32 - e12 * e33;
+  f32 c22 = e11 * e33 - e13 * e31;
+  f32 c23 = e12 * e31 - e11 * e32;
+  f32 c31 = e12 * e23 - e13 * e22;
+  f32 c32 = e13 * e21 - e11 * e23;
+  f32 c33 = e11 * e22 - e12 * e21;
+
+  f32 det = e11 * c11 + e12 * c12 + e13 * c13;
+  if(det == 0.0f)
+    return false;
+
+  f32 invDet = 1.0f / det;
+  Mat44 temp;
+
+  temp.e11 = c11 * invDet;
+  temp.e12 = c21 * invDet;
+  temp.e13 = c31 * invDet;
+  temp.e21 = c12 * invDet;
+  temp.e22 = c22 * invDet;
+  temp.e23 = c32 * invDet;
+  temp.e31 = c13 * invDet;
+  temp.e32 = c23 * invDet;
+  temp.e33 = c33 * invDet;
+
+  temp.e14 = -(temp.e11 * e14 + temp.e12 * e24 + temp.e13 * e34);
+  temp.e24 = -(temp.e21 * e14 + temp.e22 * e24 + temp.e23 * e34);
+  temp.e34 = -(temp.e31 * e14 + temp.e32 * e24 + temp.e33 * e34);
+
+  temp.e41 = 0.0f;
+  temp.e42 = 0.0f;
+  temp.e43 = 0.0f;
+  temp.e44 = 1.0f;
+
+  *this = temp;
+  return true;
+}
+
+Mat44& Mat44::InvertRigid() {
+  // A rotation's inverse is its transpose, so only the translation needs
+  // any arithmetic. Elements are written in place rather than through a
+  // temporary.
+  f32 t14 = -(e11 * e14 + e21 * e24 + e31 * e34);
+  f32 t24 = -(e12 * e14 + e22 * e24 + e32 * e34);
+  f32 t34 = -(e13 * e14 + e23 * e24 + e33 * e34);
+
+  std::swap(e12, e21);
+  std::swap(e13, e31);
+  std::swap(e23, e32);
+
+  e14 = t14;
+  e24 = t24;
+  e34 = t34;
+
+  e41 = 0.0f;
+  e42 = 0.0f;
+  e43 = 0.0f;
+  e44 = 1.0f;
+
+  return *this;
+}
+
 Mat44& Mat44::Transpose() {
   Mat44 temp;
 
@@ -28,6 +28,13 @@ SOFTWARE.
 
 using namespace Prime;
 
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+// Above this dot product a normalized lerp stays within 0.0003 radians of slerp.
+#define QUAT_NLERP_MIN_DOT 0.98f
+
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
@@ -181,7 +188,7 @@ Quat& Quat::ConvertFromEulerAnglesDeg(const Vec3& euler) {
 
 Quat Quat::Interpolate(const Quat& other, f32 t) const {
   f64 diff = x * other.x + y * other.y + z * other.z + w * other.w;
-  f64 absDiff = abs(diff);
+  f64 absDiff = fabs(diff);
 
   f64 useX;
   f64 useY;
@@ -224,6 +231,37 @@ Quat Quat::Interpolate(const Quat& other, f32 t) const {
   return result;
 }
 
+Quat Quat::InterpolateFast(const Quat& other, f32 t) const {
+  f32 diff = x * other.x + y * other.y + z * other.z + w * other.w;
+  f32 absDiff = fabsf(diff);
+
+  f32 w0;
+  f32 w1;
+
+  if(absDiff < QUAT_NLERP_MIN_DOT) {
+    f32 angle = acosf(absDiff);
+    f32 oosa = 1.0f / sinf(angle);
+    w0 = sinf(angle * (1.0f - t)) * oosa;
+    w1 = sinf(angle * t) * oosa;
+  }
+  else {
+    w0 = 1.0f - t;
+    w1 = t;
+  }
+
+  if(diff < 0.0f) {
+    w0 = -w0;
+  }
+
+  Quat result(
+    (x * w0) + (other.x * w1),
+    (y * w0) + (other.y * w1),
+    (z * w0) + (other.z * w1),
+    (w * w0) + (other.w * w1));
+  result.Normalize();
+  return result;
+}
+
 Vec3 Quat::GetEulerAngles() const {
   const f32 xx = x * x;
   const f32 yy = y * y;
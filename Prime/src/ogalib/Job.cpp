@@ -34,7 +34,265 @@ using namespace ogalib;
 
 #include <ogalib/ogalib.h>
 #include <set>
-#include <list>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define JobLatencyBucketCount 256
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace ogalib {
+
+// Chase-Lev work-stealing deque. Only the owning worker calls Push() and Pop();
+// any thread may call Steal(). Grown arrays are retired rather than freed so a
+// concurrent thief never reads released memory.
+class JobDeque {
+private:
+
+  class Array {
+  public:
+
+    int64_t capacity;
+    int64_t mask;
+    std::atomic<Job*>* items;
+
+  public:
+
+    Array(int64_t capacity): capacity(capacity), mask(capacity - 1) {
+      items = new std::atomic<Job*>[(size_t) capacity];
+    }
+
+    ~Array() {
+      delete[] items;
+    }
+
+    Job* Get(int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, Job* job) {
+      items[index & mask].store(job, std::memory_order_relaxed);
+    }
+
+  };
+
+  std::atomic<int64_t> top;
+  std::atomic<int64_t> bottom;
+  std::atomic<Array*> array;
+  std::vector<Array*> retiredArrays;
+
+public:
+
+  JobDeque(): top(0), bottom(0) {
+    array.store(new Array(OGALIB_JOB_DEQUE_INITIAL_CAPACITY), std::memory_order_relaxed);
+  }
+
+  ~JobDeque() {
+    delete array.load(std::memory_order_relaxed);
+    for(auto retiredArray: retiredArrays) {
+      delete retiredArray;
+    }
+  }
+
+  void Push(Job* job) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    Array* a = array.load(std::memory_order_relaxed);
+
+    if(b - t > a->capacity - 1) {
+      Array* grownArray = new Array(a->capacity * 2);
+      for(int64_t i = t; i < b; i++) {
+        grownArray->Put(i, a->Get(i));
+      }
+      retiredArrays.push_back(a);
+      array.store(grownArray, std::memory_order_release);
+      a = grownArray;
+    }
+
+    a->Put(b, job);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  Job* Pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    Array* a = array.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    Job* job = nullptr;
+
+    if(t <= b) {
+      job = a->Get(b);
+      if(t == b) {
+        // Last item; race any thieves for it.
+        if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+      }
+    }
+    else {
+      bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+  }
+
+  Job* Steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+
+    if(t < b) {
+      Array* a = array.load(std::memory_order_acquire);
+      Job* job = a->Get(t);
+      if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+      }
+      return job;
+    }
+
+    return nullptr;
+  }
+
+  bool IsEmpty() const {
+    int64_t t = top.load(std::memory_order_acquire);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    return b <= t;
+  }
+
+};
+
+// Lock-free multiple-producer queue. Producers push onto an intrusive stack;
+// a consumer takes the whole stack at once and reverses it, so items come out
+// in submission order without ABA hazards. Any thread may call TakeAll().
+class JobQueue {
+private:
+
+  std::atomic<Job*> head;
+
+public:
+
+  JobQueue(): head(nullptr) {}
+
+  void Push(Job* job) {
+    Job* currHead = head.load(std::memory_order_relaxed);
+    do {
+      job->queueNext = currHead;
+    }
+    while(!head.compare_exchange_weak(currHead, job, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  Job* TakeAll() {
+    Job* list = head.exchange(nullptr, std::memory_order_acquire);
+    Job* reversed = nullptr;
+
+    while(list) {
+      Job* next = list->queueNext;
+      list->queueNext = reversed;
+      reversed = list;
+      list = next;
+    }
+
+    return reversed;
+  }
+
+  bool IsEmpty() const {
+    return head.load(std::memory_order_acquire) == nullptr;
+  }
+
+};
+
+// Shared state for one ParallelFor call. Helper jobs may start after the caller
+// has already returned, so the context is reference counted and helpers only
+// touch the callback while they can still claim a chunk. Released contexts are
+// kept in a pool alongside recycled jobs.
+class ParallelForContext {
+public:
+
+  const std::function<void(size_t, size_t)>* fn;
+  size_t begin;
+  size_t end;
+  size_t grain;
+  size_t chunkCount;
+  std::atomic<size_t> nextChunk;
+  std::atomic<size_t> completedChunks;
+  std::atomic<uint32_t> refCount;
+  ParallelForContext* poolNext;
+
+public:
+
+  ParallelForContext(): fn(nullptr), begin(0), end(0), grain(0), chunkCount(0), nextChunk(0), completedChunks(0), refCount(0), poolNext(nullptr) {}
+
+  static ParallelForContext* Acquire(const std::function<void(size_t, size_t)>* fn, size_t begin, size_t end, size_t grain, size_t chunkCount, uint32_t refCount);
+
+  void Run() {
+    size_t chunk;
+    while((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+      size_t chunkBegin = begin + chunk * grain;
+      size_t chunkEnd = std::min(chunkBegin + grain, end);
+      (*fn)(chunkBegin, chunkEnd);
+      completedChunks.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  bool IsDone() const {
+    return completedChunks.load(std::memory_order_acquire) >= chunkCount;
+  }
+
+  void Release();
+
+};
+
+class JobWorker {
+public:
+
+  JobDeque deque;
+  JobDeque expressDeque;
+  JobDeque inboxDeque;
+  JobQueue inbox;
+  std::atomic<bool> active;
+  std::atomic<bool> sleeping;
+  bool wait;
+  bool expressOnly;
+  uint32_t number;
+  ThreadCondition* condition;
+  Thread* thread;
+
+  std::atomic<uint64_t> started;
+  std::atomic<uint64_t> stolen;
+  std::atomic<uint64_t> expressStarted;
+  std::atomic<uint64_t> latencyMax;
+  std::atomic<uint64_t> latencyBuckets[JobLatencyBucketCount];
+
+public:
+
+  JobWorker(): active(true), sleeping(false), wait(false), expressOnly(false), number(0), condition(nullptr), thread(nullptr) {
+    ResetStats();
+  }
+
+  void ResetStats();
+  bool DrainInbox(JobQueue& source);
+  Job* FindLocalJob();
+  Job* FindJob();
+  void RunJob(Job* job);
+  void Wait();
+  bool HasVisibleWork() const;
+  bool CanTakeInbox(uint32_t index) const;
+
+  static bool Wake(uint32_t index);
+  static void WakeIdle(uint32_t exceptIndex, bool express);
+
+};
+
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Variables
@@ -42,21 +300,27 @@ using namespace ogalib;
 
 static ThreadMutex* jobMutex = nullptr;
 static std::set<Job*> jobs;
-static std::list<Job*> jobQueue;
-static std::vector<Job*> jobCompletedStack;
-static size_t jobsInProgress = 0;
-
-static bool* workerThreadActive = nullptr;
-static bool* workerThreadWait = nullptr;
-static ThreadMutex* workerThreadMutex = nullptr;
-static ThreadCondition** workerThreadCondition = nullptr;
-static Thread** workerThread = nullptr;
-static uint32_t* workerThreadNumbers = nullptr;
+static JobQueue jobCompletedQueue;
+static std::atomic<size_t> jobsOutstanding(0);
+static std::atomic<uint64_t> jobsSubmitted(0);
+static std::atomic<uint64_t> jobsAllocated(0);
+static std::atomic<uint64_t> jobsRecycled(0);
+
+static ThreadMutex* jobPoolMutex = nullptr;
+static Job* jobPool = nullptr;
+static size_t jobPoolCount = 0;
+static ParallelForContext* parallelForContextPool = nullptr;
+static size_t parallelForContextPoolCount = 0;
+
+static JobWorker* workers = nullptr;
 static uint32_t workerThreadCount = 0;
-static uint32_t workerThreadIndex = 0;
+static uint32_t workerFirstDefaultIndex = 0;
+static std::atomic<uint32_t> workerNextIndex(0);
+static thread_local int32_t currentWorkerIndex = -1;
 
 static const std::string CanceledErrorStr("canceled");
 
+
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -66,31 +330,321 @@ void* JobThread(void* param);
 void* JobWorkerThread(void* param);
 };
 
+static uint64_t GetJobTime();
+static uint32_t GetJobLatencyBucket(uint64_t ns);
+static uint64_t GetJobLatencyBucketValue(uint32_t bucket);
+static double GetJobLatencyPercentile(const uint64_t* buckets, uint64_t total, double percentile);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Classes
 ////////////////////////////////////////////////////////////////////////////////
 
-Job::Job(std::function<void(Job&)> callback, std::function<void(Job&)> response, JobType type):
-callback(callback),
-response(response),
+ParallelForContext* ParallelForContext::Acquire(const std::function<void(size_t, size_t)>* fn, size_t begin, size_t end, size_t grain, size_t chunkCount, uint32_t refCount) {
+  ParallelForContext* context = nullptr;
+
+  if(jobPoolMutex) {
+    jobPoolMutex->Lock();
+    if(parallelForContextPool) {
+      context = parallelForContextPool;
+      parallelForContextPool = context->poolNext;
+      parallelForContextPoolCount--;
+    }
+    jobPoolMutex->Unlock();
+  }
+
+  if(!context) {
+    context = new ParallelForContext();
+  }
+
+  context->fn = fn;
+  context->begin = begin;
+  context->end = end;
+  context->grain = grain;
+  context->chunkCount = chunkCount;
+  context->nextChunk.store(0, std::memory_order_relaxed);
+  context->completedChunks.store(0, std::memory_order_relaxed);
+  context->refCount.store(refCount, std::memory_order_relaxed);
+  context->poolNext = nullptr;
+
+  return context;
+}
+
+void ParallelForContext::Release() {
+  if(refCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    return;
+
+  fn = nullptr;
+
+  ParallelForContext* context = this;
+  if(jobPoolMutex) {
+    jobPoolMutex->Lock();
+    if(parallelForContextPoolCount < OGALIB_JOB_POOL_CAPACITY) {
+      poolNext = parallelForContextPool;
+      parallelForContextPool = this;
+      parallelForContextPoolCount++;
+      context = nullptr;
+    }
+    jobPoolMutex->Unlock();
+  }
+
+  if(context) {
+    delete context;
+  }
+}
+
+void JobWorker::ResetStats() {
+  started.store(0, std::memory_order_relaxed);
+  stolen.store(0, std::memory_order_relaxed);
+  expressStarted.store(0, std::memory_order_relaxed);
+  latencyMax.store(0, std::memory_order_relaxed);
+  for(size_t i = 0; i < JobLatencyBucketCount; i++) {
+    latencyBuckets[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+bool JobWorker::DrainInbox(JobQueue& source) {
+  Job* list = source.TakeAll();
+  if(!list)
+    return false;
+
+  size_t count = 0;
+  while(list) {
+    Job* job = list;
+    list = job->queueNext;
+    job->queueNext = nullptr;
+
+    if(job->type == JobType::Express) {
+      expressDeque.Push(job);
+    }
+    else {
+      inboxDeque.Push(job);
+    }
+
+    count++;
+  }
+
+  if(count > 1) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    WakeIdle(number, false);
+  }
+
+  return true;
+}
+
+Job* JobWorker::FindLocalJob() {
+  // Express and inbox jobs are taken from the top so they run in submission
+  // order; only jobs spawned on this worker are popped newest first.
+  Job* job = expressDeque.Steal();
+  if(job)
+    return job;
+
+  for(uint32_t i = 1; i < workerThreadCount; i++) {
+    job = workers[(number + i) % workerThreadCount].expressDeque.Steal();
+    if(job) {
+      stolen.fetch_add(1, std::memory_order_relaxed);
+      return job;
+    }
+  }
+
+  if(expressOnly)
+    return nullptr;
+
+  job = deque.Pop();
+  if(job)
+    return job;
+
+  job = inboxDeque.Steal();
+  if(job)
+    return job;
+
+  for(uint32_t i = 1; i < workerThreadCount; i++) {
+    JobWorker& worker = workers[(number + i) % workerThreadCount];
+    job = worker.deque.Steal();
+    if(!job) {
+      job = worker.inboxDeque.Steal();
+    }
+
+    if(job) {
+      stolen.fetch_add(1, std::memory_order_relaxed);
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+Job* JobWorker::FindJob() {
+  DrainInbox(inbox);
+
+  Job* job = FindLocalJob();
+  if(job)
+    return job;
+
+  // A peer busy with a long job cannot drain its own inbox, so take the
+  // pending batch over and run it from here.
+  for(uint32_t i = 1; i < workerThreadCount; i++) {
+    uint32_t index = (number + i) % workerThreadCount;
+    if(CanTakeInbox(index) && DrainInbox(workers[index].inbox)) {
+      job = FindLocalJob();
+      if(job) {
+        stolen.fetch_add(1, std::memory_order_relaxed);
+        return job;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+void JobWorker::RunJob(Job* job) {
+  uint64_t latency = GetJobTime() - job->queueTime;
+  latencyBuckets[GetJobLatencyBucket(latency)].fetch_add(1, std::memory_order_relaxed);
+  if(latency > latencyMax.load(std::memory_order_relaxed)) {
+    latencyMax.store(latency, std::memory_order_relaxed);
+  }
+  started.fetch_add(1, std::memory_order_relaxed);
+  if(job->type == JobType::Express) {
+    expressStarted.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  JobGraph* graph = job->graph;
+
+  if(job->callback && !(graph && graph->canceled.load(std::memory_order_relaxed))) {
+    ogalibProfileScope("ogalib::Job");
+    job->callback(*job);
+  }
+  job->completed = true;
+
+  if(job->detached) {
+    Job::Release(job);
+  }
+  else if(graph) {
+    graph->OnJobCompleted(job);
+  }
+  else {
+    jobCompletedQueue.Push(job);
+  }
+}
+
+void JobWorker::Wait() {
+  // Publish the sleeping flag before the final check for work so a submitter
+  // either sees this worker asleep and signals it, or this check sees the job.
+  sleeping.store(true, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  {
+    ThreadConditionLock lock(condition);
+    wait = true;
+    if(!HasVisibleWork()) {
+      while(wait && active) {
+        condition->Wait();
+      }
+    }
+    wait = false;
+  }
+
+  sleeping.store(false, std::memory_order_relaxed);
+}
+
+bool JobWorker::HasVisibleWork() const {
+  if(!inbox.IsEmpty() || !expressDeque.IsEmpty())
+    return true;
+
+  for(uint32_t i = 0; i < workerThreadCount; i++) {
+    if(!workers[i].expressDeque.IsEmpty())
+      return true;
+
+    if(CanTakeInbox(i) && !workers[i].inbox.IsEmpty())
+      return true;
+
+    if(!expressOnly && (!workers[i].deque.IsEmpty() || !workers[i].inboxDeque.IsEmpty()))
+      return true;
+  }
+
+  return false;
+}
+
+bool JobWorker::CanTakeInbox(uint32_t index) const {
+  // Default worker inboxes only hold default jobs, which the express lane never runs.
+  return !expressOnly || workers[index].expressOnly;
+}
+
+bool JobWorker::Wake(uint32_t index) {
+  JobWorker& worker = workers[index];
+  if(worker.sleeping.load(std::memory_order_seq_cst)) {
+    worker.condition->Signal(worker.wait);
+    return true;
+  }
+
+  return false;
+}
+
+void JobWorker::WakeIdle(uint32_t exceptIndex, bool express) {
+  for(uint32_t i = 1; i < workerThreadCount; i++) {
+    JobWorker& worker = workers[(exceptIndex + i) % workerThreadCount];
+    if(worker.expressOnly && !express)
+      continue;
+
+    if(worker.sleeping.load(std::memory_order_seq_cst)) {
+      worker.condition->Signal(worker.wait);
+      return;
+    }
+  }
+}
+
+Job::Job(JobCallback callback, JobCallback response, JobType type):
+callback(std::move(callback)),
+response(std::move(response)),
 thread(nullptr),
 completed(false),
 canceled(false),
-type(type) {
+type(type),
+queueNext(nullptr),
+queueTime(0),
+graph(nullptr),
+dependencyCount(0),
+detached(false),
+pooled(false) {
+  jobsAllocated.fetch_add(1, std::memory_order_relaxed);
+  memset(results, 0, sizeof(results));
   InitCommon();
 }
 
-Job::Job(std::function<void(Job&)> callback, std::function<void(Job&)> response, const json& data, JobType type):
-callback(callback),
-response(response),
+Job::Job(JobCallback callback, JobCallback response, const json& data, JobType type):
+callback(std::move(callback)),
+response(std::move(response)),
 data(data),
 thread(nullptr),
 completed(false),
 canceled(false),
-type(type) {
+type(type),
+queueNext(nullptr),
+queueTime(0),
+graph(nullptr),
+dependencyCount(0),
+detached(false),
+pooled(false) {
+  jobsAllocated.fetch_add(1, std::memory_order_relaxed);
+  memset(results, 0, sizeof(results));
   InitCommon();
 }
 
+Job::Job(JobType type, JobGraph* graph, JobCallback callback):
+callback(std::move(callback)),
+thread(nullptr),
+completed(false),
+canceled(false),
+type(type == JobType::Independent ? JobType::Default : type),
+queueNext(nullptr),
+queueTime(0),
+graph(graph),
+dependencyCount(1),
+detached(false),
+pooled(false) {
+  jobsAllocated.fetch_add(1, std::memory_order_relaxed);
+  memset(results, 0, sizeof(results));
+}
+
 Job::~Job() {
   if(thread)
     delete thread;
@@ -103,6 +657,7 @@ void Job::InitCommon() {
     jobMutex->Unlock();
 
     if(callback) {
+      jobsAllocated.fetch_add(1, std::memory_order_relaxed);
       thread = new Thread(JobThread, this);
       thread->Start();
     }
@@ -111,25 +666,141 @@ void Job::InitCommon() {
     }
   }
   else {
-    if(callback) {
-      workerThreadMutex->Lock();
-      jobQueue.push_back(this);
-      workerThreadMutex->Unlock();
+    jobsOutstanding.fetch_add(1, std::memory_order_relaxed);
 
-      workerThreadMutex->Lock();
-      workerThreadCondition[workerThreadIndex]->Signal(workerThreadWait[workerThreadIndex]);
-      if(++workerThreadIndex >= workerThreadCount)
-        workerThreadIndex = 0;
-      workerThreadMutex->Unlock();
+    if(callback) {
+      Submit();
     }
     else {
       completed = true;
+      jobCompletedQueue.Push(this);
+    }
+  }
+}
+
+void Job::Submit() {
+  bool express = type == JobType::Express;
+
+  queueTime = GetJobTime();
+  jobsSubmitted.fetch_add(1, std::memory_order_relaxed);
+
+  if(currentWorkerIndex >= 0) {
+    // Jobs spawned from a worker stay local and are picked up by idle peers through stealing.
+    uint32_t index = (uint32_t) currentWorkerIndex;
+    JobWorker& worker = workers[index];
+    if(express) {
+      worker.expressDeque.Push(this);
+    }
+    else {
+      worker.deque.Push(this);
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    JobWorker::WakeIdle(index, express);
+  }
+  else {
+    uint32_t index;
+    if(express) {
+      index = 0;
+    }
+    else {
+      uint32_t defaultCount = workerThreadCount - workerFirstDefaultIndex;
+      index = workerFirstDefaultIndex + workerNextIndex.fetch_add(1, std::memory_order_relaxed) % defaultCount;
+    }
+
+    workers[index].inbox.Push(this);
+
+    // If the owner is busy, wake an idle peer to take the inbox over.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(!JobWorker::Wake(index)) {
+      JobWorker::WakeIdle(index, express);
+    }
+  }
+}
+
+Job* Job::Create(JobCallback callback, JobCallback response, JobType type) {
+  Job* job = Acquire();
+  job->callback = std::move(callback);
+  job->response = std::move(response);
+  job->type = type;
+  job->InitCommon();
+  return job;
+}
+
+Job* Job::Create(JobCallback callback, JobCallback response, const json& data, JobType type) {
+  Job* job = Acquire();
+  job->callback = std::move(callback);
+  job->response = std::move(response);
+  job->data = data;
+  job->type = type;
+  job->InitCommon();
+  return job;
+}
 
-      workerThreadMutex->Lock();
-      jobCompletedStack.push_back(this);
-      workerThreadMutex->Unlock();
+Job* Job::Acquire() {
+  Job* job = nullptr;
+
+  if(jobPoolMutex) {
+    jobPoolMutex->Lock();
+    if(jobPool) {
+      job = jobPool;
+      jobPool = job->queueNext;
+      job->queueNext = nullptr;
+      jobPoolCount--;
     }
+    jobPoolMutex->Unlock();
+  }
+
+  if(job) {
+    jobsRecycled.fetch_add(1, std::memory_order_relaxed);
+  }
+  else {
+    job = new Job(JobType::Default, nullptr, nullptr);
+    job->dependencyCount.store(0, std::memory_order_relaxed);
+  }
+
+  job->pooled = true;
+  return job;
+}
+
+void Job::Release(Job* job) {
+  // Jobs that carry json data or a thread are not worth keeping; their
+  // allocations would only grow while sitting in the pool.
+  if(!job->pooled || job->thread || !job->data.IsNull() || !jobPoolMutex) {
+    delete job;
+    return;
+  }
+
+  job->callback.Reset();
+  job->response.Reset();
+  job->completed = false;
+  job->canceled = false;
+  job->type = JobType::Default;
+  job->queueTime = 0;
+  job->graph = nullptr;
+  job->dependencyCount.store(0, std::memory_order_relaxed);
+  job->successors.clear();
+  job->detached = false;
+  job->param = nullptr;
+  job->error.clear();
+  memset(job->results, 0, sizeof(job->results));
+
+  jobPoolMutex->Lock();
+  if(jobPoolCount < OGALIB_JOB_POOL_CAPACITY) {
+    job->queueNext = jobPool;
+    jobPool = job;
+    jobPoolCount++;
+    job = nullptr;
   }
+  jobPoolMutex->Unlock();
+
+  if(job) {
+    delete job;
+  }
+}
+
+void JobCallback::OnHeapAllocation() {
+  jobsAllocated.fetch_add(1, std::memory_order_relaxed);
 }
 
 void Job::Call(void* param, const std::string& error) {
@@ -148,9 +819,200 @@ void Job::Shutdown() {
 
 }
 
+void Job::GetStats(JobStats& stats) {
+  static uint64_t buckets[JobLatencyBucketCount];
+
+  memset(&stats, 0, sizeof(stats));
+  memset(buckets, 0, sizeof(buckets));
+
+  stats.submitted = jobsSubmitted.load(std::memory_order_relaxed);
+
+  uint64_t latencyMax = 0;
+
+  for(uint32_t i = 0; i < workerThreadCount; i++) {
+    JobWorker& worker = workers[i];
+    stats.started += worker.started.load(std::memory_order_relaxed);
+    stats.stolen += worker.stolen.load(std::memory_order_relaxed);
+    stats.expressStarted += worker.expressStarted.load(std::memory_order_relaxed);
+    latencyMax = std::max(latencyMax, worker.latencyMax.load(std::memory_order_relaxed));
+
+    for(uint32_t j = 0; j < JobLatencyBucketCount; j++) {
+      buckets[j] += worker.latencyBuckets[j].load(std::memory_order_relaxed);
+    }
+  }
+
+  stats.latencyP50 = GetJobLatencyPercentile(buckets, stats.started, 0.5);
+  stats.latencyP99 = GetJobLatencyPercentile(buckets, stats.started, 0.99);
+  stats.latencyMax = latencyMax * 1.0e-9;
+  stats.allocations = jobsAllocated.load(std::memory_order_relaxed);
+  stats.recycled = jobsRecycled.load(std::memory_order_relaxed);
+}
+
+void Job::ResetStats() {
+  jobsSubmitted.store(0, std::memory_order_relaxed);
+  jobsAllocated.store(0, std::memory_order_relaxed);
+  jobsRecycled.store(0, std::memory_order_relaxed);
+
+  for(uint32_t i = 0; i < workerThreadCount; i++) {
+    workers[i].ResetStats();
+  }
+}
+
+JobGraph::JobGraph():
+remaining(0),
+canceled(false),
+started(false) {
+
+}
+
+JobGraph::~JobGraph() {
+  for(auto job: jobs) {
+    Job::Release(job);
+  }
+}
+
+Job* JobGraph::Add(JobCallback callback, JobType type) {
+  ogalibAssert(!started, "Cannot add jobs to a JobGraph that has already started.");
+
+  Job* job = Job::Acquire();
+  job->callback = std::move(callback);
+  job->type = type == JobType::Independent ? JobType::Default : type;
+  job->graph = this;
+  job->dependencyCount.store(1, std::memory_order_relaxed);
+  jobs.push_back(job);
+  return job;
+}
+
+Job* JobGraph::Add(JobCallback callback, std::initializer_list<Job*> predecessors, JobType type) {
+  Job* job = Add(std::move(callback), type);
+  for(auto predecessor: predecessors) {
+    AddDependency(job, predecessor);
+  }
+  return job;
+}
+
+Job* JobGraph::Then(Job* predecessor, JobCallback callback, JobType type) {
+  return Add(std::move(callback), {predecessor}, type);
+}
+
+void JobGraph::AddDependency(Job* job, Job* predecessor) {
+  ogalibAssert(!started, "Cannot add dependencies to a JobGraph that has already started.");
+  ogalibAssert(job && job->graph == this, "Job does not belong to this JobGraph.");
+  ogalibAssert(predecessor && predecessor->graph == this, "Predecessor does not belong to this JobGraph.");
+
+  if(!job || !predecessor || job == predecessor)
+    return;
+
+  predecessor->successors.push_back(job);
+  job->dependencyCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobGraph::Start(std::function<void(JobGraph&)> response) {
+  ogalibAssert(!started, "JobGraph has already started.");
+
+  this->response = response;
+  started = true;
+
+  jobsOutstanding.fetch_add(1, std::memory_order_relaxed);
+
+  // The extra count is a hold released below, so the graph cannot finish (and
+  // be deleted) while its roots are still being submitted.
+  remaining.store(jobs.size() + 1, std::memory_order_relaxed);
+
+  for(size_t i = 0, count = jobs.size(); i < count; i++) {
+    Job* job = jobs[i];
+    if(job->dependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      job->Submit();
+    }
+  }
+
+  Release();
+}
+
+void JobGraph::Cancel() {
+  canceled = true;
+}
+
+void JobGraph::OnJobCompleted(Job* job) {
+  for(auto successor: job->successors) {
+    if(successor->dependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      successor->Submit();
+    }
+  }
+
+  Release();
+}
+
+void JobGraph::Release() {
+  if(remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    return;
+
+  // Hand the whole graph back to the main thread as a single completed job.
+  Job* job = Job::Acquire();
+  job->response = [this](Job& job) {
+    if(canceled) {
+      error = CanceledErrorStr;
+    }
+    if(this->response) {
+      this->response(*this);
+    }
+    delete this;
+  };
+  job->completed = true;
+  jobCompletedQueue.Push(job);
+}
+
+void ogalib::ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+  if(end <= begin)
+    return;
+
+  if(grain == 0) {
+    grain = GetParallelGrain(end - begin);
+  }
+
+  size_t chunkCount = (end - begin + grain - 1) / grain;
+  size_t helperCount = std::min(chunkCount - 1, (size_t) (workerThreadCount - workerFirstDefaultIndex));
+
+  if(helperCount == 0 || !workers) {
+    for(size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grain) {
+      fn(chunkBegin, std::min(chunkBegin + grain, end));
+    }
+    return;
+  }
+
+  ParallelForContext* context = ParallelForContext::Acquire(&fn, begin, end, grain, chunkCount, (uint32_t) helperCount + 1);
+
+  for(size_t i = 0; i < helperCount; i++) {
+    Job* job = Job::Acquire();
+    job->callback = [context](Job& job) {
+      context->Run();
+      context->Release();
+    };
+    job->detached = true;
+    job->Submit();
+  }
+
+  context->Run();
+
+  while(!context->IsDone()) {
+    Thread::Yield();
+  }
+
+  context->Release();
+}
+
+size_t ogalib::GetParallelGrain(size_t count) {
+  // Aim for a few chunks per thread so uneven chunks still balance out.
+  size_t threadCount = (size_t) (workerThreadCount - workerFirstDefaultIndex) + 1;
+  size_t grain = count / (threadCount * 4);
+  return grain > 0 ? grain : 1;
+}
+
 void* ogalib::JobThread(void* param) {
   Job* job = static_cast<Job*>(param);
   if(job->callback) {
+    ogalibProfileThread("ogalib::Job independent");
+    ogalibProfileScope("ogalib::Job independent");
     job->callback(*job);
   }
   job->completed = true;
@@ -159,6 +1021,7 @@ void* ogalib::JobThread(void* param) {
 
 void Job::InitGlobal() {
   jobMutex = new ThreadMutex("Job Callback Mutex");
+  jobPoolMutex = new ThreadMutex("Job Pool Mutex");
 
   InitWorkerThread();
 }
@@ -181,47 +1044,49 @@ void Job::ShutdownGlobal() {
     delete jobMutex;
     jobMutex = nullptr;
   }
-}
 
-void Job::ProcessGlobal() {
-  if(jobQueue.size() > 0) {
-    workerThreadMutex->Lock();
-    workerThreadCondition[workerThreadIndex]->Signal(workerThreadWait[workerThreadIndex]);
-    if(++workerThreadIndex >= workerThreadCount)
-      workerThreadIndex = 0;
-    workerThreadMutex->Unlock();
+  while(jobPool) {
+    Job* job = jobPool;
+    jobPool = job->queueNext;
+    delete job;
   }
+  jobPoolCount = 0;
 
-  if(jobs.size() == 0 && jobCompletedStack.size() == 0)
-    return;
+  while(parallelForContextPool) {
+    ParallelForContext* context = parallelForContextPool;
+    parallelForContextPool = context->poolNext;
+    delete context;
+  }
+  parallelForContextPoolCount = 0;
 
-  std::vector<Job*> processJobs;
-  std::vector<Job*> removeJobs;
+  if(jobPoolMutex) {
+    delete jobPoolMutex;
+    jobPoolMutex = nullptr;
+  }
+}
 
-  workerThreadMutex->Lock();
-  for(auto jc: jobCompletedStack) {
-    processJobs.push_back(jc);
-  }  
-  jobCompletedStack.clear();
-  workerThreadMutex->Unlock();
+void Job::ProcessGlobal() {
+  Job* completedList = jobCompletedQueue.TakeAll();
+  while(completedList) {
+    Job* jc = completedList;
+    completedList = jc->queueNext;
 
-  for(auto jc: processJobs) {
     if(jc->canceled) {
       jc->Call(&jc->data, CanceledErrorStr);
-      removeJobs.push_back(jc);
     }
-    else if(jc->completed) {
+    else {
       jc->Call(&jc->data);
-      removeJobs.push_back(jc);
     }
-  }
 
-  for(auto jc: removeJobs) {
-    delete jc;
+    Release(jc);
+    jobsOutstanding.fetch_sub(1, std::memory_order_relaxed);
   }
 
-  processJobs.clear();
-  removeJobs.clear();
+  if(jobs.size() == 0)
+    return;
+
+  std::vector<Job*> processJobs;
+  std::vector<Job*> removeJobs;
 
   jobMutex->Lock();
   for(auto jc: jobs) {
@@ -247,7 +1112,7 @@ void Job::ProcessGlobal() {
   jobMutex->Unlock();
 
   for(auto jc: removeJobs) {
-    delete jc;
+    Release(jc);
   }
 }
 
@@ -255,34 +1120,36 @@ bool Job::HasJobs() {
   size_t count;
 
   jobMutex->Lock();
-  count = jobsInProgress + jobs.size() + jobQueue.size() + jobCompletedStack.size();
+  count = jobsOutstanding.load(std::memory_order_acquire) + jobs.size();
   jobMutex->Unlock();
 
   return count > 0;
 }
 
 void Job::InitWorkerThread() {
-  workerThreadMutex = new ThreadMutex("ogalib::Job worker thread mutex", true);
-
   uint32_t maxWorkerThreadCount = (uint32_t) Thread::GetDeviceThreadCount();
 
   workerThreadCount = std::min(maxWorkerThreadCount, (uint32_t) OGALIB_JOB_CALLBACK_WORKER_COUNT);
   if(workerThreadCount < 1)
     workerThreadCount = 1;
-  workerThreadCondition = new ThreadCondition*[workerThreadCount];
-  workerThread = new Thread*[workerThreadCount];
-  workerThreadNumbers = new uint32_t[workerThreadCount];
-  workerThreadActive = new bool[workerThreadCount];
-  workerThreadWait = new bool[workerThreadCount];
+
+  // Worker 0 is designated as an "express lane" for jobs that perform quickly.
+  workerFirstDefaultIndex = workerThreadCount > 1 ? 1 : 0;
+
+  workers = new JobWorker[workerThreadCount];
+
+  for(uint32_t i = 0; i < workerThreadCount; i++) {
+    JobWorker& worker = workers[i];
+    worker.number = i;
+    worker.expressOnly = i < workerFirstDefaultIndex;
+    worker.condition = new ThreadCondition(string_printf("ogalib::Job worker thread condition (%d)", i).c_str());
+  }
 
   for(uint32_t i = 0; i < workerThreadCount; i++) {
-    workerThreadActive[i] = true;
-    workerThreadWait[i] = true;
-    workerThreadNumbers[i] = i;
-    workerThreadCondition[i] = new ThreadCondition(string_printf("ogalib::Job worker thread condition (%d)", i).c_str());
-    workerThread[i] = new Thread(JobWorkerThread, &workerThreadNumbers[i], string_printf("ogalib::Job worker thread (%d)", i).c_str());
-    workerThread[i]->SetPriority(OGALIB_JOB_CALLBACK_WORKER_THREAD_PRIORITY);
-    if(!workerThread[i]->Start()) {
+    JobWorker& worker = workers[i];
+    worker.thread = new Thread(JobWorkerThread, &worker.number, string_printf("ogalib::Job worker thread (%d)", i).c_str());
+    worker.thread->SetPriority(OGALIB_JOB_CALLBACK_WORKER_THREAD_PRIORITY);
+    if(!worker.thread->Start()) {
       ogalibAssert(false, "Could not start ogalib::Job worker thread.");
     }
   }
@@ -290,99 +1157,97 @@ void Job::InitWorkerThread() {
 
 void Job::ShutdownWorkerThread() {
   for(uint32_t i = 0; i < workerThreadCount; i++) {
-    workerThreadActive[i] = false;
+    workers[i].active = false;
   }
 
   for(uint32_t i = 0; i < workerThreadCount; i++) {
-    if(workerThreadCondition[i]) {
-      workerThreadCondition[i]->ShutdownThread(workerThread[i], workerThreadWait[i]);
-      delete workerThreadCondition[i];
-      workerThreadCondition[i] = nullptr;
+    JobWorker& worker = workers[i];
+    if(worker.condition) {
+      worker.condition->ShutdownThread(worker.thread, worker.wait);
+      delete worker.condition;
+      worker.condition = nullptr;
     }
   }
 
-  if(workerThreadMutex) {
-    delete workerThreadMutex;
-    workerThreadMutex = nullptr;
+  if(workers) {
+    delete[] workers;
+    workers = nullptr;
   }
 
-  if(workerThreadCondition) {
-    delete[] workerThreadCondition;
-    workerThreadCondition = nullptr;
-  }
+  workerThreadCount = 0;
+}
 
-  if(workerThread) {
-    delete[] workerThread;
-    workerThread = nullptr;
-  }
+void* ogalib::JobWorkerThread(void* param) {
+  uint32_t* workerThreadNumbers = (uint32_t*) param;
+  uint32_t workerThreadNumber = *workerThreadNumbers;
+  JobWorker& worker = workers[workerThreadNumber];
+  uint32_t spinCount = 0;
 
-  if(workerThreadNumbers) {
-    delete[] workerThreadNumbers;
-    workerThreadNumbers = nullptr;
-  }
+  currentWorkerIndex = (int32_t) workerThreadNumber;
 
-  if(workerThreadActive) {
-    delete[] workerThreadActive;
-    workerThreadActive = nullptr;
-  }
+  ogalibProfileThread(string_printf("ogalib::Job worker (%u)", workerThreadNumber).c_str());
+
+  while(worker.active) {
+    Job* job = worker.FindJob();
 
-  if(workerThreadWait) {
-    delete[] workerThreadWait;
-    workerThreadWait = nullptr;
+    if(job) {
+      worker.RunJob(job);
+      spinCount = 0;
+    }
+    else if(++spinCount < OGALIB_JOB_WORKER_SPIN_COUNT) {
+      Thread::Yield();
+    }
+    else {
+      spinCount = 0;
+      worker.Wait();
+    }
   }
+
+  currentWorkerIndex = -1;
+
+  return nullptr;
 }
 
-void* ogalib::JobWorkerThread(void* param) {
-  uint32_t* workerThreadNumbers = (uint32_t*) param;
-  uint32_t workerThreadNumber = *workerThreadNumbers;
+uint64_t GetJobTime() {
+  return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
-  while(workerThreadActive[workerThreadNumber]) {
-    Job* job = nullptr;
+uint32_t GetJobLatencyBucket(uint64_t ns) {
+  if(ns < 4)
+    return (uint32_t) ns;
 
-    size_t jobCount = jobQueue.size();        
-    if(jobCount > 0) {
-      workerThreadMutex->Lock();
-
-      if(workerThreadNumber == 0 && workerThreadCount > 1) {
-        // This thread is designated as an "express lane" for jobs that perform quickly.
-        for(auto& currJob: jobQueue) {
-          if(currJob->type == JobType::Express) {
-            job = currJob;
-            jobQueue.remove(currJob);
-            jobsInProgress++;
-            break;
-          }
-        }
-      }
-      else {
-        if(jobQueue.size() > 0) {
-          job = jobQueue.front();
-          jobQueue.pop_front();
-          jobsInProgress++;
-        }
-      }
+  // Four buckets per power of two keeps percentile error under 25%.
+  uint32_t msb = 0;
+  for(uint64_t v = ns; v >>= 1;) {
+    msb++;
+  }
 
-      workerThreadMutex->Unlock();
-    }
+  uint32_t sub = (uint32_t) ((ns >> (msb - 2)) & 3);
+  return msb * 4 + sub;
+}
 
-    if(job) {
-      if(job->callback) {
-        job->callback(*job);
-      }
-      job->completed = true;
+uint64_t GetJobLatencyBucketValue(uint32_t bucket) {
+  if(bucket < 4)
+    return bucket;
 
-      workerThreadMutex->Lock();
-      jobCompletedStack.push_back(job);
-      if(jobsInProgress > 0) {
-        jobsInProgress--;
-      }
-      workerThreadMutex->Unlock();
+  uint32_t msb = bucket / 4;
+  uint32_t sub = bucket % 4;
+  return ((uint64_t) (4 + sub + 1) << (msb - 2)) - 1;
+}
 
-      Thread::Yield();
-    }
+double GetJobLatencyPercentile(const uint64_t* buckets, uint64_t total, double percentile) {
+  if(total == 0)
+    return 0.0;
+
+  uint64_t target = (uint64_t) (total * percentile);
+  uint64_t count = 0;
 
-    workerThreadCondition[workerThreadNumber]->Wait(workerThreadWait[workerThreadNumber]);
+  for(uint32_t i = 0; i < JobLatencyBucketCount; i++) {
+    count += buckets[i];
+    if(count > target) {
+      return GetJobLatencyBucketValue(i) * 1.0e-9;
+    }
   }
 
-  return nullptr;
+  return GetJobLatencyBucketValue(JobLatencyBucketCount - 1) * 1.0e-9;
 }
@@ -0,0 +1,702 @@
+/*
+ogalib
+
+MIT License
+
+Copyright (c) 2024 Sean Reid (email@seanreid.ca)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+// Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ogalib/ogalib.h>
+
+#if OGALIB_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define ProfileEventTypeScope 0
+#define ProfileEventTypeCounter 1
+#define ProfileEventTypeGPUScope 2
+
+////////////////////////////////////////////////////////////////////////////////
+// Structs
+////////////////////////////////////////////////////////////////////////////////
+
+namespace ogalib {
+
+typedef struct _ProfileEvent {
+  const char* name;
+  uint64_t start;
+  union {
+    uint64_t end;
+    double value;
+  };
+  uint32_t threadIndex;
+  uint16_t depth;
+  uint16_t type;
+} ProfileEvent;
+
+typedef struct _ProfileScopeAccum {
+  std::string name;
+  const char* displayName;
+  bool gpu;
+  uint64_t frameCalls;
+  uint64_t frameTime;
+  uint64_t lastFrameCalls;
+  uint64_t lastFrameTime;
+  uint64_t maxTime;
+  uint64_t totalCalls;
+  uint64_t totalTime;
+} ProfileScopeAccum;
+
+typedef struct _ProfileCounterAccum {
+  std::string name;
+  const char* displayName;
+  double value;
+} ProfileCounterAccum;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace ogalib {
+
+// Single-producer ring owned by one thread at a time. The owner advances head
+// after writing an event; the collector on the main thread advances tail after
+// reading. A full ring drops new events rather than blocking the owner.
+class ProfileThreadBuffer {
+public:
+
+  ProfileEvent* events;
+  uint64_t mask;
+  std::atomic<uint64_t> head;
+  std::atomic<uint64_t> tail;
+  std::atomic<uint64_t> dropped;
+  std::atomic<bool> owned;
+  uint32_t index;
+  uint32_t depth;
+  std::string name;
+
+public:
+
+  ProfileThreadBuffer(uint32_t index):
+  mask(OGALIB_PROFILER_THREAD_EVENT_CAPACITY - 1),
+  head(0),
+  tail(0),
+  dropped(0),
+  owned(true),
+  index(index),
+  depth(0) {
+    static_assert((OGALIB_PROFILER_THREAD_EVENT_CAPACITY & (OGALIB_PROFILER_THREAD_EVENT_CAPACITY - 1)) == 0, "OGALIB_PROFILER_THREAD_EVENT_CAPACITY must be a power of two.");
+    events = new ProfileEvent[OGALIB_PROFILER_THREAD_EVENT_CAPACITY];
+  }
+
+  ~ProfileThreadBuffer() {
+    delete[] events;
+  }
+
+  ProfileEvent* Reserve() {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    if(h - tail.load(std::memory_order_acquire) > mask) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    return &events[h & mask];
+  }
+
+  void Commit() {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+};
+
+// Hands a thread's buffer back to the pool when the thread exits, so threads
+// started per job do not each keep a ring alive.
+class ProfileThreadRelease {
+public:
+
+  ~ProfileThreadRelease();
+
+};
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace ogalib;
+
+static ThreadMutex* profilerMutex = nullptr;
+static std::atomic<uint32_t> profilerGeneration(0);
+static std::vector<ProfileThreadBuffer*> profilerBuffers;
+static ProfileThreadBuffer* profilerGPUBuffer = nullptr;
+
+static std::vector<ProfileScopeAccum> profilerScopes;
+static std::unordered_map<const char*, size_t> profilerScopeLookup[2];
+static std::unordered_map<std::string, size_t> profilerScopeNameLookup[2];
+static std::vector<ProfileCounterAccum> profilerCounters;
+static std::unordered_map<const char*, size_t> profilerCounterLookup;
+
+static uint64_t profilerFrameStart = 0;
+static uint64_t profilerFrameCount = 0;
+static uint64_t profilerFrameHistory[OGALIB_PROFILER_FRAME_HISTORY];
+static size_t profilerFrameHistoryCount = 0;
+static size_t profilerFrameHistoryNext = 0;
+static uint64_t profilerDropped = 0;
+
+static bool profilerCapturing = false;
+static uint64_t profilerCaptureStart = 0;
+static std::vector<ProfileEvent> profilerCaptureEvents;
+static std::vector<std::string> profilerCaptureThreadNames;
+
+static thread_local ProfileThreadBuffer* profilerThreadBuffer = nullptr;
+static thread_local uint32_t profilerThreadGeneration = 0;
+static thread_local ProfileThreadRelease profilerThreadRelease;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static ProfileThreadBuffer* GetProfileThreadBuffer();
+static void CollectProfileEvents();
+static void AddProfileScopeEvent(const ProfileEvent& event);
+static void AddProfileCounterEvent(const ProfileEvent& event);
+static double GetProfileFramePercentile(const std::vector<uint64_t>& sorted, double percentile);
+static void WriteProfileJSONString(FILE* file, const char* s);
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+ProfileThreadRelease::~ProfileThreadRelease() {
+  if(profilerThreadBuffer && profilerThreadGeneration == profilerGeneration.load(std::memory_order_acquire)) {
+    profilerThreadBuffer->depth = 0;
+    profilerThreadBuffer->owned.store(false, std::memory_order_release);
+  }
+
+  profilerThreadBuffer = nullptr;
+}
+
+void Profiler::Frame() {
+  if(!profilerMutex || !Thread::IsMainThread())
+    return;
+
+  uint64_t now = GetTime();
+
+  profilerMutex->Lock();
+
+  CollectProfileEvents();
+
+  for(ProfileScopeAccum& scope: profilerScopes) {
+    scope.lastFrameCalls = scope.frameCalls;
+    scope.lastFrameTime = scope.frameTime;
+    scope.maxTime = std::max(scope.maxTime, scope.frameTime);
+    scope.totalCalls += scope.frameCalls;
+    scope.totalTime += scope.frameTime;
+    scope.frameCalls = 0;
+    scope.frameTime = 0;
+  }
+
+  if(profilerFrameStart) {
+    profilerFrameHistory[profilerFrameHistoryNext] = now - profilerFrameStart;
+    profilerFrameHistoryNext = (profilerFrameHistoryNext + 1) % OGALIB_PROFILER_FRAME_HISTORY;
+    profilerFrameHistoryCount = std::min(profilerFrameHistoryCount + 1, (size_t) OGALIB_PROFILER_FRAME_HISTORY);
+    profilerFrameCount++;
+  }
+  profilerFrameStart = now;
+
+  profilerMutex->Unlock();
+}
+
+void Profiler::AddCounter(const char* name, double value) {
+  ProfileThreadBuffer* buffer = GetProfileThreadBuffer();
+  if(!buffer)
+    return;
+
+  ProfileEvent* event = buffer->Reserve();
+  if(!event)
+    return;
+
+  event->name = name;
+  event->start = GetTime();
+  event->value = value;
+  event->threadIndex = buffer->index;
+  event->depth = 0;
+  event->type = ProfileEventTypeCounter;
+  buffer->Commit();
+}
+
+void Profiler::SetThreadName(const char* name) {
+  ProfileThreadBuffer* buffer = GetProfileThreadBuffer();
+  if(!buffer)
+    return;
+
+  profilerMutex->Lock();
+  buffer->name = name ? name : "";
+  profilerMutex->Unlock();
+}
+
+void Profiler::GetStats(ProfileStats& stats) {
+  stats.frameCount = 0;
+  stats.frameTime = 0.0;
+  stats.frameP50 = 0.0;
+  stats.frameP95 = 0.0;
+  stats.frameP99 = 0.0;
+  stats.frameMax = 0.0;
+  stats.eventsDropped = 0;
+  stats.scopes.clear();
+  stats.counters.clear();
+
+  if(!profilerMutex)
+    return;
+
+  profilerMutex->Lock();
+
+  std::vector<uint64_t> sorted(profilerFrameHistory, profilerFrameHistory + profilerFrameHistoryCount);
+  std::sort(sorted.begin(), sorted.end());
+
+  stats.frameCount = profilerFrameCount;
+  if(profilerFrameHistoryCount > 0) {
+    size_t last = (profilerFrameHistoryNext + OGALIB_PROFILER_FRAME_HISTORY - 1) % OGALIB_PROFILER_FRAME_HISTORY;
+    stats.frameTime = profilerFrameHistory[last] * 1.0e-9;
+    stats.frameP50 = GetProfileFramePercentile(sorted, 0.5);
+    stats.frameP95 = GetProfileFramePercentile(sorted, 0.95);
+    stats.frameP99 = GetProfileFramePercentile(sorted, 0.99);
+    stats.frameMax = sorted.back() * 1.0e-9;
+  }
+
+  stats.eventsDropped = profilerDropped;
+  for(ProfileThreadBuffer* buffer: profilerBuffers) {
+    stats.eventsDropped += buffer->dropped.load(std::memory_order_relaxed);
+  }
+
+  stats.scopes.reserve(profilerScopes.size());
+  for(const ProfileScopeAccum& scope: profilerScopes) {
+    ProfileScopeStats& scopeStats = stats.scopes.emplace_back();
+    scopeStats.name = scope.displayName;
+    scopeStats.gpu = scope.gpu;
+    scopeStats.frameCalls = scope.lastFrameCalls;
+    scopeStats.frameTime = scope.lastFrameTime * 1.0e-9;
+    scopeStats.averageTime = profilerFrameCount > 0 ? scope.totalTime * 1.0e-9 / profilerFrameCount : 0.0;
+    scopeStats.maxTime = scope.maxTime * 1.0e-9;
+    scopeStats.totalCalls = scope.totalCalls;
+    scopeStats.totalTime = scope.totalTime * 1.0e-9;
+  }
+
+  std::sort(stats.scopes.begin(), stats.scopes.end(), [](const ProfileScopeStats& a, const ProfileScopeStats& b) {
+    return a.totalTime > b.totalTime;
+  });
+
+  stats.counters.reserve(profilerCounters.size());
+  for(const ProfileCounterAccum& counter: profilerCounters) {
+    stats.counters.push_back({counter.displayName, counter.value});
+  }
+
+  profilerMutex->Unlock();
+}
+
+std::string Profiler::GetStatsSummary(size_t maxScopes) {
+  ProfileStats stats;
+  GetStats(stats);
+
+  std::string summary = string_printf("frame %.2fms p50 %.2fms p95 %.2fms p99 %.2fms max %.2fms (%llu frames, %llu dropped)\n",
+    stats.frameTime * 1000.0, stats.frameP50 * 1000.0, stats.frameP95 * 1000.0, stats.frameP99 * 1000.0, stats.frameMax * 1000.0,
+    (unsigned long long) stats.frameCount, (unsigned long long) stats.eventsDropped);
+
+  size_t count = std::min(maxScopes, stats.scopes.size());
+  for(size_t i = 0; i < count; i++) {
+    const ProfileScopeStats& scope = stats.scopes[i];
+    summary += string_printf("  %-32s %s %8.3fms avg %8.3fms max %8.3fms (%llu calls)\n",
+      scope.name, scope.gpu ? "gpu" : "cpu", scope.frameTime * 1000.0, scope.averageTime * 1000.0, scope.maxTime * 1000.0, (unsigned long long) scope.frameCalls);
+  }
+
+  for(const ProfileCounterStats& counter: stats.counters) {
+    summary += string_printf("  %-32s %g\n", counter.name, counter.value);
+  }
+
+  return summary;
+}
+
+void Profiler::ResetStats() {
+  if(!profilerMutex)
+    return;
+
+  profilerMutex->Lock();
+
+  for(ProfileScopeAccum& scope: profilerScopes) {
+    scope.lastFrameCalls = 0;
+    scope.lastFrameTime = 0;
+    scope.maxTime = 0;
+    scope.totalCalls = 0;
+    scope.totalTime = 0;
+  }
+
+  profilerFrameCount = 0;
+  profilerFrameHistoryCount = 0;
+  profilerFrameHistoryNext = 0;
+  profilerDropped = 0;
+  for(ProfileThreadBuffer* buffer: profilerBuffers) {
+    buffer->dropped.store(0, std::memory_order_relaxed);
+  }
+
+  profilerMutex->Unlock();
+}
+
+void Profiler::StartCapture() {
+  if(!profilerMutex)
+    return;
+
+  profilerMutex->Lock();
+  profilerCapturing = true;
+  profilerCaptureStart = GetTime();
+  profilerCaptureEvents.clear();
+  profilerMutex->Unlock();
+}
+
+void Profiler::StopCapture() {
+  if(!profilerMutex)
+    return;
+
+  profilerMutex->Lock();
+  CollectProfileEvents();
+  profilerCapturing = false;
+  profilerMutex->Unlock();
+}
+
+bool Profiler::IsCapturing() {
+  return profilerCapturing;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) {
+  if(!profilerMutex)
+    return false;
+
+  FILE* file = fopen(path.c_str(), "wb");
+  if(!file)
+    return false;
+
+  profilerMutex->Lock();
+
+  fprintf(file, "{\"traceEvents\":[\n");
+
+  bool first = true;
+  for(size_t i = 0; i < profilerCaptureThreadNames.size(); i++) {
+    fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", (uint32_t) i);
+    WriteProfileJSONString(file, profilerCaptureThreadNames[i].c_str());
+    fprintf(file, "}}");
+    first = false;
+  }
+
+  for(const ProfileEvent& event: profilerCaptureEvents) {
+    double ts = (double) (int64_t) (event.start - profilerCaptureStart) * 1.0e-3;
+    fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+    WriteProfileJSONString(file, event.name);
+    if(event.type == ProfileEventTypeCounter) {
+      fprintf(file, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"value\":%g}}", ts, event.threadIndex, event.value);
+    }
+    else {
+      fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}", ts, (event.end - event.start) * 1.0e-3, event.threadIndex);
+    }
+    first = false;
+  }
+
+  fprintf(file, "\n]}\n");
+
+  profilerMutex->Unlock();
+
+  return fclose(file) == 0;
+}
+
+uint64_t Profiler::GetTime() {
+  return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+  ProfileThreadBuffer* buffer = profilerThreadBuffer;
+  if(!buffer || profilerThreadGeneration != profilerGeneration.load(std::memory_order_relaxed))
+    return;
+
+  buffer->depth = depth;
+
+  ProfileEvent* event = buffer->Reserve();
+  if(!event)
+    return;
+
+  event->name = name;
+  event->start = start;
+  event->end = end;
+  event->threadIndex = buffer->index;
+  event->depth = (uint16_t) depth;
+  event->type = ProfileEventTypeScope;
+  buffer->Commit();
+}
+
+void Profiler::AddGPUScope(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+  if(!profilerGPUBuffer || !Thread::IsMainThread())
+    return;
+
+  ProfileEvent* event = profilerGPUBuffer->Reserve();
+  if(!event)
+    return;
+
+  event->name = name;
+  event->start = start;
+  event->end = end;
+  event->threadIndex = profilerGPUBuffer->index;
+  event->depth = (uint16_t) depth;
+  event->type = ProfileEventTypeGPUScope;
+  profilerGPUBuffer->Commit();
+}
+
+uint32_t Profiler::EnterScope() {
+  ProfileThreadBuffer* buffer = GetProfileThreadBuffer();
+  if(!buffer)
+    return 0;
+
+  return buffer->depth++;
+}
+
+void Profiler::InitGlobal() {
+  profilerMutex = new ThreadMutex("ogalib::Profiler");
+  profilerGeneration.fetch_add(1, std::memory_order_release);
+
+  // GPU timings are fed from the main thread but shown on their own track.
+  profilerGPUBuffer = new ProfileThreadBuffer((uint32_t) profilerBuffers.size());
+  profilerGPUBuffer->name = "GPU";
+  profilerBuffers.push_back(profilerGPUBuffer);
+
+  profilerFrameStart = 0;
+  ResetStats();
+}
+
+void Profiler::ShutdownGlobal() {
+  if(!profilerMutex)
+    return;
+
+  // Bumping the generation invalidates every thread's cached buffer pointer
+  // before the buffers are freed.
+  profilerMutex->Lock();
+  profilerGeneration.fetch_add(1, std::memory_order_release);
+  for(ProfileThreadBuffer* buffer: profilerBuffers) {
+    delete buffer;
+  }
+  profilerBuffers.clear();
+  profilerGPUBuffer = nullptr;
+  profilerScopes.clear();
+  for(size_t i = 0; i < 2; i++) {
+    profilerScopeLookup[i].clear();
+    profilerScopeNameLookup[i].clear();
+  }
+  profilerCounters.clear();
+  profilerCounterLookup.clear();
+  profilerCaptureEvents.clear();
+  profilerCaptureEvents.shrink_to_fit();
+  profilerCaptureThreadNames.clear();
+  profilerCapturing = false;
+  profilerMutex->Unlock();
+
+  delete profilerMutex;
+  profilerMutex = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+ProfileThreadBuffer* GetProfileThreadBuffer() {
+  uint32_t generation = profilerGeneration.load(std::memory_order_acquire);
+  if(profilerThreadBuffer && profilerThreadGeneration == generation)
+    return profilerThreadBuffer;
+
+  if(!profilerMutex)
+    return nullptr;
+
+  profilerMutex->Lock();
+
+  ProfileThreadBuffer* buffer = nullptr;
+  for(ProfileThreadBuffer* candidate: profilerBuffers) {
+    if(!candidate->owned.load(std::memory_order_acquire)) {
+      candidate->owned.store(true, std::memory_order_relaxed);
+      candidate->depth = 0;
+      candidate->name.clear();
+      buffer = candidate;
+      break;
+    }
+  }
+
+  if(!buffer) {
+    buffer = new ProfileThreadBuffer((uint32_t) profilerBuffers.size());
+    profilerBuffers.push_back(buffer);
+  }
+
+  if(Thread::IsMainThread()) {
+    buffer->name = "Main";
+  }
+
+  profilerMutex->Unlock();
+
+  profilerThreadBuffer = buffer;
+  profilerThreadGeneration = generation;
+
+  // Touching the release object constructs it for this thread, which is what
+  // registers its destructor to run at thread exit.
+  (void) &profilerThreadRelease;
+
+  return buffer;
+}
+
+void CollectProfileEvents() {
+  for(ProfileThreadBuffer* buffer: profilerBuffers) {
+    uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+
+    for(; tail != head; tail++) {
+      const ProfileEvent& event = buffer->events[tail & buffer->mask];
+      if(event.type == ProfileEventTypeCounter) {
+        AddProfileCounterEvent(event);
+      }
+      else {
+        AddProfileScopeEvent(event);
+      }
+
+      if(profilerCapturing) {
+        if(profilerCaptureEvents.size() < OGALIB_PROFILER_CAPTURE_EVENT_CAPACITY) {
+          profilerCaptureEvents.push_back(event);
+        }
+        else {
+          profilerDropped++;
+        }
+      }
+    }
+
+    buffer->tail.store(tail, std::memory_order_release);
+  }
+
+  if(profilerCapturing) {
+    profilerCaptureThreadNames.resize(profilerBuffers.size());
+    for(size_t i = 0; i < profilerBuffers.size(); i++) {
+      const std::string& name = profilerBuffers[i]->name;
+      profilerCaptureThreadNames[i] = name.empty() ? string_printf("Thread %u", (uint32_t) i) : name;
+    }
+  }
+}
+
+void AddProfileScopeEvent(const ProfileEvent& event) {
+  size_t index;
+  bool gpu = event.type == ProfileEventTypeGPUScope;
+  std::unordered_map<const char*, size_t>& lookup = profilerScopeLookup[gpu ? 1 : 0];
+  std::unordered_map<std::string, size_t>& nameLookup = profilerScopeNameLookup[gpu ? 1 : 0];
+
+  // Names are looked up by pointer first; the same literal can have several
+  // addresses across translation units, so misses fall back to the string.
+  auto it = lookup.find(event.name);
+  if(it != lookup.end()) {
+    index = it->second;
+  }
+  else {
+    std::string name(event.name);
+    auto nameIt = nameLookup.find(name);
+    if(nameIt != nameLookup.end()) {
+      index = nameIt->second;
+    }
+    else {
+      index = profilerScopes.size();
+      ProfileScopeAccum& scope = profilerScopes.emplace_back();
+      scope.name = name;
+      scope.displayName = event.name;
+      scope.gpu = gpu;
+      scope.frameCalls = 0;
+      scope.frameTime = 0;
+      scope.lastFrameCalls = 0;
+      scope.lastFrameTime = 0;
+      scope.maxTime = 0;
+      scope.totalCalls = 0;
+      scope.totalTime = 0;
+      nameLookup[name] = index;
+    }
+    lookup[event.name] = index;
+  }
+
+  ProfileScopeAccum& scope = profilerScopes[index];
+  scope.frameCalls++;
+  scope.frameTime += event.end - event.start;
+}
+
+void AddProfileCounterEvent(const ProfileEvent& event) {
+  auto it = profilerCounterLookup.find(event.name);
+  if(it != profilerCounterLookup.end()) {
+    profilerCounters[it->second].value = event.value;
+    return;
+  }
+
+  std::string name(event.name);
+  for(size_t i = 0; i < profilerCounters.size(); i++) {
+    if(profilerCounters[i].name == name) {
+      profilerCounters[i].value = event.value;
+      profilerCounterLookup[event.name] = i;
+      return;
+    }
+  }
+
+  profilerCounterLookup[event.name] = profilerCounters.size();
+  profilerCounters.push_back({name, event.name, event.value});
+}
+
+double GetProfileFramePercentile(const std::vector<uint64_t>& sorted, double percentile) {
+  if(sorted.empty())
+    return 0.0;
+
+  size_t index = (size_t) (percentile * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)] * 1.0e-9;
+}
+
+void WriteProfileJSONString(FILE* file, const char* s) {
+  fputc('"', file);
+  for(; *s; s++) {
+    unsigned char c = (unsigned char) *s;
+    if(c == '"' || c == '\\') {
+      fputc('\\', file);
+      fputc(c, file);
+    }
+    else if(c < 0x20) {
+      fprintf(file, "\\u%04x", c);
+    }
+    else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+#endif
@@ -92,6 +92,9 @@ void ogalib::Init(const json& params) {
   ogalibData.globalSendURLParams = json::object();
 
   Thread::InitGlobal();
+#if OGALIB_PROFILER
+  Profiler::InitGlobal();
+#endif
   Job::InitGlobal();
 
   ogalibData.assetCacheMutex = new ThreadMutex();
@@ -126,6 +129,9 @@ void ogalib::Shutdown() {
   }
 
   Job::ShutdownGlobal();
+#if OGALIB_PROFILER
+  Profiler::ShutdownGlobal();
+#endif
 
   ogalibData.initialized = false;
 }